@@ -0,0 +1,302 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <type_traits>
+
+#ifndef __ewalena_expression_h
+#define __ewalena_expression_h
+
+namespace ewalena
+{
+
+  /**
+   * Base class of everything that can appear in an elementwise
+   * arithmetic expression: vectors, matrices and the (unevaluated)
+   * results of combining them. 
+   *
+   * Combining expressions with <code>+</code>, <code>-</code>, scalar
+   * <code>*</code> and <code>/</code>, <code>elementwise_product</code>
+   * and <code>elementwise_quotient</code> does not compute anything,
+   * but builds a small object that records the operation. The work is
+   * done when such an object is assigned to a Vector or Matrix, in a
+   * single loop over the elements. So
+   * <code>x = a*u + b*v + c*w - d*z</code> reads each operand once
+   * and writes <code>x</code> once, without any temporary vectors.
+   *
+   * Every expression <code>E</code> provides
+   * <code>E::value_type</code>, <code>n_rows ()</code>,
+   * <code>n_cols ()</code> and an unchecked <code>operator[]</code>
+   * that returns its <code>i</code>th element in row-major order.
+   *
+   * @note Expressions refer to the vectors and matrices they are built
+   * from. They are meant to be assigned in the statement that creates
+   * them, not stored.
+   *
+   * \ingroup base
+   */
+  template <typename Derived>
+    class Expression
+    {
+    public:
+
+    /**
+     * Return this expression as what it really is.
+     */
+    const Derived& operator () () const
+    {
+      return static_cast<const Derived&> (*this);
+    }
+
+    }; /* Expression */
+
+  /**
+   * The building blocks of elementwise expressions.
+   */
+  namespace expression
+  {
+
+    /**
+     * Marker of unevaluated expressions, as opposed to containers that
+     * hold data.
+     */
+    struct Node
+    {};
+
+    /**
+     * The way an operand is held by an expression: containers by
+     * reference, (light-weight) unevaluated expressions by value.
+     */
+    template <typename E>
+      struct Operand
+      {
+	typedef typename std::conditional<std::is_base_of<Node, E>::value, 
+					  const E, 
+					  const E&>::type type;
+      };
+
+    /**
+     * Elementwise operations.
+     */
+    struct Plus 
+    { 
+      template <typename T> static T apply (const T &a, const T &b) { return a + b; } 
+    };
+
+    struct Minus 
+    { 
+      template <typename T> static T apply (const T &a, const T &b) { return a - b; } 
+    };
+
+    struct Multiply 
+    { 
+      template <typename T> static T apply (const T &a, const T &b) { return a * b; } 
+    };
+
+    struct Divide 
+    { 
+      template <typename T> static T apply (const T &a, const T &b) { return a / b; } 
+    };
+
+    /**
+     * The elementwise combination of two expressions of the same
+     * shape.
+     */
+    template <typename E1, typename E2, typename Operation>
+      class Binary 
+      : 
+      public Expression<Binary<E1, E2, Operation> >,
+      public Node
+      {
+      public:
+
+      typedef typename E1::value_type value_type;
+
+      static_assert (std::is_same<value_type, typename E2::value_type>::value,
+		     "Operands of an expression must have the same value type.");
+
+      Binary (const E1 &a, const E2 &b)
+	:
+	a (a), b (b)
+      {
+	assert (a.n_rows () == b.n_rows ());
+	assert (a.n_cols () == b.n_cols ());
+      }
+
+      unsigned int n_rows () const { return a.n_rows (); }
+      unsigned int n_cols () const { return a.n_cols (); }
+
+      value_type operator [] (const unsigned int i) const
+      {
+	return Operation::apply (a[i], b[i]);
+      }
+
+      private:
+
+      typename Operand<E1>::type a;
+      typename Operand<E2>::type b;
+      };
+
+    /**
+     * An expression multiplied by a scalar.
+     */
+    template <typename E>
+      class Scaled 
+      : 
+      public Expression<Scaled<E> >,
+      public Node
+      {
+      public:
+
+      typedef typename E::value_type value_type;
+
+      Scaled (const value_type &scalar, const E &a)
+	:
+	scalar (scalar), a (a)
+      {}
+
+      unsigned int n_rows () const { return a.n_rows (); }
+      unsigned int n_cols () const { return a.n_cols (); }
+
+      value_type operator [] (const unsigned int i) const
+      {
+	return scalar*a[i];
+      }
+
+      private:
+
+      const value_type              scalar;
+      typename Operand<E>::type     a;
+      };
+
+  } /* namespace expression */
+
+  /*-------------- Operators ----------------------------------------*/
+
+  /**
+   * Elementwise sum of two expressions.
+   */
+  template <typename E1, typename E2>
+    inline
+    expression::Binary<E1, E2, expression::Plus>
+    operator + (const Expression<E1> &a, 
+		const Expression<E2> &b)
+    {
+      return expression::Binary<E1, E2, expression::Plus> (a (), b ());
+    }
+
+  /**
+   * Elementwise difference of two expressions.
+   */
+  template <typename E1, typename E2>
+    inline
+    expression::Binary<E1, E2, expression::Minus>
+    operator - (const Expression<E1> &a, 
+		const Expression<E2> &b)
+    {
+      return expression::Binary<E1, E2, expression::Minus> (a (), b ());
+    }
+
+  /**
+   * Elementwise (Hadamard) product of two expressions.
+   */
+  template <typename E1, typename E2>
+    inline
+    expression::Binary<E1, E2, expression::Multiply>
+    elementwise_product (const Expression<E1> &a, 
+			 const Expression<E2> &b)
+    {
+      return expression::Binary<E1, E2, expression::Multiply> (a (), b ());
+    }
+
+  /**
+   * Elementwise quotient of two expressions.
+   */
+  template <typename E1, typename E2>
+    inline
+    expression::Binary<E1, E2, expression::Divide>
+    elementwise_quotient (const Expression<E1> &a, 
+			  const Expression<E2> &b)
+    {
+      return expression::Binary<E1, E2, expression::Divide> (a (), b ());
+    }
+
+  /**
+   * Multiplication of an expression by a scalar.
+   */
+  template <typename E>
+    inline
+    expression::Scaled<E>
+    operator * (const typename E::value_type &scalar,
+		const Expression<E>           &a)
+    {
+      return expression::Scaled<E> (scalar, a ());
+    }
+
+  /**
+   * Multiplication of an expression by a scalar.
+   */
+  template <typename E>
+    inline
+    expression::Scaled<E>
+    operator * (const Expression<E>           &a,
+		const typename E::value_type &scalar)
+    {
+      return expression::Scaled<E> (scalar, a ());
+    }
+
+  /**
+   * Division of an expression by a scalar.
+   */
+  template <typename E>
+    inline
+    expression::Scaled<E>
+    operator / (const Expression<E>           &a,
+		const typename E::value_type &scalar)
+    {
+      return expression::Scaled<E> (typename E::value_type (1)/scalar, a ());
+    }
+
+  /**
+   * Negation of an expression.
+   */
+  template <typename E>
+    inline
+    expression::Scaled<E>
+    operator - (const Expression<E> &a)
+    {
+      return expression::Scaled<E> (typename E::value_type (-1), a ());
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_expression_h */
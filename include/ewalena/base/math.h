@@ -39,6 +39,7 @@
 #define __ewalena_math_h
 
 #include <cassert>
+#include <complex>
 
 namespace ewalena 
 {
@@ -59,6 +60,17 @@ namespace ewalena
     template <typename ValueType>
       int sgn (const ValueType scalar);
     
+    /**
+     * Return the complex conjugate of this scalar number, which for
+     * a real number is the number itself (and stays real).
+     */
+    double conjugate (const double scalar);
+
+    /**
+     * Return the complex conjugate of this scalar number.
+     */
+    std::complex<double> conjugate (const std::complex<double> &scalar);
+
     /**
      * Return the incomplete gamma function of this scalar number.
      */
@@ -68,13 +80,13 @@ namespace ewalena
     /**
      * Return \f$p=x^y\f$ where \f$p,x,y\in\{0,{\mathbb I}^+\}\f$.
      */
-    unsigned int pow (const unsigned int x, 
-		      const unsigned int y);
+    constexpr unsigned int pow (const unsigned int x, 
+				const unsigned int y);
 
     /**
      * Return the factorial of \f$x\f$: \f$x!\f$.
      */
-    unsigned int factorial (const unsigned int x);
+    constexpr unsigned int factorial (const unsigned int x);
 
     /**
      * Return the true (false) if this integer value is odd (even).
@@ -111,7 +123,7 @@ namespace ewalena
 
   /*-------------- Inline and Other Functions -----------------------*/
 
-  inline 
+  constexpr
     unsigned int math::pow (const unsigned int x, 
 			    const unsigned int y)
   {
@@ -121,6 +133,18 @@ namespace ewalena
   }
   
   inline
+    double math::conjugate (const double scalar)
+  {
+    return scalar;
+  }
+
+  inline
+    std::complex<double> math::conjugate (const std::complex<double> &scalar)
+  {
+    return std::conj (scalar);
+  }
+
+  constexpr
     unsigned int math::factorial (const unsigned int x)
   {
     return (x == 1 || x == 0) 
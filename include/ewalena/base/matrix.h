@@ -39,18 +39,24 @@
 #ifndef __ewalena_matrix_h
 #define __ewalena_matrix_h
 
+#include <ewalena/base/expression.h>
+#include <ewalena/base/memory.h>
 #include <ewalena/base/tensor.h>
+#include <ewalena/lac/gemm.h>
+#include <ewalena/lac/gemv.h>
 
 namespace ewalena
 {
   
   template <int, int, typename> class Tensor;
+  template <typename> class Vector;
 
   /**
    * A class that denotes a simple matrix with no special qualities,
    * ie. no special symmetries, data access, etc.
    * 
-   * Matrices are in row-column format.
+   * Matrices are in row-column format. Elementwise expressions of
+   * matrices are evaluated lazily, see <code>Expression</code>.
    *
    * @author Toby D. Young 2012.
    *
@@ -58,8 +64,15 @@ namespace ewalena
    */
   template <typename ValueType = double>
     class Matrix
+    :
+    public Expression<Matrix<ValueType> >
     {
     public:
+
+    /**
+     * The type of the elements of this matrix.
+     */
+    typedef ValueType value_type;
     
     /**
      * Constructor.
@@ -109,6 +122,19 @@ namespace ewalena
      * memory copy.
      */
     Matrix (const Matrix& M);
+
+    /**
+     * Initialize a matrix by taking over the memory of the matrix
+     * <code>M</code>, which is left empty.
+     */
+    Matrix (Matrix &&M) noexcept;
+
+    /**
+     * Initialize a matrix with the value of the expression
+     * <code>e</code>.
+     */
+    template <typename E>
+      Matrix (const Expression<E> &e);
     
     /**
      * Return the number of rows this matrix has.
@@ -127,7 +153,8 @@ namespace ewalena
     
     /**
      * Reinitialise this matrix to size <code>m</code>,
-     * <code>n</code>.
+     * <code>n</code>. Memory is only reallocated if this matrix never
+     * had as many elements before.
      */
     void reinit (const unsigned int m,
 		 const unsigned int n,
@@ -151,33 +178,71 @@ namespace ewalena
      */
     const ValueType& operator () (const unsigned int i, 
 				  const unsigned int j) const;
+
+    /**
+     * Unchecked read only access to the <code>i</code>th element of
+     * this matrix in row-major order, as used when evaluating
+     * expressions.
+     */
+    const ValueType& operator [] (const unsigned int i) const;
     
     /**
-     * Return the inverse of matrix \f$M\f$.
+     * Make <code>this</code> matrix the inverse of the square matrix
+     * \f$M\f$. Matrices of size up to three are inverted in closed
+     * form, those of size four to eight by <code>fixed_size::invert</code>
+     * and larger ones through their <code>LUFactorization</code>.
      */
     void invert (const Matrix<ValueType> &M);
     
     /**
-     * Multiply two matrices together:
-     * \f$M_{ij}=M_{(a)ik}M_{(b)kj}\f$.
+     * Multiply two matrices together and add the result to
+     * <code>this</code> matrix: \f$M_{ij}+=M_{(a)ik}M_{(b)kj}\f$.
      */
     void mult (const Matrix<ValueType> &M_a, 
 	       const Matrix<ValueType> &M_b);
     
     /**
-     * Transpose multiply two matrices togerher:
-     * \f$M_{ij}=M_{(a)ki}M_{(b)kj}\f$.
+     * Transpose multiply two matrices together and add the result to
+     * <code>this</code> matrix: \f$M_{ij}+=M_{(a)ki}M_{(b)kj}\f$.
      */
     void Tmult (const Matrix<ValueType> &M_a, 
 		const Matrix<ValueType> &M_b);
     
     /**
-     * Multiply transpose two matrices together:
-     * \f$M_{ij}=M_{(a)ik}M_{(b)jk}\f$.
+     * Multiply transpose two matrices together and add the result to
+     * <code>this</code> matrix: \f$M_{ij}+=M_{(a)ik}M_{(b)jk}\f$.
      */
     void multT (const Matrix<ValueType> &M_a, 
 		const Matrix<ValueType> &M_b);
     
+    /**
+     * Matrix-vector multiplication: \f$y=\alpha Mx+\beta y\f$. By
+     * default, <code>y</code> is overwritten by \f$Mx\f$.
+     */
+    void vmult (Vector<ValueType>       &y,
+		const Vector<ValueType> &x,
+		const ValueType          alpha = ValueType (1),
+		const ValueType          beta  = ValueType (0)) const;
+    
+    /**
+     * Transpose matrix-vector multiplication: \f$y=\alpha
+     * M^Tx+\beta y\f$.
+     */
+    void Tvmult (Vector<ValueType>       &y,
+		 const Vector<ValueType> &x,
+		 const ValueType          alpha = ValueType (1),
+		 const ValueType          beta  = ValueType (0)) const;
+    
+    /**
+     * Conjugate transpose matrix-vector multiplication: \f$y=\alpha
+     * M^Hx+\beta y\f$. For real value types this is the same as
+     * <code>Tvmult</code>.
+     */
+    void Hvmult (Vector<ValueType>       &y,
+		 const Vector<ValueType> &x,
+		 const ValueType          alpha = ValueType (1),
+		 const ValueType          beta  = ValueType (0)) const;
+    
     /**
      * Make this matrix the identity matrix (all previous data is
      * overwritten).
@@ -194,12 +259,27 @@ namespace ewalena
      * <code>this</code> matrix.
      */
     void operator += (const Matrix<ValueType> &M);
+
+    /**
+     * Inline addition operator. Add the expression <code>e</code> to
+     * <code>this</code> matrix in a single pass over the elements.
+     */
+    template <typename E>
+      void operator += (const Expression<E> &e);
     
     /**
      * Inline subtraction operator. Subtract <code>M</code> from
      * <code>this</code> matrix.
      */
     void operator -= (const Matrix<ValueType> &M);
+
+    /**
+     * Inline subtraction operator. Subtract the expression
+     * <code>e</code> from <code>this</code> matrix in a single pass
+     * over the elements.
+     */
+    template <typename E>
+      void operator -= (const Expression<E> &e);
     
     /**
      * Inline multiplication operator. Multiply every element in
@@ -214,9 +294,26 @@ namespace ewalena
     void operator /= (const ValueType &scalar);
     
     /**
-     * Equal operator. This is equivalent to a copy.
+     * Equal operator. This is equivalent to a copy, and the size of
+     * <code>this</code> matrix is changed if needed.
      */
-    void operator = (const Matrix<ValueType> &M);
+    Matrix<ValueType>& operator = (const Matrix<ValueType> &M);
+
+    /**
+     * Move operator. Make <code>this</code> matrix take over the
+     * memory of <code>M</code>, which is left empty.
+     */
+    Matrix<ValueType>& operator = (Matrix<ValueType> &&M) noexcept;
+
+    /**
+     * Make <code>this</code> matrix equal to the expression
+     * <code>e</code>, evaluated in a single pass over the
+     * elements, resized to the size of <code>e</code> if need
+     * be. <code>this</code> matrix may itself appear in
+     * <code>e</code>.
+     */
+    template <typename E>
+      Matrix<ValueType>& operator = (const Expression<E> &e);
     
     /**
      * Equivalence operator. Return true if <code>this</code> matrix
@@ -249,6 +346,15 @@ namespace ewalena
       return output; 
     }
     
+    /**
+     * Factorizations work on the underlying C array structure
+     * directly.
+     */
+    template <typename> friend class CholeskyFactorization;
+    template <typename> friend class LUFactorization;
+    template <typename> friend class QRFactorization;
+    template <typename> friend class TSQRFactorization;
+    
     protected:
     
     /**
@@ -287,6 +393,13 @@ namespace ewalena
      * columns this matrix has.
      */
     unsigned int __n_cols;
+
+    /**
+     * Internal reference to the number of elements there is memory
+     * for, which is never less than the number of elements this
+     * matrix has.
+     */
+    unsigned int __n_allocated;
     
     /**
      * Internal object denoting this
@@ -326,6 +439,71 @@ namespace ewalena
       return data[__n_cols*i+j];
     }
 
+  template <typename ValueType>
+    inline 
+    const ValueType& 
+    Matrix<ValueType>::operator [] (const unsigned int i) const
+    {
+      return data[i];
+    }
+
+  template <typename ValueType>
+  template <typename E>
+    inline 
+    Matrix<ValueType>::Matrix (const Expression<E> &e)
+    :
+    Matrix (e ().n_rows (), e ().n_cols (), false)
+    {
+      (*this) = e;
+    }
+
+  template <typename ValueType>
+  template <typename E>
+    inline 
+    Matrix<ValueType>&
+    Matrix<ValueType>::operator = (const Expression<E> &e) 
+    {
+      const E &expression = e ();
+      if ((expression.n_rows () != this->__n_rows) || (expression.n_cols () != this->__n_cols))
+	this->reinit (expression.n_rows (), expression.n_cols (), false);
+
+      ValueType *dst = data;
+      for (unsigned int i=0; i<__n_rows*__n_cols; ++i)
+	dst[i] = expression[i];
+
+      return *this;
+    }
+
+  template <typename ValueType>
+  template <typename E>
+    inline 
+    void
+    Matrix<ValueType>::operator += (const Expression<E> &e) 
+    {
+      const E &expression = e ();
+      if ((expression.n_rows () != this->__n_rows) || (expression.n_cols () != this->__n_cols))
+	this->reinit (expression.n_rows (), expression.n_cols (), false);
+
+      ValueType *dst = data;
+      for (unsigned int i=0; i<__n_rows*__n_cols; ++i)
+	dst[i] += expression[i];
+    }
+
+  template <typename ValueType>
+  template <typename E>
+    inline 
+    void
+    Matrix<ValueType>::operator -= (const Expression<E> &e) 
+    {
+      const E &expression = e ();
+      if ((expression.n_rows () != this->__n_rows) || (expression.n_cols () != this->__n_cols))
+	this->reinit (expression.n_rows (), expression.n_cols (), false);
+
+      ValueType *dst = data;
+      for (unsigned int i=0; i<__n_rows*__n_cols; ++i)
+	dst[i] -= expression[i];
+    }
+
   template <typename ValueType>
     inline
     unsigned int
@@ -393,17 +571,43 @@ namespace ewalena
     }
 
   template <typename ValueType>
-    void
+    inline
+    Matrix<ValueType>&
     Matrix<ValueType>::operator = (const Matrix<ValueType> &M) 
     {
-      assert (M.data);
+      if (this == &M)
+	return *this;
 
-      assert (M.__n_rows == this->__n_rows);
-      assert (M.__n_cols == this->__n_cols);
+      if ((M.__n_rows != this->__n_rows) || (M.__n_cols != this->__n_cols))
+	this->reinit (M.__n_rows, M.__n_cols, false);
+
+      if (this->n_elements () != 0)
+	std::memcpy (this->data, M.data, sizeof (ValueType)*this->n_elements ());
 
-      for (unsigned int i=0; i<__n_rows; ++i) 
-	for (unsigned int j=0; j<__n_cols; ++j) 
-	  (*this)(i,j) = M(i,j);
+      return *this;
+    }
+
+  template <typename ValueType>
+    inline
+    Matrix<ValueType>&
+    Matrix<ValueType>::operator = (Matrix<ValueType> &&M) noexcept
+    {
+      if (this == &M)
+	return *this;
+
+      memory::deallocate (this->data);
+
+      __n_rows      = M.__n_rows;
+      __n_cols      = M.__n_cols;
+      __n_allocated = M.__n_allocated;
+      data          = M.data;
+
+      M.__n_rows      = 0;
+      M.__n_cols      = 0;
+      M.__n_allocated = 0;
+      M.data          = 0;
+
+      return *this;
     }
 
   template <typename ValueType>
@@ -422,7 +626,6 @@ namespace ewalena
     bool
     Matrix<ValueType>::is_symmetric () const
     {
-      assert (this->data);
       assert (__n_rows == __n_cols);
       
       /* The matrix is trivially symmetric if it has zero size. */
@@ -468,8 +671,6 @@ namespace ewalena
     ValueType
     Matrix<ValueType>::norm ()
     {
-      assert (this->data);
-      
       ValueType scalar = 0;
       
       for (unsigned int i=0; i<(this->__n_rows)*(this->__n_cols); ++i)
@@ -478,22 +679,23 @@ namespace ewalena
       return scalar;
     }
   
+  /* All three products are handed to the blocked GEMM engine, which
+     absorbs the transposition of either operand while packing it. */
   template <typename ValueType> 
     inline  
     void
     Matrix<ValueType>::mult (const Matrix<ValueType> &M_a, 
  			     const Matrix<ValueType> &M_b)  
     { 
-      assert (M_a.data);
-      assert (M_b.data);
-
-      assert (M_a.__n_rows == M_b.__n_cols);  
       assert (M_a.__n_cols == M_b.__n_rows);  
+      assert (this->__n_rows == M_a.__n_rows);
+      assert (this->__n_cols == M_b.__n_cols);
       
-      for (unsigned int i=0; i<M_a.__n_rows; ++i)
-	for (unsigned int j=0; j<M_b.__n_cols; ++j)
-	  for (unsigned int k=0; k<M_b.__n_rows; ++k)
-	    (*this)(i,j) += M_a(i,k)*M_b(k,j);
+      blas::gemm (blas::no_transpose, blas::no_transpose,
+		  __n_rows, __n_cols, M_a.__n_cols,
+		  ValueType (1), M_a.data, M_a.__n_cols,
+		  M_b.data, M_b.__n_cols,
+		  ValueType (1), this->data, __n_cols);
     }
 
   template <typename ValueType> 
@@ -502,16 +704,15 @@ namespace ewalena
     Matrix<ValueType>::Tmult (const Matrix<ValueType> &M_a, 
 			      const Matrix<ValueType> &M_b)  
     { 
-      assert (M_a.data);
-      assert (M_b.data);
-
       assert (M_a.__n_rows == M_b.__n_rows);  
-      assert (M_a.__n_cols == M_b.__n_cols);  
+      assert (this->__n_rows == M_a.__n_cols);
+      assert (this->__n_cols == M_b.__n_cols);
       
-      for (unsigned int i=0; i<M_a.__n_rows; ++i)
-	for (unsigned int j=0; j<M_b.__n_cols; ++j)
-	  for (unsigned int k=0; k<M_b.__n_rows; ++k)
-	    (*this)(i,j) += M_a(k,i)*M_b(k,j);
+      blas::gemm (blas::transpose, blas::no_transpose,
+		  __n_rows, __n_cols, M_a.__n_rows,
+		  ValueType (1), M_a.data, M_a.__n_cols,
+		  M_b.data, M_b.__n_cols,
+		  ValueType (1), this->data, __n_cols);
     }
 
   template <typename ValueType> 
@@ -520,16 +721,15 @@ namespace ewalena
     Matrix<ValueType>::multT (const Matrix<ValueType> &M_a, 
 			      const Matrix<ValueType> &M_b)  
     { 
-      assert (M_a.data);
-      assert (M_b.data);
-
-      assert (M_a.__n_rows == M_b.__n_rows);  
       assert (M_a.__n_cols == M_b.__n_cols);  
+      assert (this->__n_rows == M_a.__n_rows);
+      assert (this->__n_cols == M_b.__n_rows);
       
-      for (unsigned int i=0; i<M_a.__n_rows; ++i)
-	for (unsigned int j=0; j<M_b.__n_cols; ++j)
-	  for (unsigned int k=0; k<M_b.__n_rows; ++k)
-	    (*this)(i,j) += M_a(i,k)*M_b(j,k);
+      blas::gemm (blas::no_transpose, blas::transpose,
+		  __n_rows, __n_cols, M_a.__n_cols,
+		  ValueType (1), M_a.data, M_a.__n_cols,
+		  M_b.data, M_b.__n_cols,
+		  ValueType (1), this->data, __n_cols);
     }
 
   /*-------------- Template and Other Functions ---------------------*/
@@ -540,9 +740,10 @@ namespace ewalena
     {
 
       /* @todo: Generalise this for rank \neq 2. */
-      __n_rows = dim;
-      __n_cols = dim;
-      data     = new ValueType[__n_rows*__n_cols];
+      __n_rows      = dim;
+      __n_cols      = dim;
+      __n_allocated = __n_rows*__n_cols;
+      data          = memory::allocate<ValueType> (__n_allocated);
       
       if ((__n_rows != 0) && (__n_cols !=0))
 	std::memcpy (this->data, *T, sizeof(ValueType)*(__n_rows*__n_cols));
@@ -559,76 +760,6 @@ namespace ewalena
   /* 	std::memcpy (this->data, *V, sizeof(ValueType)*(__n_rows*__n_cols)); */
   /*   } */
 
-  template <typename ValueType>
-    inline 
-    void
-    Matrix<ValueType>::invert (const Matrix<ValueType> &M)
-    {
-      assert (M.data);
-      assert (M.__n_rows==M.__n_cols);
-
-      this->reinit (M.__n_rows,M.__n_cols);
-
-      switch (M.__n_cols)
-	{
-	case 0:
-	  {
-	    /* Undefined operation.  */
-	    assert (false);
-	  }
-
-	case 1:
-	  {
-	    assert (M(0,0)!=ValueType (0));
-	    (*this)(0,0) = ValueType (1) / M(0,0);
-	    break;
-	  }
-	  
-	case 2:
-	  {
-	    const ValueType determinant = M(0,0)*M(1,1) - M(0,1)*M(1,0);
-	    assert (determinant!=ValueType (0));
-	    
-	    (*this)(0,0) =  M(1,1) / determinant;
-	    (*this)(0,1) = -M(0,1) / determinant;
-	    (*this)(1,0) = -M(1,0) / determinant;
-	    (*this)(1,1) =  M(0,0) / determinant;
-	    
-	    break;
-	  }
-
-	case 3: 
-	  {
-	    const ValueType determinant 
-	      = M(0,0)*(M(2,2)*M(1,1) - M(2,1)*M(1,2))
-	      - M(1,0)*(M(2,2)*M(0,1) - M(2,1)*M(0,2))
-	      + M(2,0)*(M(1,2)*M(0,1) - M(1,1)*M(0,2));
-	    assert (determinant!=ValueType (0));
-
-	    (*this)(0,0) =    (M(2,2)*M(1,1) - M(2,1)*M(1,2)) / determinant;
-	    (*this)(0,1) =  - (M(2,2)*M(0,1) - M(2,1)*M(0,2)) / determinant;
-	    (*this)(0,2) =    (M(1,2)*M(0,1) - M(1,1)*M(0,2)) / determinant;
-
-	    (*this)(1,0) =  - (M(2,2)*M(1,0) - M(2,0)*M(1,2)) / determinant;
-	    (*this)(1,1) =    (M(2,2)*M(0,0) - M(2,0)*M(0,2)) / determinant;
-	    (*this)(1,2) =  - (M(1,2)*M(0,0) - M(1,0)*M(0,2)) / determinant;
-
-	    (*this)(2,0) =    (M(2,1)*M(1,0) - M(2,0)*M(1,1)) / determinant;
-	    (*this)(2,1) =  - (M(2,1)*M(0,0) - M(2,0)*M(0,1)) / determinant;
-	    (*this)(2,2) =    (M(1,1)*M(0,0) - M(1,0)*M(0,1)) / determinant;
-
-	    break; 
-
-	  }
-
-	  /* This is not likely to work well for big or even medium
-	     sized matrices - so don't do it.  */
-	default:
-	  assert (false);
-	}
-      
-    }
-  
 } /* namespace ewalena */
 
 #endif /* __ewalena_matrix_h */
@@ -0,0 +1,118 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <stdlib.h>
+
+#ifndef __ewalena_memory_h
+#define __ewalena_memory_h
+
+namespace ewalena
+{
+
+  /**
+   * Some memory utilities used by the numerical kernels.
+   */
+  namespace memory
+  {
+
+    /**
+     * Byte alignment of memory blocks handed out by
+     * <code>allocate</code>. This is the width of a cache line, which
+     * is also wide enough for any vector instruction set we use.
+     */
+    static const std::size_t alignment = 64;
+
+    /**
+     * Return an uninitialised block of <code>n</code> elements of
+     * type <code>ValueType</code> aligned to
+     * <code>memory::alignment</code> bytes. A request for zero
+     * elements returns a null pointer.
+     *
+     * @note Only types that may be copied with <code>memcpy</code>
+     * should be stored this way, since no constructors are called.
+     */
+    template <typename ValueType>
+      ValueType* allocate (const std::size_t n);
+
+    /**
+     * Return a block obtained by <code>allocate</code> to the system.
+     */
+    template <typename ValueType>
+      void deallocate (ValueType *pointer);
+
+    /**
+     * Return the widest alignment, up to
+     * <code>memory::alignment</code>, that a block of
+     * <code>bytes</code> bytes can be given without padding it, ie. the
+     * largest power of two that divides <code>bytes</code>.
+     */
+    constexpr std::size_t block_alignment (const std::size_t bytes);
+
+  }
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    ValueType* memory::allocate (const std::size_t n)
+    {
+      if (n == 0)
+	return 0;
+
+      void *pointer = 0;
+      if (posix_memalign (&pointer, alignment, n*sizeof (ValueType)) != 0)
+	throw std::bad_alloc ();
+
+      return static_cast<ValueType*> (pointer);
+    }
+
+  template <typename ValueType>
+    inline
+    void memory::deallocate (ValueType *pointer)
+    {
+      free (pointer);
+    }
+
+  constexpr
+    std::size_t memory::block_alignment (const std::size_t bytes)
+    {
+      return ((bytes & (~bytes + 1)) < alignment) 
+	? (bytes & (~bytes + 1)) 
+	: alignment;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_memory_h */
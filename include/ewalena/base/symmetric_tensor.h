@@ -0,0 +1,543 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <array>
+#include <cassert>
+#include <iostream>
+
+#ifndef __ewalena_symmetric_tensor_h
+#define __ewalena_symmetric_tensor_h
+
+#include <ewalena/base/memory.h>
+#include <ewalena/base/tensor.h>
+
+namespace ewalena
+{
+
+  namespace internal
+  {
+
+    /**
+     * The Voigt index of the index pair (<code>i</code>,
+     * <code>j</code>) in <code>dim</code> dimensions: the diagonal
+     * comes first, then the off-diagonal pairs (1,2), (0,2) and
+     * (0,1), so that in three dimensions the order is \f$11, 22, 33,
+     * 23, 13, 12\f$.
+     */
+    template <int dim>
+      inline
+      unsigned int voigt_index (const unsigned int i, 
+				const unsigned int j)
+      {
+	assert (i < dim);
+	assert (j < dim);
+
+	/* For dim <= 3 each off-diagonal pair has a distinct sum
+	   i+j, which orders them. */
+	return (i == j) ? i : 3*dim - 3 - (i+j);
+      }
+
+    /**
+     * The weight of the Voigt index <code>voigt</code> in a
+     * contraction: off-diagonal components stand for two components
+     * of the full tensor.
+     */
+    template <int dim>
+      inline
+      unsigned int voigt_weight (const unsigned int voigt)
+      {
+	return (voigt < dim) ? 1 : 2;
+      }
+
+    /**
+     * The position of a component in the packed upper triangle of a
+     * symmetric <code>n</code>\f$\times\f$<code>n</code> matrix, stored
+     * row by row.
+     */
+    template <unsigned int n>
+      inline
+      unsigned int packed_index (const unsigned int I, 
+				 const unsigned int J)
+      {
+	return (I <= J) 
+	  ? I*n - (I*(I-1))/2 + (J-I)
+	  : J*n - (J*(J-1))/2 + (I-J);
+      }
+
+    /**
+     * Position of the component at <code>index</code> of a symmetric
+     * tensor in its storage.
+     */
+    template <int dim>
+      inline
+      unsigned int symmetric_component_index (const std::array<unsigned int, 2> &index)
+      {
+	return voigt_index<dim> (index[0], index[1]);
+      }
+
+    template <int dim>
+      inline
+      unsigned int symmetric_component_index (const std::array<unsigned int, 4> &index)
+      {
+	return packed_index<dim*(dim+1)/2> (voigt_index<dim> (index[0], index[1]),
+					    voigt_index<dim> (index[2], index[3]));
+      }
+
+    /**
+     * The average of the components of <code>T</code> that are
+     * equal in a symmetric tensor, ie. that of <code>T</code>'s
+     * symmetric part.
+     */
+    template <int dim, typename ValueType>
+      inline
+      ValueType symmetric_part (const Tensor<dim, 2, ValueType>   &T,
+				const std::array<unsigned int, 2> &index)
+      {
+	const unsigned int i = index[0], j = index[1];
+	return (T(i,j) + T(j,i))/ValueType (2);
+      }
+
+    template <int dim, typename ValueType>
+      inline
+      ValueType symmetric_part (const Tensor<dim, 4, ValueType>   &T,
+				const std::array<unsigned int, 4> &index)
+      {
+	const unsigned int i = index[0], j = index[1], k = index[2], l = index[3];
+	/* Summed pairwise, so that the result is exact if all eight
+	   are equal. */
+	return (((T(i,j,k,l) + T(j,i,k,l)) + (T(i,j,l,k) + T(j,i,l,k)))
+		+ ((T(k,l,i,j) + T(l,k,i,j)) + (T(k,l,j,i) + T(l,k,j,i))))/ValueType (8);
+      }
+
+  } /* namespace internal */
+
+  /**
+   * A tensor of rank two or four with the symmetries of strain and
+   * stress (\f$T_{ij}=T_{ji}\f$), or of elasticity
+   * (\f$C_{ijkl}=C_{jikl}=C_{ijlk}=C_{klij}\f$), that stores only its
+   * unique components in Voigt order.
+   *
+   * A rank two tensor is stored as its \f$n=d(d+1)/2\f$ Voigt
+   * components, and a rank four tensor as the upper triangle of its
+   * symmetric \f$n\times n\f$ Voigt matrix, ie. 21 rather than 81
+   * components in three dimensions. Contractions work on the Voigt
+   * representation directly, eg. \f$\sigma=C:\varepsilon\f$ is a
+   * \f$6\times6\f$ matrix-vector product.
+   *
+   * Element access uses full tensor indices; components related by
+   * symmetry share storage, so writing one writes them all.
+   *
+   * \ingroup base
+   */
+  template <int dim, int rank, typename ValueType = double>
+    class SymmetricTensor
+    {
+    static_assert ((rank == 2) || (rank == 4), 
+		   "Symmetric tensors are only available for rank two and four.");
+    static_assert ((dim > 0) && (dim < 4), 
+		   "Symmetric tensors are only available in one, two and three dimensions.");
+
+    public:
+
+    /**
+     * The number of Voigt components of a rank two tensor, which is
+     * the number of rows of the Voigt matrix of a rank four tensor.
+     */
+    static constexpr unsigned int n_voigt = dim*(dim+1)/2;
+
+    /**
+     * Constructor. Tensor elements are set to zero by default, and
+     * otherwise if <code>zero=false</code>, tensor elements are left
+     * in an unspecified state.
+     */
+    SymmetricTensor (const bool zero = true);
+
+    /**
+     * Initialize a symmetric tensor with the symmetric part of the
+     * tensor <code>T</code>. This is lossless if <code>T</code> is
+     * symmetric.
+     */
+    explicit SymmetricTensor (const Tensor<dim, rank, ValueType> &T);
+
+    /**
+     * Return this tensor as a tensor with all its components
+     * stored.
+     */
+    operator Tensor<dim, rank, ValueType> () const;
+
+    /**
+     * Read-write access to the <code>i</code>th, <code>j</code>th,
+     * etc. index of this tensor.
+     */
+    template <typename... Indices>
+      ValueType& operator () (const Indices... indices);
+
+    /**
+     * Read only access to the <code>i</code>th, <code>j</code>th,
+     * etc. index of this tensor.
+     */
+    template <typename... Indices>
+      const ValueType& operator () (const Indices... indices) const;
+
+    /**
+     * Return the position of the element at the indices held by
+     * <code>index</code> in the underlying data array.
+     */
+    static unsigned int component_index (const std::array<unsigned int, rank> &index);
+
+    /**
+     * Return the number of components this tensor stores.
+     */
+    unsigned int n_components () const;
+
+    /**
+     * Reinitialise the contents of this tensor to nothing (zero).
+     */
+    void reinit ();
+
+    /**
+     * Inline addition operator. Add <code>T</code> to
+     * <code>this</code> tensor.
+     */
+    void operator += (const SymmetricTensor<dim, rank, ValueType> &T);
+
+    /**
+     * Inline subtraction operator. Subtract <code>T</code> from
+     * <code>this</code> tensor.
+     */
+    void operator -= (const SymmetricTensor<dim, rank, ValueType> &T);
+
+    /**
+     * Inline multiplication operator. Multiply each element in
+     * <code>this</code> tensor by a <code>scalar</code> value.
+     */
+    void operator *= (const ValueType &scalar);
+
+    /**
+     * Inline division operator. Divide each element in
+     * <code>this</code> tensor by a <code>scalar</code> value.
+     */
+    void operator /= (const ValueType &scalar);
+
+    /**
+     * Equivalence operator. Return true if <code>this</code> tensor
+     * is an identical copy of the tensor <code>T</code>.
+     */
+    bool operator == (const SymmetricTensor<dim, rank, ValueType> &T) const;
+
+    /**
+     * Addition operator. Return <code>T_a</code> plus
+     * <code>T_b</code>.
+     */
+    friend SymmetricTensor<dim, rank, ValueType> operator + (SymmetricTensor<dim, rank, ValueType>        T_a,
+							     const SymmetricTensor<dim, rank, ValueType> &T_b)
+    {
+      T_a += T_b;
+      return T_a;
+    }
+
+    /**
+     * Subtraction operator. Return <code>T_a</code> minus
+     * <code>T_b</code>.
+     */
+    friend SymmetricTensor<dim, rank, ValueType> operator - (SymmetricTensor<dim, rank, ValueType>        T_a,
+							     const SymmetricTensor<dim, rank, ValueType> &T_b)
+    {
+      T_a -= T_b;
+      return T_a;
+    }
+
+    /**
+     * Output operator to stream.
+     */
+    friend std::ostream& operator << (std::ostream                                &output, 
+				      const SymmetricTensor<dim, rank, ValueType> &T)
+    {
+      for (unsigned int i=0; i<T.__n_components; ++i) 
+	output << T.data[i] << " "; 
+      
+      return output; 
+    }
+
+    /**
+     * Read only access operator to the underlying C array structure
+     * associated with this tensor.
+     */
+    inline
+    const 
+    ValueType* operator* () const
+    {
+      return (*this).data;
+    }
+    
+    /**
+     * Read-write access operator to the underlying C array structure
+     * associated with this tensor.
+     */
+    inline
+    ValueType* operator* ()
+    {
+      return (*this).data;
+    }
+
+    protected:
+
+    /**
+     * Internal reference to the number of components this tensor
+     * stores.
+     */
+    static constexpr unsigned int __n_components 
+      = (rank == 2) ? n_voigt : n_voigt*(n_voigt+1)/2;
+
+    private:
+
+    /**
+     * Internal object denoting this tensor data. It is aligned as
+     * widely as its size allows without padding.
+     */
+    alignas (memory::block_alignment (sizeof (ValueType)*__n_components))
+    ValueType data[__n_components];
+
+    }; /* SymmetricTensor */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <int dim, int rank, typename ValueType>
+    constexpr unsigned int SymmetricTensor<dim, rank, ValueType>::n_voigt;
+
+  template <int dim, int rank, typename ValueType>
+    constexpr unsigned int SymmetricTensor<dim, rank, ValueType>::__n_components;
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    SymmetricTensor<dim, rank, ValueType>::SymmetricTensor (const bool zero)
+    {
+      if (zero)
+	reinit ();
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    SymmetricTensor<dim, rank, ValueType>::SymmetricTensor (const Tensor<dim, rank, ValueType> &T)
+    {
+      /* Visit every component of the full tensor; each stored
+	 component is written once for each of its symmetric
+	 partners, always with the same value. */
+      for (unsigned int position=0; position<T.n_components (); ++position)
+	{
+	  std::array<unsigned int, rank> index;
+	  for (unsigned int i=0, p=position; i<rank; ++i, p/=dim)
+	    index[i] = p%dim;
+
+	  data[component_index (index)] = internal::symmetric_part (T, index);
+	}
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    SymmetricTensor<dim, rank, ValueType>::operator Tensor<dim, rank, ValueType> () const
+    {
+      Tensor<dim, rank, ValueType> T (false);
+      
+      for (unsigned int position=0; position<T.n_components (); ++position)
+	{
+	  std::array<unsigned int, rank> index;
+	  for (unsigned int i=0, p=position; i<rank; ++i, p/=dim)
+	    index[i] = p%dim;
+
+	  (*T)[position] = data[component_index (index)];
+	}
+
+      return T;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    unsigned int
+    SymmetricTensor<dim, rank, ValueType>::component_index (const std::array<unsigned int, rank> &index)
+    {
+      return internal::symmetric_component_index<dim> (index);
+    }
+
+  template <int dim, int rank, typename ValueType>
+  template <typename... Indices>
+    inline 
+    ValueType& 
+    SymmetricTensor<dim, rank, ValueType>::operator () (const Indices... indices) 
+    {
+      static_assert (sizeof... (Indices) == rank, 
+		     "The number of indices must be equal to the rank of the tensor.");
+
+      const std::array<unsigned int, rank> index = {{ static_cast<unsigned int> (indices)... }};
+      return data[component_index (index)];
+    }
+  
+  template <int dim, int rank, typename ValueType>
+  template <typename... Indices>
+    inline 
+    const ValueType& 
+    SymmetricTensor<dim, rank, ValueType>::operator () (const Indices... indices) const
+    {
+      static_assert (sizeof... (Indices) == rank, 
+		     "The number of indices must be equal to the rank of the tensor.");
+
+      const std::array<unsigned int, rank> index = {{ static_cast<unsigned int> (indices)... }};
+      return data[component_index (index)];
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    unsigned int
+    SymmetricTensor<dim, rank, ValueType>::n_components () const
+    {
+      return __n_components;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    SymmetricTensor<dim, rank, ValueType>::reinit () 
+    {
+      for (unsigned int i=0; i<__n_components; ++i)
+	data[i] = ValueType (0);
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline 
+    void
+    SymmetricTensor<dim, rank, ValueType>::operator += (const SymmetricTensor<dim, rank, ValueType> &T) 
+    {
+      for (unsigned int i=0; i<__n_components; ++i)
+	data[i] += T.data[i];
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline 
+    void
+    SymmetricTensor<dim, rank, ValueType>::operator -= (const SymmetricTensor<dim, rank, ValueType> &T) 
+    {
+      for (unsigned int i=0; i<__n_components; ++i)
+	data[i] -= T.data[i];
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline 
+    void
+    SymmetricTensor<dim, rank, ValueType>::operator *= (const ValueType &scalar) 
+    {
+      for (unsigned int i=0; i<__n_components; ++i)
+	data[i] *= scalar;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline 
+    void
+    SymmetricTensor<dim, rank, ValueType>::operator /= (const ValueType &scalar) 
+    {
+      for (unsigned int i=0; i<__n_components; ++i)
+	data[i] /= scalar;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline 
+    bool
+    SymmetricTensor<dim, rank, ValueType>::operator == (const SymmetricTensor<dim, rank, ValueType> &T) const
+    {
+      for (unsigned int i=0; i<__n_components; ++i)
+	if (data[i] != T.data[i])
+	  return false;
+
+      return true;
+    }
+
+  /*-------------- Contraction --------------------------------------*/
+
+  /**
+   * Contract two symmetric tensors \f$T_{(a)ij}T_{(b)ij}\f$, ie. the
+   * weighted dot product of their Voigt components.
+   */
+  template <int dim, typename ValueType>
+    inline
+    ValueType contract (const SymmetricTensor<dim, 2, ValueType> &T_a,
+			const SymmetricTensor<dim, 2, ValueType> &T_b) 
+    {
+      ValueType scalar = ValueType (0);
+
+      for (unsigned int I=0; I<SymmetricTensor<dim, 2, ValueType>::n_voigt; ++I)
+	scalar += ValueType (internal::voigt_weight<dim> (I)) * (*T_a)[I]*(*T_b)[I];
+
+      return scalar;
+    }
+
+  /**
+   * Contract two symmetric tensors
+   * \f$T_{ij}=T_{(a)ijkl}T_{(b)kl}\f$. In Voigt form this is the
+   * product of the symmetric \f$n\times n\f$ matrix of
+   * <code>T_a</code> with the vector of <code>T_b</code>, where
+   * off-diagonal components of <code>T_b</code> count twice.
+   */
+  template <int dim, typename ValueType>
+    inline
+    SymmetricTensor<dim, 2, ValueType> contract (const SymmetricTensor<dim, 4, ValueType> &T_a,
+						 const SymmetricTensor<dim, 2, ValueType> &T_b) 
+    {
+      const unsigned int n = SymmetricTensor<dim, 2, ValueType>::n_voigt;
+
+      ValueType weighted[n];
+      for (unsigned int J=0; J<n; ++J)
+	weighted[J] = ValueType (internal::voigt_weight<dim> (J)) * (*T_b)[J];
+
+      SymmetricTensor<dim, 2, ValueType> tensor;
+
+      for (unsigned int I=0; I<n; ++I)
+	for (unsigned int J=0; J<n; ++J)
+	  (*tensor)[I] += (*T_a)[internal::packed_index<n> (I, J)] * weighted[J];
+
+      return tensor;
+    }
+
+  /**
+   * Contract two symmetric tensors
+   * \f$T_{kl}=T_{(a)ij}T_{(b)ijkl}\f$, which by the symmetry of
+   * <code>T_b</code> is the same as the contraction above.
+   */
+  template <int dim, typename ValueType>
+    inline
+    SymmetricTensor<dim, 2, ValueType> contract (const SymmetricTensor<dim, 2, ValueType> &T_a,
+						 const SymmetricTensor<dim, 4, ValueType> &T_b) 
+    {
+      return contract (T_b, T_a);
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_symmetric_tensor_h */
@@ -30,8 +30,8 @@
 // implied, of the namespace ewalena authors.
 // -------------------------------------------------------------------
 
+#include <array>
 #include <cassert>
-#include <cstdarg>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
@@ -42,6 +42,8 @@
 #define __ewalena_tensor_h
 
 #include <ewalena/base/math.h>
+#include <ewalena/base/memory.h>
+#include <ewalena/lac/fixed_size_inverse.h>
 
 namespace ewalena
 {
@@ -50,6 +52,11 @@ namespace ewalena
    * A class that denotes a tensor with no special qualities, ie. no
    * special symmetries, data access, etc.
    *
+   * The \f$d^r\f$ components are known at compile time and are
+   * stored inside the tensor itself, so a tensor never allocates
+   * memory, lives on the stack, and is copied with a plain memory
+   * copy.
+   *
    * @author Toby D. Young 2012.
    */
   template <int dim, int rank, typename ValueType = double>
@@ -59,32 +66,48 @@ namespace ewalena
     public:
     
     /**
-     * Constructor.
+     * Constructor. Tensor elements are set to zero by default, and
+     * otherwise if <code>zero=false</code>, tensor elements are left
+     * in an unspecified state.
      */
     Tensor (const bool zero = true);
     
     /**
-     * Destructor.
+     * Read-write access to the <code>i</code>th, <code>j</code>th,
+     * etc. index of this tensor. Exactly <code>rank</code> indices
+     * must be given.
      */
-    ~Tensor ();
+    template <typename... Indices>
+      ValueType& operator () (const Indices... indices);
     
     /**
-     * Initialize a tensor with another tensor <code>T</code> with a
-     * memory copy.
+     * Read only access to the <code>i</code>th, <code>j</code>th,
+     * etc. index of this tensor. Exactly <code>rank</code> indices
+     * must be given.
      */
-    Tensor (const Tensor &T);
-    
+    template <typename... Indices>
+      const ValueType& operator () (const Indices... indices) const;
+
     /**
-     * Read-write access to the <code>i</code>th, <code>j</code>th,
-     * etc. index of this tensor.
+     * Read-write access to the element of this tensor at the indices
+     * held by <code>index</code>.
      */
-    ValueType& operator () (const unsigned int index, ...);
-    
+    ValueType& operator () (const std::array<unsigned int, rank> &index);
+
     /**
-     * Read only access to the <code>i</code>th, <code>j</code>th,
-     * etc. index of this tensor.
+     * Read only access to the element of this tensor at the indices
+     * held by <code>index</code>.
      */
-    const ValueType& operator () (const unsigned int index, ...) const;
+    const ValueType& operator () (const std::array<unsigned int, rank> &index) const;
+
+    /**
+     * Return the position of the element at the indices held by
+     * <code>index</code> in the underlying data array, ie.
+     * \f$i_0+d(i_1+d(i_2+\dots))\f$. Since <code>dim</code> and
+     * <code>rank</code> are known at compile time, this reduces to a
+     * fixed multiply-add per index.
+     */
+    static unsigned int component_index (const std::array<unsigned int, rank> &index);
     
     /**
      * Return the number of components this tensor has, ie. \f$d^r\f$.
@@ -105,7 +128,8 @@ namespace ewalena
     /**
      * Invert tensor \f$T\f$. @note This is instantiated for all rank
      * tensors, but will only work for rank two (everything else
-     * triggers an exception).
+     * triggers an exception). Dimensions up to three are inverted in
+     * closed form, four to eight by <code>fixed_size::invert</code>.
      */
     void invert (const Tensor<dim, rank, ValueType> &T);
     
@@ -143,16 +167,26 @@ namespace ewalena
 	       const std::vector<Tensor<dim, rank, ValueType> > &T_a);
 
     /**
-     * Inline addition operator. Return <code>this</code> plus
-     * <code>T</code> tensor.
+     * Addition operator. Return <code>T_a</code> plus
+     * <code>T_b</code>.
      */
-    Tensor<dim, rank, ValueType> operator + (const Tensor<dim, rank, ValueType> &T);
+    friend Tensor<dim, rank, ValueType> operator + (Tensor<dim, rank, ValueType>        T_a,
+						    const Tensor<dim, rank, ValueType> &T_b)
+    {
+      T_a += T_b;
+      return T_a;
+    }
 
     /**
-     * Inline subtraction operator. Return <code>this</code> minus
-     * <code>T</code> tensor.
+     * Subtraction operator. Return <code>T_a</code> minus
+     * <code>T_b</code>.
      */
-    Tensor<dim, rank, ValueType> operator - (const Tensor<dim, rank, ValueType> &T);
+    friend Tensor<dim, rank, ValueType> operator - (Tensor<dim, rank, ValueType>        T_a,
+						    const Tensor<dim, rank, ValueType> &T_b)
+    {
+      T_a -= T_b;
+      return T_a;
+    }
     
     /**
      * Inline addition operator. Add <code>T</code> to
@@ -242,136 +276,118 @@ namespace ewalena
      * ie. \f$d^r\f$. (For internal reference this is just the length
      * of the underlying data array structure).
      */
-    unsigned int __n_components;
-    
-    /**
-     * Internal object storing the tensor dimension.
-     */
-    int __dim;
-    
-    /**
-     * Internal object storing the tensor rank.
-     */
-    int __rank;
+    static constexpr unsigned int __n_components = math::pow (dim, rank);
     
     private:
     
     /**
-     * Internal object denoting this
-     * tensor data.
+     * Internal object denoting this tensor data. It is aligned as
+     * widely as its size allows without padding.
      */
-    ValueType *data;
+    alignas (memory::block_alignment (sizeof (ValueType)*__n_components))
+    ValueType data[__n_components];
     
     }; /* Tensor */
   
   /*-------------- Inline and Other Functions -----------------------*/
+
+  template <int dim, int rank, typename ValueType>
+    constexpr unsigned int Tensor<dim, rank, ValueType>::__n_components;
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    Tensor<dim, rank, ValueType>::Tensor (const bool zero)
+    {
+      if (zero)
+	reinit ();
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    Tensor<dim, rank, ValueType>::reinit () 
+    {
+      for (unsigned int i=0; i<__n_components; ++i)
+	data[i] = ValueType (0);
+    }
+  
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    Tensor<dim, rank, ValueType>::clone (const Tensor<dim, rank, ValueType> &T)
+    {
+      (*this) = T;
+    }
   
   template <int dim, int rank, typename ValueType>
     inline 
-    ValueType& 
-    Tensor<dim, rank, ValueType>::operator () (const unsigned int index, ...) 
+    unsigned int
+    Tensor<dim, rank, ValueType>::component_index (const std::array<unsigned int, rank> &index) 
     {
-      /* Assert this object is initialised. */
-      assert (__n_components != 0);
-      assert (index < dim);
-      
-      /* Indices imply rank > zero. */
-      unsigned int decimal = index;
-      
-      /* Initialise value list. */
-      va_list index_list;
-      va_start (index_list, index); 
-      
-      /* Count from one, as is done in base conversions, and to
-	 prevent a compiler warning: comparison of unsigned expression
-	 < 0 is always false. */
-      for (unsigned int i=1; i<rank; ++i)  
+      /* Horner's scheme over the indices, last to first; the loop has
+	 a fixed trip count and is unrolled. */
+      unsigned int decimal = 0;
+
+      for (int i=rank-1; i>=0; --i)
 	{
-	  /* Read index from list and convert base_dim to base_10. */
-	  unsigned int base_dim  = va_arg (index_list, unsigned int);
-	  decimal               += static_cast<unsigned int> (math::pow (dim, i) * base_dim);
-	  
-	  assert (base_dim < dim);
+	  assert (index[i] < dim);
+	  decimal = dim*decimal + index[i];
 	}
       
-      /* Finalise value list. */
-      va_end (index_list);
-      
-      /* Check that this index is in bounds. */
-      assert (decimal < __n_components);
-      return data[decimal];
+      return decimal;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline 
+    ValueType& 
+    Tensor<dim, rank, ValueType>::operator () (const std::array<unsigned int, rank> &index) 
+    {
+      return data[component_index (index)];
     }
   
-  /* This operator works in exactly the same way as the read-write
-     operator above. Perhaps there is a way to simply call the above
-     routine instead of duplicating that code? */
   template <int dim, int rank, typename ValueType>
     inline 
     const ValueType& 
-    Tensor<dim, rank, ValueType>::operator () (const unsigned int index, ...) const
+    Tensor<dim, rank, ValueType>::operator () (const std::array<unsigned int, rank> &index) const
     {
-      assert (__n_components != 0);
-      assert (index < dim);
-      
-      unsigned int decimal = index;
-      
-      va_list index_list;
-      va_start (index_list, index); 
-      for (unsigned int i=1; i<rank; ++i) 
-	{
-	  unsigned int base_dim  = va_arg (index_list, unsigned int);
-	  decimal               += static_cast<unsigned int> (math::pow (dim, i) * base_dim);
-	  
-	  assert (base_dim < dim);
-	}
-      va_end (index_list);
-
-      assert (decimal < __n_components);
-      return data[decimal];
+      return data[component_index (index)];
     }
 
   template <int dim, int rank, typename ValueType>
-    inline
-    unsigned int
-    Tensor<dim, rank, ValueType>::n_components () const
+  template <typename... Indices>
+    inline 
+    ValueType& 
+    Tensor<dim, rank, ValueType>::operator () (const Indices... indices) 
     {
-      return __n_components;
-    }
+      static_assert (sizeof... (Indices) == rank, 
+		     "The number of indices must be equal to the rank of the tensor.");
 
+      const std::array<unsigned int, rank> index = {{ static_cast<unsigned int> (indices)... }};
+      return data[component_index (index)];
+    }
+  
   template <int dim, int rank, typename ValueType>
+  template <typename... Indices>
     inline 
-    Tensor<dim, rank, ValueType>
-    Tensor<dim, rank, ValueType>::operator + (const Tensor<dim, rank, ValueType> &T) 
+    const ValueType& 
+    Tensor<dim, rank, ValueType>::operator () (const Indices... indices) const
     {
-      assert (__n_components != 0);
-      assert (T.__n_components  == __n_components);
-
-      Tensor<dim, rank, ValueType> tensor;
-      tensor.reinit ();
-
-      for (unsigned int i=0; i<__n_components; ++i)
-	tensor.data[i] = data[i] + T.data[i];
+      static_assert (sizeof... (Indices) == rank, 
+		     "The number of indices must be equal to the rank of the tensor.");
 
-      return tensor;
+      const std::array<unsigned int, rank> index = {{ static_cast<unsigned int> (indices)... }};
+      return data[component_index (index)];
     }
 
   template <int dim, int rank, typename ValueType>
-    inline 
-    Tensor<dim, rank, ValueType>
-    Tensor<dim, rank, ValueType>::operator - (const Tensor<dim, rank, ValueType> &T) 
+    inline
+    unsigned int
+    Tensor<dim, rank, ValueType>::n_components () const
     {
-      assert (__n_components != 0);
-      assert (T.__n_components  == __n_components);
-
-      Tensor<dim, rank, ValueType> tensor;
-      tensor.reinit ();
+      return __n_components;
+    }
 
-      for (unsigned int i=0; i<__n_components; ++i)
-	tensor.data[i] = data[i] - T.data[i];
 
-      return tensor;
-    }
-  
   template <int dim, int rank, typename ValueType>
     inline 
     void
@@ -509,76 +525,305 @@ namespace ewalena
   /* This routine is a definiative plagarism from the class
      Matrix<ValueType>. Thus, if anything goes wrong here, it will
      probably need to be reported there too. */
+  namespace internal
+  {
+    template <int dim, typename ValueType>
+      inline
+      void
+      invert (const Tensor<dim, 2, ValueType> &T,
+	      Tensor<dim, 2, ValueType>       &inverse) 
+      {
+	switch (dim)
+	  {
+	  case 0:
+	    {
+	      /* Undefined operation.  */
+	      assert (false);
+	    }
+
+	  case 1:
+	    {
+	      assert (T(0,0)!=ValueType (0));
+	      inverse(0,0) = ValueType (1) / T(0,0);
+	      break;
+	    }
+
+	  case 2:
+	    {
+	      const ValueType determinant = T(0,0)*T(1,1) - T(0,1)*T(1,0);
+	      assert (determinant!=ValueType (0));
+
+	      inverse(0,0) =  T(1,1) / determinant;
+	      inverse(0,1) = -T(0,1) / determinant;
+	      inverse(1,0) = -T(1,0) / determinant;
+	      inverse(1,1) =  T(0,0) / determinant;
+
+	      break;
+	    }
+
+	  case 3: 
+	    {
+	      const ValueType determinant 
+		= T(0,0)*(T(2,2)*T(1,1) - T(2,1)*T(1,2))
+		- T(1,0)*(T(2,2)*T(0,1) - T(2,1)*T(0,2))
+		+ T(2,0)*(T(1,2)*T(0,1) - T(1,1)*T(0,2));
+	      assert (determinant!=ValueType (0));
+
+	      inverse(0,0) =    (T(2,2)*T(1,1) - T(2,1)*T(1,2)) / determinant;
+	      inverse(0,1) =  - (T(2,2)*T(0,1) - T(2,1)*T(0,2)) / determinant;
+	      inverse(0,2) =    (T(1,2)*T(0,1) - T(1,1)*T(0,2)) / determinant;
+
+	      inverse(1,0) =  - (T(2,2)*T(1,0) - T(2,0)*T(1,2)) / determinant;
+	      inverse(1,1) =    (T(2,2)*T(0,0) - T(2,0)*T(0,2)) / determinant;
+	      inverse(1,2) =  - (T(1,2)*T(0,0) - T(1,0)*T(0,2)) / determinant;
+
+	      inverse(2,0) =    (T(2,1)*T(1,0) - T(2,0)*T(1,1)) / determinant;
+	      inverse(2,1) =  - (T(2,1)*T(0,0) - T(2,0)*T(0,1)) / determinant;
+	      inverse(2,2) =    (T(1,1)*T(0,0) - T(1,0)*T(0,1)) / determinant;
+
+	      break; 
+
+	    }
+
+	    /* Sizes four to eight by elimination unrolled for the
+	       size. The components are stored by columns, which
+	       inverts the transpose into the transpose of the
+	       inverse. */
+	  default:
+	    {
+	      assert (dim <= 8);
+	      const bool is_invertible = fixed_size::invert<dim> (*T, *inverse);
+	      assert (is_invertible);
+	    }
+	  }
+
+      }
+
+    /* Only rank two tensors have an inverse. */
+    template <int dim, int rank, typename ValueType>
+      inline
+      void
+      invert (const Tensor<dim, rank, ValueType> &,
+	      Tensor<dim, rank, ValueType>       &) 
+      {
+	assert (false);
+      }
+  }
+
   template <int dim, int rank, typename ValueType>
     inline
     void
     Tensor<dim, rank, ValueType>::invert (const Tensor<dim, rank, ValueType> &T) 
     {
       /* This should always be true  */
-      assert (dim < 4);
+      assert (dim <= 8);
       assert (rank == 2);
 
-      assert (T.data);
-      assert ((*this).data);
+      internal::invert (T, *this);
+    }
+
+  /*-------------- Contraction --------------------------------------*/
+
+  /**
+   * A pair of indices to be contracted: index <code>first</code> of
+   * the first tensor with index <code>second</code> of the second
+   * tensor. Indices are counted from zero.
+   */
+  template <unsigned int first, unsigned int second>
+    struct IndexPair
+    {};
+
+  namespace internal
+  {
+
+    /**
+     * Compile-time queries on a list of index pairs.
+     */
+    template <typename... Pairs>
+      struct Contraction
+      {
+	static constexpr unsigned int n_pairs = 0;
+
+	static constexpr bool contracts_first (const unsigned int)  { return false; }
+	static constexpr bool contracts_second (const unsigned int) { return false; }
+
+	static constexpr unsigned int first (const unsigned int)  { return 0; }
+	static constexpr unsigned int second (const unsigned int) { return 0; }
+
+	static constexpr bool is_valid (const int, const int) { return true; }
+      };
+
+    template <unsigned int a, unsigned int b, typename... Pairs>
+      struct Contraction<IndexPair<a, b>, Pairs...>
+      {
+	typedef Contraction<Pairs...> Rest;
+
+	static constexpr unsigned int n_pairs = 1 + Rest::n_pairs;
+
+	/* Whether index i of the first (second) tensor is contracted. */
+	static constexpr bool contracts_first (const unsigned int i)  
+	{ 
+	  return (i == a) || Rest::contracts_first (i); 
+	}
+
+	static constexpr bool contracts_second (const unsigned int i) 
+	{ 
+	  return (i == b) || Rest::contracts_second (i); 
+	}
+
+	/* The indices of the kth pair. */
+	static constexpr unsigned int first (const unsigned int k)  
+	{ 
+	  return (k == 0) ? a : Rest::first (k-1); 
+	}
 
-      switch (dim)
+	static constexpr unsigned int second (const unsigned int k) 
+	{ 
+	  return (k == 0) ? b : Rest::second (k-1); 
+	}
+
+	/* Indices are in range and none is contracted twice. */
+	static constexpr bool is_valid (const int rank_a, const int rank_b)
 	{
-	case 0:
-	  {
-	    /* Undefined operation.  */
-	    assert (false);
-	  }
-	  
-	case 1:
+	  return (int (a) < rank_a) && (int (b) < rank_b)
+	    && !Rest::contracts_first (a) && !Rest::contracts_second (b)
+	    && Rest::is_valid (rank_a, rank_b);
+	}
+      };
+
+    /**
+     * The strides of the loops that make up the contraction of a
+     * tensor of rank <code>rank_a</code> with one of rank
+     * <code>rank_b</code>. The outer loops run over the indices of the
+     * result, which are the free indices of the first tensor followed
+     * by the free indices of the second; the inner loops run over the
+     * contracted pairs. Each loop advances through the first tensor,
+     * the second tensor and the result by the strides given here.
+     */
+    template <int dim_, int rank_a, int rank_b, typename Pairs>
+      struct ContractionStrides
+      {
+	static constexpr int dim         = dim_;
+	static constexpr int n_free_a    = rank_a - int (Pairs::n_pairs);
+	static constexpr int rank_result = rank_a + rank_b - 2*int (Pairs::n_pairs);
+	static constexpr int n_levels    = rank_result + int (Pairs::n_pairs);
+
+	/* Position of the nth free index of the first (second) tensor,
+	   searching from position i. */
+	static constexpr unsigned int free_first (const int n, const unsigned int i = 0)
+	{
+	  return Pairs::contracts_first (i) 
+	    ? free_first (n, i+1) 
+	    : ((n == 0) ? i : free_first (n-1, i+1));
+	}
+
+	static constexpr unsigned int free_second (const int n, const unsigned int i = 0)
+	{
+	  return Pairs::contracts_second (i) 
+	    ? free_second (n, i+1) 
+	    : ((n == 0) ? i : free_second (n-1, i+1));
+	}
+
+	static constexpr unsigned int a (const int level)
+	{
+	  return (level < n_free_a) 
+	    ? math::pow (dim, free_first (level))
+	    : (level < rank_result) 
+	    ? 0 
+	    : math::pow (dim, Pairs::first (level-rank_result));
+	}
+
+	static constexpr unsigned int b (const int level)
+	{
+	  return (level < n_free_a) 
+	    ? 0
+	    : (level < rank_result) 
+	    ? math::pow (dim, free_second (level-n_free_a)) 
+	    : math::pow (dim, Pairs::second (level-rank_result));
+	}
+
+	static constexpr unsigned int result (const int level)
+	{
+	  return (level < rank_result) ? math::pow (dim, level) : 0;
+	}
+      };
+
+    /**
+     * The loop nest of a contraction, unrolled by template recursion:
+     * each instance handles the value <code>i</code> of loop
+     * <code>level</code>, and the innermost level accumulates one
+     * product.
+     */
+    template <typename Strides, int level, int i, 
+	      bool innermost = (level == Strides::n_levels),
+	      bool end       = (i == Strides::dim)>
+      struct ContractionLoop
+      {
+	template <typename ValueType>
+	  static void run (const ValueType *a, 
+			   const ValueType *b, 
+			   ValueType       *result)
 	  {
-	    assert (T(0,0)!=ValueType (0));
-	    (*this)(0,0) = ValueType (1) / T(0,0);
-	    break;
+	    ContractionLoop<Strides, level+1, 0>::run (a      + i*Strides::a (level), 
+						       b      + i*Strides::b (level), 
+						       result + i*Strides::result (level));
+	    ContractionLoop<Strides, level, i+1>::run (a, b, result);
 	  }
-	  
-	case 2:
+      };
+
+    template <typename Strides, int level, int i, bool end>
+      struct ContractionLoop<Strides, level, i, true, end>
+      {
+	template <typename ValueType>
+	  static void run (const ValueType *a, 
+			   const ValueType *b, 
+			   ValueType       *result)
 	  {
-	    const ValueType determinant = T(0,0)*T(1,1) - T(0,1)*T(1,0);
-	    assert (determinant!=ValueType (0));
-	    
-	    (*this)(0,0) =  T(1,1) / determinant;
-	    (*this)(0,1) = -T(0,1) / determinant;
-	    (*this)(1,0) = -T(1,0) / determinant;
-	    (*this)(1,1) =  T(0,0) / determinant;
-	    
-	    break;
+	    *result += (*a)*(*b);
 	  }
+      };
 
-	case 3: 
-	  {
-	    const ValueType determinant 
-	      = T(0,0)*(T(2,2)*T(1,1) - T(2,1)*T(1,2))
-	      - T(1,0)*(T(2,2)*T(0,1) - T(2,1)*T(0,2))
-	      + T(2,0)*(T(1,2)*T(0,1) - T(1,1)*T(0,2));
-	    assert (determinant!=ValueType (0));
-
-	    (*this)(0,0) =    (T(2,2)*T(1,1) - T(2,1)*T(1,2)) / determinant;
-	    (*this)(0,1) =  - (T(2,2)*T(0,1) - T(2,1)*T(0,2)) / determinant;
-	    (*this)(0,2) =    (T(1,2)*T(0,1) - T(1,1)*T(0,2)) / determinant;
-
-	    (*this)(1,0) =  - (T(2,2)*T(1,0) - T(2,0)*T(1,2)) / determinant;
-	    (*this)(1,1) =    (T(2,2)*T(0,0) - T(2,0)*T(0,2)) / determinant;
-	    (*this)(1,2) =  - (T(1,2)*T(0,0) - T(1,0)*T(0,2)) / determinant;
+    template <typename Strides, int level, int i>
+      struct ContractionLoop<Strides, level, i, false, true>
+      {
+	template <typename ValueType>
+	  static void run (const ValueType *, 
+			   const ValueType *, 
+			   ValueType       *)
+	  {}
+      };
 
-	    (*this)(2,0) =    (T(2,1)*T(1,0) - T(2,0)*T(1,1)) / determinant;
-	    (*this)(2,1) =  - (T(2,1)*T(0,0) - T(2,0)*T(0,1)) / determinant;
-	    (*this)(2,2) =    (T(1,1)*T(0,0) - T(1,0)*T(0,1)) / determinant;
+  } /* namespace internal */
 
-	    break; 
+  /**
+   * Contract the index pairs <code>Pairs</code> of the tensors
+   * <code>T_a</code> and <code>T_b</code>, eg.
+   * \f$T_{jl}=T_{(a)ijk}T_{(b)ikl}\f$ is
+   * <code>contract<IndexPair<0,0>, IndexPair<2,1> > (T_a, T_b)</code>.
+   * The indices of the result are the remaining indices of
+   * <code>T_a</code> followed by the remaining indices of
+   * <code>T_b</code>, each in their original order, so that with no
+   * pairs at all this is the outer product.
+   *
+   * The rank of the result is deduced at compile time, and since
+   * <code>dim</code> is known too, all loops are unrolled.
+   */
+  template <typename... Pairs, int dim, int rank_a, int rank_b, typename ValueType>
+    inline
+    Tensor<dim, rank_a+rank_b-2*int (sizeof... (Pairs)), ValueType> 
+    contract (const Tensor<dim, rank_a, ValueType> &T_a,
+	      const Tensor<dim, rank_b, ValueType> &T_b) 
+    {
+      typedef internal::Contraction<Pairs...>                                Contraction;
+      typedef internal::ContractionStrides<dim, rank_a, rank_b, Contraction> Strides;
 
-	  }
+      static_assert (Contraction::is_valid (rank_a, rank_b),
+		     "Contracted indices must be in range and may each be contracted only once.");
 
-	  /* This is not likely to work well for big or even medium
-	     sized matrices - so don't do it. */
-	default:
-	  assert (false);
-	}
+      Tensor<dim, Strides::rank_result, ValueType> tensor;
+      internal::ContractionLoop<Strides, 0, 0>::run (*T_a, *T_b, *tensor);
 
+      return tensor;
     }
 
   /*-------------- Rank 2 --------------------------------------------*/
@@ -592,15 +837,7 @@ namespace ewalena
     Tensor<dim, 2, ValueType> contract (const Tensor<dim, 2, ValueType> &T_a,
 					const Tensor<dim, 4, ValueType> &T_b) 
     {
-      Tensor<dim, 2, ValueType> tensor;
-      
-      for (unsigned int i=0; i<dim; ++i)
-	for (unsigned int j=0; j<dim; ++j)
-	  for (unsigned int k=0; k<dim; ++k)
-	    for (unsigned int l=0; l<dim; ++l)
-	      tensor(k,l) += T_a(i,j)*T_b(i,j,k,l);
-      
-      return tensor;
+      return contract<IndexPair<0, 0>, IndexPair<1, 1> > (T_a, T_b);
     }
   
   /**
@@ -612,15 +849,7 @@ namespace ewalena
     Tensor<dim, 2, ValueType> contract (const Tensor<dim, 4, ValueType> &T_a,
 					const Tensor<dim, 2, ValueType> &T_b) 
     {
-      Tensor<dim, 2, ValueType> tensor;
-      
-      for (unsigned int i=0; i<dim; ++i)
-	for (unsigned int j=0; j<dim; ++j)
-	  for (unsigned int k=0; k<dim; ++k)
-	    for (unsigned int l=0; l<dim; ++l)
-	      tensor(i,j) += T_a(i,j,k,l)*T_b(k,l);
-      
-      return tensor;
+      return contract<IndexPair<2, 0>, IndexPair<3, 1> > (T_a, T_b);
     }
   
   /*-------------- Rank 1 --------------------------------------------*/
@@ -634,14 +863,7 @@ namespace ewalena
     Tensor<dim, 1, ValueType> contract (const Tensor<dim, 3, ValueType> &T_a,
 					const Tensor<dim, 2, ValueType> &T_b) 
     {
-      Tensor<dim, 1, ValueType> tensor;
-      
-      for (unsigned int i=0; i<dim; ++i)
-	for (unsigned int j=0; j<dim; ++j)
-	  for (unsigned int k=0; k<dim; ++k)
-	    tensor(i) += T_a(i,j,k)*T_b(j,k);
-      
-      return tensor;
+      return contract<IndexPair<1, 0>, IndexPair<2, 1> > (T_a, T_b);
     }
   
   /*-------------- Scalar --------------------------------------------*/
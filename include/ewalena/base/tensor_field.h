@@ -0,0 +1,841 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#ifndef __ewalena_tensor_field_h
+#define __ewalena_tensor_field_h
+
+#include <ewalena/base/memory.h>
+#include <ewalena/base/tensor.h>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/lac/fixed_size_inverse.h>
+#include <ewalena/lac/vector_kernels.h>
+
+namespace ewalena
+{
+
+  namespace internal
+  {
+
+    /**
+     * Call <code>f(begin, end)</code> for consecutive blocks of
+     * <code>block</code> points that cover \f$[0,n)\f$, distributed
+     * over the thread pool.
+     */
+    template <typename Function>
+      inline
+      void for_each_block (const unsigned int  n,
+			   const unsigned int  block,
+			   const Function     &f)
+      {
+	const unsigned int n_blocks = (n + block - 1)/block;
+
+	if (n_blocks < 2)
+	  {
+	    if (n != 0)
+	      f (0, n);
+	    return;
+	  }
+
+	ThreadPool::instance ().run (n_blocks, 
+				     [&] (const unsigned int b)
+				     {
+				       const unsigned int begin = b*block;
+				       f (begin, std::min (n, begin + block));
+				     });
+      }
+
+    /**
+     * The inverses of <code>n</code> tensors of rank two and
+     * dimension up to three in closed form, stored as a structure of
+     * arrays: component \f$c\f$ of point \f$p\f$ of the input at
+     * <code>A[c*lda+p]</code> and of the output at
+     * <code>inverse[c*ldi+p]</code>, which may be the same. The loops
+     * run over the points without branches, so that the compiler
+     * vectorises them. Return <code>false</code> if any tensor is
+     * singular.
+     */
+    template <int dim>
+      struct ClosedFormInverse
+      {
+	template <typename ValueType>
+	  static bool invert (const unsigned int  ,
+			      const ValueType    *,
+			      const unsigned int  ,
+			      ValueType          *,
+			      const unsigned int  )
+	  {
+	    assert (false);
+	    return false;
+	  }
+      };
+
+    template <>
+      struct ClosedFormInverse<1>
+      {
+	template <typename ValueType>
+	  static bool invert (const unsigned int  n,
+			      const ValueType    *A,
+			      const unsigned int  ,
+			      ValueType          *inverse,
+			      const unsigned int  )
+	  {
+	    bool singular = false;
+	    for (unsigned int p=0; p<n; ++p)
+	      {
+		const ValueType a = A[p];
+		singular   |= (a == ValueType (0));
+		inverse[p]  = ValueType (1)/a;
+	      }
+	    return !singular;
+	  }
+      };
+
+    template <>
+      struct ClosedFormInverse<2>
+      {
+	template <typename ValueType>
+	  static bool invert (const unsigned int  n,
+			      const ValueType    *A,
+			      const unsigned int  lda,
+			      ValueType          *inverse,
+			      const unsigned int  ldi)
+	  {
+	    bool singular = false;
+	    for (unsigned int p=0; p<n; ++p)
+	      {
+		const ValueType a00 = A[p],       a01 = A[lda+p];
+		const ValueType a10 = A[2*lda+p], a11 = A[3*lda+p];
+
+		const ValueType determinant = a00*a11 - a01*a10;
+		singular |= (determinant == ValueType (0));
+
+		const ValueType scale = ValueType (1)/determinant;
+		inverse[p]       =  a11*scale;
+		inverse[ldi+p]   = -a01*scale;
+		inverse[2*ldi+p] = -a10*scale;
+		inverse[3*ldi+p] =  a00*scale;
+	      }
+	    return !singular;
+	  }
+      };
+
+    template <>
+      struct ClosedFormInverse<3>
+      {
+	template <typename ValueType>
+	  static bool invert (const unsigned int  n,
+			      const ValueType    *A,
+			      const unsigned int  lda,
+			      ValueType          *inverse,
+			      const unsigned int  ldi)
+	  {
+	    bool singular = false;
+	    for (unsigned int p=0; p<n; ++p)
+	      {
+		const ValueType a00 = A[p],       a01 = A[lda+p],   a02 = A[2*lda+p];
+		const ValueType a10 = A[3*lda+p], a11 = A[4*lda+p], a12 = A[5*lda+p];
+		const ValueType a20 = A[6*lda+p], a21 = A[7*lda+p], a22 = A[8*lda+p];
+
+		/* The cofactors of the first column give the
+		   determinant. */
+		const ValueType c00 = a11*a22 - a12*a21;
+		const ValueType c10 = a12*a20 - a10*a22;
+		const ValueType c20 = a10*a21 - a11*a20;
+
+		const ValueType determinant = a00*c00 + a01*c10 + a02*c20;
+		singular |= (determinant == ValueType (0));
+
+		const ValueType scale = ValueType (1)/determinant;
+		inverse[p]       = c00*scale;
+		inverse[ldi+p]   = (a02*a21 - a01*a22)*scale;
+		inverse[2*ldi+p] = (a01*a12 - a02*a11)*scale;
+		inverse[3*ldi+p] = c10*scale;
+		inverse[4*ldi+p] = (a00*a22 - a02*a20)*scale;
+		inverse[5*ldi+p] = (a02*a10 - a00*a12)*scale;
+		inverse[6*ldi+p] = c20*scale;
+		inverse[7*ldi+p] = (a01*a20 - a00*a21)*scale;
+		inverse[8*ldi+p] = (a00*a11 - a01*a10)*scale;
+	      }
+	    return !singular;
+	  }
+      };
+
+  } /* namespace internal */
+
+  /**
+   * A field of <code>n_points</code> tensors of the same dimension
+   * and rank, eg. one per quadrature point, stored as a structure of
+   * arrays: all values of the first component, then all values of the
+   * second, and so on. Every component array is aligned to
+   * <code>memory::alignment</code> bytes and padded to a multiple of
+   * it.
+   *
+   * The operations on a field work through whole component arrays at
+   * once, using the vector kernels of <code>blas</code>, and are
+   * spread over the thread pool in blocks of points.
+   *
+   * \ingroup base
+   */
+  template <int dim, int rank, typename ValueType = double>
+    class TensorField
+    {
+    public:
+
+    /**
+     * The number of components of each tensor, \f$d^r\f$.
+     */
+    static constexpr unsigned int n_tensor_components = math::pow (dim, rank);
+
+    /**
+     * The number of points the batched operations work on at a time
+     * (and the unit of work handed to a thread).
+     */
+    static constexpr unsigned int block_size = 1024;
+
+    /**
+     * Constructor - a field of no points.
+     */
+    TensorField ();
+
+    /**
+     * Initialize a field of <code>n_points</code> tensors. Tensor
+     * elements are set to zero by default, and otherwise if
+     * <code>zero=false</code>, tensor elements are left in an
+     * unspecified state.
+     */
+    explicit TensorField (const unsigned int n_points,
+			  const bool         zero = true);
+
+    /**
+     * Initialize a field with another field <code>F</code> with a
+     * memory copy.
+     */
+    TensorField (const TensorField<dim, rank, ValueType> &F);
+
+    /**
+     * Initialize a field by taking over the memory of the field
+     * <code>F</code>, which is left empty.
+     */
+    TensorField (TensorField<dim, rank, ValueType> &&F) noexcept;
+
+    /**
+     * Destructor.
+     */
+    ~TensorField ();
+
+    /**
+     * Copy operator. Make <code>this</code> field equal to
+     * <code>F</code>.
+     */
+    TensorField<dim, rank, ValueType>& operator = (const TensorField<dim, rank, ValueType> &F);
+
+    /**
+     * Move operator. Make <code>this</code> field take over the memory
+     * of <code>F</code>, which is left empty.
+     */
+    TensorField<dim, rank, ValueType>& operator = (TensorField<dim, rank, ValueType> &&F) noexcept;
+
+    /**
+     * Reinitialise this field to <code>n_points</code> tensors.
+     * Memory is only reallocated if the field needs more than it has.
+     */
+    void reinit (const unsigned int n_points,
+		 const bool         zero = true);
+
+    /**
+     * Reinitialise the contents of this field to nothing (zero).
+     */
+    void reinit ();
+
+    /**
+     * Return the number of tensors in this field.
+     */
+    unsigned int n_points () const;
+
+    /**
+     * Return the distance between the first values of two successive
+     * component arrays.
+     */
+    unsigned int stride () const;
+
+    /**
+     * Return a copy of the tensor at <code>point</code>.
+     */
+    Tensor<dim, rank, ValueType> operator [] (const unsigned int point) const;
+
+    /**
+     * Set the tensor at <code>point</code> to <code>T</code>.
+     */
+    void set (const unsigned int                  point,
+	      const Tensor<dim, rank, ValueType> &T);
+
+    /**
+     * Read-write access to the <code>i</code>th, <code>j</code>th,
+     * etc. index of the tensor at <code>point</code>.
+     */
+    template <typename... Indices>
+      ValueType& operator () (const unsigned int point, 
+			      const Indices...   indices);
+
+    /**
+     * Read only access to the <code>i</code>th, <code>j</code>th,
+     * etc. index of the tensor at <code>point</code>.
+     */
+    template <typename... Indices>
+      const ValueType& operator () (const unsigned int point, 
+				    const Indices...   indices) const;
+
+    /**
+     * Read-write access to the array of values of component
+     * <code>c</code> (in the order of <code>Tensor</code>) over all
+     * points.
+     */
+    ValueType* component (const unsigned int c);
+
+    /**
+     * Read only access to the array of values of component
+     * <code>c</code> over all points.
+     */
+    const ValueType* component (const unsigned int c) const;
+
+    /**
+     * Sum-add a field to <code>this</code> field: \f$F+=aF_a\f$\,.
+     */
+    void sadd (const ValueType                         &a,
+	       const TensorField<dim, rank, ValueType> &F_a);
+
+    /**
+     * Sum-add two fields to <code>this</code> field:
+     * \f$F+=aF_a+bF_b\f$\,.
+     */
+    void sadd (const ValueType                         &a,
+	       const TensorField<dim, rank, ValueType> &F_a,
+	       const ValueType                         &b,
+	       const TensorField<dim, rank, ValueType> &F_b);
+
+    /**
+     * Inline addition operator. Add <code>F</code> to
+     * <code>this</code> field.
+     */
+    void operator += (const TensorField<dim, rank, ValueType> &F);
+
+    /**
+     * Inline subtraction operator. Subtract <code>F</code> from
+     * <code>this</code> field.
+     */
+    void operator -= (const TensorField<dim, rank, ValueType> &F);
+
+    /**
+     * Inline multiplication operator. Multiply each element in
+     * <code>this</code> field by a <code>scalar</code> value.
+     */
+    void operator *= (const ValueType &scalar);
+
+    /**
+     * Inline division operator. Divide each element in
+     * <code>this</code> field by a <code>scalar</code> value.
+     */
+    void operator /= (const ValueType &scalar);
+
+    /**
+     * Make <code>this</code> field the pointwise inverse of the field
+     * <code>F</code>, which may be <code>this</code> field itself.
+     * This only works for rank two tensors, as
+     * <code>Tensor::invert</code>. Beyond dimension three the points
+     * are inverted a vector width at a time by the batched
+     * <code>fixed_size::invert</code>.
+     */
+    void invert (const TensorField<dim, rank, ValueType> &F);
+
+    private:
+
+    /**
+     * Internal reference to the number of tensors in this field.
+     */
+    unsigned int __n_points;
+
+    /**
+     * Internal reference to the distance between component arrays,
+     * <code>__n_points</code> rounded up to fill whole blocks of
+     * <code>memory::alignment</code> bytes.
+     */
+    unsigned int __stride;
+
+    /**
+     * Internal reference to the number of elements there is memory
+     * for.
+     */
+    std::size_t __n_allocated;
+
+    /**
+     * Internal object denoting this field data.
+     */
+    ValueType *data;
+
+    }; /* TensorField */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <int dim, int rank, typename ValueType>
+    constexpr unsigned int TensorField<dim, rank, ValueType>::n_tensor_components;
+
+  template <int dim, int rank, typename ValueType>
+    constexpr unsigned int TensorField<dim, rank, ValueType>::block_size;
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    TensorField<dim, rank, ValueType>::TensorField ()
+    :
+    __n_points (0),
+    __stride (0),
+    __n_allocated (0),
+    data (0)
+    {}
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    TensorField<dim, rank, ValueType>::TensorField (const unsigned int n_points,
+						    const bool         zero)
+    :
+    __n_points (0),
+    __stride (0),
+    __n_allocated (0),
+    data (0)
+    {
+      reinit (n_points, zero);
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    TensorField<dim, rank, ValueType>::TensorField (const TensorField<dim, rank, ValueType> &F)
+    :
+    __n_points (0),
+    __stride (0),
+    __n_allocated (0),
+    data (0)
+    {
+      (*this) = F;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    TensorField<dim, rank, ValueType>::TensorField (TensorField<dim, rank, ValueType> &&F) noexcept
+    :
+    __n_points (F.__n_points),
+    __stride (F.__stride),
+    __n_allocated (F.__n_allocated),
+    data (F.data)
+    {
+      F.__n_points    = 0;
+      F.__stride      = 0;
+      F.__n_allocated = 0;
+      F.data          = 0;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    TensorField<dim, rank, ValueType>::~TensorField ()
+    {
+      memory::deallocate (data);
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    TensorField<dim, rank, ValueType>& 
+    TensorField<dim, rank, ValueType>::operator = (const TensorField<dim, rank, ValueType> &F)
+    {
+      if (this == &F)
+	return *this;
+
+      reinit (F.__n_points, false);
+      
+      if (__n_points != 0)
+	std::memcpy (data, F.data, sizeof (ValueType)*n_tensor_components*__stride);
+
+      return *this;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    TensorField<dim, rank, ValueType>& 
+    TensorField<dim, rank, ValueType>::operator = (TensorField<dim, rank, ValueType> &&F) noexcept
+    {
+      std::swap (__n_points,    F.__n_points);
+      std::swap (__stride,      F.__stride);
+      std::swap (__n_allocated, F.__n_allocated);
+      std::swap (data,          F.data);
+
+      return *this;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::reinit (const unsigned int n_points,
+					       const bool         zero)
+    {
+      /* Round the component arrays up to whole blocks of the
+	 alignment, so that every one of them starts aligned. */
+      const unsigned int width = 
+	std::max<unsigned int> (1, memory::alignment/sizeof (ValueType));
+
+      __n_points = n_points;
+      __stride   = ((n_points + width - 1)/width)*width;
+
+      const std::size_t n_elements = std::size_t (n_tensor_components)*__stride;
+      if (n_elements > __n_allocated)
+	{
+	  memory::deallocate (data);
+	  data          = memory::allocate<ValueType> (n_elements);
+	  __n_allocated = n_elements;
+	}
+
+      if (zero)
+	reinit ();
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::reinit ()
+    {
+      if (__stride != 0)
+	std::fill (data, data + n_tensor_components*__stride, ValueType (0));
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    unsigned int
+    TensorField<dim, rank, ValueType>::n_points () const
+    {
+      return __n_points;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    unsigned int
+    TensorField<dim, rank, ValueType>::stride () const
+    {
+      return __stride;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    ValueType*
+    TensorField<dim, rank, ValueType>::component (const unsigned int c)
+    {
+      assert (c < n_tensor_components);
+      return data + std::size_t (c)*__stride;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    const ValueType*
+    TensorField<dim, rank, ValueType>::component (const unsigned int c) const
+    {
+      assert (c < n_tensor_components);
+      return data + std::size_t (c)*__stride;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    Tensor<dim, rank, ValueType> 
+    TensorField<dim, rank, ValueType>::operator [] (const unsigned int point) const
+    {
+      assert (point < __n_points);
+
+      Tensor<dim, rank, ValueType> T (false);
+      for (unsigned int c=0; c<n_tensor_components; ++c)
+	(*T)[c] = component (c)[point];
+
+      return T;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::set (const unsigned int                  point,
+					    const Tensor<dim, rank, ValueType> &T)
+    {
+      assert (point < __n_points);
+
+      for (unsigned int c=0; c<n_tensor_components; ++c)
+	component (c)[point] = (*T)[c];
+    }
+
+  template <int dim, int rank, typename ValueType>
+  template <typename... Indices>
+    inline 
+    ValueType& 
+    TensorField<dim, rank, ValueType>::operator () (const unsigned int point, 
+						    const Indices...   indices) 
+    {
+      static_assert (sizeof... (Indices) == rank, 
+		     "The number of indices must be equal to the rank of the tensor.");
+      assert (point < __n_points);
+
+      const std::array<unsigned int, rank> index = {{ static_cast<unsigned int> (indices)... }};
+      return component (Tensor<dim, rank, ValueType>::component_index (index))[point];
+    }
+
+  template <int dim, int rank, typename ValueType>
+  template <typename... Indices>
+    inline 
+    const ValueType& 
+    TensorField<dim, rank, ValueType>::operator () (const unsigned int point, 
+						    const Indices...   indices) const
+    {
+      static_assert (sizeof... (Indices) == rank, 
+		     "The number of indices must be equal to the rank of the tensor.");
+      assert (point < __n_points);
+
+      const std::array<unsigned int, rank> index = {{ static_cast<unsigned int> (indices)... }};
+      return component (Tensor<dim, rank, ValueType>::component_index (index))[point];
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::sadd (const ValueType                         &a,
+					     const TensorField<dim, rank, ValueType> &F_a)
+    {
+      assert (F_a.__n_points == __n_points);
+
+      internal::for_each_block (__n_points, block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  for (unsigned int c=0; c<n_tensor_components; ++c)
+				    blas::axpy (end-begin, a, F_a.component (c)+begin, component (c)+begin);
+				});
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::sadd (const ValueType                         &a,
+					     const TensorField<dim, rank, ValueType> &F_a,
+					     const ValueType                         &b,
+					     const TensorField<dim, rank, ValueType> &F_b)
+    {
+      assert (F_a.__n_points == __n_points);
+      assert (F_b.__n_points == __n_points);
+
+      internal::for_each_block (__n_points, block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  for (unsigned int c=0; c<n_tensor_components; ++c)
+				    {
+				      blas::axpy (end-begin, a, F_a.component (c)+begin, component (c)+begin);
+				      blas::axpy (end-begin, b, F_b.component (c)+begin, component (c)+begin);
+				    }
+				});
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::operator += (const TensorField<dim, rank, ValueType> &F)
+    {
+      assert (F.__n_points == __n_points);
+
+      internal::for_each_block (__n_points, block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  for (unsigned int c=0; c<n_tensor_components; ++c)
+				    blas::add (end-begin, F.component (c)+begin, component (c)+begin);
+				});
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::operator -= (const TensorField<dim, rank, ValueType> &F)
+    {
+      assert (F.__n_points == __n_points);
+
+      internal::for_each_block (__n_points, block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  for (unsigned int c=0; c<n_tensor_components; ++c)
+				    blas::subtract (end-begin, F.component (c)+begin, component (c)+begin);
+				});
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::operator *= (const ValueType &scalar)
+    {
+      internal::for_each_block (__n_points, block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  for (unsigned int c=0; c<n_tensor_components; ++c)
+				    blas::scale (end-begin, scalar, component (c)+begin);
+				});
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::operator /= (const ValueType &scalar)
+    {
+      assert (scalar != ValueType (0));
+      (*this) *= ValueType (1)/scalar;
+    }
+
+  template <int dim, int rank, typename ValueType>
+    inline
+    void
+    TensorField<dim, rank, ValueType>::invert (const TensorField<dim, rank, ValueType> &F)
+    {
+      assert (dim <= 8);
+      assert (rank == 2);
+
+      if (this != &F)
+	reinit (F.__n_points, false);
+
+      /* A block of points at a time, one point per vector lane: in
+	 closed form up to dimension three, beyond that through the
+	 batched elimination. */
+      internal::for_each_block (__n_points, block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  const bool is_invertible = (dim <= 3)
+				    ? internal::ClosedFormInverse<dim>::invert (end-begin, F.component (0)+begin, F.__stride,
+										component (0)+begin, __stride)
+				    : fixed_size::invert<dim> (end-begin, F.component (0)+begin, F.__stride,
+							       component (0)+begin, __stride);
+				  assert (is_invertible);
+				});
+    }
+
+  /*-------------- Contraction --------------------------------------*/
+
+  /**
+   * Contract the index pairs <code>Pairs</code> of the fields
+   * <code>F_a</code> and <code>F_b</code> point by point, with the
+   * same conventions as <code>contract</code> for tensors. Each term
+   * of the contraction is a fused multiply-add over a block of
+   * points.
+   */
+  template <typename... Pairs, int dim, int rank_a, int rank_b, typename ValueType>
+    inline
+    TensorField<dim, rank_a+rank_b-2*int (sizeof... (Pairs)), ValueType> 
+    contract (const TensorField<dim, rank_a, ValueType> &F_a,
+	      const TensorField<dim, rank_b, ValueType> &F_b) 
+    {
+      typedef internal::Contraction<Pairs...>                                Contraction;
+      typedef internal::ContractionStrides<dim, rank_a, rank_b, Contraction> Strides;
+
+      static_assert (Contraction::is_valid (rank_a, rank_b),
+		     "Contracted indices must be in range and may each be contracted only once.");
+      assert (F_a.n_points () == F_b.n_points ());
+
+      TensorField<dim, Strides::rank_result, ValueType> field (F_a.n_points ());
+      const unsigned int n_terms = math::pow (dim, Strides::n_levels);
+
+      internal::for_each_block (F_a.n_points (), field.block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  for (unsigned int term=0; term<n_terms; ++term)
+				    {
+				      /* The components this term reads and writes. */
+				      unsigned int a = 0, b = 0, result = 0;
+				      for (unsigned int level=0, t=term; level<Strides::n_levels; ++level, t/=dim)
+					{
+					  a      += (t%dim)*Strides::a (level);
+					  b      += (t%dim)*Strides::b (level);
+					  result += (t%dim)*Strides::result (level);
+					}
+
+				      blas::multiply_add (end-begin, 
+							  F_a.component (a)+begin, 
+							  F_b.component (b)+begin, 
+							  field.component (result)+begin);
+				    }
+				});
+
+      return field;
+    }
+
+  /**
+   * Contract the index pairs <code>Pairs</code> of the tensor
+   * <code>T_a</code>, which is the same at all points, and the field
+   * <code>F_b</code>. Each term of the contraction is an
+   * <code>axpy</code> over a block of points.
+   */
+  template <typename... Pairs, int dim, int rank_a, int rank_b, typename ValueType>
+    inline
+    TensorField<dim, rank_a+rank_b-2*int (sizeof... (Pairs)), ValueType> 
+    contract (const Tensor<dim, rank_a, ValueType>      &T_a,
+	      const TensorField<dim, rank_b, ValueType> &F_b) 
+    {
+      typedef internal::Contraction<Pairs...>                                Contraction;
+      typedef internal::ContractionStrides<dim, rank_a, rank_b, Contraction> Strides;
+
+      static_assert (Contraction::is_valid (rank_a, rank_b),
+		     "Contracted indices must be in range and may each be contracted only once.");
+
+      TensorField<dim, Strides::rank_result, ValueType> field (F_b.n_points ());
+      const unsigned int n_terms = math::pow (dim, Strides::n_levels);
+
+      internal::for_each_block (F_b.n_points (), field.block_size,
+				[&] (const unsigned int begin, const unsigned int end)
+				{
+				  for (unsigned int term=0; term<n_terms; ++term)
+				    {
+				      unsigned int a = 0, b = 0, result = 0;
+				      for (unsigned int level=0, t=term; level<Strides::n_levels; ++level, t/=dim)
+					{
+					  a      += (t%dim)*Strides::a (level);
+					  b      += (t%dim)*Strides::b (level);
+					  result += (t%dim)*Strides::result (level);
+					}
+
+				      if ((*T_a)[a] != ValueType (0))
+					blas::axpy (end-begin, (*T_a)[a],
+						    F_b.component (b)+begin, 
+						    field.component (result)+begin);
+				    }
+				});
+
+      return field;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_tensor_field_h */
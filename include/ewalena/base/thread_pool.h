@@ -0,0 +1,177 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef __ewalena_thread_pool_h
+#define __ewalena_thread_pool_h
+
+namespace ewalena
+{
+
+  /**
+   * A pool of worker threads over which the library distributes its
+   * shared-memory parallel work. The pool hands out the tasks of a
+   * parallel loop one at a time, so tasks of uneven cost are balanced
+   * automatically, and the calling thread takes part in the work.
+   *
+   * There is one pool for the whole library, obtained with
+   * <code>ThreadPool::instance ()</code>. Its size defaults to the
+   * value of the environment variable <code>EWALENA_NUM_THREADS</code>
+   * if set, and to the number of hardware threads otherwise.
+   *
+   * @note A parallel loop started from inside a task of another
+   * parallel loop is run serially on the calling thread.
+   *
+   * \ingroup base
+   */
+  class ThreadPool
+  {
+  public:
+
+    /**
+     * Return the pool shared by the library.
+     */
+    static ThreadPool& instance ();
+
+    /**
+     * Destructor. Stops and joins all workers.
+     */
+    ~ThreadPool ();
+
+    /**
+     * Return the number of threads that take part in a parallel loop,
+     * including the calling thread.
+     */
+    unsigned int n_threads () const;
+
+    /**
+     * Set the number of threads that take part in a parallel loop,
+     * including the calling thread. A value of one makes every
+     * parallel loop serial.
+     */
+    void set_n_threads (const unsigned int n);
+
+    /**
+     * Call <code>task(i)</code> for every \f$i\in[0,n)\f$ distributed
+     * over the threads of this pool, and return once all of them are
+     * done.
+     */
+    void run (const unsigned int                           n_tasks,
+	      const std::function<void (const unsigned int)> &task);
+
+  private:
+
+    /**
+     * Constructor. Use <code>instance ()</code> instead.
+     */
+    ThreadPool (const unsigned int n);
+
+    ThreadPool (const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+    /**
+     * Start (stop) worker threads until there are <code>n-1</code> of
+     * them.
+     */
+    void resize (const unsigned int n);
+
+    /**
+     * The loop each worker runs, waiting for and executing work.
+     */
+    void work (const unsigned int worker);
+
+    /**
+     * Execute tasks of the current parallel loop until there are
+     * none left.
+     */
+    void execute ();
+
+    /**
+     * The worker threads. The calling thread is not part of this.
+     */
+    std::vector<std::thread> workers;
+
+    /**
+     * Serialises parallel loops started from different threads.
+     */
+    std::mutex run_mutex;
+
+    /**
+     * Protects the state below that workers wait on.
+     */
+    std::mutex state_mutex;
+    std::condition_variable wake_workers;
+    std::condition_variable wake_caller;
+
+    /**
+     * The current parallel loop: its body, its number of tasks and
+     * the index of the next task to be handed out.
+     */
+    const std::function<void (const unsigned int)> *task;
+    unsigned int                                   n_tasks;
+    std::atomic<unsigned int>                      next_task;
+
+    /**
+     * The first exception thrown by a task of the current loop, which
+     * is rethrown on the calling thread.
+     */
+    std::exception_ptr exception;
+
+    /**
+     * Incremented every time a parallel loop starts; workers use it
+     * to tell a new loop from the one they just finished.
+     */
+    unsigned long generation;
+
+    /**
+     * Number of workers still busy with the current loop.
+     */
+    unsigned int n_busy;
+
+    /**
+     * Number of workers that should keep running; workers with a
+     * larger index quit.
+     */
+    unsigned int n_active;
+
+  }; /* ThreadPool */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_thread_pool_h */
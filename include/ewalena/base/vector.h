@@ -39,7 +39,10 @@
 #ifndef __ewalena_vector_h
 #define __ewalena_vector_h
 
+#include <ewalena/base/expression.h>
 #include <ewalena/base/matrix.h>
+#include <ewalena/base/memory.h>
+#include <ewalena/lac/vector_kernels.h>
 
 namespace ewalena
 {
@@ -48,12 +51,26 @@ namespace ewalena
    * A class that denotes a simple vector with no special qualities,
    * ie. no special data access, etc.
    *
+   * Vector data is aligned to <code>memory::alignment</code> bytes and
+   * the arithmetic operations and norms are carried out by the
+   * vectorised kernels of <code>blas</code>, which use the widest
+   * instruction set the processor offers. Linear combinations and
+   * other elementwise expressions of vectors are evaluated lazily, see
+   * <code>Expression</code>.
+   *
    * @author Toby D. Young 2012.
    */
   template <typename ValueType = double>
     class Vector
+    :
+    public Expression<Vector<ValueType> >
     {
     public:
+
+    /**
+     * The type of the elements of this vector.
+     */
+    typedef ValueType value_type;
     
     /**
      * Constructor - a vector of zero dimension.
@@ -79,6 +96,12 @@ namespace ewalena
      * memory copy.
      */
     Vector (const Vector<ValueType> &v);
+
+    /**
+     * Initialize a vector by taking over the memory of the vector
+     * <code>v</code>, which is left empty.
+     */
+    Vector (Vector<ValueType> &&v) noexcept;
     
     /**
      * Initialize a vector with list <code>v</code> using a direct
@@ -90,6 +113,13 @@ namespace ewalena
      * <code>ewalena::Vector<double> V = {1.0, 1.1, 1.25}</code>.
      */
     Vector (const std::initializer_list<ValueType> list);
+
+    /**
+     * Initialize a vector with the value of the expression
+     * <code>e</code>, which must be a single column.
+     */
+    template <typename E>
+      Vector (const Expression<E> &e);
     
     /**
      * Reinitialise the contents of this vector to nothing (zero).
@@ -102,20 +132,23 @@ namespace ewalena
     unsigned int size () const;
     
     /**
-     * Reinitialise this vector to size <code>m</code>.
+     * Reinitialise this vector to size <code>m</code>. Memory is only
+     * reallocated if <code>m</code> is larger than any size this
+     * vector has had before.
      */
     void reinit (const unsigned int m,
 		 const bool         zero = true);
     
     /**
-     * Return the \f$\ell_1\f$-norm of this vector.
+     * Return the \f$\ell_1\f$-norm of this vector, where the
+     * modulus of complex elements is summed.
      */
-    ValueType l1_norm ();
+    ValueType l1_norm () const;
     
     /**
      * Return the \f$\ell_2\f$-norm of this vector.
      */
-    ValueType l2_norm ();
+    ValueType l2_norm () const;
     
     /**
      * Return the \f$\ell_p\f$-norm of this vector, where
@@ -143,25 +176,62 @@ namespace ewalena
      * Read only access to the <code>i</code>th index of this vector.
      */
     const ValueType& operator () (const unsigned int i) const;
+
+    /**
+     * Unchecked read only access to the <code>i</code>th index of
+     * this vector, as used when evaluating expressions.
+     */
+    const ValueType& operator [] (const unsigned int i) const;
     
     /**
      * Copy/equality operator. Make <code>this</code> vector equal to
      * <code>v</code>. All data in <code>this</code> is overwritten,
      * and its size is changed if needed.
      */
-    void operator = (const Vector<ValueType> &v);
+    Vector<ValueType>& operator = (const Vector<ValueType> &v);
+
+    /**
+     * Move operator. Make <code>this</code> vector take over the
+     * memory of <code>v</code>, which is left empty.
+     */
+    Vector<ValueType>& operator = (Vector<ValueType> &&v) noexcept;
+
+    /**
+     * Make <code>this</code> vector equal to the expression
+     * <code>e</code>, evaluated in a single pass over the
+     * elements. Since each element of the result only depends on the
+     * same element of the operands, <code>this</code> vector may
+     * itself appear in <code>e</code>, as in <code>u = 2.*u + v</code>.
+     */
+    template <typename E>
+      Vector<ValueType>& operator = (const Expression<E> &e);
     
     /**
      * Inline addition operator. Add <code>v</code> to
      * <code>this</code> vector.
      */
     void operator += (const Vector<ValueType> &v);
+
+    /**
+     * Inline addition operator. Add the expression <code>e</code> to
+     * <code>this</code> vector in a single pass over the elements.
+     */
+    template <typename E>
+      void operator += (const Expression<E> &e);
     
     /**
      * Inline subtraction operator. Subtract <code>v</code> from
      * <code>this</code> vector.
      */
     void operator -= (const Vector<ValueType> &v);
+
+    /**
+     * Inline subtraction operator. Subtract the expression
+     * <code>e</code> from <code>this</code> vector in a single pass
+     * over the elements.
+     */
+    template <typename E>
+      void operator -= (const Expression<E> &e);
     
     /**
      * Inline multiplication operator.  Multiply each component of
@@ -171,7 +241,8 @@ namespace ewalena
     
     /**
      * Inline division operator.  Divide each component of
-     * <code>this</code> vector by a <code>scalar</code>.
+     * <code>this</code> vector by a <code>scalar</code>. This is done
+     * by multiplication with the inverse of <code>scalar</code>.
      */
     void operator /= (const ValueType &scalar);
     
@@ -205,12 +276,32 @@ namespace ewalena
      * Return the size of this vector.
      */
     unsigned int n_rows () const;
+
+    /**
+     * Return the number of columns of this vector, which is always
+     * one.
+     */
+    unsigned int n_cols () const;
     
     /**
      * Return the diagonal of a matrix as this vector.
      */
     void diag (const Matrix<ValueType> &M); 
     
+    /**
+     * Return the scalar product \f$\sum_i\bar{u}_iv_i\f$ of
+     * <code>this</code> vector \f$u\f$ and the vector
+     * <code>v</code>, where <code>this</code> vector is complex
+     * conjugated.
+     */
+    ValueType dot (const Vector<ValueType> &v) const;
+    
+    /**
+     * Add a multiple of a vector: <code>this += a*v</code>.
+     */
+    void add (const ValueType          a,
+	      const Vector<ValueType> &v); 
+    
     /**
      * Scale-and-add. Return <code>this = a*v</code>;
      */
@@ -225,6 +316,21 @@ namespace ewalena
 	       const ValueType          b,
 	       const Vector<ValueType> &w); 
     
+    /**
+     * Matrix products and factorizations work on the underlying C
+     * array structure directly.
+     */
+    template <typename> friend class BlockDiagonalMatrix;
+    template <typename> friend class CholeskyFactorization;
+    template <typename> friend class FockHamiltonian;
+    template <typename> friend class KroneckerOperator;
+    template <typename> friend class LUFactorization;
+    template <typename> friend class Matrix;
+    template <typename> friend class QRFactorization;
+    template <typename> friend class SellMatrix;
+    template <typename> friend class SparseMatrix;
+    template <typename> friend class TSQRFactorization;
+    
     protected:
     
     /**
@@ -255,6 +361,12 @@ namespace ewalena
      * elements this vector has.
      */
     unsigned int n_el;
+
+    /**
+     * Internal reference to the number of elements there is memory
+     * for, which is never less than <code>n_el</code>.
+     */
+    unsigned int n_allocated;
     
     /**
      * Internal object denoting this vector data.
@@ -285,24 +397,119 @@ namespace ewalena
     }
 
   template <typename ValueType>
+    inline 
+    const ValueType& 
+    Vector<ValueType>::operator [] (const unsigned int i) const
+    {
+      return data[i];
+    }
+
+  template <typename ValueType>
+  template <typename E>
+    inline 
+    Vector<ValueType>::Vector (const Expression<E> &e)
+    :
+    n_el (0),
+    n_allocated (0),
+    data (0)
+    {
+      (*this) = e;
+    }
+
+  template <typename ValueType>
+  template <typename E>
+    inline 
+    Vector<ValueType>&
+    Vector<ValueType>::operator = (const Expression<E> &e) 
+    {
+      const E &expression = e ();
+      assert (expression.n_cols () == 1);
+
+      if (this->n_el != expression.n_rows ())
+	this->reinit (expression.n_rows (), false);
+
+      ValueType *dst = data;
+      for (unsigned int i=0; i<n_el; ++i)
+	dst[i] = expression[i];
+
+      return *this;
+    }
+
+  template <typename ValueType>
+  template <typename E>
     inline 
     void
-    Vector<ValueType>::operator += (const Vector<ValueType> &v) 
+    Vector<ValueType>::operator += (const Expression<E> &e) 
     {
-      assert (v.n_el == this->n_el);
+      const E &expression = e ();
+      assert (expression.n_rows () == n_el);
+      assert (expression.n_cols () == 1);
+
+      ValueType *dst = data;
+      for (unsigned int i=0; i<n_el; ++i)
+	dst[i] += expression[i];
+    }
+
+  template <typename ValueType>
+  template <typename E>
+    inline 
+    void
+    Vector<ValueType>::operator -= (const Expression<E> &e) 
+    {
+      const E &expression = e ();
+      assert (expression.n_rows () == n_el);
+      assert (expression.n_cols () == 1);
+
+      ValueType *dst = data;
       for (unsigned int i=0; i<n_el; ++i)
-	data[i] += v.data[i];
+	dst[i] -= expression[i];
     }
 
   template <typename ValueType>
     inline 
     void
+    Vector<ValueType>::operator += (const Vector<ValueType> &v) 
+    {
+      assert (v.n_el == this->n_el);
+      blas::add (n_el, v.data, data);
+    }
+
+  template <typename ValueType>
+    inline 
+    Vector<ValueType>&
     Vector<ValueType>::operator = (const Vector<ValueType> &v) 
     {
+      if (this == &v)
+	return *this;
+
       if (this->n_el != v.n_el)
-	this->reinit (v.n_el);
+	this->reinit (v.n_el, false);
+
+      if (n_el != 0)
+	std::memcpy (this->data, v.data, sizeof (ValueType)*n_el);      
 
-      std::memcpy (this->data, v.data, sizeof (ValueType)*n_el);      
+      return *this;
+    }
+
+  template <typename ValueType>
+    inline 
+    Vector<ValueType>&
+    Vector<ValueType>::operator = (Vector<ValueType> &&v) noexcept
+    {
+      if (this == &v)
+	return *this;
+
+      memory::deallocate (this->data);
+
+      n_el        = v.n_el;
+      n_allocated = v.n_allocated;
+      data        = v.data;
+
+      v.n_el        = 0;
+      v.n_allocated = 0;
+      v.data        = 0;
+
+      return *this;
     }
   
   template <typename ValueType>
@@ -311,8 +518,7 @@ namespace ewalena
     Vector<ValueType>::operator -= (const Vector<ValueType> &v) 
     {
       assert (v.n_el == n_el);
-      for (unsigned int i=0; i<n_el; ++i)
-	data[i] -= v.data[i];
+      blas::subtract (n_el, v.data, data);
     }
   
   template <typename ValueType>
@@ -320,8 +526,7 @@ namespace ewalena
     void
     Vector<ValueType>::operator *= (const ValueType &scalar) 
     {
-      for (unsigned int i=0; i<n_el; ++i)
-	data[i] *= scalar;
+      blas::scale (n_el, scalar, data);
     }
 
   template <typename ValueType>
@@ -329,8 +534,8 @@ namespace ewalena
     void
     Vector<ValueType>::operator /= (const ValueType &scalar) 
     {
-      for (unsigned int i=0; i<n_el; ++i)
-	data[i] /= scalar;
+      assert (scalar != ValueType (0));
+      blas::scale (n_el, ValueType (1)/scalar, data);
     }
 
   template <typename ValueType>
@@ -352,27 +557,25 @@ namespace ewalena
     }
 
   template <typename ValueType>
-    ValueType
-    Vector<ValueType>::l1_norm () 
+    inline
+    unsigned int
+    Vector<ValueType>::n_cols () const
     {
-      ValueType l1_norm = (ValueType) 0;
-
-      for (unsigned int i=0; i<n_el; ++i)    
-	l1_norm += std::fabs (data[i]);
-      
-      return l1_norm;
+      return 1;
     }
 
   template <typename ValueType>
     ValueType
-    Vector<ValueType>::l2_norm () 
+    Vector<ValueType>::l1_norm () const
     {
-      ValueType l2_norm = (ValueType) 0;
-
-      for (unsigned int i=0; i<n_el; ++i)    
-	l2_norm += data[i] * data[i];
+      return ValueType (blas::asum (n_el, data));
+    }
 
-      return std::sqrt (l2_norm);
+  template <typename ValueType>
+    ValueType
+    Vector<ValueType>::l2_norm () const
+    {
+      return ValueType (blas::nrm2 (n_el, data));
     }
   
   template <typename ValueType>
@@ -436,8 +639,7 @@ namespace ewalena
       assert (n_el   != 0);
       assert (v.n_el == n_el);
 
-      for (unsigned int i=0; i<n_el; ++i)
-	data[i] = a*v(i);
+      blas::axpby (n_el, a, v.data, ValueType (0), data);
     }
 
   template <typename ValueType>
@@ -450,9 +652,30 @@ namespace ewalena
     {
       assert (n_el   != 0);
       assert (v.n_el == n_el);
+      assert (w.n_el == n_el);
 
-      for (unsigned int i=0; i<n_el; ++i)
-	data[i] = a*v(i) + b*w(i);
+      blas::waxpby (n_el, a, v.data, b, w.data, data);
+    }
+
+  template <typename ValueType>
+    inline
+    ValueType
+    Vector<ValueType>::dot (const Vector<ValueType> &v) const
+    {
+      assert (v.n_el == n_el);
+
+      return blas::dot (n_el, data, v.data);
+    }
+
+  template <typename ValueType>
+    inline
+    void
+    Vector<ValueType>::add (const ValueType          a,
+			    const Vector<ValueType> &v) 
+    {
+      assert (v.n_el == n_el);
+
+      blas::axpy (n_el, a, v.data, data);
     }
 
 } /* namespace ewalena */
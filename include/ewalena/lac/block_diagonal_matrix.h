@@ -0,0 +1,358 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#ifndef __ewalena_block_diagonal_matrix_h
+#define __ewalena_block_diagonal_matrix_h
+
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+
+namespace ewalena
+{
+
+  /**
+   * A block-diagonal matrix whose blocks are matrices of the type
+   * <code>MatrixType</code>, a <code>Matrix</code>,
+   * <code>SparseMatrix</code> or <code>SellMatrix</code>, each
+   * stored on its own. An operator that conserves a quantum number
+   * is block diagonal in the sectors of it, and its blocks are best
+   * set up and solved independently, which
+   * <code>for_each_block</code> does in parallel.
+   *
+   * The rows and columns of the blocks follow each other, the first
+   * block taking the lowest.
+   *
+   * \ingroup lac
+   */
+  template <typename MatrixType>
+    class BlockDiagonalMatrix
+    {
+    public:
+
+    /**
+     * The type of the elements of this matrix.
+     */
+    typedef typename MatrixType::value_type value_type;
+
+    /**
+     * Constructor - no blocks.
+     */
+    BlockDiagonalMatrix ();
+
+    /**
+     * Constructor - <code>n_blocks</code> empty blocks.
+     */
+    explicit BlockDiagonalMatrix (const unsigned int n_blocks);
+
+    /**
+     * Reinitialise this matrix to <code>n_blocks</code> empty
+     * blocks.
+     */
+    void reinit (const unsigned int n_blocks);
+
+    /**
+     * Return the number of blocks.
+     */
+    unsigned int n_blocks () const;
+
+    /**
+     * Read access to the block <code>b</code>.
+     */
+    const MatrixType& block (const unsigned int b) const;
+
+    /**
+     * Read-write access to the block <code>b</code>. Blocks must be
+     * square.
+     */
+    MatrixType& block (const unsigned int b);
+
+    /**
+     * Return the first row of the block <code>b</code>.
+     */
+    unsigned int block_start (const unsigned int b) const;
+
+    /**
+     * Return the number of rows this matrix has.
+     */
+    unsigned int n_rows () const;
+
+    /**
+     * Return the number of columns this matrix has.
+     */
+    unsigned int n_cols () const;
+
+    /**
+     * Call <code>f (b, block (b))</code> for every block
+     * <code>b</code>, distributed over the threads of
+     * <code>ThreadPool::instance ()</code>. The largest blocks are
+     * handed out first, so that they do not finish last. Whatever
+     * <code>f</code> runs in parallel itself is run serially.
+     */
+    template <typename Function>
+      void for_each_block (const Function &f);
+
+    /**
+     * Same as above, with read access to the blocks.
+     */
+    template <typename Function>
+      void for_each_block (const Function &f) const;
+
+    /**
+     * Matrix-vector multiplication: \f$y=Mx\f$, block by block.
+     */
+    void vmult (Vector<value_type>       &y,
+		const Vector<value_type> &x) const;
+
+    private:
+
+    /**
+     * Return the blocks in decreasing order of their number of rows.
+     */
+    std::vector<unsigned int> largest_first () const;
+
+    /**
+     * Make the empty vector <code>view</code> show the
+     * <code>n</code> elements of <code>v</code> from
+     * <code>start</code> on, without memory of its own, so that a
+     * block multiplies its part of a vector in place; and make it
+     * empty again, which must be done before it goes out of scope.
+     */
+    static void make_view (Vector<value_type>       &view,
+			   const Vector<value_type> &v,
+			   const unsigned int        start,
+			   const unsigned int        n);
+
+    static void release_view (Vector<value_type> &view);
+
+    /**
+     * Internal reference to the blocks.
+     */
+    std::vector<MatrixType> __blocks;
+
+    }; /* BlockDiagonalMatrix */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename MatrixType>
+    inline
+    BlockDiagonalMatrix<MatrixType>::BlockDiagonalMatrix ()
+    {}
+
+  template <typename MatrixType>
+    inline
+    BlockDiagonalMatrix<MatrixType>::BlockDiagonalMatrix (const unsigned int n_blocks)
+    :
+    __blocks (n_blocks)
+    {}
+
+  template <typename MatrixType>
+    inline
+    void
+    BlockDiagonalMatrix<MatrixType>::reinit (const unsigned int n_blocks)
+    {
+      __blocks.clear ();
+      __blocks.resize (n_blocks);
+    }
+
+  template <typename MatrixType>
+    inline
+    unsigned int
+    BlockDiagonalMatrix<MatrixType>::n_blocks () const
+    {
+      return __blocks.size ();
+    }
+
+  template <typename MatrixType>
+    inline
+    const MatrixType&
+    BlockDiagonalMatrix<MatrixType>::block (const unsigned int b) const
+    {
+      assert (b < __blocks.size ());
+      return __blocks[b];
+    }
+
+  template <typename MatrixType>
+    inline
+    MatrixType&
+    BlockDiagonalMatrix<MatrixType>::block (const unsigned int b)
+    {
+      assert (b < __blocks.size ());
+      return __blocks[b];
+    }
+
+  template <typename MatrixType>
+    inline
+    unsigned int
+    BlockDiagonalMatrix<MatrixType>::block_start (const unsigned int b) const
+    {
+      assert (b <= __blocks.size ());
+
+      unsigned int start = 0;
+      for (unsigned int c=0; c<b; ++c)
+	start += __blocks[c].n_rows ();
+
+      return start;
+    }
+
+  template <typename MatrixType>
+    inline
+    unsigned int
+    BlockDiagonalMatrix<MatrixType>::n_rows () const
+    {
+      return block_start (__blocks.size ());
+    }
+
+  template <typename MatrixType>
+    inline
+    unsigned int
+    BlockDiagonalMatrix<MatrixType>::n_cols () const
+    {
+      return n_rows ();
+    }
+
+  template <typename MatrixType>
+    inline
+    std::vector<unsigned int>
+    BlockDiagonalMatrix<MatrixType>::largest_first () const
+    {
+      std::vector<unsigned int> order (__blocks.size ());
+      for (unsigned int b=0; b<order.size (); ++b)
+	order[b] = b;
+
+      std::stable_sort (order.begin (), order.end (),
+			[&] (const unsigned int a, const unsigned int b)
+			{
+			  return __blocks[a].n_rows () > __blocks[b].n_rows ();
+			});
+
+      return order;
+    }
+
+  template <typename MatrixType>
+    template <typename Function>
+    inline
+    void
+    BlockDiagonalMatrix<MatrixType>::for_each_block (const Function &f)
+    {
+      const std::vector<unsigned int> order = largest_first ();
+
+      ThreadPool::instance ().run (order.size (),
+				   [&] (const unsigned int i)
+				   {
+				     f (order[i], __blocks[order[i]]);
+				   });
+    }
+
+  template <typename MatrixType>
+    template <typename Function>
+    inline
+    void
+    BlockDiagonalMatrix<MatrixType>::for_each_block (const Function &f) const
+    {
+      const std::vector<unsigned int> order = largest_first ();
+
+      ThreadPool::instance ().run (order.size (),
+				   [&] (const unsigned int i)
+				   {
+				     f (order[i], __blocks[order[i]]);
+				   });
+    }
+
+  template <typename MatrixType>
+    inline
+    void
+    BlockDiagonalMatrix<MatrixType>::vmult (Vector<value_type>       &y,
+					    const Vector<value_type> &x) const
+    {
+      assert (x.size () == n_cols ());
+      assert (y.size () == n_rows ());
+
+      std::vector<unsigned int> start (__blocks.size ()+1, 0);
+      for (unsigned int b=0; b<__blocks.size (); ++b)
+	start[b+1] = start[b] + __blocks[b].n_rows ();
+
+      /* A single block is multiplied as it is, to keep whatever
+	 parallelism its vmult has. */
+      if (__blocks.size () == 1)
+	{
+	  __blocks[0].vmult (y, x);
+	  return;
+	}
+
+      for_each_block ([&] (const unsigned int b, const MatrixType &block)
+		      {
+			const unsigned int n = block.n_rows ();
+
+			Vector<value_type> x_block, y_block;
+			make_view (x_block, x, start[b], n);
+			make_view (y_block, y, start[b], n);
+
+			block.vmult (y_block, x_block);
+
+			release_view (x_block);
+			release_view (y_block);
+		      });
+    }
+
+  template <typename MatrixType>
+    inline
+    void
+    BlockDiagonalMatrix<MatrixType>::make_view (Vector<value_type>       &view,
+						const Vector<value_type> &v,
+						const unsigned int        start,
+						const unsigned int        n)
+    {
+      assert (view.data == 0);
+      assert (start+n <= v.n_el);
+
+      view.data        = v.data + start;
+      view.n_el        = n;
+      view.n_allocated = n;
+    }
+
+  template <typename MatrixType>
+    inline
+    void
+    BlockDiagonalMatrix<MatrixType>::release_view (Vector<value_type> &view)
+    {
+      view.data        = 0;
+      view.n_el        = 0;
+      view.n_allocated = 0;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_block_diagonal_matrix_h */
@@ -0,0 +1,200 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+
+#ifndef __ewalena_cholesky_factorization_h
+#define __ewalena_cholesky_factorization_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+
+namespace ewalena
+{
+
+  /**
+   * The Cholesky factorization \f$A=LL^H\f$ of a Hermitian (for real
+   * value types, symmetric) positive definite matrix \f$A\f$, where
+   * \f$L\f$ is lower triangular with a positive real diagonal. It
+   * takes half the work of an <code>LUFactorization</code> and needs
+   * no pivoting.
+   *
+   * Only the upper triangle of \f$A\f$ is read, and \f$L^H\f$ is
+   * stored in its place, so that the rows of the stored factor are
+   * contiguous in memory. The factorization is blocked: after a
+   * diagonal block is factorized, the rows of \f$L^H\f$ beside it are
+   * found by a triangular solve, and the upper triangle of the
+   * trailing submatrix is updated by <code>blas::gemm</code> one block
+   * row at a time.
+   *
+   * Besides solving with \f$A\f$, the two triangular factors can be
+   * solved with separately, eg. to reduce a generalised eigenproblem
+   * \f$Hx=\lambda Ax\f$ to the standard form
+   * \f$L^{-1}HL^{-H}y=\lambda y\f$.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class CholeskyFactorization
+    {
+    public:
+
+    /**
+     * Constructor - the factorization of a matrix of size zero.
+     */
+    CholeskyFactorization ();
+
+    /**
+     * Initialize with the factorization of the matrix
+     * <code>M</code>.
+     */
+    explicit CholeskyFactorization (const Matrix<ValueType> &M);
+
+    /**
+     * Compute the factorization of the square matrix <code>M</code>,
+     * replacing any previous factorization. If <code>M</code> turns
+     * out not to be positive definite, the factorization stops and
+     * <code>is_positive_definite ()</code> returns false.
+     */
+    void factorize (const Matrix<ValueType> &M);
+
+    /**
+     * Return the number of rows (and columns) of the factorized
+     * matrix.
+     */
+    unsigned int size () const;
+
+    /**
+     * Return <code>true</code> if the factorization ran to completion,
+     * ie. the factorized matrix is positive definite.
+     */
+    bool is_positive_definite () const;
+
+    /**
+     * Return the determinant of the factorized matrix, which is real
+     * and positive.
+     */
+    double determinant () const;
+
+    /**
+     * Overwrite the vector <code>b</code> with the solution of
+     * \f$Ax=b\f$.
+     */
+    void solve (Vector<ValueType> &b) const;
+
+    /**
+     * Overwrite each column of the matrix <code>B</code> with the
+     * solution of \f$Ax=b\f$ for that column as right-hand side.
+     */
+    void solve (Matrix<ValueType> &B) const;
+
+    /**
+     * Overwrite the vector <code>b</code> with the solution of
+     * \f$Ly=b\f$.
+     */
+    void forward_substitution (Vector<ValueType> &b) const;
+
+    /**
+     * Overwrite each column of the matrix <code>B</code> with the
+     * solution of \f$Ly=b\f$ for that column as right-hand side.
+     */
+    void forward_substitution (Matrix<ValueType> &B) const;
+
+    /**
+     * Overwrite the vector <code>b</code> with the solution of
+     * \f$L^Hx=b\f$.
+     */
+    void backward_substitution (Vector<ValueType> &b) const;
+
+    /**
+     * Overwrite each column of the matrix <code>B</code> with the
+     * solution of \f$L^Hx=b\f$ for that column as right-hand side.
+     */
+    void backward_substitution (Matrix<ValueType> &B) const;
+
+    /**
+     * Make <code>M</code> the inverse of the factorized matrix.
+     */
+    void invert (Matrix<ValueType> &M) const;
+
+    /**
+     * Return the factor \f$L^H\f$, stored on and above the
+     * diagonal. What is below the diagonal is unspecified.
+     */
+    const Matrix<ValueType>& factors () const;
+
+    private:
+
+    /**
+     * Internal reference to the factor \f$L^H\f$, stored in place of
+     * the upper triangle of the matrix.
+     */
+    Matrix<ValueType> __factors;
+
+    /**
+     * Internal reference to whether the factorization ran to
+     * completion.
+     */
+    bool __is_positive_definite;
+
+    }; /* CholeskyFactorization */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    CholeskyFactorization<ValueType>::size () const
+    {
+      return __factors.n_rows ();
+    }
+
+  template <typename ValueType>
+    inline
+    bool
+    CholeskyFactorization<ValueType>::is_positive_definite () const
+    {
+      return __is_positive_definite;
+    }
+
+  template <typename ValueType>
+    inline
+    const Matrix<ValueType>& 
+    CholeskyFactorization<ValueType>::factors () const
+    {
+      return __factors;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_cholesky_factorization_h */
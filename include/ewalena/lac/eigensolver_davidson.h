@@ -0,0 +1,355 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#ifndef __ewalena_eigensolver_davidson_h
+#define __ewalena_eigensolver_davidson_h
+
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include <ewalena/lac/solver_control.h>
+
+namespace ewalena
+{
+
+  /**
+   * The block Davidson method for the lowest eigenpairs of a
+   * Hermitian (for real value types, symmetric) operator \f$A\f$,
+   * given as any object with a member <code>vmult (y, x)</code> that
+   * computes \f$y=Ax\f$, see <code>LinearOperator</code>.
+   *
+   * Each step the basis grows by one correction per unconverged
+   * eigenpair, the residual \f$r=Ax-\theta x\f$ of its Ritz pair
+   * scaled by \f$(\theta-D)^{-1}\f$ with \f$D\f$ the diagonal of
+   * \f$A\f$. This works well for diagonally dominant operators, such
+   * as many-body Hamiltonians in a basis of configurations. The
+   * diagonal of a dense <code>Matrix</code> is had from
+   * <code>Vector::diag</code>. Once the basis holds
+   * <code>n_basis</code> vectors, it collapses to the lowest Ritz
+   * vectors, so that the method keeps \f$O(kn)\f$ memory for \f$k\f$
+   * eigenpairs of an operator of size \f$n\f$.
+   *
+   * Each step is a step of the <code>SolverControl</code>, whose
+   * residual is the largest \f$\|Ax-\theta x\|\f$ of the wanted Ritz
+   * pairs.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class EigensolverDavidson
+    {
+    public:
+
+    /**
+     * Constructor. Take the solver control <code>control</code>, the
+     * number of eigenpairs <code>n_eigenpairs</code> wanted, and the
+     * largest size of the basis <code>n_basis</code>, zero for a
+     * default that depends on the number of eigenpairs.
+     */
+    EigensolverDavidson (SolverControl      &control,
+			 const unsigned int  n_eigenpairs,
+			 const unsigned int  n_basis = 0);
+
+    /**
+     * Find the lowest eigenpairs of \f$A\f$, whose diagonal is
+     * <code>diagonal</code>.
+     *
+     * On input, <code>eigenvectors</code> holds
+     * <code>n_eigenpairs</code> vectors of the size of \f$A\f$, which
+     * are the initial guesses; those that are zero are replaced by the
+     * unit vectors of the lowest diagonal elements. On output,
+     * <code>eigenvalues</code> and <code>eigenvectors</code> are the
+     * Ritz pairs in ascending order, with normalised vectors. Return
+     * the state the solver ended in.
+     */
+    template <typename MatrixType>
+      SolverControl::State solve (const MatrixType                 &A,
+				  const Vector<ValueType>          &diagonal,
+				  std::vector<double>              &eigenvalues,
+				  std::vector<Vector<ValueType> >  &eigenvectors);
+
+    private:
+
+    /**
+     * Orthogonalise <code>t</code> against the first <code>s</code>
+     * basis vectors, twice, and make it basis vector <code>s</code>.
+     * Return false, and leave the basis alone, if <code>t</code> was
+     * (numerically) in the span of the basis.
+     */
+    bool expand (const unsigned int  s,
+		 Vector<ValueType>  &t);
+
+    /**
+     * Internal reference to the solver control.
+     */
+    SolverControl &control;
+
+    /**
+     * Internal reference to the number of eigenpairs wanted.
+     */
+    const unsigned int n_eigenpairs;
+
+    /**
+     * Internal reference to the largest size of the basis.
+     */
+    const unsigned int n_basis;
+
+    /**
+     * Internal workspace: the basis and its products with the
+     * operator, the Ritz vectors kept at a restart and their
+     * products, the residuals of the Ritz pairs and their norms, and
+     * a correction.
+     */
+    std::vector<Vector<ValueType> > basis, products, ritz, ritz_products, residuals;
+    std::vector<double> residual_norms;
+    Vector<ValueType> t;
+
+    /**
+     * Internal workspace: the projected matrix, a copy of its leading
+     * block, and the eigensystem of that.
+     */
+    Matrix<ValueType> H, H_s;
+    HermitianEigensolver<ValueType> projected;
+
+    }; /* EigensolverDavidson */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    EigensolverDavidson<ValueType>::EigensolverDavidson (SolverControl      &control,
+							 const unsigned int  n_eigenpairs,
+							 const unsigned int  n_basis)
+    :
+    control (control),
+    n_eigenpairs (n_eigenpairs),
+    n_basis ((n_basis == 0) ? std::max (4*n_eigenpairs, 20U) : n_basis)
+    {
+      assert (n_eigenpairs > 0);
+      assert (this->n_basis >= 2*n_eigenpairs);
+    }
+
+  template <typename ValueType>
+    inline
+    bool
+    EigensolverDavidson<ValueType>::expand (const unsigned int  s,
+					    Vector<ValueType>  &t)
+    {
+      const double norm = std::abs (t.l2_norm ());
+      if (norm == 0.)
+	return false;
+
+      for (unsigned int pass=0; pass<2; ++pass)
+	for (unsigned int i=0; i<s; ++i)
+	  t.add (-basis[i].dot (t), basis[i]);
+
+      const double norm_orthogonal = std::abs (t.l2_norm ());
+      if (norm_orthogonal <= 1e-10*norm)
+	return false;
+
+      basis[s].sadd (ValueType (1./norm_orthogonal), t);
+      return true;
+    }
+
+  template <typename ValueType>
+  template <typename MatrixType>
+    inline
+    SolverControl::State 
+    EigensolverDavidson<ValueType>::solve (const MatrixType                 &A,
+					   const Vector<ValueType>          &diagonal,
+					   std::vector<double>              &eigenvalues,
+					   std::vector<Vector<ValueType> >  &eigenvectors)
+    {
+      const unsigned int k = n_eigenpairs;
+      assert (eigenvectors.size () == k);
+
+      const unsigned int n = diagonal.size ();
+      assert (k <= n);
+
+      /* The size of the basis, and how many Ritz vectors a restart
+	 keeps. */
+      const unsigned int m = std::min (n_basis, n);
+      const unsigned int l_restart = std::max (k, m/2);
+
+      basis.resize (m);
+      products.resize (m);
+      for (unsigned int i=0; i<m; ++i)
+	{
+	  basis[i].reinit (n, false);
+	  products[i].reinit (n, false);
+	}
+      ritz.resize (l_restart);
+      ritz_products.resize (l_restart);
+      residuals.resize (k);
+      residual_norms.resize (k);
+      t.reinit (n, false);
+      H.reinit (m, m);
+
+      /* The initial basis: the guesses, then the unit vectors in the
+	 order of the diagonal. */
+      unsigned int s = 0;
+      for (unsigned int i=0; i<k; ++i)
+	{
+	  assert (eigenvectors[i].size () == n);
+	  t = eigenvectors[i];
+	  s += expand (s, t);
+	}
+
+      std::vector<unsigned int> order (n);
+      std::iota (order.begin (), order.end (), 0);
+      std::stable_sort (order.begin (), order.end (),
+			[&] (const unsigned int i, const unsigned int j)
+			{
+			  return std::real (diagonal(i)) < std::real (diagonal(j));
+			});
+
+      for (unsigned int i=0; s<k; ++i)
+	{
+	  t.reinit (n);
+	  t(order[i]) = ValueType (1);
+	  s += expand (s, t);
+	}
+
+      unsigned int s_done = 0;
+
+      for (unsigned int step=0; ; ++step)
+	{
+	  /* Products with the new basis vectors, and the new columns of
+	     the projected matrix. */
+	  for (unsigned int j=s_done; j<s; ++j)
+	    {
+	      A.vmult (products[j], basis[j]);
+
+	      for (unsigned int i=0; i<=j; ++i)
+		{
+		  H(i, j) = basis[i].dot (products[j]);
+		  H(j, i) = math::conjugate (H(i, j));
+		}
+	      H(j, j) = ValueType (std::real (H(j, j)));
+	    }
+	  s_done = s;
+
+	  /* Rayleigh-Ritz, and the residuals of the wanted Ritz
+	     pairs. */
+	  H_s.reinit (s, s, false);
+	  for (unsigned int i=0; i<s; ++i)
+	    for (unsigned int j=0; j<s; ++j)
+	      H_s(i, j) = H(i, j);
+
+	  projected.compute (H_s);
+
+	  const std::vector<double> &theta = projected.eigenvalues ();
+	  const Matrix<ValueType>   &Y     = projected.eigenvectors ();
+
+	  for (unsigned int i=0; i<k; ++i)
+	    {
+	      eigenvectors[i].reinit (n);
+	      residuals[i].reinit (n);
+	      for (unsigned int j=0; j<s; ++j)
+		{
+		  eigenvectors[i].add (Y(j, i), basis[j]);
+		  residuals[i].add (Y(j, i), products[j]);
+		}
+	      residuals[i].add (ValueType (-theta[i]), eigenvectors[i]);
+	      residual_norms[i] = std::abs (residuals[i].l2_norm ());
+	    }
+
+	  const SolverControl::State state 
+	    = control.check (step, *std::max_element (residual_norms.begin (), residual_norms.end ()));
+
+	  if (state != SolverControl::iterate)
+	    {
+	      eigenvalues.assign (theta.begin (), theta.begin ()+k);
+	      return state;
+	    }
+
+	  /* Collapse to the lowest Ritz vectors, about half the basis,
+	     if there is not room for all corrections. */
+	  unsigned int n_corrections = 0;
+	  for (unsigned int i=0; i<k; ++i)
+	    n_corrections += (residual_norms[i] > control.target ());
+
+	  if (s+n_corrections > m && s > l_restart)
+	    {
+	      for (unsigned int i=0; i<l_restart; ++i)
+		{
+		  ritz[i].reinit (n);
+		  ritz_products[i].reinit (n);
+		  for (unsigned int j=0; j<s; ++j)
+		    {
+		      ritz[i].add (Y(j, i), basis[j]);
+		      ritz_products[i].add (Y(j, i), products[j]);
+		    }
+		}
+
+	      H.reinit (m, m);
+	      for (unsigned int i=0; i<l_restart; ++i)
+		{
+		  std::swap (basis[i], ritz[i]);
+		  std::swap (products[i], ritz_products[i]);
+		  H(i, i) = ValueType (theta[i]);
+		}
+	      s = s_done = l_restart;
+	    }
+
+	  /* The corrections, preconditioned by the diagonal. */
+	  const unsigned int s_previous = s;
+	  for (unsigned int i=0; i<k && s<m; ++i)
+	    if (residual_norms[i] > control.target ())
+	      {
+		for (unsigned int j=0; j<n; ++j)
+		  {
+		    ValueType shift = ValueType (theta[i]) - diagonal(j);
+		    if (std::abs (shift) < 1e-8)
+		      shift = ValueType (1e-8);
+		    t(j) = residuals[i](j)/shift;
+		  }
+		s += expand (s, t);
+	      }
+
+	  if (s == s_previous)
+	    return control.breakdown (step);
+	}
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_eigensolver_davidson_h */
@@ -0,0 +1,366 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#ifndef __ewalena_eigensolver_lanczos_h
+#define __ewalena_eigensolver_lanczos_h
+
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include <ewalena/lac/solver_control.h>
+
+namespace ewalena
+{
+
+  /**
+   * The thick-restart Lanczos method of Wu and Simon for the lowest
+   * eigenpairs of a Hermitian (for real value types, symmetric)
+   * operator \f$A\f$, which is any object with a member <code>vmult
+   * (y, x)</code> that computes \f$y=Ax\f$, see
+   * <code>LinearOperator</code>.
+   *
+   * A Krylov basis of <code>n_krylov</code> vectors is built with the
+   * Lanczos recurrence, and the eigenpairs of the projected matrix
+   * are the approximations (Ritz pairs). Unless they have converged,
+   * the method restarts from the lowest Ritz vectors, about half the
+   * basis, and the last Lanczos vector, so that it keeps \f$O(kn)\f$
+   * memory for \f$k\f$ eigenpairs of an operator of size \f$n\f$.
+   *
+   * In exact arithmetic the recurrence keeps the basis orthogonal;
+   * with <code>full</code> reorthogonalisation every new vector is
+   * orthogonalised against the whole basis, twice, which costs more
+   * inner products but prevents spurious copies of converged
+   * eigenvalues. With <code>local</code> reorthogonalisation only the
+   * recurrence itself is kept.
+   *
+   * Each restart is a step of the <code>SolverControl</code>, whose
+   * residual is the largest \f$\|Ax-\lambda x\|\f$ of the wanted Ritz
+   * pairs.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class EigensolverLanczos
+    {
+    public:
+
+    /**
+     * How much a new Lanczos vector is orthogonalised.
+     */
+    enum Reorthogonalization
+    {
+      /**
+       * Against the previous two Lanczos vectors and the Ritz vectors
+       * kept at the last restart only.
+       */
+      local,
+
+      /**
+       * Against all Lanczos vectors, twice.
+       */
+      full
+    };
+
+    /**
+     * Constructor. Take the solver control <code>control</code>, the
+     * number of eigenpairs <code>n_eigenpairs</code> wanted, the size
+     * of the Krylov basis <code>n_krylov</code>, zero for a default
+     * that depends on the number of eigenpairs, and the
+     * reorthogonalisation.
+     */
+    EigensolverLanczos (SolverControl             &control,
+			const unsigned int         n_eigenpairs,
+			const unsigned int         n_krylov = 0,
+			const Reorthogonalization  reorthogonalization = full);
+
+    /**
+     * Find the lowest eigenpairs of \f$A\f$.
+     *
+     * On input, <code>eigenvectors</code> holds
+     * <code>n_eigenpairs</code> vectors of the size of \f$A\f$, whose
+     * sum is the starting vector; if it is zero a fixed pseudo-random
+     * vector is used instead. On output, <code>eigenvalues</code> and
+     * <code>eigenvectors</code> are the Ritz pairs in ascending order,
+     * with normalised vectors. Return the state the solver ended in.
+     */
+    template <typename MatrixType>
+      SolverControl::State solve (const MatrixType                 &A,
+				  std::vector<double>              &eigenvalues,
+				  std::vector<Vector<ValueType> >  &eigenvectors);
+
+    private:
+
+    /**
+     * Orthogonalise <code>w</code> against the basis vectors
+     * <code>begin</code> to <code>end</code>, adding the coefficients
+     * to column <code>j</code> of the projected matrix.
+     */
+    void orthogonalize (const unsigned int  begin,
+			const unsigned int  end,
+			const unsigned int  j,
+			Vector<ValueType>  &w);
+
+    /**
+     * Fill <code>v</code> with pseudo-random numbers, which are the
+     * same for the same <code>seed</code>.
+     */
+    static void random (Vector<ValueType>  &v,
+			unsigned long long  seed);
+
+    /**
+     * Internal reference to the solver control.
+     */
+    SolverControl &control;
+
+    /**
+     * Internal reference to the number of eigenpairs wanted.
+     */
+    const unsigned int n_eigenpairs;
+
+    /**
+     * Internal reference to the size of the Krylov basis.
+     */
+    const unsigned int n_krylov;
+
+    /**
+     * Internal reference to the reorthogonalisation.
+     */
+    const Reorthogonalization reorthogonalization;
+
+    /**
+     * Internal workspace: the Lanczos basis, the Ritz vectors kept at
+     * a restart, and the product of the operator with a basis vector.
+     */
+    std::vector<Vector<ValueType> > basis, ritz;
+    Vector<ValueType> w;
+
+    /**
+     * Internal workspace: the projected matrix and its eigensystem.
+     */
+    Matrix<ValueType> T;
+    HermitianEigensolver<ValueType> projected;
+
+    }; /* EigensolverLanczos */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    EigensolverLanczos<ValueType>::EigensolverLanczos (SolverControl             &control,
+						       const unsigned int         n_eigenpairs,
+						       const unsigned int         n_krylov,
+						       const Reorthogonalization  reorthogonalization)
+    :
+    control (control),
+    n_eigenpairs (n_eigenpairs),
+    n_krylov ((n_krylov == 0) ? std::max (2*n_eigenpairs, n_eigenpairs+20) : n_krylov),
+    reorthogonalization (reorthogonalization)
+    {
+      assert (n_eigenpairs > 0);
+      assert (this->n_krylov > n_eigenpairs);
+    }
+
+  template <typename ValueType>
+    inline
+    void
+    EigensolverLanczos<ValueType>::orthogonalize (const unsigned int  begin,
+						  const unsigned int  end,
+						  const unsigned int  j,
+						  Vector<ValueType>  &w)
+    {
+      for (unsigned int i=begin; i<end; ++i)
+	{
+	  const ValueType h = basis[i].dot (w);
+	  w.add (-h, basis[i]);
+	  T(i, j) += h;
+	}
+    }
+
+  template <typename ValueType>
+    inline
+    void
+    EigensolverLanczos<ValueType>::random (Vector<ValueType>  &v,
+					   unsigned long long  seed)
+    {
+      /* A linear congruential generator, so that the library leaves
+	 the state of std::rand alone. */
+      for (unsigned int i=0; i<v.size (); ++i)
+	{
+	  seed = 6364136223846793005ULL*seed + 1442695040888963407ULL;
+	  v(i) = ValueType (double (seed >> 11)/double (1ULL << 53) - 0.5);
+	}
+    }
+
+  template <typename ValueType>
+  template <typename MatrixType>
+    inline
+    SolverControl::State 
+    EigensolverLanczos<ValueType>::solve (const MatrixType                 &A,
+					  std::vector<double>              &eigenvalues,
+					  std::vector<Vector<ValueType> >  &eigenvectors)
+    {
+      const unsigned int k = n_eigenpairs;
+      assert (eigenvectors.size () == k);
+
+      const unsigned int n = eigenvectors[0].size ();
+      assert (k <= n);
+
+      /* The size of the basis, and how many Ritz vectors a restart
+	 keeps. */
+      const unsigned int m = std::min (n_krylov, n);
+      const unsigned int l_restart = std::min (k + (m-k)/2, m-1);
+
+      basis.resize (m+1);
+      for (unsigned int i=0; i<=m; ++i)
+	basis[i].reinit (n, false);
+      ritz.resize (l_restart);
+      w.reinit (n, false);
+      T.reinit (m, m);
+
+      /* The starting vector. */
+      basis[0].reinit (n);
+      for (unsigned int i=0; i<k; ++i)
+	basis[0].add (ValueType (1), eigenvectors[i]);
+
+      double norm = std::abs (basis[0].l2_norm ());
+      if (norm == 0.)
+	{
+	  random (basis[0], 0);
+	  norm = std::abs (basis[0].l2_norm ());
+	}
+      basis[0] /= ValueType (norm);
+
+      const double epsilon = 100.*std::numeric_limits<double>::epsilon ();
+
+      double norm_estimate = 0.;
+      double beta          = 0.;
+      unsigned int l       = 0;
+
+      for (unsigned int step=0; ; ++step)
+	{
+	  /* Extend the basis from l to m vectors. */
+	  for (unsigned int j=l; j<m; ++j)
+	    {
+	      A.vmult (w, basis[j]);
+
+	      if (reorthogonalization == full)
+		{
+		  orthogonalize (0, j+1, j, w);
+		  orthogonalize (0, j+1, j, w);
+		}
+	      else
+		{
+		  orthogonalize (0, l, j, w);
+		  orthogonalize (std::max (l, (j == 0) ? 0 : j-1), j+1, j, w);
+		}
+
+	      /* The coefficients are column j of the projected matrix,
+		 beta_{j-1} included; its lower triangle follows. */
+	      T(j, j) = ValueType (std::real (T(j, j)));
+	      for (unsigned int i=0; i<j; ++i)
+		T(j, i) = math::conjugate (T(i, j));
+
+	      beta = std::abs (w.l2_norm ());
+	      norm_estimate = std::max (norm_estimate, std::abs (T(j, j)) + beta);
+
+	      /* An invariant subspace: go on with a new random vector
+		 that is not coupled to the basis. */
+	      if (beta <= epsilon*norm_estimate)
+		{
+		  beta = 0.;
+		  random (w, step*m+j+1);
+		  for (unsigned int pass=0; pass<2; ++pass)
+		    for (unsigned int i=0; i<=j; ++i)
+		      w.add (-basis[i].dot (w), basis[i]);
+		  basis[j+1].sadd (ValueType (1./std::abs (w.l2_norm ())), w);
+		}
+	      else
+		basis[j+1].sadd (ValueType (1./beta), w);
+	    }
+
+	  /* Rayleigh-Ritz: the residual of a Ritz pair (theta, V y)
+	     is beta times the last element of y. */
+	  projected.compute (T);
+
+	  const std::vector<double> &theta = projected.eigenvalues ();
+	  const Matrix<ValueType>   &Y     = projected.eigenvectors ();
+
+	  double residual = 0.;
+	  for (unsigned int i=0; i<k; ++i)
+	    residual = std::max (residual, beta*std::abs (Y(m-1, i)));
+
+	  const SolverControl::State state = control.check (step, residual);
+
+	  if (state != SolverControl::iterate)
+	    {
+	      eigenvalues.assign (theta.begin (), theta.begin ()+k);
+	      for (unsigned int i=0; i<k; ++i)
+		{
+		  eigenvectors[i].reinit (n);
+		  for (unsigned int j=0; j<m; ++j)
+		    eigenvectors[i].add (Y(j, i), basis[j]);
+		}
+	      return state;
+	    }
+
+	  /* Thick restart: the lowest Ritz vectors, then the last
+	     Lanczos vector. */
+	  l = l_restart;
+	  for (unsigned int i=0; i<l; ++i)
+	    {
+	      ritz[i].reinit (n);
+	      for (unsigned int j=0; j<m; ++j)
+		ritz[i].add (Y(j, i), basis[j]);
+	    }
+
+	  T.reinit (m, m);
+	  for (unsigned int i=0; i<l; ++i)
+	    {
+	      std::swap (basis[i], ritz[i]);
+	      T(i, i) = ValueType (theta[i]);
+	    }
+	  std::swap (basis[l], basis[m]);
+	}
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_eigensolver_lanczos_h */
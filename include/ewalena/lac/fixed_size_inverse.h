@@ -0,0 +1,507 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+
+#ifndef __ewalena_fixed_size_inverse_h
+#define __ewalena_fixed_size_inverse_h
+
+#include <ewalena/base/memory.h>
+
+namespace ewalena
+{
+
+  /**
+   * Inversion and solves for square matrices whose size
+   * <code>n</code> is known at compile time, meant for the many
+   * small blocks (four to eight rows, say) that are too large for a
+   * closed form and too small for a blocked factorization.
+   *
+   * Gaussian elimination with partial pivoting is unrolled at
+   * compile time: every loop over rows and columns is a template
+   * recursion, so that the code is straight-line and the matrix is
+   * kept in registers. The batched variants take many matrices of
+   * the same size stored as a structure of arrays, element \f$c\f$
+   * of matrix \f$p\f$ at <code>A[c*lda+p]</code> (the layout of a
+   * TensorField), and run the same code over <code>lanes</code>
+   * matrices at a time, one per vector lane. Pivots are then chosen
+   * per matrix, and rows are exchanged by selects instead of
+   * branches.
+   *
+   * \ingroup lac
+   */
+  namespace fixed_size
+  {
+
+    namespace internal
+    {
+
+      /**
+       * Call <code>f(i)</code> for every \f$i\in[begin,end)\f$, with
+       * the loop unrolled at compile time.
+       */
+      template <unsigned int begin, unsigned int end>
+	struct Unroll
+	{
+	  template <typename Function>
+	    static inline void run (const Function &f)
+	    {
+	      f (begin);
+	      Unroll<begin+1, end>::run (f);
+	    }
+	};
+
+      template <unsigned int end>
+	struct Unroll<end, end>
+	{
+	  template <typename Function>
+	    static inline void run (const Function &)
+	    {}
+	};
+
+      /**
+       * Step <code>k</code> of the in-place Gauss-Jordan inversion
+       * of <code>width</code> matrices of size <code>n</code>, with
+       * element \f$(i,j)\f$ of matrix \f$l\f$ at
+       * <code>a[(i*n+j)*width+l]</code>. The row exchanged with row
+       * \f$k\f$ is recorded in <code>pivots</code>, and
+       * <code>singular</code> is set if a pivot is zero.
+       */
+      template <unsigned int n, unsigned int width, unsigned int k>
+	struct GaussJordan
+	{
+	  template <typename ValueType>
+	    static inline void run (ValueType    *a,
+				    unsigned int *pivots,
+				    bool         &singular)
+	    {
+	      unsigned int *pivot = pivots + k*width;
+	      double        max[width];
+
+	      for (unsigned int l=0; l<width; ++l)
+		{
+		  pivot[l] = k;
+		  max[l]   = std::norm (a[(k*n+k)*width+l]);
+		}
+
+	      Unroll<k+1, n>::run ([&] (const unsigned int i)
+				   {
+				     for (unsigned int l=0; l<width; ++l)
+				       {
+					 const double v = std::norm (a[(i*n+k)*width+l]);
+					 pivot[l] = (v > max[l]) ? i : pivot[l];
+					 max[l]   = (v > max[l]) ? v : max[l];
+				       }
+				   });
+
+	      /* Exchange row k with the pivot row of each matrix. */
+	      Unroll<k+1, n>::run ([&] (const unsigned int i)
+				   {
+				     Unroll<0, n>::run ([&] (const unsigned int j)
+							{
+							  ValueType *a_kj = a + (k*n+j)*width;
+							  ValueType *a_ij = a + (i*n+j)*width;
+							  for (unsigned int l=0; l<width; ++l)
+							    {
+							      const bool      exchange = (pivot[l] == i);
+							      const ValueType t        = a_kj[l];
+							      a_kj[l] = exchange ? a_ij[l] : t;
+							      a_ij[l] = exchange ? t       : a_ij[l];
+							    }
+							});
+				   });
+
+	      ValueType r[width];
+	      for (unsigned int l=0; l<width; ++l)
+		{
+		  singular = singular || (max[l] == 0.);
+		  r[l] = ValueType (1)/a[(k*n+k)*width+l];
+		  a[(k*n+k)*width+l] = ValueType (1);
+		}
+
+	      Unroll<0, n>::run ([&] (const unsigned int j)
+				 {
+				   for (unsigned int l=0; l<width; ++l)
+				     a[(k*n+j)*width+l] *= r[l];
+				 });
+
+	      Unroll<0, n>::run ([&] (const unsigned int i)
+				 {
+				   if (i == k)
+				     return;
+
+				   ValueType f[width];
+				   for (unsigned int l=0; l<width; ++l)
+				     {
+				       f[l] = a[(i*n+k)*width+l];
+				       a[(i*n+k)*width+l] = ValueType (0);
+				     }
+
+				   Unroll<0, n>::run ([&] (const unsigned int j)
+						      {
+							for (unsigned int l=0; l<width; ++l)
+							  a[(i*n+j)*width+l] -= f[l]*a[(k*n+j)*width+l];
+						      });
+				 });
+
+	      GaussJordan<n, width, k+1>::run (a, pivots, singular);
+	    }
+	};
+
+      template <unsigned int n, unsigned int width>
+	struct GaussJordan<n, width, n>
+	{
+	  template <typename ValueType>
+	    static inline void run (ValueType *, unsigned int *, bool &)
+	    {}
+	};
+
+      /**
+       * Undo the row exchanges of the Gauss-Jordan steps
+       * <code>k</code>-1 down to zero on the columns of the inverse.
+       */
+      template <unsigned int n, unsigned int width, unsigned int k>
+	struct ExchangeColumns
+	{
+	  template <typename ValueType>
+	    static inline void run (ValueType          *a,
+				    const unsigned int *pivots)
+	    {
+	      const unsigned int *pivot = pivots + (k-1)*width;
+
+	      Unroll<k, n>::run ([&] (const unsigned int j)
+				 {
+				   Unroll<0, n>::run ([&] (const unsigned int i)
+						      {
+							ValueType *a_ik = a + (i*n+k-1)*width;
+							ValueType *a_ij = a + (i*n+j)*width;
+							for (unsigned int l=0; l<width; ++l)
+							  {
+							    const bool      exchange = (pivot[l] == j);
+							    const ValueType t        = a_ik[l];
+							    a_ik[l] = exchange ? a_ij[l] : t;
+							    a_ij[l] = exchange ? t       : a_ij[l];
+							  }
+						      });
+				 });
+
+	      ExchangeColumns<n, width, k-1>::run (a, pivots);
+	    }
+	};
+
+      template <unsigned int n, unsigned int width>
+	struct ExchangeColumns<n, width, 0>
+	{
+	  template <typename ValueType>
+	    static inline void run (ValueType *, const unsigned int *)
+	    {}
+	};
+
+      /**
+       * Step <code>k</code> of the elimination of <code>width</code>
+       * systems \f$Ax=b\f$ of size <code>n</code>, laid out as for
+       * GaussJordan and with element \f$i\f$ of right-hand side
+       * \f$l\f$ at <code>b[i*width+l]</code>.
+       */
+      template <unsigned int n, unsigned int width, unsigned int k>
+	struct Eliminate
+	{
+	  template <typename ValueType>
+	    static inline void run (ValueType *a,
+				    ValueType *b,
+				    bool      &singular)
+	    {
+	      unsigned int pivot[width];
+	      double       max[width];
+
+	      for (unsigned int l=0; l<width; ++l)
+		{
+		  pivot[l] = k;
+		  max[l]   = std::norm (a[(k*n+k)*width+l]);
+		}
+
+	      Unroll<k+1, n>::run ([&] (const unsigned int i)
+				   {
+				     for (unsigned int l=0; l<width; ++l)
+				       {
+					 const double v = std::norm (a[(i*n+k)*width+l]);
+					 pivot[l] = (v > max[l]) ? i : pivot[l];
+					 max[l]   = (v > max[l]) ? v : max[l];
+				       }
+				   });
+
+	      /* Exchange the rows of a right of column k and of b. */
+	      Unroll<k+1, n>::run ([&] (const unsigned int i)
+				   {
+				     const auto exchange = [&] (ValueType *x_k, ValueType *x_i)
+				       {
+					 for (unsigned int l=0; l<width; ++l)
+					   {
+					     const bool      e = (pivot[l] == i);
+					     const ValueType t = x_k[l];
+					     x_k[l] = e ? x_i[l] : t;
+					     x_i[l] = e ? t      : x_i[l];
+					   }
+				       };
+
+				     Unroll<k, n>::run ([&] (const unsigned int j)
+							{
+							  exchange (a + (k*n+j)*width, a + (i*n+j)*width);
+							});
+				     exchange (b + k*width, b + i*width);
+				   });
+
+	      ValueType r[width];
+	      for (unsigned int l=0; l<width; ++l)
+		{
+		  singular = singular || (max[l] == 0.);
+		  r[l] = ValueType (1)/a[(k*n+k)*width+l];
+		}
+
+	      Unroll<k+1, n>::run ([&] (const unsigned int i)
+				   {
+				     ValueType f[width];
+				     for (unsigned int l=0; l<width; ++l)
+				       {
+					 f[l] = a[(i*n+k)*width+l]*r[l];
+					 b[i*width+l] -= f[l]*b[k*width+l];
+				       }
+
+				     Unroll<k+1, n>::run ([&] (const unsigned int j)
+							  {
+							    for (unsigned int l=0; l<width; ++l)
+							      a[(i*n+j)*width+l] -= f[l]*a[(k*n+j)*width+l];
+							  });
+				   });
+
+	      Eliminate<n, width, k+1>::run (a, b, singular);
+	    }
+	};
+
+      template <unsigned int n, unsigned int width>
+	struct Eliminate<n, width, n>
+	{
+	  template <typename ValueType>
+	    static inline void run (ValueType *, ValueType *, bool &)
+	    {}
+	};
+
+      /**
+       * Back substitution for rows <code>k</code>-1 down to zero of
+       * the systems left upper triangular by Eliminate.
+       */
+      template <unsigned int n, unsigned int width, unsigned int k>
+	struct Substitute
+	{
+	  template <typename ValueType>
+	    static inline void run (const ValueType *a,
+				    ValueType       *b)
+	    {
+	      Unroll<k, n>::run ([&] (const unsigned int j)
+				 {
+				   for (unsigned int l=0; l<width; ++l)
+				     b[(k-1)*width+l] -= a[((k-1)*n+j)*width+l]*b[j*width+l];
+				 });
+
+	      for (unsigned int l=0; l<width; ++l)
+		b[(k-1)*width+l] /= a[((k-1)*n+k-1)*width+l];
+
+	      Substitute<n, width, k-1>::run (a, b);
+	    }
+	};
+
+      template <unsigned int n, unsigned int width>
+	struct Substitute<n, width, 0>
+	{
+	  template <typename ValueType>
+	    static inline void run (const ValueType *, ValueType *)
+	    {}
+	};
+
+    } /* namespace internal */
+
+    /**
+     * The number of matrices the batched variants work on at a time,
+     * as many as fill <code>memory::alignment</code> bytes.
+     */
+    template <typename ValueType>
+      struct Lanes
+      {
+	static constexpr unsigned int value 
+	  = (memory::alignment/sizeof (ValueType) > 0) ? memory::alignment/sizeof (ValueType) : 1;
+      };
+
+    /**
+     * Write the inverse of the row-major
+     * <code>n</code>\f$\times\f$<code>n</code> array <code>A</code>
+     * to <code>inverse</code>, which may be <code>A</code> itself.
+     * Return <code>false</code> if \f$A\f$ is singular, in which
+     * case <code>inverse</code> is not meaningful.
+     */
+    template <unsigned int n, typename ValueType>
+      inline
+      bool invert (const ValueType *A,
+		   ValueType       *inverse)
+      {
+	ValueType    a[n*n];
+	unsigned int pivots[n];
+	bool         singular = false;
+
+	std::copy (A, A+n*n, a);
+	internal::GaussJordan<n, 1, 0>::run (a, pivots, singular);
+	internal::ExchangeColumns<n, 1, n>::run (a, pivots);
+	std::copy (a, a+n*n, inverse);
+
+	return !singular;
+      }
+
+    /**
+     * Overwrite the vector <code>b</code> of length <code>n</code>
+     * with the solution of \f$Ax=b\f$, where <code>A</code> is a
+     * row-major <code>n</code>\f$\times\f$<code>n</code> array.
+     * Return <code>false</code> if \f$A\f$ is singular.
+     */
+    template <unsigned int n, typename ValueType>
+      inline
+      bool solve (const ValueType *A,
+		  ValueType       *b)
+      {
+	ValueType a[n*n];
+	bool      singular = false;
+
+	std::copy (A, A+n*n, a);
+	internal::Eliminate<n, 1, 0>::run (a, b, singular);
+	if (!singular)
+	  internal::Substitute<n, 1, n>::run (a, b);
+
+	return !singular;
+      }
+
+    /**
+     * Write the inverses of the <code>n_matrices</code> matrices
+     * stored as a structure of arrays in <code>A</code> to
+     * <code>inverse</code>, laid out the same way, where element
+     * \f$c=in+j\f$ of matrix \f$p\f$ is <code>A[c*lda+p]</code>
+     * and <code>inverse[c*ldi+p]</code>. The two may be the same.
+     * Return <code>false</code> if any of the matrices is
+     * singular.
+     */
+    template <unsigned int n, typename ValueType>
+      inline
+      bool invert (const unsigned int  n_matrices,
+		   const ValueType    *A,
+		   const std::size_t   lda,
+		   ValueType          *inverse,
+		   const std::size_t   ldi)
+      {
+	const unsigned int width = Lanes<ValueType>::value;
+
+	alignas (memory::alignment) ValueType a[n*n*width];
+	unsigned int                          pivots[n*width];
+	bool                                  singular = false;
+
+	for (unsigned int p0=0; p0<n_matrices; p0+=width)
+	  {
+	    const unsigned int w = std::min (width, n_matrices-p0);
+
+	    /* A last group that is not full is padded with
+	       identities. */
+	    for (unsigned int c=0; c<n*n; ++c)
+	      {
+		std::copy (A + c*lda + p0, A + c*lda + p0 + w, a + c*width);
+		std::fill (a + c*width + w, a + (c+1)*width, ValueType ((c%(n+1)) == 0));
+	      }
+
+	    internal::GaussJordan<n, width, 0>::run (a, pivots, singular);
+	    internal::ExchangeColumns<n, width, n>::run (a, pivots);
+
+	    for (unsigned int c=0; c<n*n; ++c)
+	      std::copy (a + c*width, a + c*width + w, inverse + c*ldi + p0);
+	  }
+
+	return !singular;
+      }
+
+    /**
+     * Overwrite the <code>n_matrices</code> right-hand sides
+     * <code>b</code>, with element \f$i\f$ of the \f$p\f$th at
+     * <code>b[i*ldb+p]</code>, by the solutions of \f$Ax=b\f$ with
+     * the matrices stored in <code>A</code> as for
+     * <code>invert</code>. Return <code>false</code> if any of the
+     * matrices is singular.
+     */
+    template <unsigned int n, typename ValueType>
+      inline
+      bool solve (const unsigned int  n_matrices,
+		  const ValueType    *A,
+		  const std::size_t   lda,
+		  ValueType          *b,
+		  const std::size_t   ldb)
+      {
+	const unsigned int width = Lanes<ValueType>::value;
+
+	alignas (memory::alignment) ValueType a[n*n*width];
+	alignas (memory::alignment) ValueType x[n*width];
+	bool                                  singular = false;
+
+	for (unsigned int p0=0; p0<n_matrices; p0+=width)
+	  {
+	    const unsigned int w = std::min (width, n_matrices-p0);
+
+	    for (unsigned int c=0; c<n*n; ++c)
+	      {
+		std::copy (A + c*lda + p0, A + c*lda + p0 + w, a + c*width);
+		std::fill (a + c*width + w, a + (c+1)*width, ValueType ((c%(n+1)) == 0));
+	      }
+	    for (unsigned int i=0; i<n; ++i)
+	      {
+		std::copy (b + i*ldb + p0, b + i*ldb + p0 + w, x + i*width);
+		std::fill (x + i*width + w, x + (i+1)*width, ValueType (0));
+	      }
+
+	    internal::Eliminate<n, width, 0>::run (a, x, singular);
+	    internal::Substitute<n, width, n>::run (a, x);
+
+	    for (unsigned int i=0; i<n; ++i)
+	      std::copy (x + i*width, x + i*width + w, b + i*ldb + p0);
+	  }
+
+	return !singular;
+      }
+
+  } /* namespace fixed_size */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_fixed_size_inverse_h */
@@ -0,0 +1,128 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <complex>
+#include <cstddef>
+
+#ifndef __ewalena_gemm_h
+#define __ewalena_gemm_h
+
+namespace ewalena
+{
+
+  /**
+   * Dense linear algebra kernels that operate directly on row-major
+   * arrays, in the manner of the BLAS. These are the work horses
+   * behind the products offered by the Matrix and Vector classes.
+   *
+   * \ingroup lac
+   */
+  namespace blas
+  {
+
+    /**
+     * The form in which an operand enters a product.
+     */
+    enum Operation
+    {
+      /**
+       * Use the operand as it is stored.
+       */
+      no_transpose,
+
+      /**
+       * Use the transpose of the operand.
+       */
+      transpose,
+
+      /**
+       * Use the complex conjugate transpose of the operand. For real
+       * value types this is the same as <code>transpose</code>.
+       */
+      conjugate_transpose
+    };
+
+    /**
+     * General matrix-matrix product \f$C=\alpha
+     * op(A)op(B)+\beta C\f$, where \f$op(A)\f$ is of size
+     * <code>m</code>\f$\times\f$<code>k</code>, \f$op(B)\f$ is of
+     * size <code>k</code>\f$\times\f$<code>n</code> and \f$C\f$ is of
+     * size <code>m</code>\f$\times\f$<code>n</code>. All arrays are
+     * row-major and <code>lda</code>, <code>ldb</code> and
+     * <code>ldc</code> are the distance between consecutive rows of
+     * the <i>stored</i> arrays.
+     *
+     * Both operands are copied into contiguous panels sized to the
+     * cache hierarchy before a register-tiled kernel runs over them,
+     * so that transposed operands never need to be formed
+     * explicitly. If <code>beta</code> is zero, \f$C\f$ need not be
+     * initialised.
+     *
+     * Products larger than <code>gemm_threshold ()</code> are split
+     * into two-dimensional tiles of \f$C\f$ that are computed
+     * concurrently by the threads of <code>ThreadPool::instance
+     * ()</code>.
+     */
+    template <typename ValueType>
+      void gemm (const Operation    op_a,
+		 const Operation    op_b,
+		 const unsigned int m,
+		 const unsigned int n,
+		 const unsigned int k,
+		 const ValueType    alpha,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 const ValueType   *B,
+		 const unsigned int ldb,
+		 const ValueType    beta,
+		 ValueType         *C,
+		 const unsigned int ldc);
+
+    /**
+     * Return the size of a product, counted in multiply-adds
+     * \f$mnk\f$, from which on <code>gemm</code> runs in parallel.
+     */
+    std::size_t gemm_threshold ();
+
+    /**
+     * Set the size of a product, counted in multiply-adds
+     * \f$mnk\f$, from which on <code>gemm</code> runs in
+     * parallel. Smaller products are computed on the calling thread
+     * only, where the cost of waking the workers would not pay off.
+     */
+    void set_gemm_threshold (const std::size_t n_operations);
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_gemm_h */
@@ -0,0 +1,94 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <complex>
+#include <cstddef>
+
+#ifndef __ewalena_gemv_h
+#define __ewalena_gemv_h
+
+#include <ewalena/lac/gemm.h>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    /**
+     * General matrix-vector product \f$y=\alpha op(A)x+\beta y\f$,
+     * where \f$A\f$ is a row-major array of size
+     * <code>m</code>\f$\times\f$<code>n</code> and <code>lda</code>
+     * is the distance between its consecutive rows. The vector
+     * \f$x\f$ is of length <code>n</code> and \f$y\f$ of length
+     * <code>m</code> if \f$A\f$ enters as it is stored, and the other
+     * way around if it enters (conjugate) transposed. If
+     * <code>beta</code> is zero, \f$y\f$ need not be initialised.
+     *
+     * Every element of \f$A\f$ is read exactly once and in storage
+     * order: as a vectorised dot product of a row of \f$A\f$ with
+     * \f$x\f$, or for the transposed forms as a vectorised update of
+     * \f$y\f$ by a row of \f$A\f$. Products larger than
+     * <code>gemv_threshold ()</code> are split into blocks of rows
+     * (columns for the transposed forms) that are computed
+     * concurrently by the threads of <code>ThreadPool::instance
+     * ()</code>; each element of \f$y\f$ is computed by one thread
+     * only, so the result does not depend on the number of threads.
+     */
+    template <typename ValueType>
+      void gemv (const Operation    op_a,
+		 const unsigned int m,
+		 const unsigned int n,
+		 const ValueType    alpha,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 const ValueType   *x,
+		 const ValueType    beta,
+		 ValueType         *y);
+
+    /**
+     * Return the size of a product, counted in elements \f$mn\f$ of
+     * \f$A\f$, from which on <code>gemv</code> runs in parallel.
+     */
+    std::size_t gemv_threshold ();
+
+    /**
+     * Set the size of a product, counted in elements \f$mn\f$ of
+     * \f$A\f$, from which on <code>gemv</code> runs in parallel.
+     */
+    void set_gemv_threshold (const std::size_t n_elements);
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_gemv_h */
@@ -0,0 +1,151 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+#include <vector>
+
+#ifndef __ewalena_hermitian_eigensolver_h
+#define __ewalena_hermitian_eigensolver_h
+
+#include <ewalena/base/matrix.h>
+
+namespace ewalena
+{
+
+  /**
+   * All eigenvalues, and optionally all eigenvectors, of a dense
+   * Hermitian (for real value types, symmetric) matrix \f$A\f$, so
+   * that \f$A=Q\Lambda Q^H\f$ with \f$Q\f$ unitary and \f$\Lambda\f$
+   * real. The eigenvalues are sorted in ascending order and column
+   * \f$j\f$ of \f$Q\f$ is the eigenvector of eigenvalue \f$j\f$.
+   *
+   * The matrix is first reduced to real symmetric tridiagonal form
+   * \f$T=Q^HAQ\f$ by Householder reflections. These are found a
+   * panel of columns at a time, and the rest of the matrix is
+   * updated once per panel by <code>blas::gemm</code>, so that most
+   * of the work is done in matrix-matrix products. The eigenvalues of
+   * \f$T\f$ alone are found by the QL method. With the eigenvectors,
+   * \f$T\f$ is split into two halves coupled by a rank-one term,
+   * which are solved recursively and merged by the secular equation
+   * (Cuppen's divide and conquer method), again with most of the
+   * work in <code>blas::gemm</code>. Finally the reflections are
+   * applied to the eigenvectors of \f$T\f$ in blocks.
+   *
+   * Only the upper triangle of \f$A\f$ is read.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class HermitianEigensolver
+    {
+    public:
+
+    /**
+     * Constructor - the eigensystem of a matrix of size zero.
+     */
+    HermitianEigensolver ();
+
+    /**
+     * Initialize with the eigensystem of the matrix <code>M</code>.
+     */
+    explicit HermitianEigensolver (const Matrix<ValueType> &M,
+				   const bool               compute_eigenvectors = true);
+
+    /**
+     * Compute the eigenvalues of the square matrix <code>M</code>,
+     * and its eigenvectors if <code>compute_eigenvectors</code> is
+     * true, replacing any previous eigensystem.
+     */
+    void compute (const Matrix<ValueType> &M,
+		  const bool               compute_eigenvectors = true);
+
+    /**
+     * Return the number of rows (and columns) of the matrix.
+     */
+    unsigned int size () const;
+
+    /**
+     * Return the eigenvalues in ascending order.
+     */
+    const std::vector<double>& eigenvalues () const;
+
+    /**
+     * Return the unitary matrix whose columns are the eigenvectors,
+     * in the order of the eigenvalues. It is empty if the
+     * eigenvectors were not computed.
+     */
+    const Matrix<ValueType>& eigenvectors () const;
+
+    private:
+
+    /**
+     * Internal reference to the eigenvalues.
+     */
+    std::vector<double> __eigenvalues;
+
+    /**
+     * Internal reference to the eigenvectors.
+     */
+    Matrix<ValueType> __eigenvectors;
+
+    }; /* HermitianEigensolver */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    HermitianEigensolver<ValueType>::size () const
+    {
+      return __eigenvalues.size ();
+    }
+
+  template <typename ValueType>
+    inline
+    const std::vector<double>& 
+    HermitianEigensolver<ValueType>::eigenvalues () const
+    {
+      return __eigenvalues;
+    }
+
+  template <typename ValueType>
+    inline
+    const Matrix<ValueType>& 
+    HermitianEigensolver<ValueType>::eigenvectors () const
+    {
+      return __eigenvectors;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_hermitian_eigensolver_h */
@@ -0,0 +1,109 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <complex>
+
+#ifndef __ewalena_householder_h
+#define __ewalena_householder_h
+
+#include <ewalena/lac/gemm.h>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    /**
+     * Find the Householder reflector \f$H=I-\tau vv^H\f$, with
+     * \f$v=(1,x')\f$, for which \f$H^H(\alpha,x)=(\beta,0)\f$ with
+     * \f$\beta\f$ real. The vector \f$x\f$ is of length
+     * <code>n</code>. On return <code>alpha</code> is overwritten by
+     * \f$\beta\f$ and <code>x</code> by the tail \f$x'\f$ of
+     * \f$v\f$, and \f$\tau\f$ is returned. If \f$x\f$ is zero and
+     * \f$\alpha\f$ real, \f$\tau\f$ is zero and \f$H\f$ the
+     * identity.
+     */
+    template <typename ValueType>
+      ValueType householder (const unsigned int  n,
+			     ValueType          &alpha,
+			     ValueType          *x);
+
+    /**
+     * Form the upper triangular factor \f$T\f$ of the compact WY
+     * representation \f$H_0H_1\cdots H_{k-1}=I-VTV^H\f$ of
+     * <code>k</code> reflectors \f$H_j=I-\tau_jv_jv_j^H\f$. The
+     * vectors \f$v_j\f$ are the <i>columns</i> of the
+     * <code>m</code>\f$\times\f$<code>k</code> array \f$V\f$, column
+     * \f$j\f$ starting at <code>V+j*ldv</code>, zeros and leading
+     * ones included. \f$T\f$ is written as a row-major
+     * <code>k</code>\f$\times\f$<code>k</code> array, zeros below
+     * the diagonal included.
+     */
+    template <typename ValueType>
+      void householder_factor (const unsigned int  m,
+			       const unsigned int  k,
+			       const ValueType    *V,
+			       const unsigned int  ldv,
+			       const ValueType    *tau,
+			       ValueType          *T,
+			       const unsigned int  ldt);
+
+    /**
+     * Overwrite the row-major <code>m</code>\f$\times\f$<code>n</code>
+     * array \f$B\f$ by \f$(I-V\,op(T)V^H)B\f$, that is by
+     * \f$H_0\cdots H_{k-1}B\f$ if <code>op_t</code> is
+     * <code>no_transpose</code> and by \f$H_{k-1}^H\cdots
+     * H_0^HB\f$ if it is <code>conjugate_transpose</code>, with
+     * \f$V\f$ and \f$T\f$ laid out as by
+     * <code>householder_factor</code>.
+     *
+     * All of the work is done by three calls to <code>gemm</code>,
+     * which is what makes blocks of reflectors worth forming.
+     */
+    template <typename ValueType>
+      void householder_apply (const Operation     op_t,
+			      const unsigned int  m,
+			      const unsigned int  n,
+			      const unsigned int  k,
+			      const ValueType    *V,
+			      const unsigned int  ldv,
+			      const ValueType    *T,
+			      const unsigned int  ldt,
+			      ValueType          *B,
+			      const unsigned int  ldb);
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_householder_h */
@@ -0,0 +1,223 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#ifndef __ewalena_kronecker_operator_h
+#define __ewalena_kronecker_operator_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+
+namespace ewalena
+{
+
+  /**
+   * A sum of Kronecker products of small square matrices, one per
+   * mode of a tensor-product space,
+   * \f[
+   *   H = \sum_t c_t\,A^{(t)}_0\otimes A^{(t)}_1\otimes\dots\otimes A^{(t)}_{K-1},
+   * \f]
+   * such as a spin-chain Hamiltonian built from local operators. Mode
+   * 0 varies slowest: the index of a vector element is \f$\sum_k
+   * i_k\prod_{j>k}d_j\f$.
+   *
+   * Only the factors are stored, and modes a term leaves out are the
+   * identity. The product with a vector applies the factors of a
+   * term one mode at a time: seen as an array of size
+   * \f$l\times d_k\times r\f$, the vector is multiplied by
+   * \f$A_k\f$ along its middle index by <code>blas::gemm</code>, for
+   * \f$n d_k\f$ multiply-adds on \f$n\f$ elements. A term that acts
+   * on a few modes thus costs a few passes over the vector, whatever
+   * the number of modes.
+   *
+   * With a member <code>vmult (y, x)</code> it can be handed to the
+   * iterative solvers and eigensolvers of the library.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class KroneckerOperator
+    {
+    public:
+
+    /**
+     * The type of the elements of this operator.
+     */
+    typedef ValueType value_type;
+
+    /**
+     * Constructor - the zero operator on the product of spaces of
+     * dimensions <code>dimensions</code>.
+     */
+    explicit KroneckerOperator (const std::vector<unsigned int> &dimensions);
+
+    /**
+     * Add the term \f$cA_0\otimes\dots\otimes A_{K-1}\f$, with
+     * <code>factors[k]</code> of size \f$d_k\times d_k\f$.
+     */
+    void add_term (const std::vector<Matrix<ValueType>> &factors,
+		   const ValueType                       coefficient = ValueType (1));
+
+    /**
+     * Add the term that is <code>factors[i]</code> on the mode
+     * <code>modes[i]</code> and the identity on all others, times
+     * <code>coefficient</code>. The modes must differ.
+     */
+    void add_term (const std::vector<unsigned int>      &modes,
+		   const std::vector<Matrix<ValueType>> &factors,
+		   const ValueType                       coefficient = ValueType (1));
+
+    /**
+     * Return the number of modes.
+     */
+    unsigned int n_modes () const;
+
+    /**
+     * Return the dimension of the mode <code>k</code>.
+     */
+    unsigned int dimension (const unsigned int k) const;
+
+    /**
+     * Return the number of rows (and columns) of this operator, the
+     * product of the dimensions.
+     */
+    unsigned int size () const;
+
+    /**
+     * Return the number of terms.
+     */
+    unsigned int n_terms () const;
+
+    /**
+     * Compute \f$y=Hx\f$. A term with more than one factor needs a
+     * workspace for its intermediate products, which this allocates.
+     */
+    void vmult (Vector<ValueType>       &y,
+		const Vector<ValueType> &x) const;
+
+    /**
+     * Compute \f$y=Hx\f$ with the intermediate products in
+     * <code>work</code>, which is enlarged to twice the size of this
+     * operator if need be and can be kept by a caller that applies
+     * the operator many times.
+     */
+    void vmult (Vector<ValueType>       &y,
+		const Vector<ValueType> &x,
+		std::vector<ValueType>  &work) const;
+
+    private:
+
+    /**
+     * A term: its coefficient, the modes it does not leave alone in
+     * increasing order, and their factors stored row after row, one
+     * after the other.
+     */
+    struct Term
+    {
+      ValueType                 coefficient;
+      std::vector<unsigned int> modes;
+      std::vector<std::size_t>  offsets;
+      std::vector<ValueType>    values;
+    };
+
+    /**
+     * Compute \f$y=\alpha(I\otimes A\otimes I)x+\beta y\f$ with
+     * <code>A</code> on the mode <code>k</code>.
+     */
+    void mode_product (const unsigned int  k,
+		       const ValueType    *A,
+		       const ValueType     alpha,
+		       const ValueType    *x,
+		       const ValueType     beta,
+		       ValueType          *y) const;
+
+    /**
+     * Internal reference to the dimensions of the modes.
+     */
+    std::vector<unsigned int> __dimensions;
+
+    /**
+     * Internal reference to the product of the dimensions of the
+     * modes before (after) every mode.
+     */
+    std::vector<unsigned int> __left;
+    std::vector<unsigned int> __right;
+
+    /**
+     * Internal reference to the terms.
+     */
+    std::vector<Term> __terms;
+
+    }; /* KroneckerOperator */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    KroneckerOperator<ValueType>::n_modes () const
+    {
+      return __dimensions.size ();
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    KroneckerOperator<ValueType>::dimension (const unsigned int k) const
+    {
+      assert (k < __dimensions.size ());
+      return __dimensions[k];
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    KroneckerOperator<ValueType>::size () const
+    {
+      return __left.back ()*__dimensions.back ();
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    KroneckerOperator<ValueType>::n_terms () const
+    {
+      return __terms.size ();
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_kronecker_operator_h */
@@ -0,0 +1,104 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <functional>
+
+#ifndef __ewalena_linear_operator_h
+#define __ewalena_linear_operator_h
+
+#include <ewalena/base/vector.h>
+
+namespace ewalena
+{
+
+  /**
+   * A linear operator given by a function that computes its product
+   * with a vector, so that an operator that is never stored as a
+   * matrix can be handed to the solvers. The solvers accept any
+   * object with a member <code>vmult (y, x)</code> that computes
+   * \f$y=Ax\f$, which <code>Matrix</code>, <code>SparseMatrix</code>
+   * and <code>SellMatrix</code> have too.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class LinearOperator
+    {
+    public:
+
+    /**
+     * The type of function that computes \f$y=Ax\f$.
+     */
+    typedef std::function<void (Vector<ValueType>&, const Vector<ValueType>&)> Function;
+
+    /**
+     * Initialize with the function <code>f</code> computing
+     * \f$y=Ax\f$ as <code>f (y, x)</code>.
+     */
+    explicit LinearOperator (const Function &f);
+
+    /**
+     * Compute \f$y=Ax\f$.
+     */
+    void vmult (Vector<ValueType>       &y,
+		const Vector<ValueType> &x) const;
+
+    private:
+
+    /**
+     * Internal reference to the function computing the product.
+     */
+    Function function;
+
+    }; /* LinearOperator */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    LinearOperator<ValueType>::LinearOperator (const Function &f)
+    :
+    function (f)
+    {}
+
+  template <typename ValueType>
+    inline
+    void
+    LinearOperator<ValueType>::vmult (Vector<ValueType>       &y,
+				      const Vector<ValueType> &x) const
+    {
+      function (y, x);
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_linear_operator_h */
@@ -0,0 +1,190 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+#include <vector>
+
+#ifndef __ewalena_lu_factorization_h
+#define __ewalena_lu_factorization_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+
+namespace ewalena
+{
+
+  /**
+   * The LU factorization with partial pivoting \f$PA=LU\f$ of a square
+   * matrix \f$A\f$, where \f$P\f$ is a permutation, \f$L\f$ is unit
+   * lower triangular and \f$U\f$ is upper triangular.
+   *
+   * The factorization is right-looking and blocked: a panel of
+   * columns is factorized at a time, after which the rows of \f$U\f$
+   * to its right are found by a triangular solve and the trailing
+   * submatrix is updated by a single <code>blas::gemm</code>. Most of
+   * the work thus runs at the speed, and on the threads, of the
+   * matrix-matrix product.
+   *
+   * A matrix is factorized once, after which the factors can be used
+   * for any number of solves, eg. with a different right-hand side at
+   * each time step.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class LUFactorization
+    {
+    public:
+
+    /**
+     * Constructor - the factorization of a matrix of size zero.
+     */
+    LUFactorization ();
+
+    /**
+     * Initialize with the factorization of the square matrix
+     * <code>M</code>.
+     */
+    explicit LUFactorization (const Matrix<ValueType> &M);
+
+    /**
+     * Compute the factorization of the square matrix <code>M</code>,
+     * replacing any previous factorization.
+     */
+    void factorize (const Matrix<ValueType> &M);
+
+    /**
+     * Return the number of rows (and columns) of the factorized
+     * matrix.
+     */
+    unsigned int size () const;
+
+    /**
+     * Return <code>true</code> if a pivot of the factorization was
+     * exactly zero, in which case the matrix is singular and can not
+     * be solved with.
+     */
+    bool is_singular () const;
+
+    /**
+     * Return the determinant of the factorized matrix.
+     */
+    ValueType determinant () const;
+
+    /**
+     * Overwrite the vector <code>b</code> with the solution of
+     * \f$Ax=b\f$.
+     */
+    void solve (Vector<ValueType> &b) const;
+
+    /**
+     * Overwrite each column of the matrix <code>B</code> with the
+     * solution of \f$Ax=b\f$ for that column as right-hand side.
+     */
+    void solve (Matrix<ValueType> &B) const;
+
+    /**
+     * Make <code>M</code> the inverse of the factorized matrix.
+     */
+    void invert (Matrix<ValueType> &M) const;
+
+    /**
+     * Return the factors, \f$U\f$ on and above the diagonal and
+     * \f$L\f$ without its unit diagonal below it.
+     */
+    const Matrix<ValueType>& factors () const;
+
+    /**
+     * Return the pivots: row <code>i</code> was exchanged with row
+     * <code>pivots ()[i]</code> when column <code>i</code> was
+     * eliminated.
+     */
+    const std::vector<unsigned int>& pivots () const;
+
+    private:
+
+    /**
+     * Internal reference to the factors of the matrix, stored in
+     * place of it.
+     */
+    Matrix<ValueType> __factors;
+
+    /**
+     * Internal reference to the row exchanges.
+     */
+    std::vector<unsigned int> __pivots;
+
+    /**
+     * Internal reference to whether a zero pivot was met.
+     */
+    bool __is_singular;
+
+    }; /* LUFactorization */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    LUFactorization<ValueType>::size () const
+    {
+      return __factors.n_rows ();
+    }
+
+  template <typename ValueType>
+    inline
+    bool
+    LUFactorization<ValueType>::is_singular () const
+    {
+      return __is_singular;
+    }
+
+  template <typename ValueType>
+    inline
+    const Matrix<ValueType>& 
+    LUFactorization<ValueType>::factors () const
+    {
+      return __factors;
+    }
+
+  template <typename ValueType>
+    inline
+    const std::vector<unsigned int>& 
+    LUFactorization<ValueType>::pivots () const
+    {
+      return __pivots;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_lu_factorization_h */
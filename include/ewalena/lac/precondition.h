@@ -0,0 +1,480 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#ifndef __ewalena_precondition_h
+#define __ewalena_precondition_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/sparse_matrix.h>
+
+namespace ewalena
+{
+
+  /**
+   * The preconditioner that does nothing. Preconditioners are given
+   * to the solvers as objects with a member <code>vmult (dst,
+   * src)</code> that applies the inverse of the preconditioner,
+   * \f$dst=P^{-1}src\f$.
+   *
+   * \ingroup lac
+   */
+  class PreconditionIdentity
+  {
+  public:
+
+    /**
+     * Apply the preconditioner: <code>dst = src</code>.
+     */
+    template <typename ValueType>
+      void vmult (Vector<ValueType>       &dst,
+		  const Vector<ValueType> &src) const;
+
+  }; /* PreconditionIdentity */
+
+  /**
+   * The Jacobi preconditioner, \f$P=D/\omega\f$ with the diagonal
+   * \f$D\f$ of the matrix. It only depends on the values of the
+   * matrix, so that a change of them needs <code>initialize</code>
+   * again and nothing else.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class PreconditionJacobi
+    {
+    public:
+
+    /**
+     * Set up the preconditioner for the dense matrix <code>A</code>
+     * with the relaxation factor <code>omega</code>.
+     */
+    void initialize (const Matrix<ValueType> &A,
+		     const double             omega = 1.);
+
+    /**
+     * Same as above, for a sparse matrix.
+     */
+    void initialize (const SparseMatrix<ValueType> &A,
+		     const double                   omega = 1.);
+
+    /**
+     * Apply the preconditioner: \f$dst=\omega D^{-1}src\f$.
+     */
+    void vmult (Vector<ValueType>       &dst,
+		const Vector<ValueType> &src) const;
+
+    private:
+
+    /**
+     * Internal reference to \f$\omega D^{-1}\f$.
+     */
+    Vector<ValueType> __inverse_diagonal;
+
+    }; /* PreconditionJacobi */
+
+  /**
+   * The block-Jacobi preconditioner: the matrix without the elements
+   * outside of the diagonal blocks of <code>block_size</code> rows
+   * and columns (the last block may be smaller), each block inverted
+   * with <code>Matrix::invert</code>, which for blocks of up to eight
+   * rows is unrolled. It only depends on the values of the matrix.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class PreconditionBlockJacobi
+    {
+    public:
+
+    /**
+     * Set up the preconditioner for the dense matrix <code>A</code>
+     * with blocks of <code>block_size</code> rows.
+     */
+    void initialize (const Matrix<ValueType> &A,
+		     const unsigned int       block_size);
+
+    /**
+     * Same as above, for a sparse matrix.
+     */
+    void initialize (const SparseMatrix<ValueType> &A,
+		     const unsigned int             block_size);
+
+    /**
+     * Apply the preconditioner: every block of <code>dst</code> is
+     * the inverse of its block of the matrix times that of
+     * <code>src</code>.
+     */
+    void vmult (Vector<ValueType>       &dst,
+		const Vector<ValueType> &src) const;
+
+    private:
+
+    /**
+     * Invert the diagonal blocks set up in <code>__inverses</code>.
+     */
+    void invert_blocks ();
+
+    /**
+     * Internal reference to the number of rows.
+     */
+    unsigned int __n_rows;
+
+    /**
+     * Internal reference to the number of rows of a block.
+     */
+    unsigned int __block_size;
+
+    /**
+     * Internal reference to the inverses of the blocks.
+     */
+    std::vector<Matrix<ValueType>> __inverses;
+
+    }; /* PreconditionBlockJacobi */
+
+  namespace internal
+  {
+
+    /**
+     * A level schedule for the solution of a sparse triangular
+     * system: the rows are grouped into levels such that a row only
+     * depends on rows of earlier levels, so that the rows of one
+     * level can be worked on at the same time.
+     *
+     * \ingroup lac
+     */
+    class LevelSchedule
+    {
+    public:
+
+      /**
+       * Set up the schedule of the lower (upper) triangle of the
+       * sparsity pattern of the square matrix <code>A</code>, a
+       * SparseMatrix; elements of the other triangle and the
+       * diagonal are ignored.
+       */
+      template <typename MatrixType>
+	void initialize (const MatrixType &A,
+			 const bool        lower);
+
+      /**
+       * Return the number of levels.
+       */
+      unsigned int n_levels () const;
+
+      /**
+       * Call <code>f (i)</code> for every row <code>i</code>, level by
+       * level, distributing the rows of a level over the threads of
+       * <code>ThreadPool::instance ()</code> if there are enough of
+       * them.
+       */
+      template <typename Function>
+	void run (const Function &f) const;
+
+    private:
+
+      /**
+       * Internal reference to the first row of every level in
+       * <code>__rows</code>, followed by the number of rows.
+       */
+      std::vector<unsigned int> __level_start;
+
+      /**
+       * Internal reference to the rows, level after level.
+       */
+      std::vector<unsigned int> __rows;
+
+    }; /* LevelSchedule */
+
+  } /* namespace internal */
+
+  /**
+   * The symmetric successive over-relaxation (SSOR) preconditioner
+   * of a sparse matrix \f$A=L+D+U\f$,
+   * \f[
+   *   P = \frac{\omega}{2-\omega}\left(\frac{D}{\omega}+L\right)D^{-1}
+   *       \left(\frac{D}{\omega}+U\right),
+   * \f]
+   * Hermitian if \f$A\f$ is. Both triangular sweeps are level
+   * scheduled, see <code>internal::LevelSchedule</code>, and give the
+   * same result as sequential sweeps.
+   *
+   * The matrix is referred to, and must outlive the
+   * preconditioner. The schedules only depend on its sparsity
+   * pattern, so that after a change of values
+   * <code>refactorize</code> is enough.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class PreconditionSSOR
+    {
+    public:
+
+    /**
+     * Set up the preconditioner for the matrix <code>A</code> with
+     * the relaxation factor <code>omega</code> in (0, 2).
+     */
+    void initialize (const SparseMatrix<ValueType> &A,
+		     const double                   omega = 1.);
+
+    /**
+     * Take the new values of the matrix given to
+     * <code>initialize</code>, whose sparsity pattern must not have
+     * changed.
+     */
+    void refactorize ();
+
+    /**
+     * Apply the preconditioner: \f$dst=P^{-1}src\f$.
+     */
+    void vmult (Vector<ValueType>       &dst,
+		const Vector<ValueType> &src) const;
+
+    private:
+
+    /**
+     * Internal reference to the matrix.
+     */
+    const SparseMatrix<ValueType> *__matrix;
+
+    /**
+     * Internal reference to the relaxation factor.
+     */
+    double __omega;
+
+    /**
+     * Internal reference to the diagonal of the matrix.
+     */
+    std::vector<ValueType> __diagonal;
+
+    /**
+     * Internal reference to the schedules of the lower and upper
+     * triangle.
+     */
+    internal::LevelSchedule __lower, __upper;
+
+    }; /* PreconditionSSOR */
+
+  /**
+   * The incomplete LU factorization of a sparse matrix, \f$P=LU\f$
+   * with a unit lower triangular \f$L\f$ and upper triangular
+   * \f$U\f$, whose elements are those of a sparsity pattern only:
+   * the pattern of the matrix for ILU(0), or one that follows the
+   * values of the factors for ILUT, which drops elements smaller than
+   * a threshold relative to their row of the matrix and keeps at most
+   * a number of the largest in every row of \f$L\f$ and \f$U\f$
+   * beyond those of the matrix.
+   *
+   * The factors are stored row by row as a single sparse matrix, and
+   * both triangular solves of <code>vmult</code> are level scheduled,
+   * see <code>internal::LevelSchedule</code>. The pattern and the
+   * schedules are kept, so that a matrix with new values but the
+   * same pattern is factorized again on them by
+   * <code>refactorize</code>, in parallel over the rows of every
+   * level of \f$L\f$.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class PreconditionILU
+    {
+    public:
+
+    /**
+     * Set up ILU(0) of the square matrix <code>A</code>.
+     */
+    void initialize (const SparseMatrix<ValueType> &A);
+
+    /**
+     * Set up ILUT of the square matrix <code>A</code>: elements of
+     * the factors smaller than <code>threshold</code> times the norm
+     * of their row of <code>A</code> are dropped, and at most
+     * <code>fill</code> elements more than <code>A</code> has are
+     * kept in every row of each factor.
+     */
+    void initialize (const SparseMatrix<ValueType> &A,
+		     const double                   threshold,
+		     const unsigned int             fill);
+
+    /**
+     * Factorize the matrix <code>A</code> again on the sparsity
+     * pattern of the factors. Elements of <code>A</code> outside of
+     * it are ignored.
+     */
+    void refactorize (const SparseMatrix<ValueType> &A);
+
+    /**
+     * Return the number of elements of the factors.
+     */
+    std::size_t n_nonzero_elements () const;
+
+    /**
+     * Apply the preconditioner: \f$dst=U^{-1}L^{-1}src\f$.
+     */
+    void vmult (Vector<ValueType>       &dst,
+		const Vector<ValueType> &src) const;
+
+    private:
+
+    /**
+     * Set up the positions of the diagonal and the schedules of the
+     * pattern of the factors.
+     */
+    void setup_pattern ();
+
+    /**
+     * Internal reference to the factors, as one matrix: the elements
+     * of \f$L\f$ but its unit diagonal, then those of \f$U\f$.
+     */
+    SparseMatrix<ValueType> __factors;
+
+    /**
+     * Internal reference to the position of the diagonal in every
+     * row of the factors, and to the inverse of the diagonal.
+     */
+    std::vector<unsigned int> __diagonal;
+    std::vector<ValueType>    __inverse_diagonal;
+
+    /**
+     * Internal reference to the schedules of \f$L\f$ and \f$U\f$.
+     */
+    internal::LevelSchedule __lower, __upper;
+
+    }; /* PreconditionILU */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    void
+    PreconditionIdentity::vmult (Vector<ValueType>       &dst,
+				 const Vector<ValueType> &src) const
+    {
+      dst = src;
+    }
+
+  namespace internal
+  {
+
+    template <typename MatrixType>
+      inline
+      void
+      LevelSchedule::initialize (const MatrixType &A,
+				 const bool        lower)
+      {
+	const unsigned int n = A.n_rows ();
+
+	/* A row comes one level after the latest of the rows it
+	   depends on, found in the order the rows are solved in. */
+	std::vector<unsigned int> level (n, 0);
+	unsigned int n_levels = 0;
+	for (unsigned int r=0; r<n; ++r)
+	  {
+	    const unsigned int  i       = lower ? r : n-1-r;
+	    const unsigned int *columns = A.columns (i);
+
+	    unsigned int l = 0;
+	    for (unsigned int k=0; k<A.row_length (i); ++k)
+	      if (lower ? (columns[k] < i) : (columns[k] > i))
+		l = std::max (l, level[columns[k]]+1);
+
+	    level[i] = l;
+	    n_levels = std::max (n_levels, l+1);
+	  }
+
+	/* Sort the rows by level, keeping their order within one. */
+	__level_start.assign (n_levels+1, 0);
+	for (unsigned int i=0; i<n; ++i)
+	  ++__level_start[level[i]+1];
+	for (unsigned int l=0; l<n_levels; ++l)
+	  __level_start[l+1] += __level_start[l];
+
+	__rows.resize (n);
+	std::vector<unsigned int> next (__level_start.begin (), __level_start.end ()-1);
+	for (unsigned int r=0; r<n; ++r)
+	  {
+	    const unsigned int i = lower ? r : n-1-r;
+	    __rows[next[level[i]]++] = i;
+	  }
+      }
+
+    inline
+    unsigned int
+    LevelSchedule::n_levels () const
+    {
+      return __level_start.empty () ? 0 : __level_start.size ()-1;
+    }
+
+    template <typename Function>
+      inline
+      void
+      LevelSchedule::run (const Function &f) const
+      {
+	/* Rows handed to a thread at a time; smaller levels are not
+	   worth waking the pool for. */
+	const unsigned int chunk = 256;
+
+	for (unsigned int level=0; level<n_levels (); ++level)
+	  {
+	    const unsigned int begin = __level_start[level];
+	    const unsigned int end   = __level_start[level+1];
+
+	    ThreadPool::instance ().run ((end-begin+chunk-1)/chunk,
+					 [&] (const unsigned int task)
+					 {
+					   const unsigned int last = std::min (end, begin+(task+1)*chunk);
+					   for (unsigned int r=begin+task*chunk; r<last; ++r)
+					     f (__rows[r]);
+					 });
+	  }
+      }
+
+  } /* namespace internal */
+
+  template <typename ValueType>
+    inline
+    std::size_t
+    PreconditionILU<ValueType>::n_nonzero_elements () const
+    {
+      return __factors.n_nonzero_elements ();
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_precondition_h */
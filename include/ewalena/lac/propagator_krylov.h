@@ -0,0 +1,594 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#ifndef __ewalena_propagator_krylov_h
+#define __ewalena_propagator_krylov_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+
+namespace ewalena
+{
+
+  /**
+   * The propagation \f$v\leftarrow e^{-iHt}v\f$ of a state by a
+   * Hermitian operator \f$H\f$, which is any object with a member
+   * <code>vmult (y, x)</code> that computes \f$y=Hx\f$, see
+   * <code>LinearOperator</code>.
+   *
+   * By default a Krylov method is used. A Lanczos basis \f$V_m\f$ of
+   * the Krylov space of \f$v\f$ is built, every new vector
+   * orthogonalised against all others as in the Arnoldi method, and
+   * \f$e^{-iH\tau}v\approx\|v\|V_me^{-iT_m\tau}e_1\f$ with the
+   * projected tridiagonal matrix \f$T_m\f$. The error of a step is
+   * estimated by \f$\|v\|\beta_m|(e^{-iT_m\tau}e_1)_m|\f$. The basis
+   * grows until this is below the share \f$\epsilon\tau/t\f$ of the
+   * tolerance, so that the whole propagation is accurate to
+   * \f$\epsilon\|v\|\f$. If <code>n_krylov</code> vectors are not
+   * enough, the step is shortened instead; after a step, the next
+   * is made as long as the error of this one suggests. The step size
+   * is kept from one call to the next, and so is the workspace, so
+   * that a propagation in many short calls allocates nothing after
+   * the first.
+   *
+   * If bounds on the spectrum of \f$H\f$ are known and given with
+   * <code>set_spectral_bounds</code>, the Chebyshev expansion
+   * \f[
+   *   e^{-iHt} = e^{-ict}\left(J_0(rt) + 2\sum_{k\geq 1}(-i)^kJ_k(rt)
+   *   T_k\left(\frac{H-c}{r}\right)\right)
+   * \f]
+   * with the centre \f$c\f$ and half-width \f$r\f$ of the spectrum is
+   * used instead, for the whole time at once. The Bessel functions
+   * \f$J_k\f$ decay beyond \f$k\approx rt\f$, which is about the
+   * number of products with \f$H\f$ needed; no inner products are
+   * taken.
+   *
+   * \ingroup lac
+   */
+  class PropagatorKrylov
+  {
+  public:
+
+    /**
+     * Constructor. Take the tolerance on the error of a propagation,
+     * relative to the norm of the state, and the largest number of
+     * Krylov vectors.
+     */
+    explicit PropagatorKrylov (const double       tolerance = 1e-10,
+			       const unsigned int n_krylov  = 30);
+
+    /**
+     * Use the Chebyshev expansion for a spectrum of \f$H\f$ in
+     * [<code>lower</code>, <code>upper</code>] from now on. Bounds
+     * that are too tight make the expansion diverge.
+     */
+    void set_spectral_bounds (const double lower,
+			      const double upper);
+
+    /**
+     * Go back to the Krylov method.
+     */
+    void clear_spectral_bounds ();
+
+    /**
+     * Propagate <code>v</code> by the time <code>t</code>, which may
+     * be negative: \f$v\leftarrow e^{-iHt}v\f$.
+     */
+    template <typename MatrixType>
+      void propagate (const MatrixType                    &H,
+		      const double                         t,
+		      Vector<std::complex<double>>        &v);
+
+    /**
+     * Return the number of steps the last propagation took.
+     */
+    unsigned int n_steps () const;
+
+    /**
+     * Return the number of products with \f$H\f$ the last
+     * propagation took.
+     */
+    unsigned int n_products () const;
+
+    /**
+     * Return the size of the next step of the Krylov method.
+     */
+    double step_size () const;
+
+  private:
+
+    /**
+     * Propagate by the Krylov method.
+     */
+    template <typename MatrixType>
+      void propagate_krylov (const MatrixType                    &H,
+			     const double                         t,
+			     Vector<std::complex<double>>        &v);
+
+    /**
+     * Propagate by the Chebyshev expansion.
+     */
+    template <typename MatrixType>
+      void propagate_chebyshev (const MatrixType                    &H,
+				const double                         t,
+				Vector<std::complex<double>>        &v);
+
+    /**
+     * Make the basis hold at least <code>m</code> vectors of size
+     * <code>n</code>.
+     */
+    void reinit (const unsigned int m,
+		 const unsigned int n);
+
+    /**
+     * Find the eigensystem of the projected matrix of the first
+     * <code>m</code> basis vectors.
+     */
+    void project (const unsigned int m);
+
+    /**
+     * Set <code>coefficients</code> to \f$e^{-iT_m\tau}e_1\f$ from
+     * the eigensystem of the projected matrix, and return the
+     * estimate of the error of the step, relative to the norm of the
+     * state.
+     */
+    double exponentiate (const unsigned int m,
+			 const double       tau);
+
+    /**
+     * Set <code>J</code> to the Bessel functions \f$J_0(x)\f$ to
+     * \f$J_n(x)\f$, \f$x\geq 0\f$, by Miller's backward recurrence.
+     */
+    static void bessel (const double         x,
+			const unsigned int   n,
+			std::vector<double> &J);
+
+    /**
+     * Internal reference to the tolerance.
+     */
+    const double tolerance;
+
+    /**
+     * Internal reference to the largest number of Krylov vectors.
+     */
+    const unsigned int n_krylov;
+
+    /**
+     * Internal reference to whether the Chebyshev expansion is used,
+     * and the bounds of the spectrum it needs.
+     */
+    bool   chebyshev;
+    double lower, upper;
+
+    /**
+     * Internal reference to the number of steps and products of the
+     * last propagation, and to the next step size.
+     */
+    unsigned int steps, products;
+    double       step;
+
+    /**
+     * Internal workspace: the Krylov basis (the Chebyshev vectors)
+     * and the product of the operator with a basis vector.
+     */
+    std::vector<Vector<std::complex<double>>> basis;
+    Vector<std::complex<double>>              w;
+
+    /**
+     * Internal workspace: the diagonal and subdiagonal of the
+     * projected matrix, the matrix itself and its eigensystem, and
+     * the coefficients of a step in the basis.
+     */
+    std::vector<double>               alpha, beta;
+    Matrix<double>                    T;
+    HermitianEigensolver<double>      projected;
+    std::vector<std::complex<double>> coefficients;
+
+    /**
+     * Internal workspace: the Bessel functions of the expansion.
+     */
+    std::vector<double> J;
+
+  }; /* PropagatorKrylov */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  inline
+  PropagatorKrylov::PropagatorKrylov (const double       tolerance,
+				      const unsigned int n_krylov)
+    :
+    tolerance (tolerance),
+    n_krylov (n_krylov),
+    chebyshev (false),
+    lower (0.),
+    upper (0.),
+    steps (0),
+    products (0),
+    step (0.)
+  {
+    assert (tolerance > 0.);
+    assert (n_krylov >= 2);
+  }
+
+  inline
+  void
+  PropagatorKrylov::set_spectral_bounds (const double lower,
+					 const double upper)
+  {
+    assert (lower <= upper);
+
+    chebyshev   = true;
+    this->lower = lower;
+    this->upper = upper;
+  }
+
+  inline
+  void
+  PropagatorKrylov::clear_spectral_bounds ()
+  {
+    chebyshev = false;
+  }
+
+  inline
+  unsigned int
+  PropagatorKrylov::n_steps () const
+  {
+    return steps;
+  }
+
+  inline
+  unsigned int
+  PropagatorKrylov::n_products () const
+  {
+    return products;
+  }
+
+  inline
+  double
+  PropagatorKrylov::step_size () const
+  {
+    return step;
+  }
+
+  inline
+  void
+  PropagatorKrylov::reinit (const unsigned int m,
+			    const unsigned int n)
+  {
+    /* Vectors only reallocate if they grow. */
+    if (basis.size () < m)
+      basis.resize (m);
+
+    for (unsigned int i=0; i<m; ++i)
+      if (basis[i].size () != n)
+	basis[i].reinit (n, false);
+
+    if (w.size () != n)
+      w.reinit (n, false);
+  }
+
+  inline
+  void
+  PropagatorKrylov::project (const unsigned int m)
+  {
+    T.reinit (m, m);
+    for (unsigned int j=0; j<m; ++j)
+      {
+	T(j, j) = alpha[j];
+	if (j+1 < m)
+	  T(j, j+1) = T(j+1, j) = beta[j];
+      }
+
+    projected.compute (T);
+  }
+
+  inline
+  double
+  PropagatorKrylov::exponentiate (const unsigned int m,
+				  const double       tau)
+  {
+    /* exp(-i T tau) e_1 = Y exp(-i Theta tau) Y^T e_1. */
+    const std::vector<double> &theta = projected.eigenvalues ();
+    const Matrix<double>      &Y     = projected.eigenvectors ();
+
+    coefficients.assign (m, std::complex<double> (0.));
+    for (unsigned int l=0; l<m; ++l)
+      {
+	const std::complex<double> phase = std::polar (Y(0, l), -theta[l]*tau);
+	for (unsigned int j=0; j<m; ++j)
+	  coefficients[j] += Y(j, l)*phase;
+      }
+
+    return beta[m-1]*std::abs (coefficients[m-1]);
+  }
+
+  inline
+  void
+  PropagatorKrylov::bessel (const double         x,
+			    const unsigned int   n,
+			    std::vector<double> &J)
+  {
+    assert (x >= 0.);
+
+    J.assign (n+1, 0.);
+    if (x == 0.)
+      {
+	J[0] = 1.;
+	return;
+      }
+
+    /* Recur downwards from far enough above both n and x, where the
+       values are negligible, and normalise by J_0 + 2 sum J_2k = 1. */
+    unsigned int start = std::max<unsigned int> (n, std::ceil (x)) + 20;
+    start += std::sqrt (160.*start);
+    start += start % 2;
+
+    double above = 0., current = 1., sum = 0.;
+    for (unsigned int k=start; k>0; --k)
+      {
+	const double below = 2.*k/x*current - above;
+	above   = current;
+	current = below;
+
+	if (std::abs (current) > 1e250)
+	  {
+	    current *= 1e-250;
+	    above   *= 1e-250;
+	    sum     *= 1e-250;
+	    for (unsigned int i=k-1; i<=n; ++i)
+	      J[i] *= 1e-250;
+	  }
+
+	if (k-1 <= n)
+	  J[k-1] = current;
+	if ((k-1) % 2 == 0 && k > 1)
+	  sum += 2.*current;
+      }
+
+    sum += current;
+    for (unsigned int k=0; k<=n; ++k)
+      J[k] /= sum;
+  }
+
+  template <typename MatrixType>
+    inline
+    void
+    PropagatorKrylov::propagate (const MatrixType                    &H,
+				 const double                         t,
+				 Vector<std::complex<double>>        &v)
+    {
+      steps    = 0;
+      products = 0;
+
+      if (t == 0. || v.size () == 0)
+	return;
+
+      if (chebyshev)
+	propagate_chebyshev (H, t, v);
+      else
+	propagate_krylov (H, t, v);
+    }
+
+  template <typename MatrixType>
+    inline
+    void
+    PropagatorKrylov::propagate_krylov (const MatrixType                    &H,
+					const double                         t,
+					Vector<std::complex<double>>        &v)
+    {
+      const unsigned int n = v.size ();
+      const unsigned int m_max = std::min (n_krylov, n);
+      reinit (m_max+1, n);
+
+      const double direction = (t < 0.) ? -1. : 1.;
+      const double epsilon   = 100.*std::numeric_limits<double>::epsilon ();
+
+      double remaining = std::abs (t);
+      if (step <= 0.)
+	step = remaining;
+
+      while (remaining > 0.)
+	{
+	  const double norm = std::abs (v.l2_norm ());
+	  if (norm == 0.)
+	    return;
+
+	  basis[0].sadd (std::complex<double> (1./norm), v);
+
+	  double tau = std::min (step, remaining);
+	  const bool last_step = (tau == remaining);
+
+	  /* Extend the basis until the error of the step is small
+	     enough, or the basis spans an invariant subspace, on which
+	     the step is exact and may take the rest of the time. */
+	  alpha.clear ();
+	  beta.clear ();
+
+	  double       norm_estimate = 0.;
+	  double       error         = 0.;
+	  bool         accepted      = false;
+	  unsigned int m             = 0;
+
+	  for (unsigned int j=0; j<m_max; ++j)
+	    {
+	      H.vmult (w, basis[j]);
+	      ++products;
+
+	      double a = 0.;
+	      for (unsigned int pass=0; pass<2; ++pass)
+		for (unsigned int i=0; i<=j; ++i)
+		  {
+		    const std::complex<double> h = basis[i].dot (w);
+		    w.add (-h, basis[i]);
+		    if (i == j)
+		      a += std::real (h);
+		  }
+
+	      alpha.push_back (a);
+	      beta.push_back (std::abs (w.l2_norm ()));
+	      norm_estimate = std::max (norm_estimate, std::abs (a) + beta[j]);
+
+	      m = j+1;
+
+	      if (beta[j] <= epsilon*norm_estimate)
+		{
+		  beta[j]  = 0.;
+		  tau      = remaining;
+		  project (m);
+		  error    = exponentiate (m, direction*tau);
+		  accepted = true;
+		  break;
+		}
+
+	      basis[j+1].sadd (std::complex<double> (1./beta[j]), w);
+
+	      project (m);
+	      error = exponentiate (m, direction*tau);
+	      if (error <= tolerance*tau/std::abs (t))
+		{
+		  accepted = true;
+		  break;
+		}
+	    }
+
+	  /* The basis is full: shorten the step, the error of which
+	     goes as about tau^m. */
+	  bool shortened = false;
+	  while (!accepted)
+	    {
+	      tau  *= std::max (0.1, 0.9*std::pow (tolerance*tau/std::abs (t)/error, 1./m));
+	      error = exponentiate (m, direction*tau);
+
+	      shortened = true;
+	      accepted  = (error <= tolerance*tau/std::abs (t));
+	    }
+
+	  /* v = |v| V_m exp(-i T_m tau) e_1. */
+	  v.sadd (norm*coefficients[0], basis[0]);
+	  for (unsigned int j=1; j<m; ++j)
+	    v.add (norm*coefficients[j], basis[j]);
+
+	  remaining = (tau < remaining) ? remaining - tau : 0.;
+	  ++steps;
+
+	  /* The next step: as long as this error allows, at most
+	     twice this one. A last step cut short by the time left
+	     says nothing about the step size. */
+	  const double next = (error > 0.)
+	    ? tau*std::min (2., 0.9*std::pow (tolerance*tau/std::abs (t)/error, 1./m))
+	    : 2.*tau;
+
+	  step = (last_step && !shortened) ? std::max (step, next) : next;
+	}
+    }
+
+  template <typename MatrixType>
+    inline
+    void
+    PropagatorKrylov::propagate_chebyshev (const MatrixType                    &H,
+					   const double                         t,
+					   Vector<std::complex<double>>        &v)
+    {
+      const unsigned int n = v.size ();
+      reinit (3, n);
+
+      const double c = 0.5*(upper + lower);
+      const double r = 0.5*(upper - lower);
+      const double x = r*std::abs (t);
+
+      /* Enough Bessel functions that the last are negligible; they
+	 fall off faster than exponentially beyond x. */
+      unsigned int n_terms = std::ceil (x) + 20;
+      for (;;)
+	{
+	  bessel (x, n_terms, J);
+	  if (std::abs (J[n_terms]) < 1e-3*tolerance)
+	    break;
+	  n_terms *= 2;
+	}
+
+      while (n_terms > 0 && std::abs (J[n_terms]) < 1e-3*tolerance)
+	--n_terms;
+
+      /* (-i)^k J_k(rt), with J_k(-x) = (-1)^k J_k(x) for t < 0. */
+      const std::complex<double> minus_i (0., (t < 0.) ? 1. : -1.);
+
+      /* The Chebyshev vectors w_k = T_k((H-c)/r) v rotate through
+	 the first three basis vectors, and the sum builds up in v. */
+      Vector<std::complex<double>> *previous = &basis[0];
+      Vector<std::complex<double>> *current  = &basis[1];
+      Vector<std::complex<double>> *next     = &basis[2];
+
+      previous->sadd (std::complex<double> (1.), v);
+      v *= std::complex<double> (J[0]);
+
+      std::complex<double> phase (1.);
+      for (unsigned int k=1; k<=n_terms; ++k)
+	{
+	  /* w_1 = H~ w_0, w_k = 2 H~ w_{k-1} - w_{k-2}. */
+	  Vector<std::complex<double>> &w_k = (k == 1) ? *current : *next;
+	  const Vector<std::complex<double>> &w_1 = (k == 1) ? *previous : *current;
+
+	  H.vmult (w_k, w_1);
+	  ++products;
+
+	  const double scale = (k == 1) ? 1./r : 2./r;
+	  w_k *= std::complex<double> (scale);
+	  w_k.add (std::complex<double> (-scale*c), w_1);
+	  if (k > 1)
+	    w_k.add (std::complex<double> (-1.), *previous);
+
+	  phase *= minus_i;
+	  v.add (2.*phase*J[k], w_k);
+
+	  if (k > 1)
+	    {
+	      std::swap (previous, current);
+	      std::swap (current, next);
+	    }
+	}
+
+      v *= std::polar (1., -c*t);
+      steps = 1;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_propagator_krylov_h */
@@ -0,0 +1,220 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+#include <vector>
+
+#ifndef __ewalena_qr_factorization_h
+#define __ewalena_qr_factorization_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/gemm.h>
+
+namespace ewalena
+{
+
+  /**
+   * The Householder QR factorization \f$A=QR\f$ of an
+   * <code>m</code>\f$\times\f$<code>n</code> matrix \f$A\f$, where
+   * \f$Q=H_0H_1\cdots H_{k-1}\f$, \f$k=\min(m,n)\f$, is a product of
+   * Householder reflectors and \f$R\f$ is upper trapezoidal. Columns
+   * are not pivoted, so that a rank deficient \f$A\f$ shows as a zero
+   * on the diagonal of \f$R\f$.
+   *
+   * The factorization is blocked: the reflectors of a panel of
+   * columns are found one at a time, after which they are gathered
+   * into the compact WY form \f$I-VTV^H\f$ and applied to the
+   * columns right of the panel by <code>blas::gemm</code>. The
+   * triangular factors \f$T\f$ are kept, so that \f$Q\f$ and
+   * \f$Q^H\f$ are applied a block of reflectors at a time as well.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class QRFactorization
+    {
+    public:
+
+    /**
+     * Constructor - the factorization of a matrix of size zero.
+     */
+    QRFactorization ();
+
+    /**
+     * Initialize with the factorization of the matrix
+     * <code>M</code>.
+     */
+    explicit QRFactorization (const Matrix<ValueType> &M);
+
+    /**
+     * Compute the factorization of the matrix <code>M</code>,
+     * replacing any previous factorization.
+     */
+    void factorize (const Matrix<ValueType> &M);
+
+    /**
+     * Return the number of rows of the factorized matrix.
+     */
+    unsigned int n_rows () const;
+
+    /**
+     * Return the number of columns of the factorized matrix.
+     */
+    unsigned int n_cols () const;
+
+    /**
+     * Overwrite <code>B</code>, which has as many rows as the
+     * factorized matrix, by \f$QB\f$.
+     */
+    void apply_Q (Matrix<ValueType> &B) const;
+
+    /**
+     * Overwrite <code>b</code> by \f$Qb\f$.
+     */
+    void apply_Q (Vector<ValueType> &b) const;
+
+    /**
+     * Overwrite <code>B</code>, which has as many rows as the
+     * factorized matrix, by \f$Q^HB\f$.
+     */
+    void apply_QH (Matrix<ValueType> &B) const;
+
+    /**
+     * Overwrite <code>b</code> by \f$Q^Hb\f$.
+     */
+    void apply_QH (Vector<ValueType> &b) const;
+
+    /**
+     * Make <code>Q</code> the first \f$k\f$ columns of \f$Q\f$, the
+     * thin factor whose columns span the range of a full rank
+     * \f$A\f$.
+     */
+    void form_Q (Matrix<ValueType> &Q) const;
+
+    /**
+     * Make <code>R</code> the \f$k\times n\f$ upper trapezoidal
+     * factor.
+     */
+    void form_R (Matrix<ValueType> &R) const;
+
+    /**
+     * Make <code>x</code> the least-squares solution, which minimises
+     * \f$\|Ax-b\|_2\f$, of a factorized matrix with at least as many
+     * rows as columns and of full rank.
+     */
+    void solve (Vector<ValueType>       &x,
+		const Vector<ValueType> &b) const;
+
+    /**
+     * Make each column of <code>X</code> the least-squares solution
+     * for the corresponding column of <code>B</code> as right-hand
+     * side.
+     */
+    void solve (Matrix<ValueType>       &X,
+		const Matrix<ValueType> &B) const;
+
+    /**
+     * Return the factors, \f$R\f$ on and above the diagonal and the
+     * reflectors \f$v_j\f$ without their leading one below it.
+     */
+    const Matrix<ValueType>& factors () const;
+
+    private:
+
+    /**
+     * Overwrite the row-major array <code>B</code> of <code>n</code>
+     * columns and as many rows as the factorized matrix by
+     * \f$QB\f$, if <code>op</code> is <code>no_transpose</code>, or
+     * by \f$Q^HB\f$, if it is <code>conjugate_transpose</code>.
+     */
+    void apply (const blas::Operation op,
+		const unsigned int    n,
+		ValueType            *B,
+		const unsigned int    ldb) const;
+
+    /**
+     * Internal reference to the factors of the matrix, stored in
+     * place of it.
+     */
+    Matrix<ValueType> __factors;
+
+    /**
+     * Internal reference to the scalars \f$\tau_j\f$ of the
+     * reflectors.
+     */
+    std::vector<ValueType> __tau;
+
+    /**
+     * Internal reference to the triangular factors \f$T\f$ of the
+     * blocks of reflectors, one after the other.
+     */
+    std::vector<ValueType> __block_factors;
+
+    /**
+     * The tall-skinny factorization applies the factorizations of its
+     * blocks to parts of a larger array.
+     */
+    template <typename> friend class TSQRFactorization;
+
+    }; /* QRFactorization */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    QRFactorization<ValueType>::n_rows () const
+    {
+      return __factors.n_rows ();
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    QRFactorization<ValueType>::n_cols () const
+    {
+      return __factors.n_cols ();
+    }
+
+  template <typename ValueType>
+    inline
+    const Matrix<ValueType>& 
+    QRFactorization<ValueType>::factors () const
+    {
+      return __factors;
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_qr_factorization_h */
@@ -0,0 +1,255 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#ifndef __ewalena_sell_matrix_h
+#define __ewalena_sell_matrix_h
+
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include <ewalena/lac/vector_kernels.h>
+
+namespace ewalena
+{
+
+  /**
+   * A sparse matrix in sliced ELLPACK format with local sorting,
+   * SELL-<i>C</i>-\f$\sigma\f$. Its rows are cut into chunks of
+   * <i>C</i><code>=chunk_height</code> rows, and each chunk is stored
+   * as a dense array of <i>C</i> rows times the length of its longest
+   * row, column after column, with shorter rows padded by zeros. A
+   * column of a chunk then fills whole SIMD registers, so that a
+   * matrix-vector product runs in registers no matter how irregular
+   * the row lengths are, using the vector kernels of
+   * <code>blas</code> with gathers from \f$x\f$.
+   *
+   * To keep the padding small, rows are sorted by length within
+   * windows of \f$\sigma\f$ consecutive rows before they are cut into
+   * chunks; the wider the window, the less padding, and the more
+   * scattered the rows of a chunk are in \f$y\f$.
+   *
+   * A matrix in this format is converted from a
+   * <code>SparseMatrix</code> and is read only.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class SellMatrix
+    {
+    public:
+
+    /**
+     * The type of the elements of this matrix.
+     */
+    typedef ValueType value_type;
+
+    /**
+     * The number of rows in a chunk, <i>C</i>.
+     */
+    static const unsigned int chunk_height = blas::sell_chunk_height;
+
+    /**
+     * The number of rows sorted by length together, \f$\sigma\f$,
+     * unless asked otherwise.
+     */
+    static const unsigned int default_sigma = 32*chunk_height;
+
+    /**
+     * Constructor - a matrix of size zero.
+     */
+    SellMatrix ();
+
+    /**
+     * Initialize with the sparse matrix <code>M</code>, see
+     * <code>reinit</code>.
+     */
+    explicit SellMatrix (const SparseMatrix<ValueType> &M,
+			 const unsigned int             sigma = default_sigma);
+
+    /**
+     * Initialize a matrix of size
+     * <code>m</code>\f$\times\f$<code>n</code> from the list of
+     * elements <code>triplets</code>, see <code>reinit</code>.
+     */
+    SellMatrix (const unsigned int                                         m,
+		const unsigned int                                         n,
+		const std::vector<typename SparseMatrix<ValueType>::Triplet> &triplets,
+		const unsigned int                                         sigma = default_sigma);
+
+    /**
+     * Reinitialise this matrix with the sparse matrix
+     * <code>M</code>, sorting rows by length within windows of
+     * <code>sigma</code> rows, which is rounded up to a multiple of
+     * <code>chunk_height</code>. If <code>sigma</code> is one, rows
+     * are kept in their order.
+     */
+    void reinit (const SparseMatrix<ValueType> &M,
+		 const unsigned int             sigma = default_sigma);
+
+    /**
+     * Reinitialise this matrix to size
+     * <code>m</code>\f$\times\f$<code>n</code> with the elements
+     * <code>triplets</code>, with the same conventions as the sparse
+     * matrix of <code>SparseMatrix::reinit</code>, which this goes
+     * through.
+     */
+    void reinit (const unsigned int                                         m,
+		 const unsigned int                                         n,
+		 const std::vector<typename SparseMatrix<ValueType>::Triplet> &triplets,
+		 const unsigned int                                         sigma = default_sigma);
+
+    /**
+     * Return the number of rows this matrix has.
+     */
+    unsigned int n_rows () const;
+
+    /**
+     * Return the number of columns this matrix has.
+     */
+    unsigned int n_cols () const;
+
+    /**
+     * Return the number of elements of the sparse matrix this matrix
+     * was converted from.
+     */
+    std::size_t n_nonzero_elements () const;
+
+    /**
+     * Return the number of elements this matrix stores, padding
+     * included. The ratio to <code>n_nonzero_elements ()</code> is
+     * the overhead of this format.
+     */
+    std::size_t n_stored_elements () const;
+
+    /**
+     * Matrix-vector multiplication: \f$y=\alpha Mx+\beta y\f$. By
+     * default, <code>y</code> is overwritten by \f$Mx\f$.
+     *
+     * Large products are split into as many blocks of consecutive
+     * chunks as there are threads in <code>ThreadPool::instance
+     * ()</code>, each with about the same number of stored elements.
+     */
+    void vmult (Vector<ValueType>       &y,
+		const Vector<ValueType> &x,
+		const ValueType          alpha = ValueType (1),
+		const ValueType          beta  = ValueType (0)) const;
+
+    private:
+
+    /**
+     * Internal reference to this matrix row-size.
+     */
+    unsigned int __n_rows;
+
+    /**
+     * Internal reference to this matrix column-size.
+     */
+    unsigned int __n_cols;
+
+    /**
+     * Internal reference to the number of elements of the sparse
+     * matrix this matrix was converted from.
+     */
+    std::size_t __n_nonzero_elements;
+
+    /**
+     * Internal reference to the position of the first element of
+     * each chunk, followed by the number of elements stored.
+     */
+    std::vector<std::size_t> chunk_start;
+
+    /**
+     * Internal reference to the number of columns of each chunk, the
+     * length of its longest row.
+     */
+    std::vector<unsigned int> chunk_length;
+
+    /**
+     * Internal reference to the row of this matrix each row of each
+     * chunk holds, or <code>n_rows ()</code> for the rows that pad the
+     * last chunk.
+     */
+    std::vector<unsigned int> row_index;
+
+    /**
+     * Internal reference to the column of each element.
+     */
+    std::vector<unsigned int> column_index;
+
+    /**
+     * Internal reference to the value of each element.
+     */
+    std::vector<ValueType> data;
+
+    }; /* SellMatrix */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    SellMatrix<ValueType>::n_rows () const
+    {
+      return __n_rows;
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    SellMatrix<ValueType>::n_cols () const
+    {
+      return __n_cols;
+    }
+
+  template <typename ValueType>
+    inline
+    std::size_t
+    SellMatrix<ValueType>::n_nonzero_elements () const
+    {
+      return __n_nonzero_elements;
+    }
+
+  template <typename ValueType>
+    inline
+    std::size_t
+    SellMatrix<ValueType>::n_stored_elements () const
+    {
+      return column_index.size ();
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_sell_matrix_h */
@@ -0,0 +1,203 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+
+#ifndef __ewalena_solver_bicgstab_h
+#define __ewalena_solver_bicgstab_h
+
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/precondition.h>
+#include <ewalena/lac/solver_control.h>
+
+namespace ewalena
+{
+
+  /**
+   * The stabilised biconjugate gradient method (BiCGStab) of van der
+   * Vorst for general systems \f$Ax=b\f$. The preconditioner is
+   * applied from the right, so that the residual checked at each
+   * step is the \f$\ell_2\f$-norm of \f$b-Ax\f$. Unlike GMRES the
+   * method needs a fixed amount of memory and two products with the
+   * matrix per step, but it may break down, which is reported as
+   * <code>failure</code>. See <code>SolverCG</code> for the matrix and
+   * preconditioner interfaces.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class SolverBiCGStab
+    {
+    public:
+
+    /**
+     * Constructor. Take the solver control <code>control</code>.
+     */
+    explicit SolverBiCGStab (SolverControl &control);
+
+    /**
+     * Solve \f$Ax=b\f$ starting from the vector <code>x</code>, which
+     * is overwritten by the solution. Return the state the solver
+     * ended in.
+     */
+    template <typename MatrixType, typename PreconditionerType>
+      SolverControl::State solve (const MatrixType         &A,
+				  Vector<ValueType>        &x,
+				  const Vector<ValueType>  &b,
+				  const PreconditionerType &P);
+
+    /**
+     * Solve \f$Ax=b\f$ without a preconditioner.
+     */
+    template <typename MatrixType>
+      SolverControl::State solve (const MatrixType        &A,
+				  Vector<ValueType>       &x,
+				  const Vector<ValueType> &b);
+
+    private:
+
+    /**
+     * Internal reference to the solver control.
+     */
+    SolverControl &control;
+
+    /**
+     * Internal workspace: the residual and the shadow residual, the
+     * search direction, the intermediate residual, their
+     * preconditioned counterparts and their products with the matrix.
+     */
+    Vector<ValueType> r, r_hat, p, p_hat, v, s, s_hat, t;
+
+    }; /* SolverBiCGStab */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    SolverBiCGStab<ValueType>::SolverBiCGStab (SolverControl &control)
+    :
+    control (control)
+    {}
+
+  template <typename ValueType>
+  template <typename MatrixType, typename PreconditionerType>
+    inline
+    SolverControl::State 
+    SolverBiCGStab<ValueType>::solve (const MatrixType         &A,
+				      Vector<ValueType>        &x,
+				      const Vector<ValueType>  &b,
+				      const PreconditionerType &P)
+    {
+      const unsigned int n = b.size ();
+      assert (x.size () == n);
+
+      r.reinit (n, false);
+      r_hat.reinit (n, false);
+      p.reinit (n);
+      p_hat.reinit (n, false);
+      v.reinit (n);
+      s.reinit (n, false);
+      s_hat.reinit (n, false);
+      t.reinit (n, false);
+
+      /* r = b - Ax */
+      A.vmult (r, x);
+      r.sadd (ValueType (1), b, ValueType (-1), r);
+      r_hat = r;
+
+      SolverControl::State state = control.check (0, std::abs (r.l2_norm ()));
+
+      ValueType rho   = ValueType (1);
+      ValueType alpha = ValueType (1);
+      ValueType omega = ValueType (1);
+
+      for (unsigned int step=1; state==SolverControl::iterate; ++step)
+	{
+	  const ValueType rho_next = r_hat.dot (r);
+	  if (rho_next == ValueType (0) || omega == ValueType (0))
+	    return control.breakdown (step);
+
+	  /* p = r + beta (p - omega v) */
+	  const ValueType beta = (rho_next/rho)*(alpha/omega);
+	  rho = rho_next;
+	  p.add (-omega, v);
+	  p.sadd (ValueType (1), r, beta, p);
+
+	  P.vmult (p_hat, p);
+	  A.vmult (v, p_hat);
+
+	  const ValueType r_hat_v = r_hat.dot (v);
+	  if (r_hat_v == ValueType (0))
+	    return control.breakdown (step);
+	  alpha = rho/r_hat_v;
+
+	  /* s = r - alpha v; stop half way if that is small enough. */
+	  s.sadd (ValueType (1), r, -alpha, v);
+	  x.add (alpha, p_hat);
+
+	  const double s_norm = std::abs (s.l2_norm ());
+	  if (s_norm <= control.target ())
+	    return control.check (step, s_norm);
+
+	  P.vmult (s_hat, s);
+	  A.vmult (t, s_hat);
+
+	  const ValueType tt = t.dot (t);
+	  if (tt == ValueType (0))
+	    return control.breakdown (step);
+	  omega = t.dot (s)/tt;
+
+	  /* x += omega s_hat, r = s - omega t */
+	  x.add (omega, s_hat);
+	  r.sadd (ValueType (1), s, -omega, t);
+
+	  state = control.check (step, std::abs (r.l2_norm ()));
+	}
+
+      return state;
+    }
+
+  template <typename ValueType>
+  template <typename MatrixType>
+    inline
+    SolverControl::State 
+    SolverBiCGStab<ValueType>::solve (const MatrixType        &A,
+				      Vector<ValueType>       &x,
+				      const Vector<ValueType> &b)
+    {
+      return solve (A, x, b, PreconditionIdentity ());
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_solver_bicgstab_h */
@@ -0,0 +1,182 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+
+#ifndef __ewalena_solver_cg_h
+#define __ewalena_solver_cg_h
+
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/precondition.h>
+#include <ewalena/lac/solver_control.h>
+
+namespace ewalena
+{
+
+  /**
+   * The preconditioned conjugate gradient method for Hermitian (for
+   * real value types, symmetric) positive definite systems
+   * \f$Ax=b\f$, with a Hermitian positive definite preconditioner.
+   *
+   * The matrix is any object with a member <code>vmult (y, x)</code>
+   * that computes \f$y=Ax\f$, see <code>LinearOperator</code>, and the
+   * preconditioner any object whose <code>vmult (z, r)</code> computes
+   * \f$z=P^{-1}r\f$. The vectors the method needs are kept by the
+   * solver, so that neither solving repeatedly nor iterating
+   * allocates memory. The residual checked at each step is the
+   * \f$\ell_2\f$-norm of \f$b-Ax\f$.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class SolverCG
+    {
+    public:
+
+    /**
+     * Constructor. Take the solver control <code>control</code>.
+     */
+    explicit SolverCG (SolverControl &control);
+
+    /**
+     * Solve \f$Ax=b\f$ starting from the vector <code>x</code>, which
+     * is overwritten by the solution. Return the state the solver
+     * ended in.
+     */
+    template <typename MatrixType, typename PreconditionerType>
+      SolverControl::State solve (const MatrixType         &A,
+				  Vector<ValueType>        &x,
+				  const Vector<ValueType>  &b,
+				  const PreconditionerType &P);
+
+    /**
+     * Solve \f$Ax=b\f$ without a preconditioner.
+     */
+    template <typename MatrixType>
+      SolverControl::State solve (const MatrixType        &A,
+				  Vector<ValueType>       &x,
+				  const Vector<ValueType> &b);
+
+    private:
+
+    /**
+     * Internal reference to the solver control.
+     */
+    SolverControl &control;
+
+    /**
+     * Internal workspace: the residual, the preconditioned residual,
+     * the search direction and its product with the matrix.
+     */
+    Vector<ValueType> r, z, p, q;
+
+    }; /* SolverCG */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    SolverCG<ValueType>::SolverCG (SolverControl &control)
+    :
+    control (control)
+    {}
+
+  template <typename ValueType>
+  template <typename MatrixType, typename PreconditionerType>
+    inline
+    SolverControl::State 
+    SolverCG<ValueType>::solve (const MatrixType         &A,
+				Vector<ValueType>        &x,
+				const Vector<ValueType>  &b,
+				const PreconditionerType &P)
+    {
+      const unsigned int n = b.size ();
+      assert (x.size () == n);
+
+      r.reinit (n, false);
+      z.reinit (n, false);
+      p.reinit (n, false);
+      q.reinit (n, false);
+
+      /* r = b - Ax */
+      A.vmult (r, x);
+      r.sadd (ValueType (1), b, ValueType (-1), r);
+
+      SolverControl::State state = control.check (0, std::abs (r.l2_norm ()));
+
+      P.vmult (z, r);
+      p = z;
+      ValueType rz = r.dot (z);
+
+      for (unsigned int step=1; state==SolverControl::iterate; ++step)
+	{
+	  A.vmult (q, p);
+
+	  const ValueType pq = p.dot (q);
+	  if (pq == ValueType (0))
+	    return control.breakdown (step);
+
+	  const ValueType alpha = rz/pq;
+	  x.add ( alpha, p);
+	  r.add (-alpha, q);
+
+	  state = control.check (step, std::abs (r.l2_norm ()));
+	  if (state != SolverControl::iterate)
+	    break;
+
+	  P.vmult (z, r);
+	  const ValueType rz_next = r.dot (z);
+	  const ValueType beta    = rz_next/rz;
+	  rz = rz_next;
+
+	  /* p = z + beta p */
+	  p.sadd (ValueType (1), z, beta, p);
+	}
+
+      return state;
+    }
+
+  template <typename ValueType>
+  template <typename MatrixType>
+    inline
+    SolverControl::State 
+    SolverCG<ValueType>::solve (const MatrixType        &A,
+				Vector<ValueType>       &x,
+				const Vector<ValueType> &b)
+    {
+      return solve (A, x, b, PreconditionIdentity ());
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_solver_cg_h */
@@ -0,0 +1,163 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <vector>
+
+#ifndef __ewalena_solver_control_h
+#define __ewalena_solver_control_h
+
+namespace ewalena
+{
+
+  /**
+   * Control of an iterative solver: decides after each step whether
+   * the solver has converged, should go on, or should give up, and
+   * keeps the history of the residuals it was shown.
+   *
+   * A solver has converged once the residual is no larger than
+   * <code>tolerance</code>, or than <code>reduction</code> times the
+   * first residual it was shown, whichever is larger. It gives up
+   * after <code>max_steps</code> steps.
+   *
+   * \ingroup lac
+   */
+  class SolverControl
+  {
+  public:
+
+    /**
+     * The state of a solver after a step.
+     */
+    enum State
+    {
+      /**
+       * Not converged yet; go on.
+       */
+      iterate,
+
+      /**
+       * Converged.
+       */
+      success,
+
+      /**
+       * Not converged within the number of steps allowed, or the
+       * solver broke down.
+       */
+      failure
+    };
+
+    /**
+     * Constructor.
+     */
+    SolverControl (const unsigned int max_steps = 100,
+		   const double       tolerance = 1e-10,
+		   const double       reduction = 0.);
+
+    /**
+     * Decide on the state of a solver at step <code>step</code> with
+     * residual <code>value</code>. Step zero is the initial residual,
+     * which starts a new history.
+     */
+    State check (const unsigned int step,
+		 const double       value);
+
+    /**
+     * Record that the solver broke down at step <code>step</code>, and
+     * return <code>failure</code>.
+     */
+    State breakdown (const unsigned int step);
+
+    /**
+     * Return the state at the last step.
+     */
+    State last_state () const;
+
+    /**
+     * Return the last step checked.
+     */
+    unsigned int last_step () const;
+
+    /**
+     * Return the residual at the last step checked.
+     */
+    double last_value () const;
+
+    /**
+     * Return the residuals of all steps checked since step zero.
+     */
+    const std::vector<double>& history () const;
+
+    /**
+     * Return the largest number of steps allowed.
+     */
+    unsigned int max_steps () const;
+
+    /**
+     * Return the residual at which a solver has converged, which may
+     * depend on the initial residual.
+     */
+    double target () const;
+
+  private:
+
+    /**
+     * Internal reference to the largest number of steps allowed.
+     */
+    unsigned int __max_steps;
+
+    /**
+     * Internal reference to the absolute tolerance.
+     */
+    double __tolerance;
+
+    /**
+     * Internal reference to the reduction of the residual relative to
+     * the initial one.
+     */
+    double __reduction;
+
+    /**
+     * Internal reference to the state at the last step.
+     */
+    State __last_state;
+
+    /**
+     * Internal reference to the residuals.
+     */
+    std::vector<double> __history;
+
+  }; /* SolverControl */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_solver_control_h */
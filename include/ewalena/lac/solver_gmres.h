@@ -0,0 +1,278 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#ifndef __ewalena_solver_gmres_h
+#define __ewalena_solver_gmres_h
+
+#include <ewalena/base/math.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/precondition.h>
+#include <ewalena/lac/solver_control.h>
+
+namespace ewalena
+{
+
+  /**
+   * The restarted generalised minimal residual method, GMRES(m), for
+   * general (nonsymmetric, non-Hermitian) systems \f$Ax=b\f$. The
+   * preconditioner is applied from the right, so that the method
+   * minimises the true residual over the Krylov space of
+   * \f$AP^{-1}\f$. The Arnoldi basis is orthogonalised with modified
+   * Gram-Schmidt and the Hessenberg matrix is reduced to triangular
+   * form with (complex) Givens rotations as it grows.
+   *
+   * The basis of <code>n_restart</code>+1 vectors and the Hessenberg
+   * matrix are kept by the solver, so that they are allocated once
+   * and reused over restarts and solves. The residual checked at each
+   * step is the \f$\ell_2\f$-norm of \f$b-Ax\f$ the rotations provide;
+   * steps are counted over restarts. See <code>SolverCG</code> for the
+   * matrix and preconditioner interfaces.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class SolverGMRES
+    {
+    public:
+
+    /**
+     * Constructor. Take the solver control <code>control</code> and
+     * the number of steps <code>n_restart</code> after which the
+     * method restarts.
+     */
+    explicit SolverGMRES (SolverControl      &control,
+			  const unsigned int  n_restart = 30);
+
+    /**
+     * Solve \f$Ax=b\f$ starting from the vector <code>x</code>, which
+     * is overwritten by the solution. Return the state the solver
+     * ended in.
+     */
+    template <typename MatrixType, typename PreconditionerType>
+      SolverControl::State solve (const MatrixType         &A,
+				  Vector<ValueType>        &x,
+				  const Vector<ValueType>  &b,
+				  const PreconditionerType &P);
+
+    /**
+     * Solve \f$Ax=b\f$ without a preconditioner.
+     */
+    template <typename MatrixType>
+      SolverControl::State solve (const MatrixType        &A,
+				  Vector<ValueType>       &x,
+				  const Vector<ValueType> &b);
+
+    private:
+
+    /**
+     * Internal reference to the solver control.
+     */
+    SolverControl &control;
+
+    /**
+     * Internal reference to the restart length.
+     */
+    const unsigned int n_restart;
+
+    /**
+     * Internal workspace: the Arnoldi basis, and two vectors for the
+     * new basis vector and the preconditioned one.
+     */
+    std::vector<Vector<ValueType> > basis;
+    Vector<ValueType> w, z;
+
+    /**
+     * Internal workspace: the column-major Hessenberg matrix, the
+     * right hand side of the least-squares problem, and the Givens
+     * rotations.
+     */
+    std::vector<ValueType> H, g, sines;
+    std::vector<double>    cosines;
+
+    }; /* SolverGMRES */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    SolverGMRES<ValueType>::SolverGMRES (SolverControl      &control,
+					 const unsigned int  n_restart)
+    :
+    control (control),
+    n_restart (n_restart)
+    {
+      assert (n_restart > 0);
+    }
+
+  template <typename ValueType>
+  template <typename MatrixType, typename PreconditionerType>
+    inline
+    SolverControl::State 
+    SolverGMRES<ValueType>::solve (const MatrixType         &A,
+				   Vector<ValueType>        &x,
+				   const Vector<ValueType>  &b,
+				   const PreconditionerType &P)
+    {
+      const unsigned int n  = b.size ();
+      const unsigned int m  = n_restart;
+      const unsigned int ld = m+1;
+      assert (x.size () == n);
+
+      basis.resize (m+1);
+      for (unsigned int i=0; i<=m; ++i)
+	basis[i].reinit (n, false);
+      w.reinit (n, false);
+      z.reinit (n, false);
+
+      H.assign (ld*m, ValueType (0));
+      g.assign (m+1, ValueType (0));
+      sines.assign (m, ValueType (0));
+      cosines.assign (m, 0.);
+
+      SolverControl::State state = SolverControl::iterate;
+
+      for (unsigned int step=0; state==SolverControl::iterate; )
+	{
+	  /* r = b - Ax, the first basis vector is r/|r| */
+	  Vector<ValueType> &r = basis[0];
+	  A.vmult (r, x);
+	  r.sadd (ValueType (1), b, ValueType (-1), r);
+
+	  const double beta = std::abs (r.l2_norm ());
+	  if (step == 0)
+	    {
+	      state = control.check (0, beta);
+	      if (state != SolverControl::iterate)
+		break;
+	    }
+	  if (beta == 0.)
+	    return SolverControl::success;
+
+	  r /= ValueType (beta);
+	  g[0] = ValueType (beta);
+
+	  /* Arnoldi steps until restart, convergence or a lucky
+	     breakdown, after which the columns 0..j-1 are used. */
+	  unsigned int j = 0;
+	  while (j<m && state==SolverControl::iterate)
+	    {
+	      ++step;
+
+	      P.vmult (z, basis[j]);
+	      A.vmult (w, z);
+
+	      ValueType *h = &H[j*ld];
+	      for (unsigned int i=0; i<=j; ++i)
+		{
+		  h[i] = basis[i].dot (w);
+		  w.add (-h[i], basis[i]);
+		}
+	      const double h_next = std::abs (w.l2_norm ());
+
+	      /* Apply the previous rotations to the new column. */
+	      for (unsigned int i=0; i<j; ++i)
+		{
+		  const ValueType t = cosines[i]*h[i] + sines[i]*h[i+1];
+		  h[i+1] = -math::conjugate (sines[i])*h[i] + cosines[i]*h[i+1];
+		  h[i]   = t;
+		}
+
+	      /* A new rotation annihilates h_next. */
+	      const double a = std::abs (h[j]);
+	      const double t = std::sqrt (a*a + h_next*h_next);
+	      if (t == 0.)
+		return control.breakdown (step);
+
+	      if (a == 0.)
+		{
+		  cosines[j] = 0.;
+		  sines[j]   = ValueType (1);
+		}
+	      else
+		{
+		  cosines[j] = a/t;
+		  sines[j]   = (h[j]/a)*(h_next/t);
+		}
+	      h[j]   = cosines[j]*h[j] + sines[j]*h_next;
+	      h[j+1] = ValueType (0);
+
+	      g[j+1] = -math::conjugate (sines[j])*g[j];
+	      g[j]   = cosines[j]*g[j];
+
+	      ++j;
+	      state = control.check (step, std::abs (g[j]));
+
+	      if (h_next == 0.)
+		break;
+
+	      if (j < m)
+		basis[j].sadd (ValueType (1./h_next), w);
+	    }
+
+	  /* Solve the triangular system for the coefficients, in place
+	     of g, and update x += P^{-1} V y. */
+	  for (unsigned int k=j; k-->0; )
+	    {
+	      for (unsigned int i=k+1; i<j; ++i)
+		g[k] -= H[i*ld+k]*g[i];
+	      g[k] /= H[k*ld+k];
+	    }
+
+	  w.sadd (g[0], basis[0]);
+	  for (unsigned int i=1; i<j; ++i)
+	    w.add (g[i], basis[i]);
+
+	  P.vmult (z, w);
+	  x.add (ValueType (1), z);
+	}
+
+      return state;
+    }
+
+  template <typename ValueType>
+  template <typename MatrixType>
+    inline
+    SolverControl::State 
+    SolverGMRES<ValueType>::solve (const MatrixType        &A,
+				   Vector<ValueType>       &x,
+				   const Vector<ValueType> &b)
+    {
+      return solve (A, x, b, PreconditionIdentity ());
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_solver_gmres_h */
@@ -0,0 +1,219 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <utility>
+
+#ifndef __ewalena_solver_minres_h
+#define __ewalena_solver_minres_h
+
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/precondition.h>
+#include <ewalena/lac/solver_control.h>
+
+namespace ewalena
+{
+
+  /**
+   * The preconditioned minimal residual method (MINRES) of Paige and
+   * Saunders for Hermitian (for real value types, symmetric) systems
+   * \f$Ax=b\f$ that may be indefinite, with a Hermitian positive
+   * definite preconditioner. It builds the Lanczos basis with a three
+   * term recurrence and updates the solution with Givens rotations,
+   * so that it only ever keeps a handful of vectors.
+   *
+   * The residual checked at each step is the norm
+   * \f$\|b-Ax\|_{P^{-1}}\f$ the method minimises, which the recurrence
+   * provides for free; without a preconditioner this is the
+   * \f$\ell_2\f$-norm of the residual. See <code>SolverCG</code> for
+   * the matrix and preconditioner interfaces.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class SolverMINRES
+    {
+    public:
+
+    /**
+     * Constructor. Take the solver control <code>control</code>.
+     */
+    explicit SolverMINRES (SolverControl &control);
+
+    /**
+     * Solve \f$Ax=b\f$ starting from the vector <code>x</code>, which
+     * is overwritten by the solution. Return the state the solver
+     * ended in.
+     */
+    template <typename MatrixType, typename PreconditionerType>
+      SolverControl::State solve (const MatrixType         &A,
+				  Vector<ValueType>        &x,
+				  const Vector<ValueType>  &b,
+				  const PreconditionerType &P);
+
+    /**
+     * Solve \f$Ax=b\f$ without a preconditioner.
+     */
+    template <typename MatrixType>
+      SolverControl::State solve (const MatrixType        &A,
+				  Vector<ValueType>       &x,
+				  const Vector<ValueType> &b);
+
+    private:
+
+    /**
+     * Internal reference to the solver control.
+     */
+    SolverControl &control;
+
+    /**
+     * Internal workspace: three Lanczos vectors, two preconditioned
+     * ones, and three search directions.
+     */
+    Vector<ValueType> v_previous, v, v_next, z, z_next, w_previous, w, w_next;
+
+    }; /* SolverMINRES */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    SolverMINRES<ValueType>::SolverMINRES (SolverControl &control)
+    :
+    control (control)
+    {}
+
+  template <typename ValueType>
+  template <typename MatrixType, typename PreconditionerType>
+    inline
+    SolverControl::State 
+    SolverMINRES<ValueType>::solve (const MatrixType         &A,
+				    Vector<ValueType>        &x,
+				    const Vector<ValueType>  &b,
+				    const PreconditionerType &P)
+    {
+      const unsigned int n = b.size ();
+      assert (x.size () == n);
+
+      v_previous.reinit (n);
+      v.reinit (n, false);
+      v_next.reinit (n, false);
+      z.reinit (n, false);
+      z_next.reinit (n, false);
+      w_previous.reinit (n);
+      w.reinit (n);
+      w_next.reinit (n, false);
+
+      /* v = b - Ax, z = P^{-1} v */
+      A.vmult (v, x);
+      v.sadd (ValueType (1), b, ValueType (-1), v);
+      P.vmult (z, v);
+
+      /* For a Hermitian matrix and preconditioner all the
+	 coefficients of the recurrence are real. */
+      double gamma_previous = 1.;
+      double gamma          = std::sqrt (std::abs (v.dot (z)));
+      double eta            = gamma;
+      double c_previous = 1., c = 1.;
+      double s_previous = 0., s = 0.;
+
+      SolverControl::State state = control.check (0, std::abs (eta));
+
+      for (unsigned int step=1; state==SolverControl::iterate; ++step)
+	{
+	  if (gamma == 0.)
+	    return control.breakdown (step);
+
+	  z /= ValueType (gamma);
+
+	  /* The next Lanczos vector. */
+	  A.vmult (v_next, z);
+	  const double delta = std::real (z.dot (v_next));
+
+	  v_next.add (ValueType (-delta/gamma), v);
+	  v_next.add (ValueType (-gamma/gamma_previous), v_previous);
+
+	  P.vmult (z_next, v_next);
+	  const double gamma_next = std::sqrt (std::abs (v_next.dot (z_next)));
+
+	  /* The next Givens rotation. */
+	  const double alpha_0 = c*delta - c_previous*s*gamma;
+	  const double alpha_1 = std::sqrt (alpha_0*alpha_0 + gamma_next*gamma_next);
+	  const double alpha_2 = s*delta + c_previous*c*gamma;
+	  const double alpha_3 = s_previous*gamma;
+
+	  if (alpha_1 == 0.)
+	    return control.breakdown (step);
+
+	  const double c_next = alpha_0/alpha_1;
+	  const double s_next = gamma_next/alpha_1;
+
+	  /* w_next = (z - alpha_3 w_previous - alpha_2 w)/alpha_1 */
+	  w_next.sadd (ValueType (1./alpha_1), z, ValueType (-alpha_3/alpha_1), w_previous);
+	  w_next.add (ValueType (-alpha_2/alpha_1), w);
+
+	  x.add (ValueType (c_next*eta), w_next);
+	  eta = -s_next*eta;
+
+	  state = control.check (step, std::abs (eta));
+
+	  /* Shift the recurrences by one; swapping never allocates. */
+	  std::swap (v_previous, v);
+	  std::swap (v, v_next);
+	  std::swap (z, z_next);
+	  std::swap (w_previous, w);
+	  std::swap (w, w_next);
+
+	  gamma_previous = gamma;
+	  gamma          = gamma_next;
+	  c_previous = c; c = c_next;
+	  s_previous = s; s = s_next;
+	}
+
+      return state;
+    }
+
+  template <typename ValueType>
+  template <typename MatrixType>
+    inline
+    SolverControl::State 
+    SolverMINRES<ValueType>::solve (const MatrixType        &A,
+				    Vector<ValueType>       &x,
+				    const Vector<ValueType> &b)
+    {
+      return solve (A, x, b, PreconditionIdentity ());
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_solver_minres_h */
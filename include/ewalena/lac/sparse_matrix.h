@@ -0,0 +1,268 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#ifndef __ewalena_sparse_matrix_h
+#define __ewalena_sparse_matrix_h
+
+#include <ewalena/base/vector.h>
+
+namespace ewalena
+{
+
+  /**
+   * A sparse matrix in compressed sparse row (CSR) format: the column
+   * indices and values of the nonzero elements are stored row after
+   * row, each row sorted by column, with the position of the first
+   * element of every row kept aside.
+   *
+   * A sparse matrix is built from a list of (row, column, value)
+   * triplets in any order. Triplets that name the same element are
+   * summed, which is what assembling a matrix from local
+   * contributions needs.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class SparseMatrix
+    {
+    public:
+
+    /**
+     * The type of the elements of this matrix.
+     */
+    typedef ValueType value_type;
+
+    /**
+     * An element of a sparse matrix, as given to build one.
+     */
+    struct Triplet
+    {
+      /**
+       * The row of the element.
+       */
+      unsigned int row;
+
+      /**
+       * The column of the element.
+       */
+      unsigned int column;
+
+      /**
+       * The value of the element.
+       */
+      ValueType value;
+    };
+
+    /**
+     * Constructor - a matrix of size zero.
+     */
+    SparseMatrix ();
+
+    /**
+     * Initialize a matrix of size
+     * <code>m</code>\f$\times\f$<code>n</code> from the list of
+     * elements <code>triplets</code>, see <code>reinit</code>.
+     */
+    SparseMatrix (const unsigned int          m,
+		  const unsigned int          n,
+		  const std::vector<Triplet> &triplets);
+
+    /**
+     * Reinitialise this matrix to size
+     * <code>m</code>\f$\times\f$<code>n</code> with the elements
+     * <code>triplets</code>. The triplets may come in any order, and
+     * the values of triplets that name the same element are summed.
+     */
+    void reinit (const unsigned int          m,
+		 const unsigned int          n,
+		 const std::vector<Triplet> &triplets);
+
+    /**
+     * Return the number of rows this matrix has.
+     */
+    unsigned int n_rows () const;
+
+    /**
+     * Return the number of columns this matrix has.
+     */
+    unsigned int n_cols () const;
+
+    /**
+     * Return the number of elements this matrix stores.
+     */
+    std::size_t n_nonzero_elements () const;
+
+    /**
+     * Return the number of elements stored in row <code>i</code>.
+     */
+    unsigned int row_length (const unsigned int i) const;
+
+    /**
+     * Return the columns of the elements stored in row
+     * <code>i</code>, in increasing order.
+     */
+    const unsigned int* columns (const unsigned int i) const;
+
+    /**
+     * Return the values of the elements stored in row
+     * <code>i</code>, in the order of <code>columns (i)</code>.
+     */
+    const ValueType* values (const unsigned int i) const;
+
+    /**
+     * Read-write access to the values of the elements stored in row
+     * <code>i</code>. The sparsity pattern can not be changed.
+     */
+    ValueType* values (const unsigned int i);
+
+    /**
+     * Return the (<code>i</code>, <code>j</code>)th element of this
+     * matrix, which is zero if it is not stored.
+     */
+    ValueType operator () (const unsigned int i, 
+			   const unsigned int j) const;
+
+    /**
+     * Matrix-vector multiplication: \f$y=\alpha Mx+\beta y\f$. By
+     * default, <code>y</code> is overwritten by \f$Mx\f$.
+     *
+     * Large products are split into as many blocks of consecutive
+     * rows as there are threads in <code>ThreadPool::instance
+     * ()</code>, each with about the same number of stored elements
+     * rather than the same number of rows, so that a few dense rows do
+     * not hold up the rest.
+     */
+    void vmult (Vector<ValueType>       &y,
+		const Vector<ValueType> &x,
+		const ValueType          alpha = ValueType (1),
+		const ValueType          beta  = ValueType (0)) const;
+
+    private:
+
+    /**
+     * Internal reference to this matrix row-size.
+     */
+    unsigned int __n_rows;
+
+    /**
+     * Internal reference to this matrix column-size.
+     */
+    unsigned int __n_cols;
+
+    /**
+     * Internal reference to the position of the first element of
+     * each row, followed by the number of elements.
+     */
+    std::vector<std::size_t> row_start;
+
+    /**
+     * Internal reference to the column of each element.
+     */
+    std::vector<unsigned int> column_index;
+
+    /**
+     * Internal reference to the value of each element.
+     */
+    std::vector<ValueType> data;
+
+    }; /* SparseMatrix */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    SparseMatrix<ValueType>::n_rows () const
+    {
+      return __n_rows;
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    SparseMatrix<ValueType>::n_cols () const
+    {
+      return __n_cols;
+    }
+
+  template <typename ValueType>
+    inline
+    std::size_t
+    SparseMatrix<ValueType>::n_nonzero_elements () const
+    {
+      return column_index.size ();
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    SparseMatrix<ValueType>::row_length (const unsigned int i) const
+    {
+      assert (i<__n_rows);
+      return row_start[i+1] - row_start[i];
+    }
+
+  template <typename ValueType>
+    inline
+    const unsigned int*
+    SparseMatrix<ValueType>::columns (const unsigned int i) const
+    {
+      assert (i<__n_rows);
+      return column_index.data () + row_start[i];
+    }
+
+  template <typename ValueType>
+    inline
+    const ValueType*
+    SparseMatrix<ValueType>::values (const unsigned int i) const
+    {
+      assert (i<__n_rows);
+      return data.data () + row_start[i];
+    }
+
+  template <typename ValueType>
+    inline
+    ValueType*
+    SparseMatrix<ValueType>::values (const unsigned int i)
+    {
+      assert (i<__n_rows);
+      return data.data () + row_start[i];
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_sparse_matrix_h */
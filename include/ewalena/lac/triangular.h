@@ -0,0 +1,133 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <complex>
+
+#ifndef __ewalena_triangular_h
+#define __ewalena_triangular_h
+
+#include <ewalena/lac/gemm.h>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    /**
+     * The triangle of a square array that holds a triangular
+     * operand.
+     */
+    enum Triangle
+    {
+      /**
+       * The operand is the lower triangle, diagonal included.
+       */
+      lower,
+
+      /**
+       * The operand is the upper triangle, diagonal included.
+       */
+      upper
+    };
+
+    /**
+     * The diagonal of a triangular operand.
+     */
+    enum Diagonal
+    {
+      /**
+       * Use the diagonal as it is stored.
+       */
+      non_unit_diagonal,
+
+      /**
+       * Assume the diagonal is all ones, and never read it. This is
+       * how the unit lower factor of an LU factorization is stored
+       * below the upper factor.
+       */
+      unit_diagonal
+    };
+
+    /**
+     * Triangular solve with many right-hand sides: overwrite the
+     * <code>m</code>\f$\times\f$<code>n</code> array \f$B\f$ by the
+     * solution \f$X\f$ of \f$op(A)X=\alpha B\f$, where \f$A\f$ is an
+     * <code>m</code>\f$\times\f$<code>m</code> triangular array whose
+     * triangle <code>uplo</code> is read. All arrays are row-major
+     * and <code>lda</code> and <code>ldb</code> are the distance
+     * between consecutive rows of the stored arrays.
+     *
+     * The solve runs over blocks of rows of \f$X\f$: each diagonal
+     * block is solved by substitution and the rows still to be solved
+     * are then updated by a single <code>gemm</code>, so that the
+     * bulk of the work runs at the speed (and on the threads) of the
+     * matrix-matrix product.
+     */
+    template <typename ValueType>
+      void trsm (const Triangle     uplo,
+		 const Operation    op_a,
+		 const Diagonal     diag,
+		 const unsigned int m,
+		 const unsigned int n,
+		 const ValueType    alpha,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 ValueType         *B,
+		 const unsigned int ldb);
+
+    /**
+     * Triangular solve with a single right-hand side: overwrite the
+     * vector \f$x\f$ of length <code>n</code> by the solution of
+     * \f$op(A)y=x\f$, where \f$A\f$ is an
+     * <code>n</code>\f$\times\f$<code>n</code> row-major triangular
+     * array whose triangle <code>uplo</code> is read.
+     *
+     * Each row of \f$A\f$ is read once and in order: as a dot product
+     * with the part of \f$y\f$ already found if \f$A\f$ enters as it
+     * is stored, and as an update of the part of \f$y\f$ still to be
+     * found if it enters transposed.
+     */
+    template <typename ValueType>
+      void trsv (const Triangle     uplo,
+		 const Operation    op_a,
+		 const Diagonal     diag,
+		 const unsigned int n,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 ValueType         *x);
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_triangular_h */
@@ -0,0 +1,228 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <complex>
+#include <vector>
+
+#ifndef __ewalena_tsqr_factorization_h
+#define __ewalena_tsqr_factorization_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/qr_factorization.h>
+
+namespace ewalena
+{
+
+  /**
+   * The tall-skinny QR factorization \f$A=QR\f$ of an
+   * <code>m</code>\f$\times\f$<code>n</code> matrix with
+   * \f$m\geq n\f$, meant for \f$m\gg n\f$, eg. a block of vectors
+   * to orthonormalise.
+   *
+   * The rows are split into blocks of at least
+   * <code>min_block_rows ()</code> and of \f$2n\f$ rows. Each block
+   * is factorized on its own, by a QRFactorization on one of the
+   * threads of <code>ThreadPool::instance ()</code>, after which the
+   * \f$n\times n\f$ factors \f$R_b\f$ of the blocks are stacked and
+   * factorized once more. The columns of a block are thus never
+   * touched by another thread, and the only serial step is of a
+   * size set by \f$n\f$ and the number of blocks, not by \f$m\f$.
+   * The split does not depend on the number of threads, so neither
+   * do the results.
+   *
+   * \f$Q\f$ is the product of the block diagonal matrix of the
+   * \f$Q_b\f$ and of the factor of the stacked \f$R_b\f$, and is
+   * applied as such.
+   *
+   * \ingroup lac
+   */
+  template <typename ValueType = double>
+    class TSQRFactorization
+    {
+    public:
+
+    /**
+     * Constructor - the factorization of a matrix of size zero.
+     */
+    TSQRFactorization ();
+
+    /**
+     * Initialize with the factorization of the matrix
+     * <code>M</code>.
+     */
+    explicit TSQRFactorization (const Matrix<ValueType> &M);
+
+    /**
+     * Compute the factorization of the matrix <code>M</code>, which
+     * has at least as many rows as columns, replacing any previous
+     * factorization.
+     */
+    void factorize (const Matrix<ValueType> &M);
+
+    /**
+     * Return the number of rows of the factorized matrix.
+     */
+    unsigned int n_rows () const;
+
+    /**
+     * Return the number of columns of the factorized matrix.
+     */
+    unsigned int n_cols () const;
+
+    /**
+     * Return the number of blocks of rows factorized on their own.
+     */
+    unsigned int n_blocks () const;
+
+    /**
+     * Overwrite <code>B</code>, which has as many rows as the
+     * factorized matrix, by \f$QB\f$.
+     */
+    void apply_Q (Matrix<ValueType> &B) const;
+
+    /**
+     * Overwrite <code>b</code> by \f$Qb\f$.
+     */
+    void apply_Q (Vector<ValueType> &b) const;
+
+    /**
+     * Overwrite <code>B</code>, which has as many rows as the
+     * factorized matrix, by \f$Q^HB\f$.
+     */
+    void apply_QH (Matrix<ValueType> &B) const;
+
+    /**
+     * Overwrite <code>b</code> by \f$Q^Hb\f$.
+     */
+    void apply_QH (Vector<ValueType> &b) const;
+
+    /**
+     * Make <code>Q</code> the <code>m</code>\f$\times\f$<code>n</code>
+     * thin factor.
+     */
+    void form_Q (Matrix<ValueType> &Q) const;
+
+    /**
+     * Make <code>R</code> the \f$n\times n\f$ upper triangular
+     * factor.
+     */
+    void form_R (Matrix<ValueType> &R) const;
+
+    /**
+     * Make <code>x</code> the least-squares solution, which minimises
+     * \f$\|Ax-b\|_2\f$, of a factorized matrix of full rank.
+     */
+    void solve (Vector<ValueType>       &x,
+		const Vector<ValueType> &b) const;
+
+    /**
+     * Make each column of <code>X</code> the least-squares solution
+     * for the corresponding column of <code>B</code> as right-hand
+     * side.
+     */
+    void solve (Matrix<ValueType>       &X,
+		const Matrix<ValueType> &B) const;
+
+    /**
+     * Return the smallest number of rows of a block.
+     */
+    static unsigned int min_block_rows ();
+
+    private:
+
+    /**
+     * Overwrite the row-major array <code>B</code> of <code>n</code>
+     * columns and as many rows as the factorized matrix by
+     * \f$QB\f$, if <code>op</code> is <code>no_transpose</code>, or
+     * by \f$Q^HB\f$, if it is <code>conjugate_transpose</code>.
+     */
+    void apply (const blas::Operation op,
+		const unsigned int    n,
+		ValueType            *B,
+		const unsigned int    ldb) const;
+
+    /**
+     * Internal reference to the number of columns of the factorized
+     * matrix.
+     */
+    unsigned int __n_cols;
+
+    /**
+     * Internal reference to the first row of each block, and the
+     * number of rows after the last one.
+     */
+    std::vector<unsigned int> __block_start;
+
+    /**
+     * Internal reference to the factorizations of the blocks.
+     */
+    std::vector<QRFactorization<ValueType>> __blocks;
+
+    /**
+     * Internal reference to the factorization of the stacked
+     * triangular factors of the blocks.
+     */
+    QRFactorization<ValueType> __top;
+
+    }; /* TSQRFactorization */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    TSQRFactorization<ValueType>::n_rows () const
+    {
+      return __block_start.back ();
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    TSQRFactorization<ValueType>::n_cols () const
+    {
+      return __n_cols;
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    TSQRFactorization<ValueType>::n_blocks () const
+    {
+      return __blocks.size ();
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_tsqr_factorization_h */
@@ -0,0 +1,238 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <complex>
+#include <cstddef>
+
+#ifndef __ewalena_vector_kernels_h
+#define __ewalena_vector_kernels_h
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    /**
+     * The instruction sets the vector kernels are written for, in
+     * increasing order of vector width.
+     */
+    enum InstructionSet
+    {
+      /**
+       * Plain C++ loops.
+       */
+      generic,
+
+      /**
+       * 128-bit SSE2 registers: two doubles, or one complex double.
+       */
+      sse2,
+
+      /**
+       * 256-bit AVX2 registers with fused multiply-add.
+       */
+      avx2,
+
+      /**
+       * 512-bit AVX-512 registers.
+       */
+      avx512
+    };
+
+    /**
+     * Return the instruction set the vector kernels currently use.
+     * This is chosen once when the library is loaded as the widest
+     * one that is both compiled in and supported by the processor
+     * (as reported by CPUID), unless the environment variable
+     * <code>EWALENA_SIMD</code> names a narrower one
+     * (<code>generic</code>, <code>sse2</code>, <code>avx2</code> or
+     * <code>avx512</code>).
+     */
+    InstructionSet instruction_set ();
+
+    /**
+     * Return true if the vector kernels for instruction set
+     * <code>isa</code> are compiled in and can be run on this
+     * processor.
+     */
+    bool is_available (const InstructionSet isa);
+
+    /**
+     * Make the vector kernels use instruction set <code>isa</code>,
+     * which must be available. This is meant for testing and
+     * benchmarking; it is not safe to call while other threads use
+     * the kernels.
+     */
+    void set_instruction_set (const InstructionSet isa);
+
+    /**
+     * \f$y_i+=x_i\f$ for \f$i<n\f$.
+     */
+    template <typename ValueType>
+      void add (const unsigned int  n,
+		const ValueType    *x,
+		ValueType          *y);
+
+    /**
+     * \f$y_i-=x_i\f$ for \f$i<n\f$.
+     */
+    template <typename ValueType>
+      void subtract (const unsigned int  n,
+		     const ValueType    *x,
+		     ValueType          *y);
+
+    /**
+     * \f$x_i*=a\f$ for \f$i<n\f$.
+     */
+    template <typename ValueType>
+      void scale (const unsigned int  n,
+		  const ValueType     a,
+		  ValueType          *x);
+
+    /**
+     * \f$y_i+=ax_i\f$ for \f$i<n\f$.
+     */
+    template <typename ValueType>
+      void axpy (const unsigned int  n,
+		 const ValueType     a,
+		 const ValueType    *x,
+		 ValueType          *y);
+
+    /**
+     * \f$y_i+=a\bar{x}_i\f$ for \f$i<n\f$, which is
+     * <code>axpy</code> for real numbers.
+     */
+    template <typename ValueType>
+      void axpy_conj (const unsigned int  n,
+		      const ValueType     a,
+		      const ValueType    *x,
+		      ValueType          *y);
+
+    /**
+     * \f$y_i=ax_i+by_i\f$ for \f$i<n\f$. If <code>b</code> is zero,
+     * <code>y</code> is not read and need not be initialised.
+     */
+    template <typename ValueType>
+      void axpby (const unsigned int  n,
+		  const ValueType     a,
+		  const ValueType    *x,
+		  const ValueType     b,
+		  ValueType          *y);
+
+    /**
+     * \f$w_i=ax_i+by_i\f$ for \f$i<n\f$. <code>w</code> may be the
+     * same array as <code>x</code> or <code>y</code>.
+     */
+    template <typename ValueType>
+      void waxpby (const unsigned int  n,
+		   const ValueType     a,
+		   const ValueType    *x,
+		   const ValueType     b,
+		   const ValueType    *y,
+		   ValueType          *w);
+
+    /**
+     * \f$z_i+=x_iy_i\f$ for \f$i<n\f$.
+     */
+    template <typename ValueType>
+      void multiply_add (const unsigned int  n,
+			 const ValueType    *x,
+			 const ValueType    *y,
+			 ValueType          *z);
+
+    /**
+     * Sliced ELLPACK matrix-vector product over <code>n_chunks</code>
+     * chunks of <code>height</code> rows each: chunk \f$c\f$ stores
+     * <code>chunk_length[c]</code> columns of <code>height</code>
+     * (column index, value) pairs each, one column after the other
+     * from position <code>chunk_start[c]</code> on, and
+     * \f$y_{c\cdot height+r}\f$ is set to the product of row
+     * \f$r\f$ of chunk \f$c\f$ with \f$x\f$. The height must be a
+     * multiple of <code>sell_chunk_height</code>, so that a register
+     * of any instruction set holds whole rows of a chunk.
+     */
+    template <typename ValueType>
+      void sell_vmult (const unsigned int  n_chunks,
+		       const unsigned int  height,
+		       const std::size_t  *chunk_start,
+		       const unsigned int *chunk_length,
+		       const unsigned int *columns,
+		       const ValueType    *values,
+		       const ValueType    *x,
+		       ValueType          *y);
+
+    /**
+     * The number of doubles in the widest register of any instruction
+     * set the vector kernels are written for, which the height of the
+     * chunks of <code>sell_vmult</code> must be a multiple of.
+     */
+    const unsigned int sell_chunk_height = 8;
+
+    /**
+     * Return \f$\sum_i|x_i|\f$, where \f$|x_i|\f$ is the modulus
+     * of a complex number.
+     */
+    template <typename ValueType>
+      double asum (const unsigned int  n,
+		   const ValueType    *x);
+
+    /**
+     * Return \f$\sqrt{\sum_i|x_i|^2}\f$.
+     */
+    template <typename ValueType>
+      double nrm2 (const unsigned int  n,
+		   const ValueType    *x);
+
+    /**
+     * Return \f$\sum_i\bar{x}_iy_i\f$, where the first argument is
+     * complex conjugated.
+     */
+    template <typename ValueType>
+      ValueType dot (const unsigned int  n,
+		     const ValueType    *x,
+		     const ValueType    *y);
+
+    /**
+     * Return \f$\sum_ix_iy_i\f$, which unlike <code>dot</code>
+     * conjugates neither argument.
+     */
+    template <typename ValueType>
+      ValueType dotu (const unsigned int  n,
+		      const ValueType    *x,
+		      const ValueType    *y);
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_vector_kernels_h */
@@ -0,0 +1,332 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#ifndef __ewalena_fock_basis_h
+#define __ewalena_fock_basis_h
+
+namespace ewalena
+{
+
+  /**
+   * A basis of occupation-number (Fock) states of up to 64 modes,
+   * each state stored as the bit string of its occupations: bit
+   * \f$a\f$ is set if mode \f$a\f$ is occupied. Spinful particles
+   * take two modes per site.
+   *
+   * The basis holds either all \f$2^n\f$ states of \f$n\f$ modes, or
+   * only those with a fixed number \f$N\f$ of particles. Either way
+   * the states are ordered by their value as integers, and are not
+   * stored: the \f$i\f$th state and the index of a state are
+   * computed, the latter for fixed \f$N\f$ by its combinatorial rank
+   * \f$\sum_k\binom{p_k}{k+1}\f$, where \f$p_0<p_1<\dots\f$ are the
+   * occupied modes. The memory a basis takes is thus independent of
+   * its size, and running through a range of states costs a few
+   * bit operations per state.
+   *
+   * \ingroup many_body
+   */
+  class FockBasis
+  {
+  public:
+
+    /**
+     * The type of a state.
+     */
+    typedef std::uint64_t State;
+
+    /**
+     * The statistics of the particles.
+     */
+    enum Statistics
+    {
+      /**
+       * Fermions: moving a particle past others changes the sign by
+       * their number.
+       */
+      fermions,
+
+      /**
+       * Hard-core bosons: at most one particle per mode and no
+       * signs.
+       */
+      hardcore_bosons
+    };
+
+    /**
+     * Constructor - all states of <code>n_modes</code> modes.
+     */
+    explicit FockBasis (const unsigned int n_modes);
+
+    /**
+     * Constructor - the states of <code>n_modes</code> modes with
+     * <code>n_particles</code> of them occupied.
+     */
+    FockBasis (const unsigned int n_modes,
+	       const unsigned int n_particles);
+
+    /**
+     * Return the number of modes.
+     */
+    unsigned int n_modes () const;
+
+    /**
+     * Return <code>true</code> if all states of the basis have the
+     * same number of particles.
+     */
+    bool conserves_particle_number () const;
+
+    /**
+     * Return the number of particles of every state, if it is
+     * conserved.
+     */
+    unsigned int n_particles () const;
+
+    /**
+     * Return the number of states.
+     */
+    unsigned int size () const;
+
+    /**
+     * Return the <code>i</code>th state.
+     */
+    State state (const unsigned int i) const;
+
+    /**
+     * Return the index of the state <code>s</code>, which must be in
+     * the basis.
+     */
+    unsigned int index (const State s) const;
+
+    /**
+     * Return the index of the state <code>s</code>, whose index is
+     * <code>i</code>, with its particle on the mode <code>from</code>
+     * moved to the empty mode <code>to</code>. Only the particles
+     * between the two modes are looked at, which for the hopping
+     * between nearby modes of a Hamiltonian is much cheaper than
+     * <code>index</code>.
+     */
+    unsigned int index (const unsigned int i,
+			const State        s,
+			const unsigned int from,
+			const unsigned int to) const;
+
+    /**
+     * Return the state following <code>s</code> in the basis.
+     */
+    State next (const State s) const;
+
+    /**
+     * Return <code>true</code> if the state <code>s</code> is in the
+     * basis.
+     */
+    bool contains (const State s) const;
+
+    /**
+     * Return the binomial coefficient \f$\binom{n}{k}\f$, or zero if
+     * \f$k>n\f$, for \f$n\leq 64\f$.
+     */
+    static std::uint64_t binomial (const unsigned int n,
+				   const unsigned int k);
+
+    /**
+     * Return the number of occupied modes of the state
+     * <code>s</code>.
+     */
+    static unsigned int count (const State s);
+
+  private:
+
+    /**
+     * Internal reference to the number of modes.
+     */
+    unsigned int __n_modes;
+
+    /**
+     * Internal reference to the number of particles, if conserved.
+     */
+    unsigned int __n_particles;
+
+    /**
+     * Internal reference to whether the number of particles is
+     * conserved.
+     */
+    bool __conserves_particle_number;
+
+    /**
+     * Internal reference to the number of states.
+     */
+    unsigned int __size;
+
+    /**
+     * Internal reference to the binomial coefficients
+     * \f$\binom{p}{k}\f$ at <code>p*(n_particles+1)+k</code>, which
+     * rank a state.
+     */
+    std::vector<std::uint64_t> __binomials;
+
+  }; /* FockBasis */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  inline
+  unsigned int
+  FockBasis::n_modes () const
+  {
+    return __n_modes;
+  }
+
+  inline
+  bool
+  FockBasis::conserves_particle_number () const
+  {
+    return __conserves_particle_number;
+  }
+
+  inline
+  unsigned int
+  FockBasis::n_particles () const
+  {
+    assert (__conserves_particle_number);
+    return __n_particles;
+  }
+
+  inline
+  unsigned int
+  FockBasis::size () const
+  {
+    return __size;
+  }
+
+  inline
+  unsigned int
+  FockBasis::count (const State s)
+  {
+    return __builtin_popcountll (s);
+  }
+
+  inline
+  unsigned int
+  FockBasis::index (const State s) const
+  {
+    if (!__conserves_particle_number)
+      return static_cast<unsigned int> (s);
+
+    /* The rank of s: the k-th lowest occupied mode p adds
+       binomial (p, k+1). */
+    std::uint64_t index = 0;
+    State         rest  = s;
+    for (unsigned int k=1; rest != 0; ++k)
+      {
+	const unsigned int p = __builtin_ctzll (rest);
+	index += __binomials[p*(__n_particles+1)+k];
+	rest  &= rest-1;
+      }
+
+    return static_cast<unsigned int> (index);
+  }
+
+  inline
+  unsigned int
+  FockBasis::index (const unsigned int i,
+		    const State        s,
+		    const unsigned int from,
+		    const unsigned int to) const
+  {
+    if (!__conserves_particle_number)
+      return static_cast<unsigned int> (s ^ ((State (1) << from) | (State (1) << to)));
+
+    const std::uint64_t *binomial = __binomials.data ();
+    const unsigned int   stride   = __n_particles+1;
+
+    /* The particle on mode p with k particles below it adds binomial
+       (p, k+1) to the index. Moving one changes its own term and
+       shifts the count of those in between by one. */
+    const unsigned int low  = (from < to) ? from : to;
+    const unsigned int high = (from < to) ? to   : from;
+    const unsigned int below_low = count (s & ((State (1) << low) - 1));
+    State between = s & ((State (1) << high) - 1) & ~((State (1) << (low+1)) - 1);
+
+    std::uint64_t index = i;
+
+    if (from < to)
+      {
+	index -= binomial[from*stride+below_low+1];
+
+	unsigned int k = below_low+1;
+	for (; between != 0; between &= between-1, ++k)
+	  {
+	    const unsigned int p = __builtin_ctzll (between);
+	    index += binomial[p*stride+k] - binomial[p*stride+k+1];
+	  }
+
+	index += binomial[to*stride+k];
+      }
+    else
+      {
+	index += binomial[to*stride+below_low+1];
+
+	unsigned int k = below_low;
+	for (; between != 0; between &= between-1, ++k)
+	  {
+	    const unsigned int p = __builtin_ctzll (between);
+	    index += binomial[p*stride+k+2] - binomial[p*stride+k+1];
+	  }
+
+	index -= binomial[from*stride+k+1];
+      }
+
+    return static_cast<unsigned int> (index);
+  }
+
+  inline
+  FockBasis::State
+  FockBasis::next (const State s) const
+  {
+    if (!__conserves_particle_number)
+      return s+1;
+
+    /* The next larger integer with as many bits set. */
+    if (s == 0)
+      return 0;
+
+    const State lowest = s & (~s+1);
+    const State ripple = s + lowest;
+    return ripple | (((s ^ ripple) >> 2) >> __builtin_ctzll (s));
+  }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_fock_basis_h */
@@ -0,0 +1,290 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <utility>
+#include <vector>
+
+#ifndef __ewalena_fock_hamiltonian_h
+#define __ewalena_fock_hamiltonian_h
+
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/block_diagonal_matrix.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include <ewalena/many_body/fock_basis.h>
+#include <ewalena/many_body/sector_basis.h>
+
+namespace ewalena
+{
+
+  /**
+   * A many-body Hamiltonian of particles hopping between the modes
+   * of a FockBasis,
+   * \f[
+   *   H = \sum_{a\neq b}\left(t_{ab}c_a^\dagger c_b + \mathrm{h.c.}\right)
+   *     + \sum_a\epsilon_an_a + \sum_{a<b}V_{ab}n_an_b,
+   * \f]
+   * for fermions, or for hard-core bosons (equivalently, spins one
+   * half) if the signs from reordering the operators are left
+   * out. It is Hermitian by construction.
+   *
+   * The operator is matrix-free: <code>vmult</code> runs through the
+   * basis states and finds, for each of them, the states the terms
+   * connect it to by flipping bits, and their indices from its own
+   * by <code>FockBasis::index</code>. The matrix is never stored, so that the memory needed is
+   * that of the vectors. Since every output element is found from
+   * the input by itself, blocks of states are handed to the threads
+   * of <code>ThreadPool::instance ()</code> without any
+   * synchronisation.
+   *
+   * With a member <code>vmult (y, x)</code> it can be handed to the
+   * iterative solvers and eigensolvers of the library, and
+   * <code>diagonal</code> gives what EigensolverDavidson needs.
+   *
+   * If the terms conserve the number of particles of every species,
+   * and are invariant under translations along the ring of sites,
+   * <code>assemble</code> sets up the blocks of the operator in the
+   * symmetry sectors of a SectorBasis as matrices of their own, to
+   * be solved independently.
+   *
+   * \ingroup many_body
+   */
+  template <typename ValueType = std::complex<double>>
+    class FockHamiltonian
+    {
+    public:
+
+    /**
+     * Constructor - no terms yet. The basis must outlive this
+     * operator.
+     */
+    explicit FockHamiltonian (const FockBasis             &basis,
+			      const FockBasis::Statistics  statistics = FockBasis::fermions);
+
+    /**
+     * Add the hopping term \f$tc_a^\dagger c_b + \bar tc_b^\dagger
+     * c_a\f$, for \f$a\neq b\f$.
+     */
+    void add_hopping (const unsigned int a,
+		      const unsigned int b,
+		      const ValueType    t);
+
+    /**
+     * Add the on-site term \f$\epsilon n_a\f$.
+     */
+    void add_potential (const unsigned int a,
+			const double       epsilon);
+
+    /**
+     * Add the density-density interaction \f$Vn_an_b\f$, for
+     * \f$a\neq b\f$.
+     */
+    void add_interaction (const unsigned int a,
+			  const unsigned int b,
+			  const double       V);
+
+    /**
+     * Return the basis.
+     */
+    const FockBasis& basis () const;
+
+    /**
+     * Return the number of rows (and columns) of the operator, the
+     * size of the basis.
+     */
+    unsigned int size () const;
+
+    /**
+     * Return the diagonal element for the state <code>s</code>.
+     */
+    double diagonal (const FockBasis::State s) const;
+
+    /**
+     * Make <code>d</code> the diagonal of the operator.
+     */
+    void diagonal (Vector<ValueType> &d) const;
+
+    /**
+     * Compute \f$y=Hx\f$.
+     */
+    void vmult (Vector<ValueType>       &y,
+		const Vector<ValueType> &x) const;
+
+    /**
+     * Make <code>M</code> the block of this operator in the sector
+     * <code>sector</code>, whose modes must be those of the basis. If
+     * the sector has a fixed momentum, the terms must be invariant
+     * under translations, and for real <code>ValueType</code> the
+     * momentum must be zero or $\pi$. The columns are set up in
+     * parallel.
+     */
+    void assemble (const SectorBasis       &sector,
+		   SparseMatrix<ValueType> &M) const;
+
+    /**
+     * Same as above, for a dense block.
+     */
+    void assemble (const SectorBasis &sector,
+		   Matrix<ValueType> &M) const;
+
+    /**
+     * Make <code>M</code> the block-diagonal matrix of the blocks of
+     * this operator in the sectors <code>sectors</code>, see
+     * <code>SectorBasis::partition</code>. The blocks are set up in
+     * parallel, the largest first.
+     */
+    template <typename MatrixType>
+      void assemble (const std::vector<SectorBasis>  &sectors,
+		     BlockDiagonalMatrix<MatrixType> &M) const;
+
+    private:
+
+    /**
+     * A hopping term \f$tc_a^\dagger c_b\f$ and its adjoint, with the
+     * bits of the modes \f$a\f$ and \f$b\f$ and of the modes between
+     * them.
+     */
+    struct Hopping
+    {
+      unsigned int     a;
+      unsigned int     b;
+      FockBasis::State bit_a;
+      FockBasis::State bit_b;
+      FockBasis::State between;
+      ValueType        t;
+    };
+
+    /**
+     * A density-density interaction, as the bits of its two modes.
+     */
+    struct Interaction
+    {
+      FockBasis::State modes;
+      double           V;
+    };
+
+    /**
+     * Compute \f$y=Hx\f$ for the states <code>begin</code> up to
+     * <code>end</code> of the basis.
+     */
+    void vmult_states (const unsigned int  begin,
+		       const unsigned int  end,
+		       ValueType          *y,
+		       const ValueType    *x) const;
+
+    /**
+     * Find the nonzero elements of column <code>a</code> of the
+     * block of this operator in the sector <code>sector</code>, as
+     * pairs of row and value. Rows may repeat.
+     */
+    void sector_column (const SectorBasis                               &sector,
+			const unsigned int                               a,
+			std::vector<std::pair<unsigned int, ValueType>> &column) const;
+
+    /**
+     * Internal reference to the basis.
+     */
+    const FockBasis &__basis;
+
+    /**
+     * Internal reference to the statistics of the particles.
+     */
+    FockBasis::Statistics __statistics;
+
+    /**
+     * Internal reference to the hopping terms.
+     */
+    std::vector<Hopping> __hoppings;
+
+    /**
+     * Internal reference to the on-site energies, one per mode.
+     */
+    std::vector<double> __potential;
+
+    /**
+     * Internal reference to the interactions.
+     */
+    std::vector<Interaction> __interactions;
+
+    }; /* FockHamiltonian */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  template <typename ValueType>
+    inline
+    const FockBasis&
+    FockHamiltonian<ValueType>::basis () const
+    {
+      return __basis;
+    }
+
+  template <typename ValueType>
+    inline
+    unsigned int
+    FockHamiltonian<ValueType>::size () const
+    {
+      return __basis.size ();
+    }
+
+  template <typename ValueType>
+    template <typename MatrixType>
+    inline
+    void
+    FockHamiltonian<ValueType>::assemble (const std::vector<SectorBasis>  &sectors,
+					  BlockDiagonalMatrix<MatrixType> &M) const
+    {
+      M.reinit (sectors.size ());
+
+      std::vector<unsigned int> order (sectors.size ());
+      for (unsigned int b=0; b<order.size (); ++b)
+	order[b] = b;
+
+      std::stable_sort (order.begin (), order.end (),
+			[&] (const unsigned int a, const unsigned int b)
+			{
+			  return sectors[a].size () > sectors[b].size ();
+			});
+
+      ThreadPool::instance ().run (order.size (),
+				   [&] (const unsigned int i)
+				   {
+				     assemble (sectors[order[i]], M.block (order[i]));
+				   });
+    }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_fock_hamiltonian_h */
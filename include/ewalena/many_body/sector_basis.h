@@ -0,0 +1,386 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#ifndef __ewalena_sector_basis_h
+#define __ewalena_sector_basis_h
+
+#include <ewalena/many_body/fock_basis.h>
+
+namespace ewalena
+{
+
+  /**
+   * The basis of one symmetry sector of particles of several species
+   * on a ring of sites: the states with a fixed number of particles
+   * of every species and, optionally, a fixed lattice momentum. Mode
+   * <code>sigma*n_sites+i</code> is site \f$i\f$ of species
+   * \f$\sigma\f$, so that spin one half is two species whose numbers
+   * of particles fix \f$N\f$ and \f$S_z\f$ together. A Hamiltonian
+   * that conserves these quantum numbers is block diagonal in the
+   * sectors, and every block can be set up and solved on its own,
+   * see <code>FockHamiltonian::assemble</code> and
+   * <code>partition</code>.
+   *
+   * Without momentum the states are the products of those of a
+   * FockBasis per species, ordered by their value as integers, and
+   * are not stored: the index of a state is
+   * \f$\sum_\sigma r_\sigma\prod_{\tau<\sigma}\binom{L}{N_\tau}\f$,
+   * where \f$r_\sigma\f$ is the combinatorial rank of the particles
+   * of species \f$\sigma\f$.
+   *
+   * With momentum \f$k=2\pi m/L\f$, a basis state stands for the
+   * Bloch state
+   * \f[
+   *   |r,k\rangle = \frac{1}{\sqrt{R_r}}\sum_{l=0}^{R_r-1}e^{-ikl}T^l|r\rangle,
+   * \f]
+   * where \f$T\f$ translates all particles by one site, the
+   * representative \f$r\f$ is the smallest state of its orbit under
+   * \f$T\f$, and \f$R_r\f$ the period of the orbit. Orbits whose
+   * Bloch state vanishes, because \f$T^{R_r}|r\rangle=\chi|r\rangle\f$
+   * with \f$e^{-ikR_r}\chi\neq 1\f$, are left out. The representatives
+   * are stored in increasing order and found by binary search, after
+   * translating a state to the smallest of its orbit.
+   *
+   * \ingroup many_body
+   */
+  class SectorBasis
+  {
+  public:
+
+    /**
+     * The type of a state.
+     */
+    typedef FockBasis::State State;
+
+    /**
+     * Constructor - the states of <code>n_particles[sigma]</code>
+     * particles of every species <code>sigma</code> on
+     * <code>n_sites</code> sites, with the momentum \f$2\pi
+     * m/L\f$ for <code>momentum</code> \f$m\geq 0\f$, or any momentum
+     * if it is negative. The statistics give the signs picked up by
+     * translating fermions around the ring.
+     */
+    SectorBasis (const unsigned int               n_sites,
+		 const std::vector<unsigned int> &n_particles,
+		 const int                        momentum   = -1,
+		 const FockBasis::Statistics      statistics = FockBasis::fermions);
+
+    /**
+     * Return the non-empty sectors of <code>n_species</code> species
+     * on <code>n_sites</code> sites, for all numbers of particles of
+     * every species and, if <code>momentum</code> is
+     * <code>true</code>, all momenta. Together they hold every state
+     * exactly once.
+     */
+    static std::vector<SectorBasis> partition (const unsigned int          n_sites,
+					       const unsigned int          n_species,
+					       const bool                  momentum   = false,
+					       const FockBasis::Statistics statistics = FockBasis::fermions);
+
+    /**
+     * Return the number of sites.
+     */
+    unsigned int n_sites () const;
+
+    /**
+     * Return the number of species.
+     */
+    unsigned int n_species () const;
+
+    /**
+     * Return the number of modes, sites times species.
+     */
+    unsigned int n_modes () const;
+
+    /**
+     * Return the number of particles of the species
+     * <code>sigma</code>.
+     */
+    unsigned int n_particles (const unsigned int sigma) const;
+
+    /**
+     * Return <code>true</code> if the states have a fixed momentum.
+     */
+    bool has_momentum () const;
+
+    /**
+     * Return the momentum \f$m\f$ of the states, in units of
+     * \f$2\pi/L\f$.
+     */
+    unsigned int momentum () const;
+
+    /**
+     * Return the statistics of the particles.
+     */
+    FockBasis::Statistics statistics () const;
+
+    /**
+     * Return the number of states.
+     */
+    unsigned int size () const;
+
+    /**
+     * Return the <code>i</code>th state, or its representative if the
+     * momentum is fixed.
+     */
+    State state (const unsigned int i) const;
+
+    /**
+     * Return the index of the state <code>s</code>, which must be in
+     * the basis, or be the representative of a state in the basis if
+     * the momentum is fixed.
+     */
+    unsigned int index (const State s) const;
+
+    /**
+     * Return the period of the orbit of the <code>i</code>th state
+     * under translations, which is one if the momentum is not fixed.
+     */
+    unsigned int period (const unsigned int i) const;
+
+    /**
+     * Return the state <code>s</code> translated by one site, and
+     * multiply <code>sign</code> by the sign this picks up.
+     */
+    State translate (const State  s,
+		     double      &sign) const;
+
+    /**
+     * Find the state of the basis that <code>s</code> belongs to: its
+     * index <code>i</code>, and the <code>shift</code> and
+     * <code>sign</code> with
+     * \f$T^{\mathrm{shift}}|s\rangle=\mathrm{sign}\,|r_i\rangle\f$. Return
+     * <code>false</code> if <code>s</code> has the wrong numbers of
+     * particles or its Bloch state vanishes.
+     */
+    bool find (const State   s,
+	       unsigned int &i,
+	       unsigned int &shift,
+	       double       &sign) const;
+
+  private:
+
+    /**
+     * Return <code>true</code> if the numbers of particles of the
+     * state <code>s</code> are those of this sector.
+     */
+    bool conserves (const State s) const;
+
+    /**
+     * Return the <code>i</code>th state of the product of the
+     * per-species bases.
+     */
+    State product_state (const unsigned int i) const;
+
+    /**
+     * Return the index of the state <code>s</code> in the product of
+     * the per-species bases.
+     */
+    unsigned int product_index (const State s) const;
+
+    /**
+     * Internal reference to the number of sites.
+     */
+    unsigned int __n_sites;
+
+    /**
+     * Internal reference to the momentum, or minus one.
+     */
+    int __momentum;
+
+    /**
+     * Internal reference to the statistics of the particles.
+     */
+    FockBasis::Statistics __statistics;
+
+    /**
+     * Internal reference to the bits of the sites of one species.
+     */
+    State __site_mask;
+
+    /**
+     * Internal reference to the basis of every species.
+     */
+    std::vector<FockBasis> __species;
+
+    /**
+     * Internal reference to the index strides of the species in the
+     * product basis.
+     */
+    std::vector<unsigned int> __strides;
+
+    /**
+     * Internal reference to the number of states.
+     */
+    unsigned int __size;
+
+    /**
+     * Internal reference to the representatives, in increasing order,
+     * if the momentum is fixed.
+     */
+    std::vector<State> __representatives;
+
+    /**
+     * Internal reference to the periods of the representatives. The
+     * number of sites is at most 64, which a byte holds.
+     */
+    std::vector<unsigned char> __periods;
+
+  }; /* SectorBasis */
+
+  /*-------------- Inline and Other Functions -----------------------*/
+
+  inline
+  unsigned int
+  SectorBasis::n_sites () const
+  {
+    return __n_sites;
+  }
+
+  inline
+  unsigned int
+  SectorBasis::n_species () const
+  {
+    return __species.size ();
+  }
+
+  inline
+  unsigned int
+  SectorBasis::n_modes () const
+  {
+    return __n_sites*__species.size ();
+  }
+
+  inline
+  unsigned int
+  SectorBasis::n_particles (const unsigned int sigma) const
+  {
+    assert (sigma < __species.size ());
+    return __species[sigma].n_particles ();
+  }
+
+  inline
+  bool
+  SectorBasis::has_momentum () const
+  {
+    return __momentum >= 0;
+  }
+
+  inline
+  unsigned int
+  SectorBasis::momentum () const
+  {
+    assert (has_momentum ());
+    return __momentum;
+  }
+
+  inline
+  FockBasis::Statistics
+  SectorBasis::statistics () const
+  {
+    return __statistics;
+  }
+
+  inline
+  unsigned int
+  SectorBasis::size () const
+  {
+    return __size;
+  }
+
+  inline
+  SectorBasis::State
+  SectorBasis::state (const unsigned int i) const
+  {
+    assert (i < __size);
+    return has_momentum () ? __representatives[i] : product_state (i);
+  }
+
+  inline
+  unsigned int
+  SectorBasis::period (const unsigned int i) const
+  {
+    assert (i < __size);
+    return has_momentum () ? __periods[i] : 1;
+  }
+
+  inline
+  bool
+  SectorBasis::conserves (const State s) const
+  {
+    for (unsigned int sigma=0; sigma<__species.size (); ++sigma)
+      if (FockBasis::count ((s >> (sigma*__n_sites)) & __site_mask) != __species[sigma].n_particles ())
+	return false;
+
+    return true;
+  }
+
+  inline
+  unsigned int
+  SectorBasis::product_index (const State s) const
+  {
+    unsigned int index = 0;
+    for (unsigned int sigma=0; sigma<__species.size (); ++sigma)
+      index += __strides[sigma]*__species[sigma].index ((s >> (sigma*__n_sites)) & __site_mask);
+
+    return index;
+  }
+
+  inline
+  SectorBasis::State
+  SectorBasis::translate (const State  s,
+			  double      &sign) const
+  {
+    /* Every species is rotated by one site. A fermion taken from the
+       last site to the first passes the others of its species. */
+    State t = 0;
+    for (unsigned int sigma=0; sigma<__species.size (); ++sigma)
+      {
+	const State block = (s >> (sigma*__n_sites)) & __site_mask;
+	const State last  = (block >> (__n_sites-1)) & 1;
+
+	if (last && (__statistics == FockBasis::fermions) && !(__species[sigma].n_particles () & 1))
+	  sign = -sign;
+
+	t |= (((block << 1) & __site_mask) | last) << (sigma*__n_sites);
+      }
+
+    return t;
+  }
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_sector_basis_h */
@@ -32,6 +32,9 @@
 
 #include <ewalena/base/matrix.h>
 #include <ewalena/base/tensor.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/fixed_size_inverse.h>
+#include <ewalena/lac/lu_factorization.h>
 
 namespace ewalena
 {
@@ -41,7 +44,8 @@ namespace ewalena
     :
     __n_rows (0),
     __n_cols (0),
-    data (new ValueType[0])
+    __n_allocated (0),
+    data (0)
   {}
   
   template <typename ValueType>
@@ -51,7 +55,8 @@ namespace ewalena
     :
     __n_rows (m),
     __n_cols (n),
-    data (new ValueType[m*n])
+    __n_allocated (m*n),
+    data (memory::allocate<ValueType> (__n_allocated))
   {
     if (zero)
       this->reinit ();
@@ -63,7 +68,8 @@ namespace ewalena
     :
     __n_rows (mn_pair.first),
     __n_cols (mn_pair.second),
-    data (new ValueType[__n_rows*__n_cols])
+    __n_allocated (__n_rows*__n_cols),
+    data (memory::allocate<ValueType> (__n_allocated))
   {
     if (zero)
       this->reinit ();
@@ -74,18 +80,33 @@ namespace ewalena
     :
     __n_rows (M.n_rows ()),
     __n_cols (M.n_cols ()),
-    data (new ValueType[__n_rows*__n_cols])
+    __n_allocated (__n_rows*__n_cols),
+    data (memory::allocate<ValueType> (__n_allocated))
   {
     if (this->data)
       std::memcpy (this->data, M.data, sizeof (ValueType) * this->__n_rows*this->__n_cols);
   }
 
+  template <typename ValueType>
+  Matrix<ValueType>::Matrix (Matrix<ValueType> &&M) noexcept
+    :
+    __n_rows (M.__n_rows),
+    __n_cols (M.__n_cols),
+    __n_allocated (M.__n_allocated),
+    data (M.data)
+  {
+    M.__n_rows      = 0;
+    M.__n_cols      = 0;
+    M.__n_allocated = 0;
+    M.data          = 0;
+  }
+
   
   template <typename ValueType>
   Matrix<ValueType>::~Matrix ()
   {
     // Contents don't matter - just blowm away whatever is there.
-    delete[] this->data;
+    memory::deallocate (this->data);
   }
 
   template <typename ValueType>
@@ -94,12 +115,16 @@ namespace ewalena
 			     const unsigned int n,
 			     const bool         zero) 
   {
-    if (data)
-      delete[] this->data;
+    // Only go to the system for memory if what we have is too small.
+    if (m*n > __n_allocated)
+      {
+	memory::deallocate (this->data);
+	this->data          = memory::allocate<ValueType> (m*n);
+	this->__n_allocated = m*n;
+      }
 
     this->__n_rows = m;
     this->__n_cols = n;
-    this->data     = new ValueType [this->__n_rows*this->__n_cols];
 
                                  // Zero out the memory pertaining to
                                  // this new vector.
@@ -112,7 +137,148 @@ namespace ewalena
   Matrix<ValueType>::reinit () 
   {
     // Zero out matrix memory.
-    std::memset (data, 0, sizeof (ValueType) * this->__n_rows*this->__n_cols);
+    if (this->n_elements () != 0)
+      std::memset (data, 0, sizeof (ValueType) * this->__n_rows*this->__n_cols);
+  }
+
+  template <typename ValueType>
+  void
+  Matrix<ValueType>::vmult (Vector<ValueType>       &y,
+			    const Vector<ValueType> &x,
+			    const ValueType          alpha,
+			    const ValueType          beta) const
+  {
+    assert (x.size () == __n_cols);
+    assert (y.size () == __n_rows);
+    assert (&x != &y);
+
+    blas::gemv (blas::no_transpose, __n_rows, __n_cols,
+		alpha, data, __n_cols, *x, beta, *y);
+  }
+
+  template <typename ValueType>
+  void
+  Matrix<ValueType>::Tvmult (Vector<ValueType>       &y,
+			     const Vector<ValueType> &x,
+			     const ValueType          alpha,
+			     const ValueType          beta) const
+  {
+    assert (x.size () == __n_rows);
+    assert (y.size () == __n_cols);
+    assert (&x != &y);
+
+    blas::gemv (blas::transpose, __n_rows, __n_cols,
+		alpha, data, __n_cols, *x, beta, *y);
+  }
+
+  template <typename ValueType>
+  void
+  Matrix<ValueType>::Hvmult (Vector<ValueType>       &y,
+			     const Vector<ValueType> &x,
+			     const ValueType          alpha,
+			     const ValueType          beta) const
+  {
+    assert (x.size () == __n_rows);
+    assert (y.size () == __n_cols);
+    assert (&x != &y);
+
+    blas::gemv (blas::conjugate_transpose, __n_rows, __n_cols,
+		alpha, data, __n_cols, *x, beta, *y);
+  }
+
+  template <typename ValueType>
+  void
+  Matrix<ValueType>::invert (const Matrix<ValueType> &M)
+  {
+    assert (M.__n_rows==M.__n_cols);
+
+    /* Larger matrices go through their factorization, which also
+       keeps M intact should it be this matrix. */
+    if (M.__n_rows > 8)
+      {
+	const LUFactorization<ValueType> factorization (M);
+	assert (!factorization.is_singular ());
+
+	factorization.invert (*this);
+	return;
+      }
+
+    /* Medium sized ones by elimination unrolled for their size,
+       which works on a copy; reinit keeps the elements should M be
+       this matrix. */
+    if (M.__n_rows > 3)
+      {
+	this->reinit (M.__n_rows, M.__n_cols, false);
+
+	bool is_invertible = false;
+	switch (M.__n_rows)
+	  {
+	  case 4: is_invertible = fixed_size::invert<4> (M.data, data); break;
+	  case 5: is_invertible = fixed_size::invert<5> (M.data, data); break;
+	  case 6: is_invertible = fixed_size::invert<6> (M.data, data); break;
+	  case 7: is_invertible = fixed_size::invert<7> (M.data, data); break;
+	  case 8: is_invertible = fixed_size::invert<8> (M.data, data); break;
+	  }
+	assert (is_invertible);
+	return;
+      }
+
+    this->reinit (M.__n_rows,M.__n_cols);
+
+    switch (M.__n_cols)
+      {
+      case 0:
+	{
+	  /* Undefined operation.  */
+	  assert (false);
+	}
+
+      case 1:
+	{
+	  assert (M(0,0)!=ValueType (0));
+	  (*this)(0,0) = ValueType (1) / M(0,0);
+	  break;
+	}
+
+      case 2:
+	{
+	  const ValueType determinant = M(0,0)*M(1,1) - M(0,1)*M(1,0);
+	  assert (determinant!=ValueType (0));
+
+	  (*this)(0,0) =  M(1,1) / determinant;
+	  (*this)(0,1) = -M(0,1) / determinant;
+	  (*this)(1,0) = -M(1,0) / determinant;
+	  (*this)(1,1) =  M(0,0) / determinant;
+
+	  break;
+	}
+
+      case 3: 
+	{
+	  const ValueType determinant 
+	    = M(0,0)*(M(2,2)*M(1,1) - M(2,1)*M(1,2))
+	    - M(1,0)*(M(2,2)*M(0,1) - M(2,1)*M(0,2))
+	    + M(2,0)*(M(1,2)*M(0,1) - M(1,1)*M(0,2));
+	  assert (determinant!=ValueType (0));
+
+	  (*this)(0,0) =    (M(2,2)*M(1,1) - M(2,1)*M(1,2)) / determinant;
+	  (*this)(0,1) =  - (M(2,2)*M(0,1) - M(2,1)*M(0,2)) / determinant;
+	  (*this)(0,2) =    (M(1,2)*M(0,1) - M(1,1)*M(0,2)) / determinant;
+
+	  (*this)(1,0) =  - (M(2,2)*M(1,0) - M(2,0)*M(1,2)) / determinant;
+	  (*this)(1,1) =    (M(2,2)*M(0,0) - M(2,0)*M(0,2)) / determinant;
+	  (*this)(1,2) =  - (M(1,2)*M(0,0) - M(1,0)*M(0,2)) / determinant;
+
+	  (*this)(2,0) =    (M(2,1)*M(1,0) - M(2,0)*M(1,1)) / determinant;
+	  (*this)(2,1) =  - (M(2,1)*M(0,0) - M(2,0)*M(0,1)) / determinant;
+	  (*this)(2,2) =    (M(1,1)*M(0,0) - M(1,0)*M(0,1)) / determinant;
+
+	  break; 
+	}
+
+      default:
+	assert (false);
+      }
   }
 
 } // namepsace ewalena
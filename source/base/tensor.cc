@@ -37,40 +37,6 @@
 namespace ewalena
 {
  
-  template <int dim, int rank, typename ValueType>
-  Tensor<dim, rank, ValueType>::Tensor (const bool zero)
-    :
-    __n_components (static_cast<unsigned int> (math::pow (dim, rank))),
-    data (new ValueType[__n_components])
-  {
-    if (zero)
-      reinit ();
-  }
- 
-  template <int dim, int rank, typename ValueType>
-  Tensor<dim, rank, ValueType>::Tensor (const Tensor<dim, rank, ValueType> &T)
-    :
-    __n_components (T.__n_components),
-    data (new ValueType[__n_components])
-  {
-    if (__n_components != 0)
-      std::memcpy (this->data, T.data, sizeof (ValueType)*__n_components);
-  }
-
-  template <int dim, int rank, typename ValueType>
-  Tensor<dim, rank, ValueType>::~Tensor ()
-  {
-    // Contents don't matter - set the pointer to NULL.
-    delete[] this->data;
-  }
-  
-  template <int dim, int rank, typename ValueType>
-  void
-  Tensor<dim, rank, ValueType>::clone (const Tensor<dim, rank, ValueType> &T)
-  {
-    std::memcpy (this->data, T.data, sizeof (ValueType)*__n_components);
-  }
-  
   template <int dim, int rank, typename ValueType>
   std::pair<unsigned int, unsigned int>
   Tensor<dim, rank, ValueType>::voight_components () const
@@ -78,7 +44,6 @@ namespace ewalena
     
     // This operation is undefined for rank 0 tensors.
     assert (rank > 0);
-    assert (data);
     
     switch (rank)
       {
@@ -108,15 +73,6 @@ namespace ewalena
       }
   }
   
-  
-  template <int dim, int rank, typename ValueType>
-  void
-  Tensor<dim, rank, ValueType>::reinit () 
-  {
-    // Zero out tensor memory.
-    std::memset (data, ValueType(0), sizeof (ValueType)*__n_components);
-  }
-  
 } // namepsace ewalena
 
 // -------------- Explicit Instantiations -------------------------------
@@ -0,0 +1,201 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/thread_pool.h>
+
+#include <cassert>
+#include <cstdlib>
+
+namespace ewalena
+{
+
+  namespace
+  {
+    /* Set while a thread executes a task, so that nested parallel
+       loops can be detected and run serially. */
+    thread_local bool inside_task = false;
+
+    unsigned int default_n_threads ()
+    {
+      const char *environment = std::getenv ("EWALENA_NUM_THREADS");
+      if (environment && std::atoi (environment) > 0)
+	return static_cast<unsigned int> (std::atoi (environment));
+
+      const unsigned int n = std::thread::hardware_concurrency ();
+      return (n > 0) ? n : 1;
+    }
+  }
+
+  ThreadPool&
+  ThreadPool::instance ()
+  {
+    static ThreadPool pool (default_n_threads ());
+    return pool;
+  }
+
+  ThreadPool::ThreadPool (const unsigned int n)
+    :
+    task (0),
+    n_tasks (0),
+    next_task (0),
+    generation (0),
+    n_busy (0),
+    n_active (0)
+  {
+    resize (n);
+  }
+
+  ThreadPool::~ThreadPool ()
+  {
+    resize (1);
+  }
+
+  unsigned int
+  ThreadPool::n_threads () const
+  {
+    return workers.size ()+1;
+  }
+
+  void
+  ThreadPool::set_n_threads (const unsigned int n)
+  {
+    assert (n > 0);
+
+    std::lock_guard<std::mutex> run_lock (run_mutex);
+    if (n != n_threads ())
+      resize (n);
+  }
+
+  void
+  ThreadPool::resize (const unsigned int n)
+  {
+    /* Retire all workers... */
+    {
+      std::lock_guard<std::mutex> lock (state_mutex);
+      n_active = 0;
+    }
+    wake_workers.notify_all ();
+
+    for (unsigned int i=0; i<workers.size (); ++i)
+      workers[i].join ();
+    workers.clear ();
+
+    /* ...and hire as many as needed. */
+    n_active = n-1;
+    for (unsigned int i=0; i<n_active; ++i)
+      workers.push_back (std::thread (&ThreadPool::work, this, i));
+  }
+
+  void
+  ThreadPool::run (const unsigned int                           n,
+		   const std::function<void (const unsigned int)> &body)
+  {
+    /* Nothing to share, nobody to share it with, or we are already
+       inside a parallel loop: do it here. */
+    if ((n < 2) || workers.empty () || inside_task)
+      {
+	for (unsigned int i=0; i<n; ++i)
+	  body (i);
+	return;
+      }
+
+    std::lock_guard<std::mutex> run_lock (run_mutex);
+
+    {
+      std::lock_guard<std::mutex> lock (state_mutex);
+      task      = &body;
+      n_tasks   = n;
+      next_task = 0;
+      n_busy    = workers.size ();
+      exception = std::exception_ptr ();
+      ++generation;
+    }
+    wake_workers.notify_all ();
+
+    execute ();
+
+    std::unique_lock<std::mutex> lock (state_mutex);
+    wake_caller.wait (lock, [this] () { return n_busy == 0; });
+
+    task = 0;
+    if (exception)
+      std::rethrow_exception (exception);
+  }
+
+  void
+  ThreadPool::execute ()
+  {
+    inside_task = true;
+
+    for (unsigned int i=next_task++; i<n_tasks; i=next_task++)
+      try
+	{
+	  (*task) (i);
+	}
+      catch (...)
+	{
+	  std::lock_guard<std::mutex> lock (state_mutex);
+	  if (!exception)
+	    exception = std::current_exception ();
+	}
+
+    inside_task = false;
+  }
+
+  void
+  ThreadPool::work (const unsigned int worker)
+  {
+    unsigned long seen = 0;
+
+    while (true)
+      {
+	{
+	  std::unique_lock<std::mutex> lock (state_mutex);
+	  wake_workers.wait (lock, [&] () { return (worker >= n_active) || (generation != seen); });
+
+	  if (worker >= n_active)
+	    return;
+
+	  seen = generation;
+	}
+
+	execute ();
+
+	{
+	  std::lock_guard<std::mutex> lock (state_mutex);
+	  --n_busy;
+	}
+	wake_caller.notify_one ();
+      }
+  }
+
+} // namespace ewalena
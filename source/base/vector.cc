@@ -39,7 +39,8 @@ namespace ewalena
   Vector<ValueType>::Vector ()
     :
     n_el (0),
-    data (new ValueType[0])
+    n_allocated (0),
+    data (0)
   {}
   
   template <typename ValueType>
@@ -47,7 +48,8 @@ namespace ewalena
 			     const bool         zero)
     :
     n_el (m),
-    data (new ValueType[n_el])
+    n_allocated (m),
+    data (memory::allocate<ValueType> (n_el))
   {
     if (zero)
       reinit ();
@@ -57,17 +59,31 @@ namespace ewalena
   Vector<ValueType>::Vector (const Vector<ValueType> &v)
     :
     n_el (v.n_rows ()),
-    data (new ValueType[n_el])
+    n_allocated (n_el),
+    data (memory::allocate<ValueType> (n_el))
   {
     if (n_el != 0)
       std::memcpy (this->data, v.data, sizeof (ValueType)*n_el);
   }
 
+  template <typename ValueType>
+  Vector<ValueType>::Vector (Vector<ValueType> &&v) noexcept
+    :
+    n_el (v.n_el),
+    n_allocated (v.n_allocated),
+    data (v.data)
+  {
+    v.n_el        = 0;
+    v.n_allocated = 0;
+    v.data        = 0;
+  }
+
   template <typename ValueType>
   Vector<ValueType>::Vector (const std::initializer_list<ValueType> list) 
     :
     n_el (list.size ()),
-    data (new ValueType[n_el])
+    n_allocated (n_el),
+    data (memory::allocate<ValueType> (n_el))
   {
     if (n_el != 0)
       std::copy (list.begin(), list.end(), this->data);
@@ -77,7 +93,7 @@ namespace ewalena
   Vector<ValueType>::~Vector ()
   {
     // Blow away whatever is there if something is there.
-    delete[] this->data;
+    memory::deallocate (this->data);
   }
 
   
@@ -86,7 +102,8 @@ namespace ewalena
   Vector<ValueType>::reinit () 
   {
     // Zero out the memory pertaining to this vector by brute force.
-    std::memset (data, 0, sizeof (ValueType)*n_el);
+    if (n_el != 0)
+      std::memset (data, 0, sizeof (ValueType)*n_el);
   }
   
   template <typename ValueType>
@@ -101,15 +118,19 @@ namespace ewalena
   Vector<ValueType>::reinit (const unsigned int m,
 			     const bool         zero) 
   {
-    if (data)
-      delete[] this->data;
+    // Only go to the system for memory if what we have is too small.
+    if (m > n_allocated)
+      {
+	memory::deallocate (this->data);
+	data        = memory::allocate<ValueType> (m);
+	n_allocated = m;
+      }
     
     n_el = m;
-    data     = new ValueType [n_el];
     
     // Zero out the memory pertaining to this new vector.
     if (zero)
-      std::memset (data, 0, sizeof (ValueType)*n_el);
+      this->reinit ();
   }
   
 } // namespace ewalena
@@ -0,0 +1,233 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/math.h>
+#include <ewalena/lac/cholesky_factorization.h>
+#include <ewalena/lac/triangular.h>
+#include <ewalena/lac/vector_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of rows factorized as one diagonal block. */
+    const unsigned int block_size = 64;
+
+    /* Factorize the kb x kb diagonal block starting at row (and
+       column) k0 of the upper triangle of the n x n row-major array
+       a, in place. Return false if a pivot is not positive. */
+    template <typename ValueType>
+      bool factorize_block (const unsigned int  n,
+			    const unsigned int  k0,
+			    const unsigned int  kb,
+			    ValueType          *a)
+      {
+	const unsigned int end = k0+kb;
+
+	for (unsigned int j=k0; j<end; ++j)
+	  {
+	    ValueType *row_j = a + std::size_t (j)*n;
+
+	    const double pivot = std::real (row_j[j]);
+	    if (!(pivot > 0.))
+	      return false;
+
+	    row_j[j] = ValueType (std::sqrt (pivot));
+	    blas::scale (end-j-1, ValueType (1)/row_j[j], row_j+j+1);
+
+	    for (unsigned int i=j+1; i<end; ++i)
+	      blas::axpy (end-i, -math::conjugate (row_j[i]), row_j+i, a + std::size_t (i)*n+i);
+	  }
+
+	return true;
+      }
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  CholeskyFactorization<ValueType>::CholeskyFactorization ()
+    :
+    __is_positive_definite (true)
+  {}
+
+  template <typename ValueType>
+  CholeskyFactorization<ValueType>::CholeskyFactorization (const Matrix<ValueType> &M)
+    :
+    __is_positive_definite (true)
+  {
+    factorize (M);
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::factorize (const Matrix<ValueType> &M)
+  {
+    assert (M.n_rows () == M.n_cols ());
+
+    const unsigned int n = M.n_rows ();
+
+    __factors = M;
+    __is_positive_definite = true;
+
+    ValueType *a = *__factors;
+
+    for (unsigned int k0=0; k0<n; k0+=block_size)
+      {
+	const unsigned int kb = std::min (block_size, n-k0);
+	const unsigned int n_trailing = n-k0-kb;
+
+	if (!factorize_block (n, k0, kb, a))
+	  {
+	    __is_positive_definite = false;
+	    return;
+	  }
+
+	if (n_trailing == 0)
+	  break;
+
+	/* The rows of L^H beside the block: U_12 = U_11^{-H} A_12. */
+	ValueType *a_12 = a + std::size_t (k0)*n+k0+kb;
+
+	blas::trsm (blas::upper, blas::conjugate_transpose, blas::non_unit_diagonal,
+		    kb, n_trailing,
+		    ValueType (1), a + std::size_t (k0)*n+k0, n,
+		    a_12, n);
+
+	/* The upper triangle of the trailing submatrix, A_22 -=
+	   U_12^H U_12, a block row at a time so that the lower
+	   triangle is (mostly) left alone. */
+	for (unsigned int r=0; r<n_trailing; r+=block_size)
+	  {
+	    const unsigned int rb = std::min (block_size, n_trailing-r);
+	    const unsigned int i0 = k0+kb+r;
+
+	    blas::gemm (blas::conjugate_transpose, blas::no_transpose,
+			rb, n_trailing-r, kb,
+			ValueType (-1), a_12+r, n,
+			a_12+r, n,
+			ValueType (1), a + std::size_t (i0)*n+i0, n);
+	  }
+      }
+  }
+
+  template <typename ValueType>
+  double
+  CholeskyFactorization<ValueType>::determinant () const
+  {
+    double determinant = 1.;
+
+    for (unsigned int i=0; i<size (); ++i)
+      determinant *= std::real (__factors (i, i))*std::real (__factors (i, i));
+
+    return determinant;
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::forward_substitution (Vector<ValueType> &b) const
+  {
+    assert (__is_positive_definite);
+    assert (b.size () == size ());
+
+    blas::trsv (blas::upper, blas::conjugate_transpose, blas::non_unit_diagonal,
+		size (), *__factors, size (), *b);
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::forward_substitution (Matrix<ValueType> &B) const
+  {
+    assert (__is_positive_definite);
+    assert (B.n_rows () == size ());
+
+    blas::trsm (blas::upper, blas::conjugate_transpose, blas::non_unit_diagonal,
+		size (), B.n_cols (), ValueType (1), *__factors, size (), *B, B.n_cols ());
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::backward_substitution (Vector<ValueType> &b) const
+  {
+    assert (__is_positive_definite);
+    assert (b.size () == size ());
+
+    blas::trsv (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		size (), *__factors, size (), *b);
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::backward_substitution (Matrix<ValueType> &B) const
+  {
+    assert (__is_positive_definite);
+    assert (B.n_rows () == size ());
+
+    blas::trsm (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		size (), B.n_cols (), ValueType (1), *__factors, size (), *B, B.n_cols ());
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::solve (Vector<ValueType> &b) const
+  {
+    forward_substitution (b);
+    backward_substitution (b);
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::solve (Matrix<ValueType> &B) const
+  {
+    forward_substitution (B);
+    backward_substitution (B);
+  }
+
+  template <typename ValueType>
+  void
+  CholeskyFactorization<ValueType>::invert (Matrix<ValueType> &M) const
+  {
+    M.reinit (size (), size (), false);
+    M.identity ();
+
+    solve (M);
+  }
+
+} // namepsace ewalena
+
+#include "cholesky_factorization.inst"
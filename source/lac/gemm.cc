@@ -0,0 +1,462 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/gemm.h>
+#include <ewalena/base/math.h>
+#include <ewalena/base/memory.h>
+#include <ewalena/base/thread_pool.h>
+
+#include <cmath>
+
+#include <cstddef>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    namespace
+    {
+
+      /* Blocking parameters of the engine. The micro-kernel computes
+	 an mr x nr block of C from a kc long sliver of packed A and of
+	 packed B: kc is chosen so that both slivers live in L1, an mc x
+	 kc block of packed A lives in L2 and a kc x nc block of packed
+	 B lives in L3. mc (nc) must be a multiple of mr (nr). */
+      template <typename ValueType>
+	struct Blocking;
+
+      template <>
+	struct Blocking<double>
+	{
+	  enum { mr = 4, nr = 8, kc = 256, mc = 128, nc = 4096 };
+	};
+
+      template <>
+	struct Blocking<std::complex<double> >
+	{
+	  enum { mr = 2, nr = 4, kc = 128, mc = 128, nc = 2048 };
+	};
+
+      inline
+	unsigned int min (const unsigned int a,
+			  const unsigned int b)
+      {
+	return (a < b) ? a : b;
+      }
+
+      /* Packing buffers are kept per thread and only ever grow, so
+	 that repeated products do not hit the allocator. */
+      template <typename ValueType>
+	class Workspace
+	{
+	public:
+
+	Workspace ()
+	  :
+	  a (0), b (0), a_size (0), b_size (0)
+	{}
+
+	~Workspace ()
+	{
+	  memory::deallocate (a);
+	  memory::deallocate (b);
+	}
+
+	ValueType* packed_a (const std::size_t n)
+	{
+	  return reserve (a, a_size, n);
+	}
+
+	ValueType* packed_b (const std::size_t n)
+	{
+	  return reserve (b, b_size, n);
+	}
+
+	private:
+
+	static
+	ValueType* reserve (ValueType   *&buffer,
+			    std::size_t  &size,
+			    const std::size_t n)
+	{
+	  if (n > size)
+	    {
+	      memory::deallocate (buffer);
+	      buffer = memory::allocate<ValueType> (n);
+	      size   = n;
+	    }
+	  return buffer;
+	}
+
+	ValueType   *a;
+	ValueType   *b;
+	std::size_t  a_size;
+	std::size_t  b_size;
+	};
+
+      /* Copy the mc x kc block of op(A), whose (i,p)th element lives
+	 at A[i*rs+p*cs], into row panels of height mr: within a panel
+	 the mr elements of each column are adjacent. Ragged panels are
+	 padded with zeros so the kernel never has to care. */
+      template <typename ValueType, unsigned int mr>
+	void pack_a (const unsigned int  mc,
+		     const unsigned int  kc,
+		     const ValueType    *A,
+		     const unsigned int  rs,
+		     const unsigned int  cs,
+		     const bool          conj,
+		     ValueType          *buffer)
+	{
+	  for (unsigned int i0=0; i0<mc; i0+=mr, buffer+=mr*kc)
+	    {
+	      const unsigned int rows = min (mr, mc-i0);
+	      const ValueType   *a    = A + i0*rs;
+
+	      /* Walk the source in the order it is stored. */
+	      if (cs == 1)
+		for (unsigned int i=0; i<rows; ++i)
+		  for (unsigned int p=0; p<kc; ++p)
+		    buffer[p*mr+i] = conj ? math::conjugate (a[i*rs+p]) : a[i*rs+p];
+	      else
+		for (unsigned int p=0; p<kc; ++p)
+		  for (unsigned int i=0; i<rows; ++i)
+		    buffer[p*mr+i] = conj ? math::conjugate (a[i*rs+p*cs]) : a[i*rs+p*cs];
+
+	      for (unsigned int p=0; p<kc; ++p)
+		for (unsigned int i=rows; i<mr; ++i)
+		  buffer[p*mr+i] = ValueType (0);
+	    }
+	}
+
+      /* Copy the kc x nc block of op(B), whose (p,j)th element lives
+	 at B[p*rs+j*cs], into column panels of width nr: within a
+	 panel the nr elements of each row are adjacent. */
+      template <typename ValueType, unsigned int nr>
+	void pack_b (const unsigned int  kc,
+		     const unsigned int  nc,
+		     const ValueType    *B,
+		     const unsigned int  rs,
+		     const unsigned int  cs,
+		     const bool          conj,
+		     ValueType          *buffer)
+	{
+	  for (unsigned int j0=0; j0<nc; j0+=nr, buffer+=nr*kc)
+	    {
+	      const unsigned int cols = min (nr, nc-j0);
+	      const ValueType   *b    = B + j0*cs;
+
+	      if (cs == 1)
+		for (unsigned int p=0; p<kc; ++p)
+		  for (unsigned int j=0; j<cols; ++j)
+		    buffer[p*nr+j] = conj ? math::conjugate (b[p*rs+j]) : b[p*rs+j];
+	      else
+		for (unsigned int j=0; j<cols; ++j)
+		  for (unsigned int p=0; p<kc; ++p)
+		    buffer[p*nr+j] = conj ? math::conjugate (b[p*rs+j*cs]) : b[p*rs+j*cs];
+
+	      for (unsigned int p=0; p<kc; ++p)
+		for (unsigned int j=cols; j<nr; ++j)
+		  buffer[p*nr+j] = ValueType (0);
+	    }
+	}
+
+      /* The register-tiled micro-kernel: ab = a*b where a is an mr x
+	 kc row panel and b is a kc x nr column panel. The accumulator
+	 block is small enough to be held in registers and the inner
+	 loop is a rank-one update the compiler can vectorise. */
+      template <unsigned int mr, unsigned int nr>
+	inline
+	void kernel (const unsigned int  kc,
+		     const double       *a,
+		     const double       *b,
+		     double             *ab)
+	{
+	  double c[mr*nr];
+	  for (unsigned int i=0; i<mr*nr; ++i)
+	    c[i] = 0.;
+
+	  for (unsigned int p=0; p<kc; ++p, a+=mr, b+=nr)
+	    for (unsigned int i=0; i<mr; ++i)
+	      {
+		const double a_i = a[i];
+		for (unsigned int j=0; j<nr; ++j)
+		  c[i*nr+j] += a_i*b[j];
+	      }
+
+	  for (unsigned int i=0; i<mr*nr; ++i)
+	    ab[i] = c[i];
+	}
+
+      /* Same as above for complex numbers: real and imaginary parts
+	 are accumulated separately, which avoids the slow (but
+	 IEEE-careful) library complex multiplication. */
+      template <unsigned int mr, unsigned int nr>
+	inline
+	void kernel (const unsigned int          kc,
+		     const std::complex<double> *a,
+		     const std::complex<double> *b,
+		     std::complex<double>       *ab)
+	{
+	  const double *x = reinterpret_cast<const double*> (a);
+	  const double *y = reinterpret_cast<const double*> (b);
+
+	  double re[mr*nr];
+	  double im[mr*nr];
+	  for (unsigned int i=0; i<mr*nr; ++i)
+	    re[i] = im[i] = 0.;
+
+	  for (unsigned int p=0; p<kc; ++p, x+=2*mr, y+=2*nr)
+	    for (unsigned int i=0; i<mr; ++i)
+	      {
+		const double x_re = x[2*i];
+		const double x_im = x[2*i+1];
+		for (unsigned int j=0; j<nr; ++j)
+		  {
+		    re[i*nr+j] += x_re*y[2*j]   - x_im*y[2*j+1];
+		    im[i*nr+j] += x_re*y[2*j+1] + x_im*y[2*j];
+		  }
+	      }
+
+	  for (unsigned int i=0; i<mr*nr; ++i)
+	    ab[i] = std::complex<double> (re[i], im[i]);
+	}
+
+      /* C = beta*C + alpha*ab on the rows x cols corner of an mr x nr
+	 block; a zero beta never reads C. */
+      template <typename ValueType, unsigned int nr>
+	inline
+	void update (const unsigned int  rows,
+		     const unsigned int  cols,
+		     const ValueType     alpha,
+		     const ValueType    *ab,
+		     const ValueType     beta,
+		     ValueType          *C,
+		     const unsigned int  ldc)
+	{
+	  if (beta == ValueType (0))
+	    for (unsigned int i=0; i<rows; ++i)
+	      for (unsigned int j=0; j<cols; ++j)
+		C[i*ldc+j] = alpha*ab[i*nr+j];
+
+	  else if (beta == ValueType (1))
+	    for (unsigned int i=0; i<rows; ++i)
+	      for (unsigned int j=0; j<cols; ++j)
+		C[i*ldc+j] += alpha*ab[i*nr+j];
+
+	  else
+	    for (unsigned int i=0; i<rows; ++i)
+	      for (unsigned int j=0; j<cols; ++j)
+		C[i*ldc+j] = beta*C[i*ldc+j] + alpha*ab[i*nr+j];
+	}
+
+      /* Scale C by beta, the whole product when k or alpha vanish. */
+      template <typename ValueType>
+	void scale (const unsigned int  m,
+		    const unsigned int  n,
+		    const ValueType     beta,
+		    ValueType          *C,
+		    const unsigned int  ldc)
+	{
+	  if (beta == ValueType (1))
+	    return;
+
+	  for (unsigned int i=0; i<m; ++i)
+	    for (unsigned int j=0; j<n; ++j)
+	      C[i*ldc+j] = (beta == ValueType (0)) ? ValueType (0) : beta*C[i*ldc+j];
+	}
+
+      /* The single-threaded engine. */
+      template <typename ValueType>
+	  void gemm_serial (const Operation    op_a,
+			    const Operation    op_b,
+			    const unsigned int m,
+			    const unsigned int n,
+			    const unsigned int k,
+			    const ValueType    alpha,
+			    const ValueType   *A,
+			    const unsigned int lda,
+			    const ValueType   *B,
+			    const unsigned int ldb,
+			    const ValueType    beta,
+			    ValueType         *C,
+			    const unsigned int ldc)
+      {
+	typedef Blocking<ValueType> blocking;
+	const unsigned int mr = blocking::mr;
+	const unsigned int nr = blocking::nr;
+
+	if ((m == 0) || (n == 0))
+	  return;
+
+	if ((k == 0) || (alpha == ValueType (0)))
+	  {
+	    scale (m, n, beta, C, ldc);
+	    return;
+	  }
+
+	/* Express op(A) and op(B) as strided views so that the packing
+	   routines absorb any transposition. */
+	const unsigned int rs_a = (op_a == no_transpose) ? lda : 1;
+	const unsigned int cs_a = (op_a == no_transpose) ? 1   : lda;
+	const unsigned int rs_b = (op_b == no_transpose) ? ldb : 1;
+	const unsigned int cs_b = (op_b == no_transpose) ? 1   : ldb;
+	const bool       conj_a = (op_a == conjugate_transpose);
+	const bool       conj_b = (op_b == conjugate_transpose);
+
+	static thread_local Workspace<ValueType> workspace;
+	ValueType *packed_a = workspace.packed_a (std::size_t (blocking::mc)*blocking::kc);
+	ValueType *packed_b = workspace.packed_b (std::size_t (blocking::kc)*blocking::nc);
+
+	ValueType ab[mr*nr];
+
+	for (unsigned int jc=0; jc<n; jc+=blocking::nc)
+	  {
+	    const unsigned int nc = min (blocking::nc, n-jc);
+
+	    for (unsigned int pc=0; pc<k; pc+=blocking::kc)
+	      {
+		const unsigned int kc = min (blocking::kc, k-pc);
+
+		/* Only the first pass over k sees the caller's beta; all
+		   later passes accumulate onto it. */
+		const ValueType beta_pc = (pc == 0) ? beta : ValueType (1);
+
+		pack_b<ValueType, nr> (kc, nc, B + pc*rs_b + jc*cs_b, rs_b, cs_b, conj_b, packed_b);
+
+		for (unsigned int ic=0; ic<m; ic+=blocking::mc)
+		  {
+		    const unsigned int mc = min (blocking::mc, m-ic);
+
+		    pack_a<ValueType, mr> (mc, kc, A + ic*rs_a + pc*cs_a, rs_a, cs_a, conj_a, packed_a);
+
+		    for (unsigned int jr=0; jr<nc; jr+=nr)
+		      for (unsigned int ir=0; ir<mc; ir+=mr)
+			{
+			  kernel<mr, nr> (kc, packed_a + ir*kc, packed_b + jr*kc, ab);
+
+			  update<ValueType, nr> (min (mr, mc-ir), min (nr, nc-jr),
+						 alpha, ab, beta_pc,
+						 C + (ic+ir)*ldc + jc+jr, ldc);
+			}
+		  }
+	      }
+	  }
+      }
+
+      /* Products below this size are not worth waking the pool
+	 for. */
+      std::size_t threshold = 128*128*128;
+
+    } /* namespace */
+
+
+    std::size_t gemm_threshold ()
+    {
+      return threshold;
+    }
+
+    void set_gemm_threshold (const std::size_t n_operations)
+    {
+      threshold = n_operations;
+    }
+
+    template <typename ValueType>
+      void gemm (const Operation    op_a,
+		 const Operation    op_b,
+		 const unsigned int m,
+		 const unsigned int n,
+		 const unsigned int k,
+		 const ValueType    alpha,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 const ValueType   *B,
+		 const unsigned int ldb,
+		 const ValueType    beta,
+		 ValueType         *C,
+		 const unsigned int ldc)
+    {
+      typedef Blocking<ValueType> blocking;
+
+      ThreadPool &pool = ThreadPool::instance ();
+      const unsigned int n_threads = pool.n_threads ();
+
+      if ((n_threads == 1) || 
+	  (std::size_t (m)*n*k < threshold))
+	{
+	  gemm_serial (op_a, op_b, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+	  return;
+	}
+
+      /* Cut C into a grid of about as many tiles as there are
+	 threads, with the grid shaped like C so that tiles are close
+	 to square, and with tile edges on register tile boundaries. */
+      const unsigned int max_rows = (m+blocking::mr-1)/blocking::mr;
+      const unsigned int max_cols = (n+blocking::nr-1)/blocking::nr;
+
+      unsigned int grid_rows = static_cast<unsigned int> (std::sqrt (double (n_threads)*m/n) + 0.5);
+      grid_rows = min (max_rows, (grid_rows > 0) ? grid_rows : 1);
+
+      unsigned int grid_cols = (n_threads+grid_rows-1)/grid_rows;
+      grid_cols = min (max_cols, grid_cols);
+
+      const unsigned int tile_rows = ((max_rows+grid_rows-1)/grid_rows)*blocking::mr;
+      const unsigned int tile_cols = ((max_cols+grid_cols-1)/grid_cols)*blocking::nr;
+
+      grid_rows = (m+tile_rows-1)/tile_rows;
+      grid_cols = (n+tile_cols-1)/tile_cols;
+
+      /* The (i,j)th element of op(A) (op(B)) lives i (j) strides away
+	 from the first, so a tile only needs shifted operands. */
+      const unsigned int rs_a = (op_a == no_transpose) ? lda : 1;
+      const unsigned int cs_b = (op_b == no_transpose) ? 1   : ldb;
+
+      pool.run (grid_rows*grid_cols,
+		[&] (const unsigned int tile)
+		{
+		  const unsigned int i0 = (tile/grid_cols)*tile_rows;
+		  const unsigned int j0 = (tile%grid_cols)*tile_cols;
+
+		  gemm_serial (op_a, op_b,
+			       min (tile_rows, m-i0), min (tile_cols, n-j0), k,
+			       alpha, A + std::size_t (i0)*rs_a, lda,
+			       B + std::size_t (j0)*cs_b, ldb,
+			       beta, C + std::size_t (i0)*ldc + j0, ldc);
+		});
+    }
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#include "gemm.inst"
@@ -0,0 +1,202 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/gemv.h>
+#include <ewalena/lac/vector_kernels.h>
+#include <ewalena/base/memory.h>
+#include <ewalena/base/thread_pool.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    namespace
+    {
+
+      inline
+	unsigned int min (const unsigned int a,
+			  const unsigned int b)
+      {
+	return (a < b) ? a : b;
+      }
+
+      /* y = beta y, without reading y if beta is zero. */
+      template <typename ValueType>
+	void scale_or_zero (const unsigned int  n,
+			    const ValueType     beta,
+			    ValueType          *y)
+	{
+	  if (beta == ValueType (0))
+	    for (unsigned int i=0; i<n; ++i)
+	      y[i] = ValueType (0);
+	  else if (beta != ValueType (1))
+	    scale (n, beta, y);
+	}
+
+      /* Rows i0 to i1 of y = alpha A x + beta y. */
+      template <typename ValueType>
+	void gemv_rows (const unsigned int  i0,
+			const unsigned int  i1,
+			const unsigned int  n,
+			const ValueType     alpha,
+			const ValueType    *A,
+			const unsigned int  lda,
+			const ValueType    *x,
+			const ValueType     beta,
+			ValueType          *y)
+	{
+	  for (unsigned int i=i0; i<i1; ++i)
+	    {
+	      const ValueType sum = alpha*dotu (n, A + std::size_t (i)*lda, x);
+	      y[i] = (beta == ValueType (0)) ? sum : beta*y[i] + sum;
+	    }
+	}
+
+      /* Elements j0 to j1 of y = alpha op(A) x + beta y for the
+	 (conjugate) transpose of the m x n array A. */
+      template <typename ValueType>
+	void gemv_columns (const bool          conj,
+			   const unsigned int  j0,
+			   const unsigned int  j1,
+			   const unsigned int  m,
+			   const ValueType     alpha,
+			   const ValueType    *A,
+			   const unsigned int  lda,
+			   const ValueType    *x,
+			   const ValueType     beta,
+			   ValueType          *y)
+	{
+	  scale_or_zero (j1-j0, beta, y+j0);
+
+	  for (unsigned int i=0; i<m; ++i)
+	    {
+	      const ValueType a = alpha*x[i];
+	      if (a == ValueType (0))
+		continue;
+
+	      const ValueType *row = A + std::size_t (i)*lda + j0;
+	      if (conj)
+		axpy_conj (j1-j0, a, row, y+j0);
+	      else
+		axpy (j1-j0, a, row, y+j0);
+	    }
+	}
+
+      /* The number of elements of y a thread updates at a time in
+	 the transposed forms: a slice of y this long stays in L1
+	 while the rows of A stream past it. */
+      const unsigned int column_block = 512;
+
+      /* Products below this size are not worth waking the pool
+	 for. */
+      std::size_t threshold = 256*256;
+
+    } /* namespace */
+
+
+    std::size_t gemv_threshold ()
+    {
+      return threshold;
+    }
+
+    void set_gemv_threshold (const std::size_t n_elements)
+    {
+      threshold = n_elements;
+    }
+
+    template <typename ValueType>
+      void gemv (const Operation    op_a,
+		 const unsigned int m,
+		 const unsigned int n,
+		 const ValueType    alpha,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 const ValueType   *x,
+		 const ValueType    beta,
+		 ValueType         *y)
+    {
+      const bool   conj = (op_a == conjugate_transpose);
+      const unsigned int m_y = (op_a == no_transpose) ? m : n;
+
+      if (m_y == 0)
+	return;
+
+      ThreadPool &pool = ThreadPool::instance ();
+      const unsigned int n_threads = pool.n_threads ();
+
+      const bool parallel = (n_threads > 1) && (std::size_t (m)*n >= threshold);
+
+      /* Cut y into blocks with edges on cache lines, so that no two
+	 threads write to the same one. Rows are cut into a block per
+	 thread. Columns are always cut into blocks of the same size,
+	 because the vector kernels round the ends of a block
+	 differently from its middle; this keeps the result the same
+	 for any number of threads. */
+      const unsigned int line  = memory::alignment/sizeof (ValueType);
+      unsigned int       block = m_y;
+
+      if (op_a != no_transpose)
+	block = column_block;
+      else if (parallel)
+	block = ((m_y + n_threads - 1)/n_threads + line - 1)/line*line;
+
+      const unsigned int n_blocks = (m_y + block - 1)/block;
+
+      const std::function<void (const unsigned int)> task = 
+	[&] (const unsigned int b)
+	{
+	  const unsigned int i0 = b*block;
+	  const unsigned int i1 = min (m_y, i0+block);
+
+	  if (op_a == no_transpose)
+	    gemv_rows (i0, i1, n, alpha, A, lda, x, beta, y);
+	  else
+	    gemv_columns (conj, i0, i1, m, alpha, A, lda, x, beta, y);
+	};
+
+      if (parallel)
+	pool.run (n_blocks, task);
+      else
+	for (unsigned int b=0; b<n_blocks; ++b)
+	  task (b);
+    }
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#include "gemv.inst"
@@ -0,0 +1,694 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/math.h>
+#include <ewalena/lac/gemm.h>
+#include <ewalena/lac/gemv.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include <ewalena/lac/householder.h>
+#include <ewalena/lac/vector_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of Householder reflectors that are accumulated
+       before the trailing matrix, or the eigenvectors, are updated
+       by blas::gemm. */
+    const unsigned int block_size = 32;
+
+    /* The size below which a tridiagonal problem is not divided any
+       further, but solved by the QL method. */
+    const unsigned int leaf_size = 25;
+
+    /* The largest number of QL iterations for one eigenvalue. */
+    const unsigned int max_ql_iterations = 60;
+
+    const double epsilon = std::numeric_limits<double>::epsilon ();
+
+    /* Reduce the n x n Hermitian column-major array a to real
+       symmetric tridiagonal form T = Q^H A Q, with diagonal d and
+       off-diagonal e. Q is the product of the reflectors
+       I - tau_c v_c v_c^H, c<n-1, where v_c is stored below the
+       diagonal of column c of a, including its leading one.
+
+       The reflectors are found a panel of block_size columns at a
+       time. Within a panel, the columns and the products with the
+       trailing matrix are corrected for the reflectors of the panel
+       so far, v_j and w_j, and after the panel the trailing matrix
+       is updated as A -= VW^H + WV^H by blas::gemm. */
+    template <typename ValueType>
+      void tridiagonalize (const unsigned int  n,
+			   ValueType          *a,
+			   double             *d,
+			   double             *e,
+			   ValueType          *tau)
+      {
+	std::vector<ValueType> w (std::size_t (n)*block_size);
+
+	const auto A = [&] (const unsigned int i, const unsigned int j) -> ValueType&
+	  {
+	    return a[std::size_t (j)*n+i];
+	  };
+
+	const auto W = [&] (const unsigned int i, const unsigned int j) -> ValueType*
+	  {
+	    return &w[std::size_t (j)*n+i];
+	  };
+
+	for (unsigned int i0=0; i0+1<n; i0+=block_size)
+	  {
+	    const unsigned int nb = std::min (block_size, n-1-i0);
+
+	    for (unsigned int jj=0; jj<nb; ++jj)
+	      {
+		const unsigned int c = i0+jj;
+
+		/* Column c of the matrix updated by the panel so far. */
+		for (unsigned int j=0; j<jj; ++j)
+		  {
+		    blas::axpy (n-c, -math::conjugate (*W (c, j)), &A (c, i0+j), &A (c, c));
+		    blas::axpy (n-c, -math::conjugate (A (c, i0+j)), W (c, j), &A (c, c));
+		  }
+		A (c, c) = ValueType (std::real (A (c, c)));
+
+		/* The reflector that annihilates A(c+2:n, c). */
+		ValueType alpha = A (c+1, c);
+		tau[c] = blas::householder (n-c-2, alpha, (c+2 < n) ? &A (c+2, c) : 0);
+		e[c]   = std::real (alpha);
+
+		A (c+1, c) = ValueType (1);
+
+		const unsigned int m = n-c-1;
+		const ValueType   *v = &A (c+1, c);
+		ValueType         *y = W (c+1, jj);
+
+		/* y = tau (A - VW^H - WV^H) v, then y -= (tau/2)(y^H v) v,
+		   with the trailing matrix as yet unchanged by the
+		   panel. */
+		blas::gemv (blas::transpose, m, m, ValueType (1), &A (c+1, c+1), n, v, ValueType (0), y);
+
+		for (unsigned int j=0; j<jj; ++j)
+		  {
+		    const ValueType s = blas::dot (m, &A (c+1, i0+j), v);
+		    const ValueType t = blas::dot (m, W (c+1, j), v);
+		    blas::axpy (m, -s, W (c+1, j), y);
+		    blas::axpy (m, -t, &A (c+1, i0+j), y);
+		  }
+
+		blas::scale (m, tau[c], y);
+		blas::axpy (m, ValueType (-0.5)*tau[c]*blas::dot (m, y, v), v, y);
+	      }
+
+	    /* The trailing matrix, as a row-major array its transpose:
+	       A^T -= conj(W) V^T + conj(V) W^T. */
+	    const unsigned int r = i0+nb;
+	    const unsigned int m = n-r;
+
+	    blas::gemm (blas::conjugate_transpose, blas::no_transpose, m, m, nb,
+			ValueType (-1), W (r, 0), n, &A (r, i0), n,
+			ValueType (1), &A (r, r), n);
+	    blas::gemm (blas::conjugate_transpose, blas::no_transpose, m, m, nb,
+			ValueType (-1), &A (r, i0), n, W (r, 0), n,
+			ValueType (1), &A (r, r), n);
+	  }
+
+	for (unsigned int i=0; i<n; ++i)
+	  d[i] = std::real (A (i, i));
+	if (n != 0)
+	  e[n-1] = 0.;
+      }
+
+    /* Overwrite the n x n column-major array z with Qz, where Q is
+       the product of the reflectors stored in a by tridiagonalize.
+       A block of reflectors H_i0 ... H_i0+nb-1 is applied at once as
+       I - VTV^H, with T upper triangular, by blas::gemm. */
+    template <typename ValueType>
+      void apply_reflectors (const unsigned int  n,
+			     const ValueType    *a,
+			     const ValueType    *tau,
+			     ValueType          *z)
+      {
+	if (n < 2)
+	  return;
+
+	std::vector<ValueType> v (std::size_t (n)*block_size);
+	std::vector<ValueType> T (block_size*block_size);
+	std::vector<ValueType> y (std::size_t (n)*block_size);
+	std::vector<ValueType> yt (std::size_t (n)*block_size);
+
+	for (unsigned int i0=((n-2)/block_size)*block_size; ; i0-=block_size)
+	  {
+	    const unsigned int nb = std::min (block_size, n-1-i0);
+	    const unsigned int c0 = i0+1;
+	    const unsigned int m  = n-c0;
+
+	    /* The reflectors as an m x nb column-major array, with the
+	       zeros above their leading ones. */
+	    std::fill (v.begin (), v.end (), ValueType (0));
+	    for (unsigned int j=0; j<nb; ++j)
+	      {
+		ValueType *v_j = &v[std::size_t (j)*m];
+		v_j[j] = ValueType (1);
+		std::copy (a + std::size_t (i0+j)*n + c0+j+1, a + std::size_t (i0+j+1)*n, v_j+j+1);
+	      }
+
+	    blas::householder_factor (m, nb, &v[0], m, tau+i0, &T[0], block_size);
+
+	    /* As row-major arrays, with V^T stored as v: Y^T =
+	       Z^T conj(V), Y^T := Y^T T^T, Z^T -= Y^T V^T. */
+	    blas::gemm (blas::no_transpose, blas::conjugate_transpose, n, nb, m,
+			ValueType (1), z + c0, n, &v[0], m,
+			ValueType (0), &y[0], nb);
+	    blas::gemm (blas::no_transpose, blas::transpose, n, nb, nb,
+			ValueType (1), &y[0], nb, &T[0], block_size,
+			ValueType (0), &yt[0], nb);
+	    blas::gemm (blas::no_transpose, blas::no_transpose, n, m, nb,
+			ValueType (-1), &yt[0], nb, &v[0], m,
+			ValueType (1), z + c0, n);
+
+	    if (i0 == 0)
+	      break;
+	  }
+      }
+
+    /* The eigenvalues d, and if q is not zero the eigenvectors, of
+       the n x n symmetric tridiagonal matrix with diagonal d and
+       off-diagonal e by the implicit QL method with Wilkinson
+       shifts. The rotations are applied to the columns of the
+       column-major array q, whose leading dimension is ldq. e is
+       overwritten, and e[n-1] must be zero. */
+    void tridiagonal_ql (const unsigned int  n,
+			 double             *d,
+			 double             *e,
+			 double             *q,
+			 const unsigned int  ldq)
+    {
+      for (unsigned int l=0; l<n; ++l)
+	{
+	  for (unsigned int iteration=0; ; ++iteration)
+	    {
+	      unsigned int m = l;
+	      for (; m+1<n; ++m)
+		if (std::abs (e[m]) <= epsilon*(std::abs (d[m]) + std::abs (d[m+1])))
+		  break;
+
+	      if (m == l || iteration == max_ql_iterations)
+		break;
+
+	      double g = (d[l+1]-d[l])/(2.*e[l]);
+	      double r = std::hypot (g, 1.);
+	      g = d[m] - d[l] + e[l]/(g + std::copysign (r, g));
+
+	      double s = 1., c = 1., p = 0.;
+	      bool underflow = false;
+
+	      for (int i=int (m)-1; i>=int (l); --i)
+		{
+		  const double f = s*e[i];
+		  const double b = c*e[i];
+		  r = std::hypot (f, g);
+		  e[i+1] = r;
+
+		  if (r == 0.)
+		    {
+		      d[i+1] -= p;
+		      e[m]    = 0.;
+		      underflow = true;
+		      break;
+		    }
+
+		  s = f/r;
+		  c = g/r;
+		  g = d[i+1] - p;
+		  r = (d[i]-g)*s + 2.*c*b;
+		  p = s*r;
+		  d[i+1] = g + p;
+		  g = c*r - b;
+
+		  if (q != 0)
+		    {
+		      double *q_i    = q + std::size_t (i)*ldq;
+		      double *q_next = q_i + ldq;
+		      for (unsigned int k=0; k<n; ++k)
+			{
+			  const double t = q_next[k];
+			  q_next[k] = s*q_i[k] + c*t;
+			  q_i[k]    = c*q_i[k] - s*t;
+			}
+		    }
+		}
+
+	      if (underflow)
+		continue;
+
+	      d[l] -= p;
+	      e[l]  = g;
+	      e[m]  = 0.;
+	    }
+	}
+    }
+
+    /* Sort the eigenvalues d ascending, and the n columns of length
+       n of the column-major array q (leading dimension ldq) with
+       them. */
+    void sort (const unsigned int  n,
+	       double             *d,
+	       double             *q,
+	       const unsigned int  ldq)
+    {
+      std::vector<unsigned int> order (n);
+      std::iota (order.begin (), order.end (), 0);
+      std::stable_sort (order.begin (), order.end (),
+			[&] (const unsigned int i, const unsigned int j)
+			{
+			  return d[i] < d[j];
+			});
+
+      const std::vector<double> d_copy (d, d+n);
+      std::vector<double> q_copy (std::size_t (n)*n);
+      for (unsigned int j=0; j<n; ++j)
+	std::copy (q + std::size_t (j)*ldq, q + std::size_t (j)*ldq + n, &q_copy[std::size_t (j)*n]);
+
+      for (unsigned int j=0; j<n; ++j)
+	{
+	  d[j] = d_copy[order[j]];
+	  std::copy (&q_copy[std::size_t (order[j])*n], &q_copy[std::size_t (order[j])*n] + n,
+		     q + std::size_t (j)*ldq);
+	}
+    }
+
+    /* Return the root tau of the secular equation 1 + sum_i
+       w_i^2/(delta_i - tau) = 0 between lower and upper, where delta
+       are the poles shifted by the origin of tau, so that the
+       distances to the nearest poles are accurate. The function
+       increases between its poles, and is bracketed by bisection
+       while Newton steps take over as they can. */
+    double secular_root (const unsigned int  k,
+			 const double       *delta,
+			 const double       *w,
+			 double              lower,
+			 double              upper)
+    {
+      double tau = 0.5*(lower+upper);
+
+      for (unsigned int iteration=0; iteration<200; ++iteration)
+	{
+	  double f = 1., df = 0.;
+	  for (unsigned int i=0; i<k; ++i)
+	    {
+	      const double t = w[i]/(delta[i]-tau);
+	      f  += w[i]*t;
+	      df += t*t;
+	    }
+
+	  if (f == 0.)
+	    break;
+	  if (f < 0.)
+	    lower = tau;
+	  else
+	    upper = tau;
+
+	  double tau_next = tau - f/df;
+	  if (!(tau_next > lower && tau_next < upper))
+	    tau_next = 0.5*(lower+upper);
+
+	  const bool converged = (std::abs (tau_next-tau) <= 2.*epsilon*std::abs (tau_next))
+	    || (upper-lower <= 2.*epsilon*std::max (std::abs (lower), std::abs (upper)));
+
+	  tau = tau_next;
+	  if (converged)
+	    break;
+	}
+
+      return tau;
+    }
+
+    /* The eigensystem of Q diag(d) Q^T + rho z z^T, where the n
+       columns of the column-major array q (leading dimension ldq)
+       are orthonormal, z is given in their basis, and rho > 0.
+       Eigenvalues that are (numerically) eigenvalues of diag(d) are
+       deflated; the others are the roots of the secular equation,
+       and their eigenvectors are recomputed from them (Gu and
+       Eisenstat) so that they are orthogonal. On return d is
+       ascending and q holds the eigenvectors. */
+    void merge (const unsigned int  n,
+		double             *d,
+		double             *z,
+		double              rho,
+		double             *q,
+		const unsigned int  ldq)
+    {
+      /* Normalise z, and sort by d. */
+      const double z_norm = blas::nrm2 (n, z);
+      rho *= z_norm*z_norm;
+      for (unsigned int i=0; i<n; ++i)
+	z[i] /= z_norm;
+
+      std::vector<unsigned int> order (n);
+      std::iota (order.begin (), order.end (), 0);
+      std::stable_sort (order.begin (), order.end (),
+			[&] (const unsigned int i, const unsigned int j)
+			{
+			  return d[i] < d[j];
+			});
+
+      double d_max = 0.;
+      for (unsigned int i=0; i<n; ++i)
+	d_max = std::max (d_max, std::abs (d[i]));
+      const double tolerance = 8.*epsilon*std::max (d_max, rho);
+
+      /* Deflation: a small component of z, or two close poles, of
+	 which a rotation zeroes one component. */
+      std::vector<unsigned int> kept;
+      std::vector<unsigned int> deflated;
+
+      for (unsigned int s=0; s<n; ++s)
+	{
+	  const unsigned int i = order[s];
+
+	  if (rho*std::abs (z[i]) <= tolerance)
+	    {
+	      deflated.push_back (i);
+	      continue;
+	    }
+
+	  if (!kept.empty ())
+	    {
+	      const unsigned int p = kept.back ();
+
+	      const double tau = std::hypot (z[p], z[i]);
+	      const double c   =  z[i]/tau;
+	      const double s   = -z[p]/tau;
+
+	      if (std::abs ((d[i]-d[p])*c*s) <= tolerance)
+		{
+		  double *q_p = q + std::size_t (p)*ldq;
+		  double *q_i = q + std::size_t (i)*ldq;
+		  for (unsigned int k=0; k<n; ++k)
+		    {
+		      const double x = q_p[k];
+		      const double y = q_i[k];
+		      q_p[k] = c*x + s*y;
+		      q_i[k] = c*y - s*x;
+		    }
+
+		  const double d_p = d[p]*c*c + d[i]*s*s;
+		  d[i] = d[p]*s*s + d[i]*c*c;
+		  d[p] = d_p;
+		  z[i] = tau;
+		  z[p] = 0.;
+
+		  kept.back () = i;
+		  deflated.push_back (p);
+		  continue;
+		}
+	    }
+
+	  kept.push_back (i);
+	}
+
+      /* The rotations may have left the kept poles out of order. */
+      std::stable_sort (kept.begin (), kept.end (),
+			[&] (const unsigned int i, const unsigned int j)
+			{
+			  return d[i] < d[j];
+			});
+
+      const unsigned int k = kept.size ();
+
+      std::vector<double> lambda (n);
+      std::vector<double> q_new (std::size_t (n)*n);
+
+      /* Deflated eigenpairs are those of diag(d). */
+      for (unsigned int s=0; s<deflated.size (); ++s)
+	{
+	  const unsigned int i = deflated[s];
+	  lambda[k+s] = d[i];
+	  std::copy (q + std::size_t (i)*ldq, q + std::size_t (i)*ldq + n, &q_new[std::size_t (k+s)*n]);
+	}
+
+      if (k != 0)
+	{
+	  std::vector<double> d_k (k), w (k), delta (k);
+	  std::vector<unsigned int> origin (k);
+	  std::vector<double> tau (k);
+
+	  const double sqrt_rho = std::sqrt (rho);
+	  double w_norm2 = 0.;
+	  for (unsigned int j=0; j<k; ++j)
+	    {
+	      d_k[j] = d[kept[j]];
+	      w[j]   = sqrt_rho*z[kept[j]];
+	      w_norm2 += w[j]*w[j];
+	    }
+
+	  /* Root j lies between poles j and j+1, or above the last
+	     one; it is found relative to the nearer pole. */
+	  for (unsigned int j=0; j<k; ++j)
+	    {
+	      if (j+1 == k)
+		origin[j] = j;
+	      else
+		{
+		  const double middle = 0.5*(d_k[j]+d_k[j+1]);
+		  double f = 1.;
+		  for (unsigned int i=0; i<k; ++i)
+		    f += w[i]*w[i]/(d_k[i]-middle);
+		  origin[j] = (f >= 0.) ? j : j+1;
+		}
+
+	      const unsigned int o = origin[j];
+	      for (unsigned int i=0; i<k; ++i)
+		delta[i] = d_k[i]-d_k[o];
+
+	      double lower, upper;
+	      if (j+1 == k)
+		{
+		  lower = 0.;
+		  upper = w_norm2;
+		}
+	      else if (o == j)
+		{
+		  lower = 0.;
+		  upper = 0.5*delta[j+1];
+		}
+	      else
+		{
+		  lower = 0.5*delta[j];
+		  upper = 0.;
+		}
+
+	      tau[j]    = secular_root (k, &delta[0], &w[0], lower, upper);
+	      lambda[j] = d_k[o] + tau[j];
+	    }
+
+	  /* The distance d_i - lambda_j, accurately. */
+	  const auto distance = [&] (const unsigned int i, const unsigned int j)
+	    {
+	      return (d_k[i] - d_k[origin[j]]) - tau[j];
+	    };
+
+	  /* The vector w for which the roots are exact (Loewner). */
+	  std::vector<double> w_hat (k);
+	  for (unsigned int i=0; i<k; ++i)
+	    {
+	      double product = -distance (i, i);
+	      for (unsigned int j=0; j<k; ++j)
+		if (j != i)
+		  product *= distance (i, j)/(d_k[i]-d_k[j]);
+	      w_hat[i] = std::copysign (std::sqrt (std::abs (product)), w[i]);
+	    }
+
+	  /* The eigenvectors in the basis of the kept columns, and
+	     then in that of the matrix by blas::gemm. */
+	  std::vector<double> u (std::size_t (k)*k);
+	  for (unsigned int j=0; j<k; ++j)
+	    {
+	      double *u_j = &u[std::size_t (j)*k];
+	      for (unsigned int i=0; i<k; ++i)
+		u_j[i] = w_hat[i]/distance (i, j);
+
+	      const double norm = blas::nrm2 (k, u_j);
+	      for (unsigned int i=0; i<k; ++i)
+		u_j[i] /= norm;
+	    }
+
+	  std::vector<double> q_k (std::size_t (n)*k);
+	  for (unsigned int j=0; j<k; ++j)
+	    std::copy (q + std::size_t (kept[j])*ldq, q + std::size_t (kept[j])*ldq + n,
+		       &q_k[std::size_t (j)*n]);
+
+	  /* As row-major arrays: Q_new^T = U^T Q_k^T. */
+	  blas::gemm (blas::no_transpose, blas::no_transpose, k, n, k,
+		      1., &u[0], k, &q_k[0], n,
+		      0., &q_new[0], n);
+	}
+
+      for (unsigned int j=0; j<n; ++j)
+	{
+	  d[j] = lambda[j];
+	  std::copy (&q_new[std::size_t (j)*n], &q_new[std::size_t (j)*n] + n, q + std::size_t (j)*ldq);
+	}
+
+      sort (n, d, q, ldq);
+    }
+
+    /* The eigensystem of the n x n symmetric tridiagonal matrix with
+       diagonal d and off-diagonal e by Cuppen's divide and conquer
+       method: the matrix is split in two by a rank-one modification,
+       the halves are solved recursively, and their eigensystems
+       merged. The eigenvectors are written to the columns of the
+       column-major array q (leading dimension ldq), which must be
+       zero on input, and d becomes the ascending eigenvalues. */
+    void divide_and_conquer (const unsigned int  n,
+			     double             *d,
+			     const double       *e,
+			     double             *q,
+			     const unsigned int  ldq)
+    {
+      if (n <= leaf_size)
+	{
+	  std::vector<double> e_leaf (e, e+n);
+	  e_leaf[n-1] = 0.;
+
+	  for (unsigned int i=0; i<n; ++i)
+	    q[std::size_t (i)*ldq+i] = 1.;
+
+	  tridiagonal_ql (n, d, &e_leaf[0], q, ldq);
+	  sort (n, d, q, ldq);
+	  return;
+	}
+
+      /* T = diag(T_1, T_2) + |rho| u u^T, with u = e_m-1 + sgn(rho) e_m. */
+      const unsigned int m   = n/2;
+      const double       rho = e[m-1];
+      const double       sgn = (rho < 0.) ? -1. : 1.;
+
+      d[m-1] -= std::abs (rho);
+      d[m]   -= std::abs (rho);
+
+      divide_and_conquer (m,   d,   e,   q,                          ldq);
+      divide_and_conquer (n-m, d+m, e+m, q + std::size_t (m)*ldq+m, ldq);
+
+      /* u in the basis of the eigenvectors of the halves: the last
+	 row of Q_1 and the first row of Q_2. */
+      std::vector<double> z (n);
+      for (unsigned int i=0; i<m; ++i)
+	z[i] = q[std::size_t (i)*ldq + m-1];
+      for (unsigned int i=m; i<n; ++i)
+	z[i] = sgn*q[std::size_t (i)*ldq + m];
+
+      if (rho == 0.)
+	sort (n, d, q, ldq);
+      else
+	merge (n, d, &z[0], std::abs (rho), q, ldq);
+    }
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  HermitianEigensolver<ValueType>::HermitianEigensolver ()
+  {}
+
+  template <typename ValueType>
+  HermitianEigensolver<ValueType>::HermitianEigensolver (const Matrix<ValueType> &M,
+							 const bool               compute_eigenvectors)
+  {
+    compute (M, compute_eigenvectors);
+  }
+
+  template <typename ValueType>
+  void
+  HermitianEigensolver<ValueType>::compute (const Matrix<ValueType> &M,
+					    const bool               compute_eigenvectors)
+  {
+    assert (M.n_rows () == M.n_cols ());
+
+    const unsigned int n = M.n_rows ();
+
+    __eigenvalues.resize (n);
+    __eigenvectors.reinit (0, 0);
+
+    if (n == 0)
+      return;
+
+    /* Work on a full Hermitian column-major copy built from the
+       upper triangle. */
+    std::vector<ValueType> a (std::size_t (n)*n);
+    for (unsigned int j=0; j<n; ++j)
+      {
+	for (unsigned int i=0; i<j; ++i)
+	  {
+	    a[std::size_t (j)*n+i] = M(i, j);
+	    a[std::size_t (i)*n+j] = math::conjugate (M(i, j));
+	  }
+	a[std::size_t (j)*n+j] = ValueType (std::real (M(j, j)));
+      }
+
+    std::vector<double>    e (n);
+    std::vector<ValueType> tau (n);
+
+    double *d = &__eigenvalues[0];
+    tridiagonalize (n, &a[0], d, &e[0], &tau[0]);
+
+    if (!compute_eigenvectors)
+      {
+	tridiagonal_ql (n, d, &e[0], 0, 0);
+	std::sort (__eigenvalues.begin (), __eigenvalues.end ());
+	return;
+      }
+
+    std::vector<double> q (std::size_t (n)*n, 0.);
+    divide_and_conquer (n, d, &e[0], &q[0], n);
+
+    std::vector<ValueType> z (q.begin (), q.end ());
+    apply_reflectors (n, &a[0], &tau[0], &z[0]);
+
+    __eigenvectors.reinit (n, n, false);
+    for (unsigned int i=0; i<n; ++i)
+      for (unsigned int j=0; j<n; ++j)
+	__eigenvectors(i, j) = z[std::size_t (j)*n+i];
+  }
+
+} // namepsace ewalena
+
+#include "hermitian_eigensolver.inst"
@@ -0,0 +1,140 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/householder.h>
+#include <ewalena/lac/vector_kernels.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    template <typename ValueType>
+      ValueType householder (const unsigned int  n,
+			     ValueType          &alpha,
+			     ValueType          *x)
+      {
+	const double x_norm = (n == 0) ? 0. : nrm2 (n, x);
+
+	if (x_norm == 0. && std::imag (alpha) == 0.)
+	  return ValueType (0);
+
+	const double beta 
+	  = -std::copysign (std::sqrt (std::norm (alpha) + x_norm*x_norm), std::real (alpha));
+
+	const ValueType tau = (ValueType (beta) - alpha)/beta;
+	if (n != 0)
+	  scale (n, ValueType (1)/(alpha - ValueType (beta)), x);
+	alpha = ValueType (beta);
+
+	return tau;
+      }
+
+
+    template <typename ValueType>
+      void householder_factor (const unsigned int  m,
+			       const unsigned int  k,
+			       const ValueType    *V,
+			       const unsigned int  ldv,
+			       const ValueType    *tau,
+			       ValueType          *T,
+			       const unsigned int  ldt)
+      {
+	std::vector<ValueType> t (k);
+
+	/* T(j,j) = tau_j and T(0:j,j) = -tau_j T(0:j,0:j) V(:,0:j)^H
+	   v_j, column by column. */
+	for (unsigned int j=0; j<k; ++j)
+	  {
+	    const ValueType *v_j = V + std::size_t (j)*ldv;
+
+	    for (unsigned int i=0; i<j; ++i)
+	      t[i] = -tau[j]*dot (m, V + std::size_t (i)*ldv, v_j);
+
+	    for (unsigned int i=0; i<j; ++i)
+	      {
+		ValueType sum = ValueType (0);
+		for (unsigned int l=i; l<j; ++l)
+		  sum += T[std::size_t (i)*ldt+l]*t[l];
+		T[std::size_t (i)*ldt+j] = sum;
+	      }
+	    T[std::size_t (j)*ldt+j] = tau[j];
+
+	    for (unsigned int i=j+1; i<k; ++i)
+	      T[std::size_t (i)*ldt+j] = ValueType (0);
+	  }
+      }
+
+
+    template <typename ValueType>
+      void householder_apply (const Operation     op_t,
+			      const unsigned int  m,
+			      const unsigned int  n,
+			      const unsigned int  k,
+			      const ValueType    *V,
+			      const unsigned int  ldv,
+			      const ValueType    *T,
+			      const unsigned int  ldt,
+			      ValueType          *B,
+			      const unsigned int  ldb)
+      {
+	if (m == 0 || n == 0 || k == 0)
+	  return;
+
+	/* V is stored as the row-major array V^T, and B enters as
+	   B^H, so that the n x k product W^H = B^H V, then X^H =
+	   W^H op(T)^H and finally B -= V X all read the operands
+	   where they are. */
+	std::vector<ValueType> w (std::size_t (n)*k);
+	std::vector<ValueType> x (std::size_t (n)*k);
+
+	gemm (conjugate_transpose, transpose, n, k, m,
+	      ValueType (1), B, ldb, V, ldv,
+	      ValueType (0), &w[0], k);
+	gemm (no_transpose, (op_t == no_transpose) ? conjugate_transpose : no_transpose, n, k, k,
+	      ValueType (1), &w[0], k, T, ldt,
+	      ValueType (0), &x[0], k);
+	gemm (transpose, conjugate_transpose, m, n, k,
+	      ValueType (-1), V, ldv, &x[0], k,
+	      ValueType (1), B, ldb);
+      }
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#include "householder.inst"
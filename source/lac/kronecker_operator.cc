@@ -0,0 +1,278 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/lac/gemm.h>
+#include <ewalena/lac/kronecker_operator.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of multiply-adds below which a slice of a mode
+       product is not worth a task of its own. */
+    const std::size_t threshold = 32768;
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  KroneckerOperator<ValueType>::KroneckerOperator (const std::vector<unsigned int> &dimensions)
+    :
+    __dimensions (dimensions),
+    __left (dimensions.size (), 1),
+    __right (dimensions.size (), 1)
+  {
+    assert (!dimensions.empty ());
+
+    std::uint64_t size = 1;
+    for (unsigned int k=0; k<dimensions.size (); ++k)
+      {
+	assert (dimensions[k] > 0);
+	__left[k] = size;
+	size     *= dimensions[k];
+	assert (size <= std::numeric_limits<unsigned int>::max ());
+      }
+
+    for (unsigned int k=dimensions.size ()-1; k>0; --k)
+      __right[k-1] = __right[k]*dimensions[k];
+  }
+
+  template <typename ValueType>
+  void
+  KroneckerOperator<ValueType>::add_term (const std::vector<Matrix<ValueType>> &factors,
+					  const ValueType                       coefficient)
+  {
+    assert (factors.size () == n_modes ());
+
+    std::vector<unsigned int> modes (n_modes ());
+    for (unsigned int k=0; k<n_modes (); ++k)
+      modes[k] = k;
+
+    add_term (modes, factors, coefficient);
+  }
+
+  template <typename ValueType>
+  void
+  KroneckerOperator<ValueType>::add_term (const std::vector<unsigned int>      &modes,
+					  const std::vector<Matrix<ValueType>> &factors,
+					  const ValueType                       coefficient)
+  {
+    assert (modes.size () == factors.size ());
+
+    /* The factors are applied in increasing order of their modes,
+       which commute, so the order they come in does not matter. */
+    std::vector<unsigned int> order (modes.size ());
+    for (unsigned int i=0; i<order.size (); ++i)
+      order[i] = i;
+
+    std::sort (order.begin (), order.end (),
+	       [&] (const unsigned int a, const unsigned int b)
+	       {
+		 return modes[a] < modes[b];
+	       });
+
+    Term term;
+    term.coefficient = coefficient;
+
+    for (unsigned int i=0; i<order.size (); ++i)
+      {
+	const unsigned int       k = modes[order[i]];
+	const Matrix<ValueType> &A = factors[order[i]];
+
+	assert (k < n_modes ());
+	assert (term.modes.empty () || term.modes.back () < k);
+	assert (A.n_rows () == __dimensions[k] && A.n_cols () == __dimensions[k]);
+
+	term.modes.push_back (k);
+	term.offsets.push_back (term.values.size ());
+	for (unsigned int r=0; r<A.n_rows (); ++r)
+	  for (unsigned int c=0; c<A.n_cols (); ++c)
+	    term.values.push_back (A(r, c));
+      }
+
+    __terms.push_back (term);
+  }
+
+  template <typename ValueType>
+  void
+  KroneckerOperator<ValueType>::mode_product (const unsigned int  k,
+					      const ValueType    *A,
+					      const ValueType     alpha,
+					      const ValueType    *x,
+					      const ValueType     beta,
+					      ValueType          *y) const
+  {
+    const unsigned int left  = __left[k];
+    const unsigned int d     = __dimensions[k];
+    const unsigned int right = __right[k];
+
+    /* On the last mode, the vector is a left x d matrix X and the
+       product is X A^T, one product large enough for gemm to run in
+       parallel on its own. */
+    if (right == 1)
+      {
+	blas::gemm (blas::no_transpose, blas::transpose,
+		    left, d, d,
+		    alpha, x, d, A, d,
+		    beta, y, d);
+	return;
+      }
+
+    /* Otherwise every one of the left slices is a d x right matrix
+       that A multiplies from the left. If there are fewer slices
+       than threads and each is large enough for gemm to run in
+       parallel on its own, it gets them one after the other. */
+    ThreadPool        &pool  = ThreadPool::instance ();
+    const std::size_t  slice = std::size_t (d)*d*right;
+
+    if (left < pool.n_threads () && slice >= blas::gemm_threshold ())
+      {
+	for (unsigned int l=0; l<left; ++l)
+	  blas::gemm (blas::no_transpose, blas::no_transpose,
+		      d, right, d,
+		      alpha, A, d, x + std::size_t (l)*d*right, right,
+		      beta, y + std::size_t (l)*d*right, right);
+	return;
+      }
+
+    /* Else the slices are grouped into tasks of a useful size and, if
+       there are fewer slices than threads, their columns are split
+       into blocks so that every thread has a task. */
+    const unsigned int chunk    = std::max<std::size_t> (1, threshold/slice);
+    const unsigned int n_groups = (left+chunk-1)/chunk;
+
+    unsigned int n_blocks = 1;
+    if (left < pool.n_threads ())
+      n_blocks = std::min<std::size_t> ((pool.n_threads ()+left-1)/left,
+					std::min<std::size_t> (right, std::max<std::size_t> (1, slice/threshold)));
+
+    const unsigned int width = (right+n_blocks-1)/n_blocks;
+
+    pool.run (n_groups*n_blocks,
+	      [&] (const unsigned int task)
+	      {
+		const unsigned int group = task/n_blocks;
+		const unsigned int c0    = (task%n_blocks)*width;
+		const unsigned int c1    = std::min (right, c0+width);
+		if (c0 >= c1)
+		  return;
+
+		const unsigned int end = std::min (left, (group+1)*chunk);
+		for (unsigned int l=group*chunk; l<end; ++l)
+		  blas::gemm (blas::no_transpose, blas::no_transpose,
+			      d, c1-c0, d,
+			      alpha, A, d, x + std::size_t (l)*d*right + c0, right,
+			      beta, y + std::size_t (l)*d*right + c0, right);
+	      });
+  }
+
+  template <typename ValueType>
+  void
+  KroneckerOperator<ValueType>::vmult (Vector<ValueType>       &y,
+				       const Vector<ValueType> &x) const
+  {
+    std::vector<ValueType> work;
+    vmult (y, x, work);
+  }
+
+  template <typename ValueType>
+  void
+  KroneckerOperator<ValueType>::vmult (Vector<ValueType>       &y,
+				       const Vector<ValueType> &x,
+				       std::vector<ValueType>  &work) const
+  {
+    assert (x.size () == size ());
+    assert (y.size () == size ());
+    assert (&x != &y);
+
+    const unsigned int n = size ();
+
+    if (__terms.empty ())
+      {
+	std::fill (*y, *y + n, ValueType (0));
+	return;
+      }
+
+    /* Two halves of the workspace to pass the intermediate products
+       of a term between, only needed if a term has more than one
+       factor. */
+    unsigned int max_factors = 0;
+    for (const Term &term : __terms)
+      max_factors = std::max<unsigned int> (max_factors, term.modes.size ());
+
+    if (max_factors > 1 && work.size () < 2*std::size_t (n))
+      work.resize (2*std::size_t (n));
+
+    /* The first term overwrites y, the others add to it. The last
+       factor of a term writes into y directly, with the coefficient
+       folded in. */
+    for (unsigned int t=0; t<__terms.size (); ++t)
+      {
+	const Term      &term = __terms[t];
+	const ValueType  beta = (t == 0) ? ValueType (0) : ValueType (1);
+
+	if (term.modes.empty ())
+	  {
+	    ValueType       *y_values = *y;
+	    const ValueType *x_values = *x;
+	    for (unsigned int i=0; i<n; ++i)
+	      y_values[i] = (t == 0)
+		? term.coefficient*x_values[i]
+		: term.coefficient*x_values[i] + y_values[i];
+	    continue;
+	  }
+
+	const ValueType *source = *x;
+	for (unsigned int i=0; i<term.modes.size (); ++i)
+	  {
+	    const bool  last        = (i+1 == term.modes.size ());
+	    ValueType  *destination = last ? *y : work.data () + (i & 1)*std::size_t (n);
+
+	    mode_product (term.modes[i], term.values.data () + term.offsets[i],
+			  last ? term.coefficient : ValueType (1), source,
+			  last ? beta : ValueType (0), destination);
+
+	    source = destination;
+	  }
+      }
+  }
+
+} // namepsace ewalena
+
+#include "kronecker_operator.inst"
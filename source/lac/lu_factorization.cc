@@ -0,0 +1,234 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/lu_factorization.h>
+#include <ewalena/lac/triangular.h>
+#include <ewalena/lac/vector_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of columns factorized as one panel. */
+    const unsigned int block_size = 64;
+
+    /* Factorize the kb columns starting at column k0 of the n x n
+       row-major array a, from row k0 down, by Gaussian elimination
+       with partial pivoting. Rows are exchanged over their whole
+       length, so that the columns left of the panel carry the same
+       permutation as L and those right of it are ready for the
+       update. */
+    template <typename ValueType>
+      bool factorize_panel (const unsigned int         n,
+			    const unsigned int         k0,
+			    const unsigned int         kb,
+			    ValueType                 *a,
+			    std::vector<unsigned int> &pivots)
+      {
+	bool is_singular = false;
+
+	for (unsigned int j=k0; j<k0+kb; ++j)
+	  {
+	    unsigned int pivot = j;
+	    double       max   = std::abs (a[std::size_t (j)*n+j]);
+	    for (unsigned int i=j+1; i<n; ++i)
+	      if (std::abs (a[std::size_t (i)*n+j]) > max)
+		{
+		  pivot = i;
+		  max   = std::abs (a[std::size_t (i)*n+j]);
+		}
+
+	    pivots[j] = pivot;
+	    if (pivot != j)
+	      for (unsigned int l=0; l<n; ++l)
+		std::swap (a[std::size_t (j)*n+l], a[std::size_t (pivot)*n+l]);
+
+	    /* Leave a zero column be; the factorization goes on, but
+	       can not be solved with. */
+	    if (max == 0.)
+	      {
+		is_singular = true;
+		continue;
+	      }
+
+	    const ValueType *row_j = a + std::size_t (j)*n;
+	    const ValueType  inverse_pivot = ValueType (1)/row_j[j];
+
+	    for (unsigned int i=j+1; i<n; ++i)
+	      {
+		ValueType *row_i = a + std::size_t (i)*n;
+		row_i[j] *= inverse_pivot;
+		blas::axpy (k0+kb-j-1, -row_i[j], row_j+j+1, row_i+j+1);
+	      }
+	  }
+
+	return is_singular;
+      }
+
+    /* Apply the row exchanges to the m rows of length n of b, in the
+       order in which they were found. */
+    template <typename ValueType>
+      void permute (const std::vector<unsigned int> &pivots,
+		    const unsigned int               n,
+		    ValueType                       *b)
+      {
+	for (unsigned int j=0; j<pivots.size (); ++j)
+	  if (pivots[j] != j)
+	    for (unsigned int l=0; l<n; ++l)
+	      std::swap (b[std::size_t (j)*n+l], b[std::size_t (pivots[j])*n+l]);
+      }
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  LUFactorization<ValueType>::LUFactorization ()
+    :
+    __is_singular (false)
+  {}
+
+  template <typename ValueType>
+  LUFactorization<ValueType>::LUFactorization (const Matrix<ValueType> &M)
+    :
+    __is_singular (false)
+  {
+    factorize (M);
+  }
+
+  template <typename ValueType>
+  void
+  LUFactorization<ValueType>::factorize (const Matrix<ValueType> &M)
+  {
+    assert (M.n_rows () == M.n_cols ());
+
+    const unsigned int n = M.n_rows ();
+
+    __factors = M;
+    __pivots.resize (n);
+    __is_singular = false;
+
+    ValueType *a = *__factors;
+
+    for (unsigned int k0=0; k0<n; k0+=block_size)
+      {
+	const unsigned int kb = std::min (block_size, n-k0);
+	const unsigned int n_trailing = n-k0-kb;
+
+	if (factorize_panel (n, k0, kb, a, __pivots))
+	  __is_singular = true;
+
+	if (n_trailing == 0)
+	  break;
+
+	/* The rows of U right of the panel: U_12 = L_11^{-1} A_12. */
+	blas::trsm (blas::lower, blas::no_transpose, blas::unit_diagonal,
+		    kb, n_trailing,
+		    ValueType (1), a + std::size_t (k0)*n+k0, n,
+		    a + std::size_t (k0)*n+k0+kb, n);
+
+	/* The trailing submatrix: A_22 -= L_21 U_12. */
+	blas::gemm (blas::no_transpose, blas::no_transpose,
+		    n_trailing, n_trailing, kb,
+		    ValueType (-1), a + std::size_t (k0+kb)*n+k0, n,
+		    a + std::size_t (k0)*n+k0+kb, n,
+		    ValueType (1), a + std::size_t (k0+kb)*n+k0+kb, n);
+      }
+  }
+
+  template <typename ValueType>
+  ValueType
+  LUFactorization<ValueType>::determinant () const
+  {
+    ValueType determinant = ValueType (1);
+
+    for (unsigned int i=0; i<size (); ++i)
+      {
+	determinant *= __factors (i, i);
+
+	if (__pivots[i] != i)
+	  determinant = -determinant;
+      }
+
+    return determinant;
+  }
+
+  template <typename ValueType>
+  void
+  LUFactorization<ValueType>::solve (Vector<ValueType> &b) const
+  {
+    assert (!__is_singular);
+    assert (b.size () == size ());
+
+    permute (__pivots, 1, *b);
+
+    blas::trsv (blas::lower, blas::no_transpose, blas::unit_diagonal,
+		size (), *__factors, size (), *b);
+    blas::trsv (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		size (), *__factors, size (), *b);
+  }
+
+  template <typename ValueType>
+  void
+  LUFactorization<ValueType>::solve (Matrix<ValueType> &B) const
+  {
+    assert (!__is_singular);
+    assert (B.n_rows () == size ());
+
+    const unsigned int n = B.n_cols ();
+
+    permute (__pivots, n, *B);
+
+    blas::trsm (blas::lower, blas::no_transpose, blas::unit_diagonal,
+		size (), n, ValueType (1), *__factors, size (), *B, n);
+    blas::trsm (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		size (), n, ValueType (1), *__factors, size (), *B, n);
+  }
+
+  template <typename ValueType>
+  void
+  LUFactorization<ValueType>::invert (Matrix<ValueType> &M) const
+  {
+    M.reinit (size (), size (), false);
+    M.identity ();
+
+    solve (M);
+  }
+
+} // namepsace ewalena
+
+#include "lu_factorization.inst"
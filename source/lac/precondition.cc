@@ -0,0 +1,539 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/lac/precondition.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of rows handed to a thread at a time. */
+    const unsigned int rows_per_task = 1024;
+
+    /* Keep the n largest in magnitude of the elements, then put them
+       back in order of their columns. */
+    template <typename ValueType>
+      void keep_largest (std::vector<std::pair<unsigned int, ValueType>> &row,
+			 const std::size_t                                n)
+      {
+	if (row.size () > n)
+	  {
+	    std::nth_element (row.begin (), row.begin ()+n, row.end (),
+			      [] (const std::pair<unsigned int, ValueType> &a,
+				  const std::pair<unsigned int, ValueType> &b)
+			      {
+				return std::abs (a.second) > std::abs (b.second);
+			      });
+	    row.resize (n);
+	  }
+
+	std::sort (row.begin (), row.end (),
+		   [] (const std::pair<unsigned int, ValueType> &a,
+		       const std::pair<unsigned int, ValueType> &b)
+		   {
+		     return a.first < b.first;
+		   });
+      }
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  void
+  PreconditionJacobi<ValueType>::initialize (const Matrix<ValueType> &A,
+					     const double             omega)
+  {
+    __inverse_diagonal.reinit (A.n_rows (), false);
+    __inverse_diagonal.diag (A);
+
+    for (unsigned int i=0; i<A.n_rows (); ++i)
+      {
+	assert (__inverse_diagonal(i) != ValueType (0));
+	__inverse_diagonal(i) = ValueType (omega)/__inverse_diagonal(i);
+      }
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionJacobi<ValueType>::initialize (const SparseMatrix<ValueType> &A,
+					     const double                   omega)
+  {
+    assert (A.n_rows () == A.n_cols ());
+
+    __inverse_diagonal.reinit (A.n_rows (), false);
+
+    for (unsigned int i=0; i<A.n_rows (); ++i)
+      {
+	assert (A(i, i) != ValueType (0));
+	__inverse_diagonal(i) = ValueType (omega)/A(i, i);
+      }
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionJacobi<ValueType>::vmult (Vector<ValueType>       &dst,
+					const Vector<ValueType> &src) const
+  {
+    assert (src.size () == __inverse_diagonal.size ());
+    assert (dst.size () == __inverse_diagonal.size ());
+
+    for (unsigned int i=0; i<src.size (); ++i)
+      dst(i) = __inverse_diagonal(i)*src(i);
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionBlockJacobi<ValueType>::initialize (const Matrix<ValueType> &A,
+						  const unsigned int       block_size)
+  {
+    assert (A.n_rows () == A.n_cols ());
+    assert (block_size > 0);
+
+    __n_rows     = A.n_rows ();
+    __block_size = block_size;
+    __inverses.resize ((__n_rows+block_size-1)/block_size);
+
+    for (unsigned int b=0; b<__inverses.size (); ++b)
+      {
+	const unsigned int start = b*block_size;
+	const unsigned int m     = std::min (block_size, __n_rows-start);
+
+	__inverses[b].reinit (m, m, false);
+	for (unsigned int i=0; i<m; ++i)
+	  for (unsigned int j=0; j<m; ++j)
+	    __inverses[b](i, j) = A(start+i, start+j);
+      }
+
+    invert_blocks ();
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionBlockJacobi<ValueType>::initialize (const SparseMatrix<ValueType> &A,
+						  const unsigned int             block_size)
+  {
+    assert (A.n_rows () == A.n_cols ());
+    assert (block_size > 0);
+
+    __n_rows     = A.n_rows ();
+    __block_size = block_size;
+    __inverses.resize ((__n_rows+block_size-1)/block_size);
+
+    for (unsigned int b=0; b<__inverses.size (); ++b)
+      {
+	const unsigned int start = b*block_size;
+	const unsigned int m     = std::min (block_size, __n_rows-start);
+
+	__inverses[b].reinit (m, m);
+	for (unsigned int i=0; i<m; ++i)
+	  {
+	    const unsigned int *columns = A.columns (start+i);
+	    const ValueType    *values  = A.values (start+i);
+	    for (unsigned int k=0; k<A.row_length (start+i); ++k)
+	      if (columns[k] >= start && columns[k] < start+m)
+		__inverses[b](i, columns[k]-start) = values[k];
+	  }
+      }
+
+    invert_blocks ();
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionBlockJacobi<ValueType>::invert_blocks ()
+  {
+    ThreadPool::instance ().run (__inverses.size (),
+				 [&] (const unsigned int b)
+				 {
+				   Matrix<ValueType> inverse;
+				   inverse.invert (__inverses[b]);
+				   __inverses[b] = std::move (inverse);
+				 });
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionBlockJacobi<ValueType>::vmult (Vector<ValueType>       &dst,
+					     const Vector<ValueType> &src) const
+  {
+    assert (src.size () == __n_rows);
+    assert (dst.size () == __n_rows);
+
+    /* Enough blocks to a task to fill a block of rows. */
+    const unsigned int chunk   = std::max (1u, rows_per_task/__block_size);
+    const unsigned int n_tasks = (__inverses.size ()+chunk-1)/chunk;
+
+    ThreadPool::instance ().run (n_tasks,
+				 [&] (const unsigned int task)
+				 {
+				   const unsigned int end = std::min<unsigned int> (__inverses.size (), (task+1)*chunk);
+				   for (unsigned int b=task*chunk; b<end; ++b)
+				     {
+				       const Matrix<ValueType> &inverse = __inverses[b];
+				       const unsigned int       start   = b*__block_size;
+
+				       for (unsigned int i=0; i<inverse.n_rows (); ++i)
+					 {
+					   ValueType sum = ValueType (0);
+					   for (unsigned int j=0; j<inverse.n_cols (); ++j)
+					     sum += inverse(i, j)*src(start+j);
+					   dst(start+i) = sum;
+					 }
+				     }
+				 });
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionSSOR<ValueType>::initialize (const SparseMatrix<ValueType> &A,
+					   const double                   omega)
+  {
+    assert (A.n_rows () == A.n_cols ());
+    assert (omega > 0. && omega < 2.);
+
+    __matrix = &A;
+    __omega  = omega;
+
+    __lower.initialize (A, true);
+    __upper.initialize (A, false);
+
+    refactorize ();
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionSSOR<ValueType>::refactorize ()
+  {
+    const SparseMatrix<ValueType> &A = *__matrix;
+
+    __diagonal.resize (A.n_rows ());
+    for (unsigned int i=0; i<A.n_rows (); ++i)
+      {
+	__diagonal[i] = A(i, i);
+	assert (__diagonal[i] != ValueType (0));
+      }
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionSSOR<ValueType>::vmult (Vector<ValueType>       &dst,
+				      const Vector<ValueType> &src) const
+  {
+    const SparseMatrix<ValueType> &A = *__matrix;
+
+    assert (src.size () == A.n_rows ());
+    assert (dst.size () == A.n_rows ());
+    assert (&dst != &src);
+
+    /* (D/omega + L) y = src. */
+    __lower.run ([&] (const unsigned int i)
+		 {
+		   const unsigned int *columns = A.columns (i);
+		   const ValueType    *values  = A.values (i);
+
+		   ValueType sum = src(i);
+		   for (unsigned int k=0; k<A.row_length (i) && columns[k]<i; ++k)
+		     sum -= values[k]*dst(columns[k]);
+
+		   dst(i) = ValueType (__omega)*sum/__diagonal[i];
+		 });
+
+    /* (D/omega + U) z = (2-omega)/omega D y, in place. */
+    __upper.run ([&] (const unsigned int i)
+		 {
+		   const unsigned int *columns = A.columns (i);
+		   const ValueType    *values  = A.values (i);
+
+		   ValueType sum = ValueType ((2.-__omega)/__omega)*__diagonal[i]*dst(i);
+		   for (unsigned int k=0; k<A.row_length (i); ++k)
+		     if (columns[k] > i)
+		       sum -= values[k]*dst(columns[k]);
+
+		   dst(i) = ValueType (__omega)*sum/__diagonal[i];
+		 });
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionILU<ValueType>::initialize (const SparseMatrix<ValueType> &A)
+  {
+    assert (A.n_rows () == A.n_cols ());
+
+    __factors = A;
+    setup_pattern ();
+    refactorize (A);
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionILU<ValueType>::initialize (const SparseMatrix<ValueType> &A,
+					  const double                   threshold,
+					  const unsigned int             fill)
+  {
+    assert (A.n_rows () == A.n_cols ());
+    assert (threshold >= 0.);
+
+    const unsigned int n = A.n_rows ();
+
+    /* The rows of U so far, the diagonal first, and the inverse of
+       its diagonal. */
+    std::vector<std::vector<std::pair<unsigned int, ValueType>>> upper (n);
+    __inverse_diagonal.resize (n);
+
+    std::vector<typename SparseMatrix<ValueType>::Triplet> triplets;
+
+    /* The row being eliminated, dense, with the list of its nonzero
+       columns and a queue of those in L still to be eliminated, in
+       increasing order. */
+    std::vector<ValueType>    w (n, ValueType (0));
+    std::vector<bool>         nonzero (n, false);
+    std::vector<unsigned int> pattern;
+    std::priority_queue<unsigned int, std::vector<unsigned int>, std::greater<unsigned int>> queue;
+
+    for (unsigned int i=0; i<n; ++i)
+      {
+	const unsigned int *columns = A.columns (i);
+	const ValueType    *values  = A.values (i);
+
+	double       norm    = 0.;
+	unsigned int n_lower = 0, n_upper = 0;
+	for (unsigned int k=0; k<A.row_length (i); ++k)
+	  {
+	    const unsigned int j = columns[k];
+	    w[j]       = values[k];
+	    nonzero[j] = true;
+	    pattern.push_back (j);
+	    if (j < i)
+	      {
+		queue.push (j);
+		++n_lower;
+	      }
+	    else if (j > i)
+	      ++n_upper;
+	    norm += std::norm (values[k]);
+	  }
+	norm = std::sqrt (norm);
+
+	const double tolerance = threshold*norm;
+
+	while (!queue.empty ())
+	  {
+	    const unsigned int p = queue.top ();
+	    queue.pop ();
+
+	    const ValueType l = w[p]*__inverse_diagonal[p];
+	    if (std::abs (l) <= tolerance)
+	      {
+		w[p] = ValueType (0);
+		continue;
+	      }
+	    w[p] = l;
+
+	    for (unsigned int q=1; q<upper[p].size (); ++q)
+	      {
+		const unsigned int j = upper[p][q].first;
+		if (!nonzero[j])
+		  {
+		    nonzero[j] = true;
+		    pattern.push_back (j);
+		    if (j < i)
+		      queue.push (j);
+		  }
+		w[j] -= l*upper[p][q].second;
+	      }
+	  }
+
+	/* Drop what is small, and keep the largest of the rest. */
+	std::vector<std::pair<unsigned int, ValueType>> lower;
+	for (const unsigned int j : pattern)
+	  {
+	    if (j != i && std::abs (w[j]) > tolerance)
+	      (j < i ? lower : upper[i]).push_back (std::make_pair (j, w[j]));
+	    nonzero[j] = false;
+	  }
+
+	keep_largest (lower, n_lower+fill);
+	keep_largest (upper[i], n_upper+fill);
+
+	/* A zero pivot is replaced by a small one. */
+	ValueType pivot = w[i];
+	if (pivot == ValueType (0))
+	  pivot = ValueType ((norm > 0.) ? std::max (tolerance, 1e-8*norm) : 1.);
+	upper[i].insert (upper[i].begin (), std::make_pair (i, pivot));
+	__inverse_diagonal[i] = ValueType (1)/pivot;
+
+	for (const unsigned int j : pattern)
+	  w[j] = ValueType (0);
+	pattern.clear ();
+
+	for (const std::pair<unsigned int, ValueType> &element : lower)
+	  {
+	    const typename SparseMatrix<ValueType>::Triplet triplet = {i, element.first, element.second};
+	    triplets.push_back (triplet);
+	  }
+	for (const std::pair<unsigned int, ValueType> &element : upper[i])
+	  {
+	    const typename SparseMatrix<ValueType>::Triplet triplet = {i, element.first, element.second};
+	    triplets.push_back (triplet);
+	  }
+      }
+
+    __factors.reinit (n, n, triplets);
+    setup_pattern ();
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionILU<ValueType>::setup_pattern ()
+  {
+    const unsigned int n = __factors.n_rows ();
+
+    __diagonal.resize (n);
+    __inverse_diagonal.resize (n);
+
+    for (unsigned int i=0; i<n; ++i)
+      {
+	const unsigned int *columns = __factors.columns (i);
+	const unsigned int *end     = columns + __factors.row_length (i);
+	const unsigned int *p       = std::lower_bound (columns, end, i);
+
+	/* The factors need every diagonal element. */
+	assert (p != end && *p == i);
+	__diagonal[i] = p - columns;
+      }
+
+    __lower.initialize (__factors, true);
+    __upper.initialize (__factors, false);
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionILU<ValueType>::refactorize (const SparseMatrix<ValueType> &A)
+  {
+    assert (A.n_rows () == __factors.n_rows ());
+
+    /* Row i of the factors only needs the rows of L it refers to,
+       which the schedule of L has done before. */
+    __lower.run ([&] (const unsigned int i)
+		 {
+		   const unsigned int *columns = __factors.columns (i);
+		   ValueType          *values  = __factors.values (i);
+		   const unsigned int  length  = __factors.row_length (i);
+
+		   /* The row of A on the pattern; both are sorted. */
+		   std::fill (values, values+length, ValueType (0));
+		   {
+		     const unsigned int *a_columns = A.columns (i);
+		     const ValueType    *a_values  = A.values (i);
+		     unsigned int k = 0;
+		     for (unsigned int q=0; q<A.row_length (i); ++q)
+		       {
+			 while (k < length && columns[k] < a_columns[q])
+			   ++k;
+			 if (k < length && columns[k] == a_columns[q])
+			   values[k] = a_values[q];
+		       }
+		   }
+
+		   for (unsigned int k=0; k<__diagonal[i]; ++k)
+		     {
+		       const unsigned int p = columns[k];
+		       values[k] *= __inverse_diagonal[p];
+
+		       /* Subtract l_ip times row p of U where the pattern
+			  of row i has room. */
+		       const unsigned int *p_columns = __factors.columns (p);
+		       const ValueType    *p_values  = __factors.values (p);
+		       unsigned int j = k+1;
+		       for (unsigned int q=__diagonal[p]+1; q<__factors.row_length (p); ++q)
+			 {
+			   while (j < length && columns[j] < p_columns[q])
+			     ++j;
+			   if (j == length)
+			     break;
+			   if (columns[j] == p_columns[q])
+			     values[j] -= values[k]*p_values[q];
+			 }
+		     }
+
+		   assert (values[__diagonal[i]] != ValueType (0));
+		   __inverse_diagonal[i] = ValueType (1)/values[__diagonal[i]];
+		 });
+  }
+
+  template <typename ValueType>
+  void
+  PreconditionILU<ValueType>::vmult (Vector<ValueType>       &dst,
+				     const Vector<ValueType> &src) const
+  {
+    assert (src.size () == __factors.n_rows ());
+    assert (dst.size () == __factors.n_rows ());
+    assert (&dst != &src);
+
+    /* L y = src, with the unit diagonal left out. */
+    __lower.run ([&] (const unsigned int i)
+		 {
+		   const unsigned int *columns = __factors.columns (i);
+		   const ValueType    *values  = __factors.values (i);
+
+		   ValueType sum = src(i);
+		   for (unsigned int k=0; k<__diagonal[i]; ++k)
+		     sum -= values[k]*dst(columns[k]);
+		   dst(i) = sum;
+		 });
+
+    /* U z = y, in place. */
+    __upper.run ([&] (const unsigned int i)
+		 {
+		   const unsigned int *columns = __factors.columns (i);
+		   const ValueType    *values  = __factors.values (i);
+
+		   ValueType sum = dst(i);
+		   for (unsigned int k=__diagonal[i]+1; k<__factors.row_length (i); ++k)
+		     sum -= values[k]*dst(columns[k]);
+		   dst(i) = sum*__inverse_diagonal[i];
+		 });
+  }
+
+} // namepsace ewalena
+
+#include "precondition.inst"
@@ -0,0 +1,300 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/math.h>
+#include <ewalena/lac/householder.h>
+#include <ewalena/lac/qr_factorization.h>
+#include <ewalena/lac/triangular.h>
+#include <ewalena/lac/vector_kernels.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of reflectors gathered into one block. */
+    const unsigned int block_size = 32;
+
+    /* Copy the reflectors of the kb columns starting at column j0 of
+       the row-major array of factors a, with n columns and m rows,
+       into the (m-j0) x kb column-major array v, with the zeros above
+       and the ones on their diagonal. */
+    template <typename ValueType>
+      void gather_reflectors (const unsigned int  m,
+			      const unsigned int  n,
+			      const unsigned int  j0,
+			      const unsigned int  kb,
+			      const ValueType    *a,
+			      ValueType          *v)
+      {
+	const unsigned int mr = m-j0;
+
+	for (unsigned int j=0; j<kb; ++j)
+	  {
+	    ValueType *v_j = v + std::size_t (j)*mr;
+
+	    for (unsigned int i=0; i<j; ++i)
+	      v_j[i] = ValueType (0);
+	    v_j[j] = ValueType (1);
+	    for (unsigned int i=j+1; i<mr; ++i)
+	      v_j[i] = a[std::size_t (j0+i)*n+j0+j];
+	  }
+      }
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  QRFactorization<ValueType>::QRFactorization ()
+  {}
+
+  template <typename ValueType>
+  QRFactorization<ValueType>::QRFactorization (const Matrix<ValueType> &M)
+  {
+    factorize (M);
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::factorize (const Matrix<ValueType> &M)
+  {
+    const unsigned int m = M.n_rows ();
+    const unsigned int n = M.n_cols ();
+    const unsigned int k = std::min (m, n);
+    const unsigned int n_blocks = (k+block_size-1)/block_size;
+
+    __factors = M;
+    __tau.assign (k, ValueType (0));
+    __block_factors.assign (std::size_t (n_blocks)*block_size*block_size, ValueType (0));
+
+    ValueType *a = *__factors;
+
+    std::vector<ValueType> v (std::size_t (m)*block_size);
+    std::vector<ValueType> beta (block_size);
+
+    for (unsigned int j0=0; j0<k; j0+=block_size)
+      {
+	const unsigned int kb = std::min (block_size, k-j0);
+	const unsigned int mr = m-j0;
+
+	/* The panel as an mr x kb column-major array, so that its
+	   columns are contiguous while their reflectors are found. */
+	for (unsigned int j=0; j<kb; ++j)
+	  for (unsigned int i=0; i<mr; ++i)
+	    v[std::size_t (j)*mr+i] = a[std::size_t (j0+i)*n+j0+j];
+
+	for (unsigned int j=0; j<kb; ++j)
+	  {
+	    ValueType *v_j = &v[std::size_t (j)*mr];
+
+	    beta[j] = v_j[j];
+	    const ValueType tau = blas::householder (mr-j-1, beta[j], v_j+j+1);
+	    __tau[j0+j] = tau;
+	    v_j[j] = ValueType (1);
+
+	    /* The rest of the panel: H^H = I - conj(tau) v v^H. */
+	    for (unsigned int l=j+1; l<kb; ++l)
+	      {
+		ValueType *v_l = &v[std::size_t (l)*mr];
+		blas::axpy (mr-j, -math::conjugate (tau)*blas::dot (mr-j, v_j+j, v_l+j), v_j+j, v_l+j);
+	      }
+	  }
+
+	/* Write the panel back: R on and above the diagonal, the
+	   reflectors below it. Then leave v with the zeros above the
+	   leading ones, as householder_factor wants it. */
+	for (unsigned int j=0; j<kb; ++j)
+	  {
+	    ValueType *v_j = &v[std::size_t (j)*mr];
+
+	    for (unsigned int i=0; i<mr; ++i)
+	      a[std::size_t (j0+i)*n+j0+j] = v_j[i];
+	    a[std::size_t (j0+j)*n+j0+j] = beta[j];
+
+	    for (unsigned int i=0; i<j; ++i)
+	      v_j[i] = ValueType (0);
+	  }
+
+	ValueType *T = &__block_factors[std::size_t (j0/block_size)*block_size*block_size];
+	blas::householder_factor (mr, kb, &v[0], mr, &__tau[j0], T, block_size);
+
+	/* The columns right of the panel: A_2 -= V T^H V^H A_2. */
+	if (j0+kb < n)
+	  blas::householder_apply (blas::conjugate_transpose, mr, n-j0-kb, kb,
+				   &v[0], mr, T, block_size,
+				   a + std::size_t (j0)*n+j0+kb, n);
+      }
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::apply (const blas::Operation op,
+				     const unsigned int    n,
+				     ValueType            *B,
+				     const unsigned int    ldb) const
+  {
+    const unsigned int m = n_rows ();
+    const unsigned int k = __tau.size ();
+
+    if (k == 0 || n == 0)
+      return;
+
+    std::vector<ValueType> v (std::size_t (m)*block_size);
+
+    /* Q^H = ... H_1^H H_0^H takes the blocks first to last, Q = H_0
+       H_1 ... last to first. */
+    const unsigned int n_blocks = (k+block_size-1)/block_size;
+
+    for (unsigned int b=0; b<n_blocks; ++b)
+      {
+	const unsigned int j0 = ((op == blas::no_transpose) ? n_blocks-1-b : b)*block_size;
+	const unsigned int kb = std::min (block_size, k-j0);
+
+	gather_reflectors (m, n_cols (), j0, kb, *__factors, &v[0]);
+
+	blas::householder_apply (op, m-j0, n, kb,
+				 &v[0], m-j0,
+				 &__block_factors[std::size_t (j0/block_size)*block_size*block_size], block_size,
+				 B + std::size_t (j0)*ldb, ldb);
+      }
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::apply_Q (Matrix<ValueType> &B) const
+  {
+    assert (B.n_rows () == n_rows ());
+
+    apply (blas::no_transpose, B.n_cols (), *B, B.n_cols ());
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::apply_Q (Vector<ValueType> &b) const
+  {
+    assert (b.size () == n_rows ());
+
+    apply (blas::no_transpose, 1, *b, 1);
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::apply_QH (Matrix<ValueType> &B) const
+  {
+    assert (B.n_rows () == n_rows ());
+
+    apply (blas::conjugate_transpose, B.n_cols (), *B, B.n_cols ());
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::apply_QH (Vector<ValueType> &b) const
+  {
+    assert (b.size () == n_rows ());
+
+    apply (blas::conjugate_transpose, 1, *b, 1);
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::form_Q (Matrix<ValueType> &Q) const
+  {
+    const unsigned int k = __tau.size ();
+
+    Q.reinit (n_rows (), k);
+    for (unsigned int i=0; i<k; ++i)
+      Q (i, i) = ValueType (1);
+
+    apply_Q (Q);
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::form_R (Matrix<ValueType> &R) const
+  {
+    const unsigned int k = __tau.size ();
+
+    R.reinit (k, n_cols ());
+    for (unsigned int i=0; i<k; ++i)
+      for (unsigned int j=i; j<n_cols (); ++j)
+	R (i, j) = __factors (i, j);
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::solve (Vector<ValueType>       &x,
+				     const Vector<ValueType> &b) const
+  {
+    assert (n_rows () >= n_cols ());
+    assert (b.size () == n_rows ());
+
+    const unsigned int n = n_cols ();
+
+    /* x = R^{-1} (Q^H b)(0:n). */
+    Vector<ValueType> c (b);
+    apply_QH (c);
+
+    x.reinit (n, false);
+    std::copy (*c, *c+n, *x);
+
+    blas::trsv (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		n, *__factors, n, *x);
+  }
+
+  template <typename ValueType>
+  void
+  QRFactorization<ValueType>::solve (Matrix<ValueType>       &X,
+				     const Matrix<ValueType> &B) const
+  {
+    assert (n_rows () >= n_cols ());
+    assert (B.n_rows () == n_rows ());
+
+    const unsigned int n = n_cols ();
+    const unsigned int p = B.n_cols ();
+
+    Matrix<ValueType> C (B);
+    apply_QH (C);
+
+    X.reinit (n, p, false);
+    std::copy (*C, *C+std::size_t (n)*p, *X);
+
+    blas::trsm (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		n, p, ValueType (1), *__factors, n, *X, p);
+  }
+
+} // namepsace ewalena
+
+#include "qr_factorization.inst"
@@ -0,0 +1,264 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/sell_matrix.h>
+#include <ewalena/base/thread_pool.h>
+
+#include <algorithm>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* Products with fewer stored elements plus rows than this are not
+       worth waking the pool for. */
+    const std::size_t threshold = 32768;
+
+    /* The number of chunks whose products are collected before they
+       are scattered into y. */
+    const unsigned int batch_size = 64;
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  const unsigned int SellMatrix<ValueType>::chunk_height;
+
+  template <typename ValueType>
+  const unsigned int SellMatrix<ValueType>::default_sigma;
+
+  template <typename ValueType>
+  SellMatrix<ValueType>::SellMatrix ()
+    :
+    __n_rows (0),
+    __n_cols (0),
+    __n_nonzero_elements (0),
+    chunk_start (1, 0)
+  {}
+
+  template <typename ValueType>
+  SellMatrix<ValueType>::SellMatrix (const SparseMatrix<ValueType> &M,
+				     const unsigned int             sigma)
+    :
+    __n_rows (0),
+    __n_cols (0),
+    __n_nonzero_elements (0),
+    chunk_start (1, 0)
+  {
+    reinit (M, sigma);
+  }
+
+  template <typename ValueType>
+  SellMatrix<ValueType>::SellMatrix (const unsigned int                                         m,
+				     const unsigned int                                         n,
+				     const std::vector<typename SparseMatrix<ValueType>::Triplet> &triplets,
+				     const unsigned int                                         sigma)
+    :
+    __n_rows (0),
+    __n_cols (0),
+    __n_nonzero_elements (0),
+    chunk_start (1, 0)
+  {
+    reinit (m, n, triplets, sigma);
+  }
+
+  template <typename ValueType>
+  void
+  SellMatrix<ValueType>::reinit (const SparseMatrix<ValueType> &M,
+				 const unsigned int             sigma)
+  {
+    assert (sigma > 0);
+
+    __n_rows             = M.n_rows ();
+    __n_cols             = M.n_cols ();
+    __n_nonzero_elements = M.n_nonzero_elements ();
+
+    const unsigned int n_chunks = (__n_rows + chunk_height - 1)/chunk_height;
+
+    /* Sort the rows of each window by decreasing length, keeping rows
+       of the same length in order; the rows that pad the last chunk
+       come last. */
+    row_index.resize (std::size_t (n_chunks)*chunk_height);
+    for (unsigned int i=0; i<row_index.size (); ++i)
+      row_index[i] = std::min (i, __n_rows);
+
+    if (sigma > 1)
+      {
+	const unsigned int window = 
+	  ((sigma + chunk_height - 1)/chunk_height)*chunk_height;
+
+	for (unsigned int i=0; i<__n_rows; i+=window)
+	  std::stable_sort (row_index.begin () + i, 
+			    row_index.begin () + std::min (i+window, __n_rows),
+			    [&] (const unsigned int a, const unsigned int b)
+			    {
+			      return M.row_length (a) > M.row_length (b);
+			    });
+      }
+
+    const auto length = [&] (const unsigned int i) -> unsigned int
+      {
+	return (i < __n_rows) ? M.row_length (i) : 0;
+      };
+
+    chunk_length.resize (n_chunks);
+    chunk_start.resize (n_chunks+1);
+    chunk_start[0] = 0;
+
+    for (unsigned int c=0; c<n_chunks; ++c)
+      {
+	unsigned int max_length = 0;
+	for (unsigned int r=0; r<chunk_height; ++r)
+	  max_length = std::max (max_length, length (row_index[c*chunk_height+r]));
+
+	chunk_length[c]  = max_length;
+	chunk_start[c+1] = chunk_start[c] + std::size_t (max_length)*chunk_height;
+      }
+
+    /* Store each chunk column after column. Padding repeats the last
+       column of a row, with value zero, so that gathers stay close to
+       those of the row itself. */
+    column_index.assign (chunk_start[n_chunks], 0);
+    data.assign (chunk_start[n_chunks], ValueType (0));
+
+    for (unsigned int c=0; c<n_chunks; ++c)
+      for (unsigned int r=0; r<chunk_height; ++r)
+	{
+	  const unsigned int i = row_index[c*chunk_height+r];
+	  if (length (i) == 0)
+	    continue;
+
+	  const unsigned int *columns = M.columns (i);
+	  const ValueType    *values  = M.values (i);
+
+	  for (unsigned int k=0; k<chunk_length[c]; ++k)
+	    {
+	      const std::size_t position = chunk_start[c] + std::size_t (k)*chunk_height + r;
+
+	      if (k < length (i))
+		{
+		  column_index[position] = columns[k];
+		  data[position]         = values[k];
+		}
+	      else
+		column_index[position] = columns[length (i)-1];
+	    }
+	}
+  }
+
+  template <typename ValueType>
+  void
+  SellMatrix<ValueType>::reinit (const unsigned int                                         m,
+				 const unsigned int                                         n,
+				 const std::vector<typename SparseMatrix<ValueType>::Triplet> &triplets,
+				 const unsigned int                                         sigma)
+  {
+    reinit (SparseMatrix<ValueType> (m, n, triplets), sigma);
+  }
+
+  template <typename ValueType>
+  void
+  SellMatrix<ValueType>::vmult (Vector<ValueType>       &y,
+				const Vector<ValueType> &x,
+				const ValueType          alpha,
+				const ValueType          beta) const
+  {
+    assert (x.size () == __n_cols);
+    assert (y.size () == __n_rows);
+    assert (&x != &y);
+
+    const unsigned int n_chunks = chunk_length.size ();
+
+    /* Chunks c0 to c1: collect the products of a batch of chunks,
+       then scatter them to the rows they belong to. */
+    const auto vmult_chunks = [&] (const unsigned int c0, 
+				   const unsigned int c1)
+      {
+	ValueType product[batch_size*chunk_height];
+
+	for (unsigned int b=c0; b<c1; b+=batch_size)
+	  {
+	    const unsigned int n_batch = std::min (batch_size, c1-b);
+
+	    blas::sell_vmult (n_batch, chunk_height, 
+			      chunk_start.data () + b, chunk_length.data () + b,
+			      column_index.data (), data.data (), 
+			      *x, product);
+
+	    for (unsigned int s=0; s<n_batch*chunk_height; ++s)
+	      {
+		const unsigned int i = row_index[b*chunk_height+s];
+		if (i < __n_rows)
+		  (*y)[i] = (beta == ValueType (0)) 
+		    ? alpha*product[s] 
+		    : alpha*product[s] + beta*(*y)[i];
+	      }
+	  }
+      };
+
+    ThreadPool &pool = ThreadPool::instance ();
+    const unsigned int n_threads = pool.n_threads ();
+
+    const std::size_t cost = n_stored_elements () + __n_rows;
+
+    if ((n_threads == 1) || (cost < threshold))
+      {
+	vmult_chunks (0, n_chunks);
+	return;
+      }
+
+    /* Cut the chunks where the accumulated number of stored elements
+       plus rows crosses multiples of the cost per thread. */
+    std::vector<unsigned int> boundary (n_threads+1, n_chunks);
+    boundary[0] = 0;
+
+    unsigned int c = 0;
+    for (unsigned int t=1; t<n_threads; ++t)
+      {
+	const std::size_t target = cost*t/n_threads;
+	while ((c < n_chunks) && (chunk_start[c] + std::size_t (c)*chunk_height < target))
+	  ++c;
+	boundary[t] = c;
+      }
+
+    pool.run (n_threads,
+	      [&] (const unsigned int t)
+	      {
+		vmult_chunks (boundary[t], boundary[t+1]);
+	      });
+  }
+
+} // namepsace ewalena
+
+#include "sell_matrix.inst"
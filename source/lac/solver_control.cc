@@ -0,0 +1,124 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/solver_control.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace ewalena
+{
+
+  SolverControl::SolverControl (const unsigned int max_steps,
+				const double       tolerance,
+				const double       reduction)
+    :
+    __max_steps (max_steps),
+    __tolerance (tolerance),
+    __reduction (reduction),
+    __last_state (iterate)
+  {}
+
+  SolverControl::State 
+  SolverControl::check (const unsigned int step,
+			const double       value)
+  {
+    /* Reserve the whole history up front, so that solvers do not
+       allocate while they iterate. */
+    if (step == 0)
+      {
+	__history.clear ();
+	__history.reserve (__max_steps+1);
+      }
+
+    assert (step == __history.size ());
+    __history.push_back (value);
+
+    if (value <= target ())
+      __last_state = success;
+    else if ((step >= __max_steps) || !std::isfinite (value))
+      __last_state = failure;
+    else
+      __last_state = iterate;
+
+    return __last_state;
+  }
+
+  SolverControl::State 
+  SolverControl::breakdown (const unsigned int)
+  {
+    __last_state = failure;
+    return __last_state;
+  }
+
+  SolverControl::State 
+  SolverControl::last_state () const
+  {
+    return __last_state;
+  }
+
+  unsigned int 
+  SolverControl::last_step () const
+  {
+    assert (!__history.empty ());
+    return __history.size ()-1;
+  }
+
+  double 
+  SolverControl::last_value () const
+  {
+    assert (!__history.empty ());
+    return __history.back ();
+  }
+
+  const std::vector<double>& 
+  SolverControl::history () const
+  {
+    return __history;
+  }
+
+  unsigned int 
+  SolverControl::max_steps () const
+  {
+    return __max_steps;
+  }
+
+  double 
+  SolverControl::target () const
+  {
+    return __history.empty () 
+      ? __tolerance 
+      : std::max (__tolerance, __reduction*__history.front ());
+  }
+
+} // namepsace ewalena
@@ -0,0 +1,229 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/sparse_matrix.h>
+#include <ewalena/base/thread_pool.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* Products with fewer stored elements plus rows than this are not
+       worth waking the pool for. */
+    const std::size_t threshold = 32768;
+
+    /* Rows i0 to i1 of y = alpha M x + beta y. */
+    template <typename ValueType>
+      void vmult_rows (const unsigned int  i0,
+		       const unsigned int  i1,
+		       const std::size_t  *row_start,
+		       const unsigned int *column_index,
+		       const ValueType    *data,
+		       const ValueType     alpha,
+		       const ValueType    *x,
+		       const ValueType     beta,
+		       ValueType          *y)
+      {
+	for (unsigned int i=i0; i<i1; ++i)
+	  {
+	    ValueType sum = ValueType (0);
+	    for (std::size_t k=row_start[i]; k<row_start[i+1]; ++k)
+	      sum += data[k]*x[column_index[k]];
+
+	    y[i] = (beta == ValueType (0)) ? alpha*sum : alpha*sum + beta*y[i];
+	  }
+      }
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  SparseMatrix<ValueType>::SparseMatrix ()
+    :
+    __n_rows (0),
+    __n_cols (0),
+    row_start (1, 0)
+  {}
+
+  template <typename ValueType>
+  SparseMatrix<ValueType>::SparseMatrix (const unsigned int          m,
+					 const unsigned int          n,
+					 const std::vector<Triplet> &triplets)
+    :
+    __n_rows (0),
+    __n_cols (0),
+    row_start (1, 0)
+  {
+    reinit (m, n, triplets);
+  }
+
+  template <typename ValueType>
+  void
+  SparseMatrix<ValueType>::reinit (const unsigned int          m,
+				   const unsigned int          n,
+				   const std::vector<Triplet> &triplets)
+  {
+    __n_rows = m;
+    __n_cols = n;
+
+    /* Bucket the triplets by row, keeping their order within a
+       row. */
+    row_start.assign (m+1, 0);
+    for (std::size_t k=0; k<triplets.size (); ++k)
+      {
+	assert (triplets[k].row<m);
+	assert (triplets[k].column<n);
+	++row_start[triplets[k].row+1];
+      }
+
+    for (unsigned int i=0; i<m; ++i)
+      row_start[i+1] += row_start[i];
+
+    std::vector<std::pair<unsigned int, ValueType> > entries (triplets.size ());
+    {
+      std::vector<std::size_t> next (row_start.begin (), row_start.end ()-1);
+      for (std::size_t k=0; k<triplets.size (); ++k)
+	entries[next[triplets[k].row]++] 
+	  = std::make_pair (triplets[k].column, triplets[k].value);
+    }
+
+    /* Sort each row by column and sum duplicates in the order they
+       were given, compacting the rows as we go. */
+    column_index.clear ();
+    data.clear ();
+    column_index.reserve (entries.size ());
+    data.reserve (entries.size ());
+
+    std::size_t begin = 0;
+    for (unsigned int i=0; i<m; ++i)
+      {
+	const std::size_t end = row_start[i+1];
+
+	std::stable_sort (entries.begin ()+begin, entries.begin ()+end,
+			  [] (const std::pair<unsigned int, ValueType> &a,
+			      const std::pair<unsigned int, ValueType> &b)
+			  {
+			    return a.first < b.first;
+			  });
+
+	const std::size_t first = column_index.size ();
+	for (std::size_t k=begin; k<end; ++k)
+	  if ((column_index.size () > first) && 
+	      (column_index.back () == entries[k].first))
+	    data.back () += entries[k].second;
+	  else
+	    {
+	      column_index.push_back (entries[k].first);
+	      data.push_back (entries[k].second);
+	    }
+
+	row_start[i] = first;
+	begin        = end;
+      }
+
+    row_start[m] = column_index.size ();
+  }
+
+  template <typename ValueType>
+  ValueType
+  SparseMatrix<ValueType>::operator () (const unsigned int i, 
+					const unsigned int j) const
+  {
+    assert (i<__n_rows);
+    assert (j<__n_cols);
+
+    const unsigned int *begin = column_index.data () + row_start[i];
+    const unsigned int *end   = column_index.data () + row_start[i+1];
+    const unsigned int *k     = std::lower_bound (begin, end, j);
+
+    return ((k != end) && (*k == j)) 
+      ? data[k - column_index.data ()] 
+      : ValueType (0);
+  }
+
+  template <typename ValueType>
+  void
+  SparseMatrix<ValueType>::vmult (Vector<ValueType>       &y,
+				  const Vector<ValueType> &x,
+				  const ValueType          alpha,
+				  const ValueType          beta) const
+  {
+    assert (x.size () == __n_cols);
+    assert (y.size () == __n_rows);
+    assert (&x != &y);
+
+    ThreadPool &pool = ThreadPool::instance ();
+    const unsigned int n_threads = pool.n_threads ();
+
+    /* The cost of a row is its number of elements plus one for
+       writing y, so that the cost of rows 0 to i is row_start[i]+i,
+       which grows with i. */
+    const std::size_t cost = n_nonzero_elements () + __n_rows;
+
+    if ((n_threads == 1) || (cost < threshold))
+      {
+	vmult_rows (0, __n_rows, row_start.data (), column_index.data (), data.data (),
+		    alpha, *x, beta, *y);
+	return;
+      }
+
+    /* Cut the rows where the accumulated cost crosses multiples of
+       the cost per thread. */
+    std::vector<unsigned int> boundary (n_threads+1, __n_rows);
+    boundary[0] = 0;
+
+    unsigned int i = 0;
+    for (unsigned int t=1; t<n_threads; ++t)
+      {
+	const std::size_t target = cost*t/n_threads;
+	while ((i < __n_rows) && (row_start[i]+i < target))
+	  ++i;
+	boundary[t] = i;
+      }
+
+    pool.run (n_threads,
+	      [&] (const unsigned int t)
+	      {
+		vmult_rows (boundary[t], boundary[t+1], 
+			    row_start.data (), column_index.data (), data.data (),
+			    alpha, *x, beta, *y);
+	      });
+  }
+
+} // namepsace ewalena
+
+#include "sparse_matrix.inst"
@@ -0,0 +1,226 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/math.h>
+#include <ewalena/lac/triangular.h>
+#include <ewalena/lac/vector_kernels.h>
+
+#include <cstddef>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    namespace
+    {
+
+      /* The number of rows solved by substitution before the rest of
+	 the right-hand side is brought up to date by a product. */
+      const unsigned int block_size = 64;
+
+      inline
+	unsigned int min (const unsigned int a,
+			  const unsigned int b)
+      {
+	return (a < b) ? a : b;
+      }
+
+      /* y_i += alpha a_i, with a_i complex conjugated if conj is
+	 set. */
+      template <typename ValueType>
+	inline
+	void axpy_conj (const unsigned int  n,
+			const ValueType     alpha,
+			const ValueType    *a,
+			const bool          conj,
+			ValueType          *y)
+      {
+	if (!conj)
+	  axpy (n, alpha, a, y);
+	else
+	  blas::axpy_conj (n, alpha, a, y);
+      }
+
+      /* Solve the diagonal block of op(A) that starts at row (and
+	 column) k0 and is kb long, whose (i,j)th element is
+	 a[i*rs+j*cs], by substitution over the rows of B; forward if
+	 op(A) is lower triangular, backward otherwise. */
+      template <typename ValueType>
+	void substitute (const bool         forward,
+			 const Diagonal     diag,
+			 const bool         conj,
+			 const unsigned int k0,
+			 const unsigned int kb,
+			 const unsigned int n,
+			 const ValueType   *A,
+			 const unsigned int rs,
+			 const unsigned int cs,
+			 ValueType         *B,
+			 const unsigned int ldb)
+      {
+	for (unsigned int r=0; r<kb; ++r)
+	  {
+	    const unsigned int i = forward ? k0+r : k0+kb-1-r;
+
+	    for (unsigned int s=0; s<r; ++s)
+	      {
+		const unsigned int p = forward ? k0+s : k0+kb-1-s;
+
+		ValueType a = A[std::size_t (i)*rs + std::size_t (p)*cs];
+		if (conj)
+		  a = math::conjugate (a);
+
+		if (a != ValueType (0))
+		  axpy (n, -a, B + std::size_t (p)*ldb, B + std::size_t (i)*ldb);
+	      }
+
+	    if (diag == non_unit_diagonal)
+	      {
+		ValueType a = A[std::size_t (i)*(rs+cs)];
+		if (conj)
+		  a = math::conjugate (a);
+
+		scale (n, ValueType (1)/a, B + std::size_t (i)*ldb);
+	      }
+	  }
+      }
+
+    } /* namespace */
+
+
+    template <typename ValueType>
+      void trsv (const Triangle     uplo,
+		 const Operation    op_a,
+		 const Diagonal     diag,
+		 const unsigned int n,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 ValueType         *x)
+    {
+      const bool    conj = (op_a == conjugate_transpose);
+      const bool forward = ((uplo == lower) == (op_a == no_transpose));
+
+      for (unsigned int r=0; r<n; ++r)
+	{
+	  const unsigned int i = forward ? r : n-1-r;
+	  const ValueType *row = A + std::size_t (i)*lda;
+
+	  ValueType a_ii = (diag == non_unit_diagonal) ? row[i] : ValueType (1);
+	  if (conj)
+	    a_ii = math::conjugate (a_ii);
+
+	  if (op_a == no_transpose)
+	    {
+	      /* x_i is due the found part of y along row i of A. */
+	      const ValueType sum = forward 
+		? dotu (i, row, x) 
+		: dotu (n-1-i, row+i+1, x+i+1);
+
+	      x[i] = (x[i] - sum)/a_ii;
+	    }
+	  else
+	    {
+	      /* y_i is final; take it out of the rest of x along row i
+		 of A, which is column i of op(A). */
+	      x[i] /= a_ii;
+
+	      if (forward)
+		axpy_conj (n-1-i, -x[i], row+i+1, conj, x+i+1);
+	      else
+		axpy_conj (i, -x[i], row, conj, x);
+	    }
+	}
+    }
+
+
+    template <typename ValueType>
+      void trsm (const Triangle     uplo,
+		 const Operation    op_a,
+		 const Diagonal     diag,
+		 const unsigned int m,
+		 const unsigned int n,
+		 const ValueType    alpha,
+		 const ValueType   *A,
+		 const unsigned int lda,
+		 ValueType         *B,
+		 const unsigned int ldb)
+    {
+      if ((m == 0) || (n == 0))
+	return;
+
+      if ((n == 1) && (ldb == 1) && (alpha == ValueType (1)))
+	{
+	  trsv (uplo, op_a, diag, m, A, lda, B);
+	  return;
+	}
+
+      if (alpha != ValueType (1))
+	for (unsigned int i=0; i<m; ++i)
+	  scale (n, alpha, B + std::size_t (i)*ldb);
+
+      /* op(A) as a strided view: its (i,j)th element lives at
+	 A[i*rs+j*cs]. Transposition swaps the triangles. */
+      const unsigned int rs   = (op_a == no_transpose) ? lda : 1;
+      const unsigned int cs   = (op_a == no_transpose) ? 1   : lda;
+      const bool         conj = (op_a == conjugate_transpose);
+      const bool      forward = ((uplo == lower) == (op_a == no_transpose));
+
+      for (unsigned int b=0; b<m; b+=block_size)
+	{
+	  const unsigned int kb = min (block_size, m-b);
+
+	  /* Forward solves eat blocks from the top, backward solves
+	     from the bottom; the rows still to be solved are always
+	     those on the far side of the block. */
+	  const unsigned int k0 = forward ? b : m-b-kb;
+
+	  substitute (forward, diag, conj, k0, kb, n, A, rs, cs, B, ldb);
+
+	  const unsigned int i0     = forward ? k0+kb : 0;
+	  const unsigned int n_rest = forward ? m-k0-kb : k0;
+
+	  if (n_rest != 0)
+	    gemm (op_a, no_transpose,
+		  n_rest, n, kb,
+		  ValueType (-1), A + std::size_t (i0)*rs + std::size_t (k0)*cs, lda,
+		  B + std::size_t (k0)*ldb, ldb,
+		  ValueType (1), B + std::size_t (i0)*ldb, ldb);
+	}
+    }
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#include "triangular.inst"
@@ -0,0 +1,258 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/lac/triangular.h>
+#include <ewalena/lac/tsqr_factorization.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The smallest number of rows of a block; below it a block is
+       not worth a task of its own. */
+    const unsigned int min_rows = 256;
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  TSQRFactorization<ValueType>::TSQRFactorization ()
+    :
+    __n_cols (0),
+    __block_start (1, 0)
+  {}
+
+  template <typename ValueType>
+  TSQRFactorization<ValueType>::TSQRFactorization (const Matrix<ValueType> &M)
+    :
+    __n_cols (0),
+    __block_start (1, 0)
+  {
+    factorize (M);
+  }
+
+  template <typename ValueType>
+  unsigned int
+  TSQRFactorization<ValueType>::min_block_rows ()
+  {
+    return min_rows;
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::factorize (const Matrix<ValueType> &M)
+  {
+    assert (M.n_rows () >= M.n_cols ());
+
+    const unsigned int m = M.n_rows ();
+    const unsigned int n = M.n_cols ();
+
+    /* Blocks of at least block_rows rows, with the remainder spread
+       over all of them. */
+    const unsigned int block_rows = std::max (min_rows, 2*n);
+    const unsigned int n_blocks   = std::max (1u, m/block_rows);
+
+    __n_cols = n;
+    __block_start.resize (n_blocks+1);
+    for (unsigned int b=0; b<=n_blocks; ++b)
+      __block_start[b] = (std::size_t (m)*b)/n_blocks;
+
+    __blocks.resize (n_blocks);
+
+    ThreadPool::instance ().run (n_blocks,
+				 [&] (const unsigned int b)
+				 {
+				   const unsigned int r0 = __block_start[b];
+				   const unsigned int r1 = __block_start[b+1];
+
+				   Matrix<ValueType> A_b (r1-r0, n, false);
+				   std::copy (*M + std::size_t (r0)*n, *M + std::size_t (r1)*n, *A_b);
+
+				   __blocks[b].factorize (A_b);
+				 });
+
+    /* The triangular factors of the blocks, one below the other. */
+    Matrix<ValueType> S (n_blocks*n, n);
+    for (unsigned int b=0; b<n_blocks; ++b)
+      for (unsigned int i=0; i<n; ++i)
+	for (unsigned int j=i; j<n; ++j)
+	  S (b*n+i, j) = __blocks[b].factors () (i, j);
+
+    __top.factorize (S);
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::apply (const blas::Operation op,
+				       const unsigned int    n,
+				       ValueType            *B,
+				       const unsigned int    ldb) const
+  {
+    if (n == 0 || n_rows () == 0)
+      return;
+
+    const auto apply_blocks = [&] ()
+      {
+	ThreadPool::instance ().run (n_blocks (),
+				     [&] (const unsigned int b)
+				     {
+				       __blocks[b].apply (op, n, B + std::size_t (__block_start[b])*ldb, ldb);
+				     });
+      };
+
+    /* Q^H first applies the Q_b^H, then the factor of the stacked
+       R_b to the first n_cols () rows of every block, which is where
+       the R_b are. Q does the same in reverse. */
+    if (op != blas::no_transpose)
+      apply_blocks ();
+
+    Matrix<ValueType> C (n_blocks ()*n_cols (), n, false);
+    for (unsigned int b=0; b<n_blocks (); ++b)
+      for (unsigned int i=0; i<n_cols (); ++i)
+	std::copy (B + std::size_t (__block_start[b]+i)*ldb,
+		   B + std::size_t (__block_start[b]+i)*ldb + n,
+		   *C + std::size_t (b*n_cols ()+i)*n);
+
+    __top.apply (op, n, *C, n);
+
+    for (unsigned int b=0; b<n_blocks (); ++b)
+      for (unsigned int i=0; i<n_cols (); ++i)
+	std::copy (*C + std::size_t (b*n_cols ()+i)*n,
+		   *C + std::size_t (b*n_cols ()+i+1)*n,
+		   B + std::size_t (__block_start[b]+i)*ldb);
+
+    if (op == blas::no_transpose)
+      apply_blocks ();
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::apply_Q (Matrix<ValueType> &B) const
+  {
+    assert (B.n_rows () == n_rows ());
+
+    apply (blas::no_transpose, B.n_cols (), *B, B.n_cols ());
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::apply_Q (Vector<ValueType> &b) const
+  {
+    assert (b.size () == n_rows ());
+
+    apply (blas::no_transpose, 1, *b, 1);
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::apply_QH (Matrix<ValueType> &B) const
+  {
+    assert (B.n_rows () == n_rows ());
+
+    apply (blas::conjugate_transpose, B.n_cols (), *B, B.n_cols ());
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::apply_QH (Vector<ValueType> &b) const
+  {
+    assert (b.size () == n_rows ());
+
+    apply (blas::conjugate_transpose, 1, *b, 1);
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::form_Q (Matrix<ValueType> &Q) const
+  {
+    Q.reinit (n_rows (), n_cols ());
+    for (unsigned int i=0; i<n_cols (); ++i)
+      Q (i, i) = ValueType (1);
+
+    apply_Q (Q);
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::form_R (Matrix<ValueType> &R) const
+  {
+    __top.form_R (R);
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::solve (Vector<ValueType>       &x,
+				       const Vector<ValueType> &b) const
+  {
+    assert (b.size () == n_rows ());
+
+    const unsigned int n = n_cols ();
+
+    Vector<ValueType> c (b);
+    apply_QH (c);
+
+    x.reinit (n, false);
+    std::copy (*c, *c+n, *x);
+
+    blas::trsv (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		n, *__top.factors (), n, *x);
+  }
+
+  template <typename ValueType>
+  void
+  TSQRFactorization<ValueType>::solve (Matrix<ValueType>       &X,
+				       const Matrix<ValueType> &B) const
+  {
+    assert (B.n_rows () == n_rows ());
+
+    const unsigned int n = n_cols ();
+    const unsigned int p = B.n_cols ();
+
+    Matrix<ValueType> C (B);
+    apply_QH (C);
+
+    X.reinit (n, p, false);
+    std::copy (*C, *C+std::size_t (n)*p, *X);
+
+    blas::trsm (blas::upper, blas::no_transpose, blas::non_unit_diagonal,
+		n, p, ValueType (1), *__top.factors (), n, *X, p);
+  }
+
+} // namepsace ewalena
+
+#include "tsqr_factorization.inst"
@@ -0,0 +1,537 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/lac/vector_kernels.h>
+
+#include "vector_kernels_table.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    namespace
+    {
+
+      /* The portable kernels: a two-lane "register" in plain C++, so
+	 that the same kernel source serves every instruction set. */
+      struct Simd
+      {
+	struct type
+	{
+	  double lane[2];
+	};
+
+	enum { width = 2 };
+
+	static type make (const double a, const double b)
+	{
+	  type r;
+	  r.lane[0] = a;
+	  r.lane[1] = b;
+	  return r;
+	}
+
+	static type load  (const double *p)          { return make (p[0], p[1]); }
+	static void store (double *p, const type a)  { p[0] = a.lane[0]; p[1] = a.lane[1]; }
+	static type set1  (const double a)           { return make (a, a); }
+	static type zero  ()                         { return make (0., 0.); }
+	static type add   (const type a, const type b) { return make (a.lane[0]+b.lane[0], a.lane[1]+b.lane[1]); }
+	static type sub   (const type a, const type b) { return make (a.lane[0]-b.lane[0], a.lane[1]-b.lane[1]); }
+	static type mul   (const type a, const type b) { return make (a.lane[0]*b.lane[0], a.lane[1]*b.lane[1]); }
+	static type abs   (const type a)             { return make (std::fabs (a.lane[0]), std::fabs (a.lane[1])); }
+	static type sqrt  (const type a)             { return make (std::sqrt (a.lane[0]), std::sqrt (a.lane[1])); }
+	static type swap  (const type a)             { return make (a.lane[1], a.lane[0]); }
+
+	static type gather (const double *p, const unsigned int *index)
+	{
+	  return make (p[index[0]], p[index[1]]);
+	}
+
+	static type fmadd (const type a, const type b, const type c)
+	{
+	  return make (a.lane[0]*b.lane[0] + c.lane[0], a.lane[1]*b.lane[1] + c.lane[1]);
+	}
+
+	static type fmaddsub (const type a, const type b, const type c)
+	{
+	  return make (a.lane[0]*b.lane[0] - c.lane[0], a.lane[1]*b.lane[1] + c.lane[1]);
+	}
+      };
+
+#include "vector_kernels_simd.h"
+
+    } /* namespace */
+
+    internal::Kernels internal::generic_kernels ()
+    {
+      return make_kernels ();
+    }
+
+    namespace
+    {
+
+      bool processor_supports (const InstructionSet isa)
+      {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	switch (isa)
+	  {
+	  case generic:
+	    return true;
+	  case sse2:
+	    return __builtin_cpu_supports ("sse2");
+	  case avx2:
+	    return __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+	  case avx512:
+	    return __builtin_cpu_supports ("avx512f");
+	  }
+	return false;
+#else
+	return (isa == generic);
+#endif
+      }
+
+      bool compiled_in (const InstructionSet isa)
+      {
+	switch (isa)
+	  {
+	  case generic:
+	    return true;
+	  case sse2:
+#ifdef EWALENA_WITH_SSE2
+	    return true;
+#else
+	    return false;
+#endif
+	  case avx2:
+#ifdef EWALENA_WITH_AVX2
+	    return true;
+#else
+	    return false;
+#endif
+	  case avx512:
+#ifdef EWALENA_WITH_AVX512
+	    return true;
+#else
+	    return false;
+#endif
+	  }
+	return false;
+      }
+
+      internal::Kernels kernels_for (const InstructionSet isa)
+      {
+	switch (isa)
+	  {
+#ifdef EWALENA_WITH_SSE2
+	  case sse2:
+	    return internal::sse2_kernels ();
+#endif
+#ifdef EWALENA_WITH_AVX2
+	  case avx2:
+	    return internal::avx2_kernels ();
+#endif
+#ifdef EWALENA_WITH_AVX512
+	  case avx512:
+	    return internal::avx512_kernels ();
+#endif
+	  default:
+	    return internal::generic_kernels ();
+	  }
+      }
+
+      /* The widest available instruction set, narrowed down to the
+	 one named in EWALENA_SIMD if there is one. */
+      InstructionSet initial_instruction_set ()
+      {
+	InstructionSet isa = avx512;
+	while (!is_available (isa))
+	  isa = static_cast<InstructionSet> (isa-1);
+
+	const char *names[] = { "generic", "sse2", "avx2", "avx512" };
+	const char *environment = std::getenv ("EWALENA_SIMD");
+
+	if (environment)
+	  for (int i=0; i<=isa; ++i)
+	    if (std::strcmp (environment, names[i]) == 0)
+	      return static_cast<InstructionSet> (i);
+
+	return isa;
+      }
+
+      /* Both are set once, when the library is loaded. */
+      InstructionSet    current = initial_instruction_set ();
+      internal::Kernels kernels = kernels_for (current);
+
+      /* Views of complex arrays and scalars as arrays of doubles. */
+      inline
+	const double* real_array (const std::complex<double> *x)
+      {
+	return reinterpret_cast<const double*> (x);
+      }
+
+      inline
+	double* real_array (std::complex<double> *x)
+      {
+	return reinterpret_cast<double*> (x);
+      }
+
+      /* The kernels proper, for each value type. */
+      inline
+	void add_ (const unsigned int n, const double *x, double *y)
+      {
+	kernels.add (n, x, y);
+      }
+
+      inline
+	void add_ (const unsigned int n, const std::complex<double> *x, std::complex<double> *y)
+      {
+	kernels.add (2*std::size_t (n), real_array (x), real_array (y));
+      }
+
+      inline
+	void subtract_ (const unsigned int n, const double *x, double *y)
+      {
+	kernels.subtract (n, x, y);
+      }
+
+      inline
+	void subtract_ (const unsigned int n, const std::complex<double> *x, std::complex<double> *y)
+      {
+	kernels.subtract (2*std::size_t (n), real_array (x), real_array (y));
+      }
+
+      inline
+	void scale_ (const unsigned int n, const double a, double *x)
+      {
+	kernels.scale (n, a, x);
+      }
+
+      inline
+	void scale_ (const unsigned int n, const std::complex<double> a, std::complex<double> *x)
+      {
+	kernels.zscale (n, real_array (&a), real_array (x));
+      }
+
+      inline
+	void axpy_ (const unsigned int n, const double a, const double *x, double *y)
+      {
+	kernels.axpy (n, a, x, y);
+      }
+
+      inline
+	void axpy_ (const unsigned int n, const std::complex<double> a, const std::complex<double> *x, std::complex<double> *y)
+      {
+	kernels.zaxpy (n, real_array (&a), real_array (x), real_array (y));
+      }
+
+      inline
+	void axpy_conj_ (const unsigned int n, const double a, const double *x, double *y)
+      {
+	kernels.axpy (n, a, x, y);
+      }
+
+      inline
+	void axpy_conj_ (const unsigned int n, const std::complex<double> a, const std::complex<double> *x, std::complex<double> *y)
+      {
+	kernels.zaxpyc (n, real_array (&a), real_array (x), real_array (y));
+      }
+
+      inline
+	void axpby_ (const unsigned int n, const double a, const double *x, const double b, double *y)
+      {
+	kernels.axpby (n, a, x, b, y);
+      }
+
+      inline
+	void axpby_ (const unsigned int n, const std::complex<double> a, const std::complex<double> *x,
+		     const std::complex<double> b, std::complex<double> *y)
+      {
+	kernels.zaxpby (n, real_array (&a), real_array (x), real_array (&b), real_array (y));
+      }
+
+      inline
+	void waxpby_ (const unsigned int n, const double a, const double *x, const double b, const double *y, double *w)
+      {
+	kernels.waxpby (n, a, x, b, y, w);
+      }
+
+      inline
+	void waxpby_ (const unsigned int n, const std::complex<double> a, const std::complex<double> *x,
+		      const std::complex<double> b, const std::complex<double> *y, std::complex<double> *w)
+      {
+	kernels.zwaxpby (n, real_array (&a), real_array (x), real_array (&b), real_array (y), real_array (w));
+      }
+
+      inline
+	void multiply_add_ (const unsigned int n, const double *x, const double *y, double *z)
+      {
+	kernels.multiply_add (n, x, y, z);
+      }
+
+      /* There is no vector kernel for the elementwise product of
+	 complex numbers, which would need lane shuffles beyond those
+	 of Simd. */
+      inline
+	void multiply_add_ (const unsigned int n, const std::complex<double> *x, const std::complex<double> *y,
+			    std::complex<double> *z)
+      {
+	for (unsigned int i=0; i<n; ++i)
+	  z[i] += x[i]*y[i];
+      }
+
+      inline
+	void sell_vmult_ (const unsigned int n_chunks, const unsigned int height, const std::size_t *chunk_start,
+			  const unsigned int *chunk_length, const unsigned int *columns, const double *values,
+			  const double *x, double *y)
+      {
+	kernels.sell (n_chunks, height, chunk_start, chunk_length, columns, values, x, y);
+      }
+
+      /* Complex sliced ELLPACK products have no vector kernel: a
+	 gather of complex numbers would need lane shuffles beyond
+	 those of Simd. */
+      inline
+	void sell_vmult_ (const unsigned int n_chunks, const unsigned int height, const std::size_t *chunk_start,
+			  const unsigned int *chunk_length, const unsigned int *columns,
+			  const std::complex<double> *values, const std::complex<double> *x, std::complex<double> *y)
+      {
+	for (unsigned int c=0; c<n_chunks; ++c)
+	  for (unsigned int r=0; r<height; ++r)
+	    {
+	      std::complex<double> sum = 0.;
+	      for (std::size_t k=chunk_start[c]+r; k<chunk_start[c]+std::size_t (chunk_length[c])*height; k+=height)
+		sum += values[k]*x[columns[k]];
+	      y[std::size_t (c)*height+r] = sum;
+	    }
+      }
+
+      inline
+	double asum_ (const unsigned int n, const double *x)
+      {
+	return kernels.asum (n, x);
+      }
+
+      inline
+	double asum_ (const unsigned int n, const std::complex<double> *x)
+      {
+	return kernels.zasum (n, real_array (x));
+      }
+
+      inline
+	double sumsq_ (const unsigned int n, const double *x)
+      {
+	return kernels.sumsq (n, x);
+      }
+
+      inline
+	double sumsq_ (const unsigned int n, const std::complex<double> *x)
+      {
+	return kernels.sumsq (2*std::size_t (n), real_array (x));
+      }
+
+      inline
+	double dot_ (const unsigned int n, const double *x, const double *y)
+      {
+	return kernels.dot (n, x, y);
+      }
+
+      inline
+	std::complex<double> dot_ (const unsigned int n, const std::complex<double> *x, const std::complex<double> *y)
+      {
+	std::complex<double> result;
+	kernels.zdot (n, real_array (x), real_array (y), real_array (&result));
+	return result;
+      }
+
+      inline
+	double dotu_ (const unsigned int n, const double *x, const double *y)
+      {
+	return kernels.dot (n, x, y);
+      }
+
+      inline
+	std::complex<double> dotu_ (const unsigned int n, const std::complex<double> *x, const std::complex<double> *y)
+      {
+	std::complex<double> result;
+	kernels.zdotu (n, real_array (x), real_array (y), real_array (&result));
+	return result;
+      }
+
+    } /* namespace */
+
+
+    InstructionSet instruction_set ()
+    {
+      return current;
+    }
+
+    bool is_available (const InstructionSet isa)
+    {
+      return compiled_in (isa) && processor_supports (isa);
+    }
+
+    void set_instruction_set (const InstructionSet isa)
+    {
+      assert (is_available (isa));
+
+      current = isa;
+      kernels = kernels_for (isa);
+    }
+
+    template <typename ValueType>
+      void add (const unsigned int  n,
+		const ValueType    *x,
+		ValueType          *y)
+    {
+      add_ (n, x, y);
+    }
+
+    template <typename ValueType>
+      void subtract (const unsigned int  n,
+		     const ValueType    *x,
+		     ValueType          *y)
+    {
+      subtract_ (n, x, y);
+    }
+
+    template <typename ValueType>
+      void scale (const unsigned int  n,
+		  const ValueType     a,
+		  ValueType          *x)
+    {
+      scale_ (n, a, x);
+    }
+
+    template <typename ValueType>
+      void axpy (const unsigned int  n,
+		 const ValueType     a,
+		 const ValueType    *x,
+		 ValueType          *y)
+    {
+      axpy_ (n, a, x, y);
+    }
+
+    template <typename ValueType>
+      void axpy_conj (const unsigned int  n,
+		      const ValueType     a,
+		      const ValueType    *x,
+		      ValueType          *y)
+    {
+      axpy_conj_ (n, a, x, y);
+    }
+
+    template <typename ValueType>
+      void axpby (const unsigned int  n,
+		  const ValueType     a,
+		  const ValueType    *x,
+		  const ValueType     b,
+		  ValueType          *y)
+    {
+      axpby_ (n, a, x, b, y);
+    }
+
+    template <typename ValueType>
+      void waxpby (const unsigned int  n,
+		   const ValueType     a,
+		   const ValueType    *x,
+		   const ValueType     b,
+		   const ValueType    *y,
+		   ValueType          *w)
+    {
+      waxpby_ (n, a, x, b, y, w);
+    }
+
+    template <typename ValueType>
+      void multiply_add (const unsigned int  n,
+			 const ValueType    *x,
+			 const ValueType    *y,
+			 ValueType          *z)
+    {
+      multiply_add_ (n, x, y, z);
+    }
+
+    template <typename ValueType>
+      void sell_vmult (const unsigned int  n_chunks,
+		       const unsigned int  height,
+		       const std::size_t  *chunk_start,
+		       const unsigned int *chunk_length,
+		       const unsigned int *columns,
+		       const ValueType    *values,
+		       const ValueType    *x,
+		       ValueType          *y)
+    {
+      assert (height % sell_chunk_height == 0);
+      sell_vmult_ (n_chunks, height, chunk_start, chunk_length, columns, values, x, y);
+    }
+
+    template <typename ValueType>
+      double asum (const unsigned int  n,
+		   const ValueType    *x)
+    {
+      return asum_ (n, x);
+    }
+
+    template <typename ValueType>
+      double nrm2 (const unsigned int  n,
+		   const ValueType    *x)
+    {
+      return std::sqrt (sumsq_ (n, x));
+    }
+
+    template <typename ValueType>
+      ValueType dot (const unsigned int  n,
+		     const ValueType    *x,
+		     const ValueType    *y)
+    {
+      return dot_ (n, x, y);
+    }
+
+    template <typename ValueType>
+      ValueType dotu (const unsigned int  n,
+		      const ValueType    *x,
+		      const ValueType    *y)
+    {
+      return dotu_ (n, x, y);
+    }
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#include "vector_kernels.inst"
@@ -0,0 +1,93 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+// AVX-512 vector kernels, compiled with -mavx512f. Everything here
+// has internal linkage; see vector_kernels_table.h.
+
+#include "vector_kernels_table.h"
+
+#include <immintrin.h>
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    namespace
+    {
+
+      struct Simd
+      {
+	typedef __m512d type;
+
+	enum { width = 8 };
+
+	static type load  (const double *p)          { return _mm512_loadu_pd (p); }
+	static void store (double *p, const type a)  { _mm512_storeu_pd (p, a); }
+	static type set1  (const double a)           { return _mm512_set1_pd (a); }
+	static type zero  ()                         { return _mm512_setzero_pd (); }
+	static type add   (const type a, const type b) { return _mm512_add_pd (a, b); }
+	static type sub   (const type a, const type b) { return _mm512_sub_pd (a, b); }
+	static type mul   (const type a, const type b) { return _mm512_mul_pd (a, b); }
+	static type abs   (const type a)             { return _mm512_abs_pd (a); }
+	static type sqrt  (const type a)             { return _mm512_sqrt_pd (a); }
+	static type swap  (const type a)             { return _mm512_permute_pd (a, 0x55); }
+
+	static type gather (const double *p, const unsigned int *index)
+	{
+	  return _mm512_i32gather_pd (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (index)), p, 8);
+	}
+
+	static type fmadd (const type a, const type b, const type c)
+	{
+	  return _mm512_fmadd_pd (a, b, c);
+	}
+
+	static type fmaddsub (const type a, const type b, const type c)
+	{
+	  return _mm512_fmaddsub_pd (a, b, c);
+	}
+      };
+
+#include "vector_kernels_simd.h"
+
+    } /* namespace */
+
+    internal::Kernels internal::avx512_kernels ()
+    {
+      return make_kernels ();
+    }
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
@@ -0,0 +1,539 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+// The vector kernels, written once against a register type
+// <code>Simd</code> that each including translation unit defines for
+// its instruction set. This file is included inside an anonymous
+// namespace so that every instruction set gets its own private copy.
+//
+// Simd provides: type, width (doubles per register), load, store
+// (unaligned), set1, zero, add, sub, mul, fmadd (a*b+c), abs, sqrt,
+// swap (exchange neighbouring pairs), fmaddsub (a*b-c in even,
+// a*b+c in odd lanes) and gather (load p[index[l]] into lane l).
+
+/* Horizontal sums of a register: all lanes, and even minus odd
+   lanes. */
+inline
+double sum (const Simd::type a)
+{
+  double lanes[Simd::width];
+  Simd::store (lanes, a);
+
+  double s = 0.;
+  for (unsigned int l=0; l<Simd::width; ++l)
+    s += lanes[l];
+  return s;
+}
+
+inline
+double alternating_sum (const Simd::type a)
+{
+  double lanes[Simd::width];
+  Simd::store (lanes, a);
+
+  double s = 0.;
+  for (unsigned int l=0; l<Simd::width; l+=2)
+    s += lanes[l] - lanes[l+1];
+  return s;
+}
+
+/* (a_re + i a_im) times the interleaved complex numbers in x. */
+inline
+Simd::type complex_mul (const Simd::type a_re,
+			const Simd::type a_im,
+			const Simd::type x)
+{
+  return Simd::fmaddsub (a_re, x, Simd::mul (a_im, Simd::swap (x)));
+}
+
+/*-------------- Real kernels ---------------------------------------*/
+
+void add (const std::size_t n, const double *x, double *y)
+{
+  const std::size_t w = Simd::width;
+  std::size_t i = 0;
+
+  for (; i+2*w<=n; i+=2*w)
+    {
+      Simd::store (y+i,   Simd::add (Simd::load (y+i),   Simd::load (x+i)));
+      Simd::store (y+i+w, Simd::add (Simd::load (y+i+w), Simd::load (x+i+w)));
+    }
+  for (; i<n; ++i)
+    y[i] += x[i];
+}
+
+void subtract (const std::size_t n, const double *x, double *y)
+{
+  const std::size_t w = Simd::width;
+  std::size_t i = 0;
+
+  for (; i+2*w<=n; i+=2*w)
+    {
+      Simd::store (y+i,   Simd::sub (Simd::load (y+i),   Simd::load (x+i)));
+      Simd::store (y+i+w, Simd::sub (Simd::load (y+i+w), Simd::load (x+i+w)));
+    }
+  for (; i<n; ++i)
+    y[i] -= x[i];
+}
+
+void scale (const std::size_t n, const double a, double *x)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  va = Simd::set1 (a);
+  std::size_t i = 0;
+
+  for (; i+2*w<=n; i+=2*w)
+    {
+      Simd::store (x+i,   Simd::mul (va, Simd::load (x+i)));
+      Simd::store (x+i+w, Simd::mul (va, Simd::load (x+i+w)));
+    }
+  for (; i<n; ++i)
+    x[i] *= a;
+}
+
+void axpy (const std::size_t n, const double a, const double *x, double *y)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  va = Simd::set1 (a);
+  std::size_t i = 0;
+
+  for (; i+2*w<=n; i+=2*w)
+    {
+      Simd::store (y+i,   Simd::fmadd (va, Simd::load (x+i),   Simd::load (y+i)));
+      Simd::store (y+i+w, Simd::fmadd (va, Simd::load (x+i+w), Simd::load (y+i+w)));
+    }
+  for (; i<n; ++i)
+    y[i] += a*x[i];
+}
+
+void axpby (const std::size_t n, const double a, const double *x, const double b, double *y)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  va = Simd::set1 (a);
+  const Simd::type  vb = Simd::set1 (b);
+  std::size_t i = 0;
+
+  /* Never read y if it is to be discarded: it may not even hold
+     numbers. */
+  if (b == 0.)
+    {
+      for (; i+w<=n; i+=w)
+	Simd::store (y+i, Simd::mul (va, Simd::load (x+i)));
+      for (; i<n; ++i)
+	y[i] = a*x[i];
+      return;
+    }
+
+  for (; i+w<=n; i+=w)
+    Simd::store (y+i, Simd::fmadd (va, Simd::load (x+i), Simd::mul (vb, Simd::load (y+i))));
+  for (; i<n; ++i)
+    y[i] = a*x[i] + b*y[i];
+}
+
+void waxpby (const std::size_t n, const double a, const double *x, const double b, const double *y, double *z)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  va = Simd::set1 (a);
+  const Simd::type  vb = Simd::set1 (b);
+  std::size_t i = 0;
+
+  for (; i+w<=n; i+=w)
+    Simd::store (z+i, Simd::fmadd (va, Simd::load (x+i), Simd::mul (vb, Simd::load (y+i))));
+  for (; i<n; ++i)
+    z[i] = a*x[i] + b*y[i];
+}
+
+void multiply_add (const std::size_t n, const double *x, const double *y, double *z)
+{
+  const std::size_t w = Simd::width;
+  std::size_t i = 0;
+
+  for (; i+2*w<=n; i+=2*w)
+    {
+      Simd::store (z+i,   Simd::fmadd (Simd::load (x+i),   Simd::load (y+i),   Simd::load (z+i)));
+      Simd::store (z+i+w, Simd::fmadd (Simd::load (x+i+w), Simd::load (y+i+w), Simd::load (z+i+w)));
+    }
+  for (; i<n; ++i)
+    z[i] += x[i]*y[i];
+}
+
+/* The reductions keep four independent accumulators to hide the
+   latency of the additions. */
+double asum (const std::size_t n, const double *x)
+{
+  const std::size_t w = Simd::width;
+  Simd::type s0 = Simd::zero (), s1 = Simd::zero (), s2 = Simd::zero (), s3 = Simd::zero ();
+  std::size_t i = 0;
+
+  for (; i+4*w<=n; i+=4*w)
+    {
+      s0 = Simd::add (s0, Simd::abs (Simd::load (x+i)));
+      s1 = Simd::add (s1, Simd::abs (Simd::load (x+i+w)));
+      s2 = Simd::add (s2, Simd::abs (Simd::load (x+i+2*w)));
+      s3 = Simd::add (s3, Simd::abs (Simd::load (x+i+3*w)));
+    }
+  for (; i+w<=n; i+=w)
+    s0 = Simd::add (s0, Simd::abs (Simd::load (x+i)));
+
+  double s = sum (Simd::add (Simd::add (s0, s1), Simd::add (s2, s3)));
+  for (; i<n; ++i)
+    s += __builtin_fabs (x[i]);
+  return s;
+}
+
+double dot (const std::size_t n, const double *x, const double *y)
+{
+  const std::size_t w = Simd::width;
+  Simd::type s0 = Simd::zero (), s1 = Simd::zero (), s2 = Simd::zero (), s3 = Simd::zero ();
+  std::size_t i = 0;
+
+  for (; i+4*w<=n; i+=4*w)
+    {
+      s0 = Simd::fmadd (Simd::load (x+i),     Simd::load (y+i),     s0);
+      s1 = Simd::fmadd (Simd::load (x+i+w),   Simd::load (y+i+w),   s1);
+      s2 = Simd::fmadd (Simd::load (x+i+2*w), Simd::load (y+i+2*w), s2);
+      s3 = Simd::fmadd (Simd::load (x+i+3*w), Simd::load (y+i+3*w), s3);
+    }
+  for (; i+w<=n; i+=w)
+    s0 = Simd::fmadd (Simd::load (x+i), Simd::load (y+i), s0);
+
+  double s = sum (Simd::add (Simd::add (s0, s1), Simd::add (s2, s3)));
+  for (; i<n; ++i)
+    s += x[i]*y[i];
+  return s;
+}
+
+double sumsq (const std::size_t n, const double *x)
+{
+  return dot (n, x, x);
+}
+
+/* Sliced ELLPACK products: chunk c holds chunk_length[c] columns of
+   height values each, stored column after column from
+   chunk_start[c], and y[c*height+r] becomes the product of its rth
+   row with x. The height is a multiple of the widest register, so
+   every register holds consecutive rows of one column of a chunk;
+   two columns are in flight at a time to hide the latency of the
+   gathers. */
+void sell (const std::size_t    n_chunks,
+	   const std::size_t    height,
+	   const std::size_t   *chunk_start,
+	   const unsigned int  *chunk_length,
+	   const unsigned int  *columns,
+	   const double        *values,
+	   const double        *x,
+	   double              *y)
+{
+  const std::size_t w = Simd::width;
+
+  for (std::size_t c=0; c<n_chunks; ++c)
+    for (std::size_t r=0; r<height; r+=w)
+      {
+	const unsigned int *column = columns + chunk_start[c] + r;
+	const double       *value  = values  + chunk_start[c] + r;
+	const std::size_t   length = chunk_length[c];
+
+	Simd::type s0 = Simd::zero (), s1 = Simd::zero ();
+	std::size_t k = 0;
+
+	for (; k+2<=length; k+=2)
+	  {
+	    s0 = Simd::fmadd (Simd::load (value+k*height), 
+			      Simd::gather (x, column+k*height), s0);
+	    s1 = Simd::fmadd (Simd::load (value+(k+1)*height), 
+			      Simd::gather (x, column+(k+1)*height), s1);
+	  }
+	if (k < length)
+	  s0 = Simd::fmadd (Simd::load (value+k*height), 
+			    Simd::gather (x, column+k*height), s0);
+
+	Simd::store (y + c*height + r, Simd::add (s0, s1));
+      }
+}
+
+/*-------------- Complex kernels ------------------------------------*/
+
+/* In here n counts complex numbers, that is pairs of doubles, and
+   every register holds width/2 of them. */
+
+void zscale (const std::size_t n, const double *a, double *x)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  a_re = Simd::set1 (a[0]);
+  const Simd::type  a_im = Simd::set1 (a[1]);
+  std::size_t i = 0;
+
+  for (; i+w<=2*n; i+=w)
+    Simd::store (x+i, complex_mul (a_re, a_im, Simd::load (x+i)));
+  for (; i<2*n; i+=2)
+    {
+      const double x_re = x[i];
+      x[i]   = a[0]*x_re - a[1]*x[i+1];
+      x[i+1] = a[0]*x[i+1] + a[1]*x_re;
+    }
+}
+
+void zaxpy (const std::size_t n, const double *a, const double *x, double *y)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  a_re = Simd::set1 (a[0]);
+  const Simd::type  a_im = Simd::set1 (a[1]);
+  std::size_t i = 0;
+
+  for (; i+w<=2*n; i+=w)
+    Simd::store (y+i, Simd::add (Simd::load (y+i), complex_mul (a_re, a_im, Simd::load (x+i))));
+  for (; i<2*n; i+=2)
+    {
+      y[i]   += a[0]*x[i]   - a[1]*x[i+1];
+      y[i+1] += a[0]*x[i+1] + a[1]*x[i];
+    }
+}
+
+void zaxpby (const std::size_t n, const double *a, const double *x, const double *b, double *y)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  a_re = Simd::set1 (a[0]);
+  const Simd::type  a_im = Simd::set1 (a[1]);
+  const Simd::type  b_re = Simd::set1 (b[0]);
+  const Simd::type  b_im = Simd::set1 (b[1]);
+  std::size_t i = 0;
+
+  if ((b[0] == 0.) && (b[1] == 0.))
+    {
+      for (; i+w<=2*n; i+=w)
+	Simd::store (y+i, complex_mul (a_re, a_im, Simd::load (x+i)));
+      for (; i<2*n; i+=2)
+	{
+	  y[i]   = a[0]*x[i]   - a[1]*x[i+1];
+	  y[i+1] = a[0]*x[i+1] + a[1]*x[i];
+	}
+      return;
+    }
+
+  for (; i+w<=2*n; i+=w)
+    Simd::store (y+i, Simd::add (complex_mul (a_re, a_im, Simd::load (x+i)),
+				 complex_mul (b_re, b_im, Simd::load (y+i))));
+  for (; i<2*n; i+=2)
+    {
+      const double y_re = y[i];
+      y[i]   = a[0]*x[i]   - a[1]*x[i+1] + b[0]*y_re   - b[1]*y[i+1];
+      y[i+1] = a[0]*x[i+1] + a[1]*x[i]   + b[0]*y[i+1] + b[1]*y_re;
+    }
+}
+
+void zwaxpby (const std::size_t n, const double *a, const double *x, const double *b, const double *y, double *z)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  a_re = Simd::set1 (a[0]);
+  const Simd::type  a_im = Simd::set1 (a[1]);
+  const Simd::type  b_re = Simd::set1 (b[0]);
+  const Simd::type  b_im = Simd::set1 (b[1]);
+  std::size_t i = 0;
+
+  for (; i+w<=2*n; i+=w)
+    Simd::store (z+i, Simd::add (complex_mul (a_re, a_im, Simd::load (x+i)),
+				 complex_mul (b_re, b_im, Simd::load (y+i))));
+  for (; i<2*n; i+=2)
+    {
+      const double z_re = a[0]*x[i]   - a[1]*x[i+1] + b[0]*y[i]   - b[1]*y[i+1];
+      const double z_im = a[0]*x[i+1] + a[1]*x[i]   + b[0]*y[i+1] + b[1]*y[i];
+      z[i]   = z_re;
+      z[i+1] = z_im;
+    }
+}
+
+double zasum (const std::size_t n, const double *x)
+{
+  const std::size_t w = Simd::width;
+  Simd::type s0 = Simd::zero (), s1 = Simd::zero ();
+  std::size_t i = 0;
+
+  /* Adding the squares to their swapped selves puts the squared
+     modulus in both lanes of a pair, so the sum is counted twice. */
+  for (; i+2*w<=2*n; i+=2*w)
+    {
+      const Simd::type x0 = Simd::load (x+i);
+      const Simd::type x1 = Simd::load (x+i+w);
+      const Simd::type q0 = Simd::mul (x0, x0);
+      const Simd::type q1 = Simd::mul (x1, x1);
+      s0 = Simd::add (s0, Simd::sqrt (Simd::add (q0, Simd::swap (q0))));
+      s1 = Simd::add (s1, Simd::sqrt (Simd::add (q1, Simd::swap (q1))));
+    }
+  for (; i+w<=2*n; i+=w)
+    {
+      const Simd::type x0 = Simd::load (x+i);
+      const Simd::type q0 = Simd::mul (x0, x0);
+      s0 = Simd::add (s0, Simd::sqrt (Simd::add (q0, Simd::swap (q0))));
+    }
+
+  double s = 0.5*sum (Simd::add (s0, s1));
+  for (; i<2*n; i+=2)
+    s += __builtin_sqrt (x[i]*x[i] + x[i+1]*x[i+1]);
+  return s;
+}
+
+void zdot (const std::size_t n, const double *x, const double *y, double *result)
+{
+  const std::size_t w = Simd::width;
+  Simd::type re0 = Simd::zero (), re1 = Simd::zero ();
+  Simd::type im0 = Simd::zero (), im1 = Simd::zero ();
+  std::size_t i = 0;
+
+  /* conj(x)*y = (x_re y_re + x_im y_im) + i (x_re y_im - x_im y_re):
+     the real part is the plain sum of x*y, the imaginary part the
+     alternating sum of x*swap(y). */
+  for (; i+2*w<=2*n; i+=2*w)
+    {
+      const Simd::type x0 = Simd::load (x+i),   y0 = Simd::load (y+i);
+      const Simd::type x1 = Simd::load (x+i+w), y1 = Simd::load (y+i+w);
+      re0 = Simd::fmadd (x0, y0, re0);
+      re1 = Simd::fmadd (x1, y1, re1);
+      im0 = Simd::fmadd (x0, Simd::swap (y0), im0);
+      im1 = Simd::fmadd (x1, Simd::swap (y1), im1);
+    }
+  for (; i+w<=2*n; i+=w)
+    {
+      const Simd::type x0 = Simd::load (x+i), y0 = Simd::load (y+i);
+      re0 = Simd::fmadd (x0, y0, re0);
+      im0 = Simd::fmadd (x0, Simd::swap (y0), im0);
+    }
+
+  double s_re = sum (Simd::add (re0, re1));
+  double s_im = alternating_sum (Simd::add (im0, im1));
+  for (; i<2*n; i+=2)
+    {
+      s_re += x[i]*y[i]   + x[i+1]*y[i+1];
+      s_im += x[i]*y[i+1] - x[i+1]*y[i];
+    }
+
+  result[0] = s_re;
+  result[1] = s_im;
+}
+
+void zdotu (const std::size_t n, const double *x, const double *y, double *result)
+{
+  const std::size_t w = Simd::width;
+  Simd::type re0 = Simd::zero (), re1 = Simd::zero ();
+  Simd::type im0 = Simd::zero (), im1 = Simd::zero ();
+  std::size_t i = 0;
+
+  /* x*y = (x_re y_re - x_im y_im) + i (x_re y_im + x_im y_re): the
+     real part is the alternating sum of x*y, the imaginary part the
+     plain sum of x*swap(y). */
+  for (; i+2*w<=2*n; i+=2*w)
+    {
+      const Simd::type x0 = Simd::load (x+i),   y0 = Simd::load (y+i);
+      const Simd::type x1 = Simd::load (x+i+w), y1 = Simd::load (y+i+w);
+      re0 = Simd::fmadd (x0, y0, re0);
+      re1 = Simd::fmadd (x1, y1, re1);
+      im0 = Simd::fmadd (x0, Simd::swap (y0), im0);
+      im1 = Simd::fmadd (x1, Simd::swap (y1), im1);
+    }
+  for (; i+w<=2*n; i+=w)
+    {
+      const Simd::type x0 = Simd::load (x+i), y0 = Simd::load (y+i);
+      re0 = Simd::fmadd (x0, y0, re0);
+      im0 = Simd::fmadd (x0, Simd::swap (y0), im0);
+    }
+
+  double s_re = alternating_sum (Simd::add (re0, re1));
+  double s_im = sum (Simd::add (im0, im1));
+  for (; i<2*n; i+=2)
+    {
+      s_re += x[i]*y[i]   - x[i+1]*y[i+1];
+      s_im += x[i]*y[i+1] + x[i+1]*y[i];
+    }
+
+  result[0] = s_re;
+  result[1] = s_im;
+}
+
+void zaxpyc (const std::size_t n, const double *a, const double *x, double *y)
+{
+  const std::size_t w = Simd::width;
+  const Simd::type  a_im       = Simd::set1 (a[1]);
+  const Simd::type  minus_a_re = Simd::set1 (-a[0]);
+  std::size_t i = 0;
+
+  /* a*conj(x) = (a_re x_re + a_im x_im) + i (a_im x_re - a_re x_im),
+     which is a_im swap(x) + a_re x in the even and a_im swap(x) -
+     a_re x in the odd lanes. */
+  for (; i+2*w<=2*n; i+=2*w)
+    {
+      const Simd::type x0 = Simd::load (x+i), x1 = Simd::load (x+i+w);
+      Simd::store (y+i,   Simd::add (Simd::load (y+i),   
+				     Simd::fmaddsub (a_im, Simd::swap (x0), Simd::mul (minus_a_re, x0))));
+      Simd::store (y+i+w, Simd::add (Simd::load (y+i+w), 
+				     Simd::fmaddsub (a_im, Simd::swap (x1), Simd::mul (minus_a_re, x1))));
+    }
+  for (; i+w<=2*n; i+=w)
+    {
+      const Simd::type x0 = Simd::load (x+i);
+      Simd::store (y+i, Simd::add (Simd::load (y+i), 
+				   Simd::fmaddsub (a_im, Simd::swap (x0), Simd::mul (minus_a_re, x0))));
+    }
+  for (; i<2*n; i+=2)
+    {
+      y[i]   += a[0]*x[i]   + a[1]*x[i+1];
+      y[i+1] += a[1]*x[i]   - a[0]*x[i+1];
+    }
+}
+
+/*-------------- The table ------------------------------------------*/
+
+internal::Kernels make_kernels ()
+{
+  internal::Kernels kernels;
+
+  kernels.add      = &add;
+  kernels.subtract = &subtract;
+  kernels.scale    = &scale;
+  kernels.axpy     = &axpy;
+  kernels.axpby    = &axpby;
+  kernels.waxpby   = &waxpby;
+  kernels.multiply_add = &multiply_add;
+  kernels.asum     = &asum;
+  kernels.sumsq    = &sumsq;
+  kernels.dot      = &dot;
+  kernels.sell     = &sell;
+
+  kernels.zscale   = &zscale;
+  kernels.zaxpy    = &zaxpy;
+  kernels.zaxpyc   = &zaxpyc;
+  kernels.zaxpby   = &zaxpby;
+  kernels.zwaxpby  = &zwaxpby;
+  kernels.zasum    = &zasum;
+  kernels.zdot     = &zdot;
+  kernels.zdotu    = &zdotu;
+
+  return kernels;
+}
@@ -0,0 +1,99 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <cstddef>
+
+#ifndef __ewalena_vector_kernels_table_h
+#define __ewalena_vector_kernels_table_h
+
+namespace ewalena
+{
+
+  namespace blas
+  {
+
+    namespace internal
+    {
+
+      /**
+       * The vector kernels of one instruction set. Everything is
+       * expressed in terms of arrays of doubles so that the
+       * translation units compiled for wider instruction sets need
+       * not touch any inline library code (which the linker could
+       * otherwise pick up for the rest of the program). The
+       * <code>z</code> kernels work on interleaved complex numbers,
+       * with complex scalars passed as {real, imaginary} pairs, and
+       * their length counts complex numbers; <code>zaxpyc</code>
+       * conjugates <code>x</code>, and <code>zdotu</code> conjugates
+       * neither argument.
+       */
+      struct Kernels
+      {
+	void   (*add)      (const std::size_t, const double*, double*);
+	void   (*subtract) (const std::size_t, const double*, double*);
+	void   (*scale)    (const std::size_t, const double, double*);
+	void   (*axpy)     (const std::size_t, const double, const double*, double*);
+	void   (*axpby)    (const std::size_t, const double, const double*, const double, double*);
+	void   (*waxpby)   (const std::size_t, const double, const double*, const double, const double*, double*);
+	void   (*multiply_add) (const std::size_t, const double*, const double*, double*);
+	double (*asum)     (const std::size_t, const double*);
+	double (*sumsq)    (const std::size_t, const double*);
+	double (*dot)      (const std::size_t, const double*, const double*);
+	void   (*sell)     (const std::size_t, const std::size_t, const std::size_t*, const unsigned int*,
+			    const unsigned int*, const double*, const double*, double*);
+
+	void   (*zscale)   (const std::size_t, const double*, double*);
+	void   (*zaxpy)    (const std::size_t, const double*, const double*, double*);
+	void   (*zaxpyc)   (const std::size_t, const double*, const double*, double*);
+	void   (*zaxpby)   (const std::size_t, const double*, const double*, const double*, double*);
+	void   (*zwaxpby)  (const std::size_t, const double*, const double*, const double*, const double*, double*);
+	double (*zasum)    (const std::size_t, const double*);
+	void   (*zdot)     (const std::size_t, const double*, const double*, double*);
+	void   (*zdotu)    (const std::size_t, const double*, const double*, double*);
+      };
+
+      /**
+       * The kernels for each instruction set; only those compiled in
+       * are defined.
+       */
+      Kernels generic_kernels ();
+      Kernels sse2_kernels ();
+      Kernels avx2_kernels ();
+      Kernels avx512_kernels ();
+
+    } /* namespace internal */
+
+  } /* namespace blas */
+
+} /* namespace ewalena */
+
+#endif /* __ewalena_vector_kernels_table_h */
@@ -0,0 +1,130 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/many_body/fock_basis.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace ewalena
+{
+
+  FockBasis::FockBasis (const unsigned int n_modes)
+    :
+    __n_modes (n_modes),
+    __n_particles (0),
+    __conserves_particle_number (false),
+    __size (0)
+  {
+    /* The index of a state is its value. */
+    assert (n_modes < 32);
+
+    __size = 1u << n_modes;
+  }
+
+  FockBasis::FockBasis (const unsigned int n_modes,
+			const unsigned int n_particles)
+    :
+    __n_modes (n_modes),
+    __n_particles (n_particles),
+    __conserves_particle_number (true),
+    __size (0)
+  {
+    assert (n_modes <= 64);
+    assert (n_particles <= n_modes);
+    assert (binomial (n_modes, n_particles) <= std::numeric_limits<unsigned int>::max ());
+
+    __size = binomial (n_modes, n_particles);
+
+    __binomials.resize (std::size_t (n_modes+1)*(n_particles+1));
+    for (unsigned int p=0; p<=n_modes; ++p)
+      for (unsigned int k=0; k<=n_particles; ++k)
+	__binomials[p*(n_particles+1)+k] = binomial (p, k);
+  }
+
+  std::uint64_t
+  FockBasis::binomial (const unsigned int n,
+		       const unsigned int k)
+  {
+    assert (n <= 64);
+
+    if (k > n)
+      return 0;
+
+    /* A row of Pascal's triangle, which never overflows for n up to
+       64. */
+    std::vector<std::uint64_t> row (k+1, 0);
+    row[0] = 1;
+    for (unsigned int m=1; m<=n; ++m)
+      for (unsigned int j=std::min (m, k); j>0; --j)
+	row[j] += row[j-1];
+
+    return row[k];
+  }
+
+  FockBasis::State
+  FockBasis::state (const unsigned int i) const
+  {
+    assert (i < __size);
+
+    if (!__conserves_particle_number)
+      return i;
+
+    /* Unrank greedily from the highest occupied mode down: it is the
+       largest p with binomial (p, k) not above what is left of the
+       index. */
+    State         s    = 0;
+    std::uint64_t rest = i;
+    unsigned int  p    = __n_modes;
+    for (unsigned int k=__n_particles; k>0; --k)
+      {
+	do
+	  --p;
+	while (__binomials[p*(__n_particles+1)+k] > rest);
+
+	s    |= State (1) << p;
+	rest -= __binomials[p*(__n_particles+1)+k];
+      }
+
+    return s;
+  }
+
+  bool
+  FockBasis::contains (const State s) const
+  {
+    if (__n_modes < 64 && (s >> __n_modes) != 0)
+      return false;
+
+    return !__conserves_particle_number || (count (s) == __n_particles);
+  }
+
+} // namepsace ewalena
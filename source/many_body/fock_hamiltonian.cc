@@ -0,0 +1,329 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/math.h>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/many_body/fock_hamiltonian.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of consecutive states handed to a thread at a
+       time. */
+    const unsigned int block_size = 4096;
+
+    /* The phase e^{-2 pi i ml/L} of a Bloch state with momentum m
+       translated by l sites, which is real only for the momenta zero
+       and pi. */
+    template <typename ValueType>
+    ValueType phase (const unsigned int m,
+		     const unsigned int l,
+		     const unsigned int L);
+
+    template <>
+    double phase (const unsigned int m,
+		  const unsigned int l,
+		  const unsigned int L)
+    {
+      assert ((2*m) % L == 0);
+      return ((2*m*l/L) & 1) ? -1. : 1.;
+    }
+
+    template <>
+    std::complex<double> phase (const unsigned int m,
+				const unsigned int l,
+				const unsigned int L)
+    {
+      return std::polar (1., -2.*math::PI*((m*l) % L)/L);
+    }
+
+  } /* namespace */
+
+
+  template <typename ValueType>
+  FockHamiltonian<ValueType>::FockHamiltonian (const FockBasis             &basis,
+					       const FockBasis::Statistics  statistics)
+    :
+    __basis (basis),
+    __statistics (statistics),
+    __potential (basis.n_modes (), 0.)
+  {}
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::add_hopping (const unsigned int a,
+					   const unsigned int b,
+					   const ValueType    t)
+  {
+    assert (a < __basis.n_modes () && b < __basis.n_modes ());
+    assert (a != b);
+
+    const unsigned int low  = std::min (a, b);
+    const unsigned int high = std::max (a, b);
+
+    Hopping hopping;
+    hopping.a       = a;
+    hopping.b       = b;
+    hopping.bit_a   = FockBasis::State (1) << a;
+    hopping.bit_b   = FockBasis::State (1) << b;
+    hopping.between = ((FockBasis::State (1) << high) - 1) & ~((FockBasis::State (1) << (low+1)) - 1);
+    hopping.t       = t;
+
+    __hoppings.push_back (hopping);
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::add_potential (const unsigned int a,
+					     const double       epsilon)
+  {
+    assert (a < __basis.n_modes ());
+
+    __potential[a] += epsilon;
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::add_interaction (const unsigned int a,
+					       const unsigned int b,
+					       const double       V)
+  {
+    assert (a < __basis.n_modes () && b < __basis.n_modes ());
+    assert (a != b);
+
+    Interaction interaction;
+    interaction.modes = (FockBasis::State (1) << a) | (FockBasis::State (1) << b);
+    interaction.V     = V;
+
+    __interactions.push_back (interaction);
+  }
+
+  template <typename ValueType>
+  double
+  FockHamiltonian<ValueType>::diagonal (const FockBasis::State s) const
+  {
+    double value = 0.;
+
+    for (FockBasis::State rest=s; rest!=0; rest&=rest-1)
+      value += __potential[__builtin_ctzll (rest)];
+
+    for (const Interaction &interaction : __interactions)
+      if ((s & interaction.modes) == interaction.modes)
+	value += interaction.V;
+
+    return value;
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::diagonal (Vector<ValueType> &d) const
+  {
+    d.reinit (size (), false);
+
+    ThreadPool::instance ().run ((size ()+block_size-1)/block_size,
+				 [&] (const unsigned int block)
+				 {
+				   const unsigned int begin = block*block_size;
+				   const unsigned int end   = std::min (size (), begin+block_size);
+
+				   FockBasis::State s = __basis.state (begin);
+				   for (unsigned int i=begin; i<end; ++i, s=__basis.next (s))
+				     d(i) = ValueType (diagonal (s));
+				 });
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::vmult_states (const unsigned int  begin,
+					    const unsigned int  end,
+					    ValueType          *y,
+					    const ValueType    *x) const
+  {
+    FockBasis::State s = __basis.state (begin);
+
+    for (unsigned int i=begin; i<end; ++i, s=__basis.next (s))
+      {
+	ValueType sum = ValueType (diagonal (s))*x[i];
+
+	/* A term connects s to the state with the particle on the
+	   other of its two modes, t c_a^+ c_b if it is on a and its
+	   adjoint if it is on b. */
+	for (const Hopping &hopping : __hoppings)
+	  {
+	    const bool on_a = (s & hopping.bit_a) != 0;
+	    const bool on_b = (s & hopping.bit_b) != 0;
+	    if (on_a == on_b)
+	      continue;
+
+	    ValueType amplitude = on_a ? hopping.t : math::conjugate (hopping.t);
+	    if ((__statistics == FockBasis::fermions) && (FockBasis::count (s & hopping.between) & 1))
+	      amplitude = -amplitude;
+
+	    const unsigned int j = on_a
+	      ? __basis.index (i, s, hopping.a, hopping.b)
+	      : __basis.index (i, s, hopping.b, hopping.a);
+
+	    sum += amplitude*x[j];
+	  }
+
+	y[i] = sum;
+      }
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::vmult (Vector<ValueType>       &y,
+				     const Vector<ValueType> &x) const
+  {
+    assert (x.size () == size ());
+    assert (y.size () == size ());
+    assert (&x != &y);
+
+    ThreadPool::instance ().run ((size ()+block_size-1)/block_size,
+				 [&] (const unsigned int block)
+				 {
+				   const unsigned int begin = block*block_size;
+				   vmult_states (begin, std::min (size (), begin+block_size), *y, *x);
+				 });
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::sector_column (const SectorBasis                               &sector,
+					     const unsigned int                               a,
+					     std::vector<std::pair<unsigned int, ValueType>> &column) const
+  {
+    const FockBasis::State r = sector.state (a);
+
+    column.clear ();
+    column.push_back (std::make_pair (a, ValueType (diagonal (r))));
+
+    /* Scatter: t c_a^+ c_b takes the particle from b to a, and its
+       adjoint from a to b. The state reached is brought back to its
+       representative, which for Bloch states gives
+       H(b,a) = h sign e^{-ikl} sqrt (R_a/R_b). */
+    for (const Hopping &hopping : __hoppings)
+      {
+	const bool on_a = (r & hopping.bit_a) != 0;
+	const bool on_b = (r & hopping.bit_b) != 0;
+	if (on_a == on_b)
+	  continue;
+
+	ValueType h = on_b ? hopping.t : math::conjugate (hopping.t);
+	if ((__statistics == FockBasis::fermions) && (FockBasis::count (r & hopping.between) & 1))
+	  h = -h;
+
+	unsigned int b, shift;
+	double       sign;
+	if (!sector.find (r ^ (hopping.bit_a | hopping.bit_b), b, shift, sign))
+	  continue;
+
+	if (sector.has_momentum ())
+	  h *= sign*phase<ValueType> (sector.momentum (), shift, sector.n_sites ())
+	    *std::sqrt (double (sector.period (a))/sector.period (b));
+
+	column.push_back (std::make_pair (b, h));
+      }
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::assemble (const SectorBasis       &sector,
+					SparseMatrix<ValueType> &M) const
+  {
+    assert (sector.n_modes () == __basis.n_modes ());
+    assert (!sector.has_momentum () || (sector.statistics () == __statistics));
+
+    const unsigned int n_blocks = (sector.size ()+block_size-1)/block_size;
+    std::vector<std::vector<typename SparseMatrix<ValueType>::Triplet>> triplets (n_blocks);
+
+    ThreadPool::instance ().run (n_blocks,
+				 [&] (const unsigned int block)
+				 {
+				   const unsigned int begin = block*block_size;
+				   const unsigned int end   = std::min (sector.size (), begin+block_size);
+
+				   std::vector<std::pair<unsigned int, ValueType>> column;
+				   for (unsigned int a=begin; a<end; ++a)
+				     {
+				       sector_column (sector, a, column);
+				       for (const std::pair<unsigned int, ValueType> &element : column)
+					 {
+					   const typename SparseMatrix<ValueType>::Triplet triplet = {element.first, a, element.second};
+					   triplets[block].push_back (triplet);
+					 }
+				     }
+				 });
+
+    for (unsigned int block=1; block<n_blocks; ++block)
+      triplets[0].insert (triplets[0].end (), triplets[block].begin (), triplets[block].end ());
+
+    M.reinit (sector.size (), sector.size (),
+	      (n_blocks > 0) ? triplets[0] : std::vector<typename SparseMatrix<ValueType>::Triplet> ());
+  }
+
+  template <typename ValueType>
+  void
+  FockHamiltonian<ValueType>::assemble (const SectorBasis &sector,
+					Matrix<ValueType> &M) const
+  {
+    assert (sector.n_modes () == __basis.n_modes ());
+    assert (!sector.has_momentum () || (sector.statistics () == __statistics));
+
+    M.reinit (sector.size (), sector.size ());
+
+    /* Every thread writes its own columns. */
+    ThreadPool::instance ().run ((sector.size ()+block_size-1)/block_size,
+				 [&] (const unsigned int block)
+				 {
+				   const unsigned int begin = block*block_size;
+				   const unsigned int end   = std::min (sector.size (), begin+block_size);
+
+				   std::vector<std::pair<unsigned int, ValueType>> column;
+				   for (unsigned int a=begin; a<end; ++a)
+				     {
+				       sector_column (sector, a, column);
+				       for (const std::pair<unsigned int, ValueType> &element : column)
+					 M(element.first, a) += element.second;
+				     }
+				 });
+  }
+
+} // namepsace ewalena
+
+#include "fock_hamiltonian.inst"
@@ -0,0 +1,258 @@
+// -------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE NAMEPSACE EWALENA AUTHORS ``AS
+// IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// NAMESPACE EWALENA AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// The views and conclusions contained in the software and
+// documentation are those of the authors and should not be
+// interpreted as representing official policies, either expressed or
+// implied, of the namespace ewalena authors.
+// -------------------------------------------------------------------
+
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/many_body/sector_basis.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace ewalena
+{
+
+  namespace
+  {
+
+    /* The number of consecutive states handed to a thread at a
+       time. */
+    const unsigned int block_size = 4096;
+
+  } /* namespace */
+
+
+  SectorBasis::SectorBasis (const unsigned int               n_sites,
+			    const std::vector<unsigned int> &n_particles,
+			    const int                        momentum,
+			    const FockBasis::Statistics      statistics)
+    :
+    __n_sites (n_sites),
+    __momentum (momentum),
+    __statistics (statistics),
+    __site_mask ((n_sites < 64) ? (State (1) << n_sites) - 1 : ~State (0)),
+    __size (0)
+  {
+    assert (n_sites > 0);
+    assert (!n_particles.empty ());
+    assert (n_sites*n_particles.size () <= 64);
+    assert (momentum < int (n_sites));
+
+    std::uint64_t size = 1;
+    for (unsigned int sigma=0; sigma<n_particles.size (); ++sigma)
+      {
+	__species.push_back (FockBasis (n_sites, n_particles[sigma]));
+	__strides.push_back (size);
+
+	size *= __species[sigma].size ();
+	assert (size <= std::numeric_limits<unsigned int>::max ());
+      }
+
+    __size = size;
+
+    if (!has_momentum ())
+      return;
+
+    /* Keep the states that are the smallest of their orbit and whose
+       Bloch state with this momentum does not vanish. The blocks are
+       searched in parallel and their representatives appended in
+       order, so that they come out sorted. */
+    const unsigned int n_blocks = (__size+block_size-1)/block_size;
+    std::vector<std::vector<State>>         representatives (n_blocks);
+    std::vector<std::vector<unsigned char>> periods (n_blocks);
+
+    ThreadPool::instance ().run (n_blocks,
+				 [&] (const unsigned int block)
+				 {
+				   const unsigned int begin = block*block_size;
+				   const unsigned int end   = std::min (__size, begin+block_size);
+
+				   for (unsigned int i=begin; i<end; ++i)
+				     {
+				       const State s = product_state (i);
+
+				       State        t      = s;
+				       double       sign   = 1.;
+				       unsigned int period = 0;
+				       bool         smallest = true;
+				       for (unsigned int l=1; l<=__n_sites; ++l)
+					 {
+					   t = translate (t, sign);
+					   if (t < s)
+					     {
+					       smallest = false;
+					       break;
+					     }
+					   if (t == s)
+					     {
+					       period = l;
+					       break;
+					     }
+					 }
+
+				       if (!smallest)
+					 continue;
+
+				       /* e^{-ikR} chi = 1 with k = 2 pi m/L, that is mR/L
+					  is whole for chi = 1 and half-odd for chi = -1. */
+				       const unsigned int twice = (2*__momentum*period) % (2*__n_sites);
+				       if (twice != ((sign > 0) ? 0 : __n_sites))
+					 continue;
+
+				       representatives[block].push_back (s);
+				       periods[block].push_back (period);
+				     }
+				 });
+
+    for (unsigned int block=0; block<n_blocks; ++block)
+      {
+	__representatives.insert (__representatives.end (), representatives[block].begin (), representatives[block].end ());
+	__periods.insert (__periods.end (), periods[block].begin (), periods[block].end ());
+      }
+
+    __size = __representatives.size ();
+  }
+
+  std::vector<SectorBasis>
+  SectorBasis::partition (const unsigned int          n_sites,
+			  const unsigned int          n_species,
+			  const bool                  momentum,
+			  const FockBasis::Statistics statistics)
+  {
+    std::vector<SectorBasis> sectors;
+
+    /* Run through the numbers of particles of all species like the
+       digits of a number in base n_sites+1. */
+    std::vector<unsigned int> n_particles (n_species, 0);
+    for (bool done=false; !done; )
+      {
+	if (momentum)
+	  for (unsigned int m=0; m<n_sites; ++m)
+	    {
+	      SectorBasis sector (n_sites, n_particles, m, statistics);
+	      if (sector.size () > 0)
+		sectors.push_back (std::move (sector));
+	    }
+	else
+	  sectors.push_back (SectorBasis (n_sites, n_particles, -1, statistics));
+
+	done = true;
+	for (unsigned int sigma=0; sigma<n_species; ++sigma)
+	  if (n_particles[sigma] < n_sites)
+	    {
+	      ++n_particles[sigma];
+	      done = false;
+	      break;
+	    }
+	  else
+	    n_particles[sigma] = 0;
+      }
+
+    return sectors;
+  }
+
+  SectorBasis::State
+  SectorBasis::product_state (const unsigned int i) const
+  {
+    State        s    = 0;
+    unsigned int rest = i;
+    for (unsigned int sigma=0; sigma<__species.size (); ++sigma)
+      {
+	const unsigned int n = __species[sigma].size ();
+	s    |= __species[sigma].state (rest % n) << (sigma*__n_sites);
+	rest /= n;
+      }
+
+    return s;
+  }
+
+  unsigned int
+  SectorBasis::index (const State s) const
+  {
+    if (!has_momentum ())
+      {
+	assert (conserves (s));
+	return product_index (s);
+      }
+
+    const std::vector<State>::const_iterator p =
+      std::lower_bound (__representatives.begin (), __representatives.end (), s);
+    assert (p != __representatives.end () && *p == s);
+
+    return p - __representatives.begin ();
+  }
+
+  bool
+  SectorBasis::find (const State   s,
+		     unsigned int &i,
+		     unsigned int &shift,
+		     double       &sign) const
+  {
+    if (!conserves (s))
+      return false;
+
+    shift = 0;
+    sign  = 1.;
+
+    if (!has_momentum ())
+      {
+	i = product_index (s);
+	return true;
+      }
+
+    /* The smallest state of the orbit, and how far and with which
+       sign it is from s. */
+    State  representative = s;
+    State  t              = s;
+    double t_sign         = 1.;
+    for (unsigned int l=1; l<__n_sites; ++l)
+      {
+	t = translate (t, t_sign);
+	if (t == s)
+	  break;
+	if (t < representative)
+	  {
+	    representative = t;
+	    shift          = l;
+	    sign           = t_sign;
+	  }
+      }
+
+    const std::vector<State>::const_iterator p =
+      std::lower_bound (__representatives.begin (), __representatives.end (), representative);
+    if (p == __representatives.end () || *p != representative)
+      return false;
+
+    i = p - __representatives.begin ();
+    return true;
+  }
+
+} // namepsace ewalena
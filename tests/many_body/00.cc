@@ -0,0 +1,257 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/eigensolver_lanczos.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include <ewalena/many_body/fock_basis.h>
+#include <ewalena/many_body/fock_hamiltonian.h>
+#include "../tests.h"
+
+// Fock bases and the matrix-free Hamiltonian on them: ranking of
+// states, the matrix elements against creation and annihilation
+// operators applied one at a time, and ground state energies of
+// free fermions, hard-core bosons and the two-site Hubbard model.
+
+typedef ewalena::FockBasis::State State;
+
+// The states are those with the right number of particles, in
+// increasing order, and the index of a state is its position.
+unsigned int test_basis (const ewalena::FockBasis &basis)
+{
+  unsigned int error = 0;
+
+  const unsigned int n = basis.n_modes ();
+
+  unsigned int i = 0;
+  State        s = basis.state (0);
+  for (State t=0; t<(State (1) << n); ++t)
+    if (!basis.conserves_particle_number () || ewalena::FockBasis::count (t) == basis.n_particles ())
+      {
+	error += !basis.contains (t);
+	error += (basis.state (i) != t);
+	error += (basis.index (t) != i);
+	error += (s != t);
+	s = basis.next (s);
+	++i;
+      }
+    else
+      error += basis.contains (t);
+
+  error += (i != basis.size ());
+
+  return error;
+}
+
+// Apply c_a to the state s with Jordan-Wigner signs from the
+// occupied modes below a; return false if the result vanishes.
+bool annihilate (const unsigned int  a,
+		 State              &s,
+		 double             &sign,
+		 const bool          fermions)
+{
+  if (!(s & (State (1) << a)))
+    return false;
+  if (fermions && (ewalena::FockBasis::count (s & ((State (1) << a) - 1)) & 1))
+    sign = -sign;
+  s ^= State (1) << a;
+  return true;
+}
+
+bool create (const unsigned int  a,
+	     State              &s,
+	     double             &sign,
+	     const bool          fermions)
+{
+  if (s & (State (1) << a))
+    return false;
+  if (fermions && (ewalena::FockBasis::count (s & ((State (1) << a) - 1)) & 1))
+    sign = -sign;
+  s ^= State (1) << a;
+  return true;
+}
+
+// Random hoppings, potentials and interactions, compared with the
+// matrix assembled from the operators one at a time.
+template <typename ValueType>
+unsigned int test_elements (const ewalena::FockBasis &basis,
+			    const bool                fermions)
+{
+  unsigned int error = 0;
+
+  typedef ewalena::FockHamiltonian<ValueType> Hamiltonian;
+
+  const unsigned int n_modes = basis.n_modes ();
+  const unsigned int n       = basis.size ();
+
+  Hamiltonian H (basis, fermions ? ewalena::FockBasis::fermions : ewalena::FockBasis::hardcore_bosons);
+  ewalena::Matrix<ValueType> dense (n, n);
+
+  for (unsigned int term=0; term<2*n_modes; ++term)
+    {
+      const unsigned int a = std::rand () % n_modes;
+      const unsigned int b = (a + 1 + std::rand () % (n_modes-1)) % n_modes;
+      const ValueType    t = uniform<ValueType> ();
+      const double       V = uniform<double> ();
+      const double       e = uniform<double> ();
+
+      H.add_hopping (a, b, t);
+      H.add_interaction (a, b, V);
+      H.add_potential (a, e);
+
+      for (unsigned int j=0; j<n; ++j)
+	{
+	  const State s = basis.state (j);
+
+	  // t c_a^+ c_b + conj(t) c_b^+ c_a.
+	  for (unsigned int h=0; h<2; ++h)
+	    {
+	      State  r    = s;
+	      double sign = 1.;
+	      if (annihilate (h ? a : b, r, sign, fermions) && create (h ? b : a, r, sign, fermions))
+		dense(basis.index (r), j) += ValueType (sign)*(h ? ewalena::math::conjugate (t) : t);
+	    }
+
+	  if ((s >> a) & (s >> b) & 1)
+	    dense(j, j) += ValueType (V);
+	  if ((s >> a) & 1)
+	    dense(j, j) += ValueType (e);
+	}
+    }
+
+  ewalena::Vector<ValueType> x (n), y (n), d;
+  for (unsigned int i=0; i<n; ++i)
+    x(i) = uniform<ValueType> ();
+
+  H.vmult (y, x);
+  H.diagonal (d);
+  error += (H.size () != n || d.size () != n);
+
+  for (unsigned int i=0; i<n; ++i)
+    {
+      ValueType Ax = ValueType (0);
+      for (unsigned int j=0; j<n; ++j)
+	Ax += dense(i, j)*x(j);
+      error += (std::abs (Ax - y(i)) > 1e-12);
+      error += (std::abs (d(i) - dense(i, i)) > 1e-14);
+
+      // Hermitian by construction.
+      for (unsigned int j=0; j<n; ++j)
+	error += (std::abs (dense(i, j) - ewalena::math::conjugate (dense(j, i))) > 1e-14);
+    }
+
+  return error;
+}
+
+// The lowest eigenvalue of H by Lanczos.
+template <typename ValueType>
+double ground_state_energy (const ewalena::FockHamiltonian<ValueType> &H)
+{
+  ewalena::SolverControl control (1000, 1e-10);
+  ewalena::EigensolverLanczos<ValueType> lanczos (control, 1);
+
+  std::vector<double> lambda;
+  std::vector<ewalena::Vector<ValueType> > x (1, ewalena::Vector<ValueType> (H.size ()));
+  lanczos.solve (H, lambda, x);
+  assert (control.last_state () == ewalena::SolverControl::success);
+
+  return lambda[0];
+}
+
+// N particles on an open chain of L sites with hopping -1: the
+// energies of free fermions are -2 cos (pi k/(L+1)), and hard-core
+// bosons on an open chain have the same spectrum.
+template <typename ValueType>
+unsigned int test_chain (const unsigned int L,
+			 const unsigned int N)
+{
+  unsigned int error = 0;
+
+  double exact = 0.;
+  for (unsigned int k=1; k<=N; ++k)
+    exact -= 2.*std::cos (M_PI*k/(L+1));
+
+  const ewalena::FockBasis basis (L, N);
+
+  typedef ewalena::FockHamiltonian<ValueType> Hamiltonian;
+  Hamiltonian fermions (basis), bosons (basis, ewalena::FockBasis::hardcore_bosons);
+  for (unsigned int i=0; i+1<L; ++i)
+    {
+      fermions.add_hopping (i, i+1, ValueType (-1.));
+      bosons.add_hopping (i+1, i, ValueType (-1.));
+    }
+
+  error += (std::abs (ground_state_energy (fermions) - exact) > 1e-8);
+  error += (std::abs (ground_state_energy (bosons) - exact) > 1e-8);
+
+  return error;
+}
+
+// Two sites at half filling, with mode 2i+sigma for site i and spin
+// sigma: the ground state is the singlet at (U - sqrt (U^2+16))/2.
+template <typename ValueType>
+unsigned int test_hubbard (const double U)
+{
+  const ewalena::FockBasis basis (4, 2);
+  ewalena::FockHamiltonian<ValueType> H (basis);
+  for (unsigned int sigma=0; sigma<2; ++sigma)
+    H.add_hopping (sigma, 2+sigma, ValueType (-1.));
+  H.add_interaction (0, 1, U);
+  H.add_interaction (2, 3, U);
+
+  const unsigned int n = basis.size ();
+  ewalena::Matrix<ValueType> dense (n, n);
+  ewalena::Vector<ValueType> x (n), y (n);
+  for (unsigned int j=0; j<n; ++j)
+    {
+      x.reinit (n);
+      x(j) = ValueType (1);
+      H.vmult (y, x);
+      for (unsigned int i=0; i<n; ++i)
+	dense(i, j) = y(i);
+    }
+
+  const double E = ewalena::HermitianEigensolver<ValueType> (dense, false).eigenvalues ()[0];
+  return (std::abs (E - 0.5*(U - std::sqrt (U*U + 16.))) > 1e-12);
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test_basis (ewalena::FockBasis (10));
+  for (unsigned int N=0; N<=10; ++N)
+    error += test_basis (ewalena::FockBasis (10, N));
+
+  // All 64 modes, the highest of them occupied.
+  error += (ewalena::FockBasis::binomial (64, 32) != 1832624140942590534ull);
+  const ewalena::FockBasis wide (64, 2);
+  error += (wide.size () != 2016);
+  for (unsigned int i=0; i<wide.size (); i+=97)
+    error += (wide.index (wide.state (i)) != i);
+  error += (wide.state (wide.size ()-1) != (State (3) << 62));
+
+  for (unsigned int fermions=0; fermions<2; ++fermions)
+    {
+      error += test_elements<double>               (ewalena::FockBasis (8, 3), fermions);
+      error += test_elements<std::complex<double> > (ewalena::FockBasis (8, 4), fermions);
+      error += test_elements<std::complex<double> > (ewalena::FockBasis (6), fermions);
+    }
+
+  error += test_chain<double>               (12, 6);
+  error += test_chain<std::complex<double> > (10, 3);
+
+  error += test_hubbard<double>               (4.);
+  error += test_hubbard<std::complex<double> > (0.);
+
+  assert (error == 0);
+}
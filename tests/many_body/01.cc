@@ -0,0 +1,228 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/block_diagonal_matrix.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include <ewalena/many_body/fock_basis.h>
+#include <ewalena/many_body/fock_hamiltonian.h>
+#include <ewalena/many_body/sector_basis.h>
+#include "../tests.h"
+
+// Symmetry sectors and the block-diagonal Hamiltonian on them: the
+// sectors hold every state once, and the spectra of the blocks
+// together are the spectrum of the Hamiltonian on the whole Fock
+// space, for fermions with and without spin and for hard-core
+// bosons on rings, with and without momentum.
+
+typedef ewalena::FockBasis::State State;
+
+// Without momentum the states of the sectors are all states once,
+// each ranked at its position; with momentum the representatives of
+// the momenta of a number of particles are every orbit once per
+// momentum its Bloch state does not vanish for, which adds up to the
+// number of states.
+unsigned int test_partition (const unsigned int                   n_sites,
+			     const unsigned int                   n_species,
+			     const ewalena::FockBasis::Statistics statistics)
+{
+  unsigned int error = 0;
+
+  const unsigned int n_modes = n_sites*n_species;
+
+  const std::vector<ewalena::SectorBasis> sectors =
+    ewalena::SectorBasis::partition (n_sites, n_species, false, statistics);
+
+  std::vector<unsigned int> seen (State (1) << n_modes, 0);
+  for (const ewalena::SectorBasis &sector : sectors)
+    for (unsigned int i=0; i<sector.size (); ++i)
+      {
+	const State s = sector.state (i);
+	++seen[s];
+	error += (sector.index (s) != i);
+	error += (i > 0 && sector.state (i-1) >= s);
+
+	unsigned int j, shift;
+	double       sign;
+	error += !sector.find (s, j, shift, sign);
+	error += (j != i || shift != 0 || sign != 1.);
+      }
+
+  for (State s=0; s<seen.size (); ++s)
+    error += (seen[s] != 1);
+
+  const std::vector<ewalena::SectorBasis> momenta =
+    ewalena::SectorBasis::partition (n_sites, n_species, true, statistics);
+
+  unsigned int size = 0;
+  for (const ewalena::SectorBasis &sector : momenta)
+    {
+      size += sector.size ();
+      for (unsigned int i=0; i<sector.size (); ++i)
+	{
+	  const State s = sector.state (i);
+	  error += (sector.index (s) != i);
+	  error += (sector.n_sites () % sector.period (i) != 0);
+
+	  // Any state of the orbit is found, and translated back to
+	  // the representative.
+	  double sign = 1.;
+	  State  t    = s;
+	  for (unsigned int l=0; l<n_sites; ++l)
+	    t = sector.translate (t, sign);
+	  error += (t != s || sign != 1.);
+
+	  t = sector.translate (s, sign);
+	  unsigned int j, shift;
+	  double       found_sign;
+	  error += !sector.find (t, j, shift, found_sign);
+	  error += (j != i);
+	}
+    }
+
+  error += (size != (1u << n_modes));
+
+  return error;
+}
+
+// A ring of n_species species of particles hopping between nearest
+// and next-nearest neighbours, with an interaction between all
+// species on the same site and between nearest neighbours.
+template <typename ValueType>
+void ring (ewalena::FockHamiltonian<ValueType> &H,
+	   const unsigned int                   n_sites,
+	   const unsigned int                   n_species)
+{
+  const ValueType t1 = uniform<ValueType> ();
+  const ValueType t2 = uniform<ValueType> ();
+  const double    U  = 4.;
+  const double    V  = uniform<double> ();
+
+  for (unsigned int sigma=0; sigma<n_species; ++sigma)
+    for (unsigned int i=0; i<n_sites; ++i)
+      {
+	const unsigned int a = sigma*n_sites + i;
+	H.add_hopping (sigma*n_sites + (i+1) % n_sites, a, t1);
+	if (n_sites > 4)
+	  H.add_hopping (sigma*n_sites + (i+2) % n_sites, a, t2);
+	H.add_interaction (a, sigma*n_sites + (i+1) % n_sites, V);
+	H.add_potential (a, 0.5*sigma);
+
+	for (unsigned int tau=sigma+1; tau<n_species; ++tau)
+	  H.add_interaction (a, tau*n_sites + i, U);
+      }
+}
+
+// The eigenvalues of the blocks of H in the sectors, sorted, are
+// those of H on the whole Fock space. The blocks are assembled dense
+// and sparse; without momentum the block-diagonal product is that
+// of H with the states permuted.
+template <typename ValueType>
+unsigned int test_spectrum (const unsigned int                   n_sites,
+			    const unsigned int                   n_species,
+			    const bool                           momentum,
+			    const ewalena::FockBasis::Statistics statistics)
+{
+  unsigned int error = 0;
+
+  const ewalena::FockBasis basis (n_sites*n_species);
+  const unsigned int       n = basis.size ();
+
+  ewalena::FockHamiltonian<ValueType> H (basis, statistics);
+  ring (H, n_sites, n_species);
+
+  ewalena::Matrix<ValueType> full (n, n);
+  ewalena::Vector<ValueType> e (n), column (n);
+  for (unsigned int j=0; j<n; ++j)
+    {
+      e(j) = ValueType (1);
+      H.vmult (column, e);
+      e(j) = ValueType (0);
+      for (unsigned int i=0; i<n; ++i)
+	full(i, j) = column(i);
+    }
+
+  const std::vector<double> exact = ewalena::HermitianEigensolver<ValueType> (full, false).eigenvalues ();
+
+  const std::vector<ewalena::SectorBasis> sectors =
+    ewalena::SectorBasis::partition (n_sites, n_species, momentum, statistics);
+
+  ewalena::BlockDiagonalMatrix<ewalena::Matrix<ValueType>>       dense;
+  ewalena::BlockDiagonalMatrix<ewalena::SparseMatrix<ValueType>> sparse;
+  H.assemble (sectors, dense);
+  H.assemble (sectors, sparse);
+  error += (dense.n_blocks () != sectors.size () || dense.n_rows () != n || sparse.n_rows () != n);
+
+  std::vector<std::vector<double>> lambda (dense.n_blocks ());
+  dense.for_each_block ([&] (const unsigned int b, const ewalena::Matrix<ValueType> &block)
+			{
+			  lambda[b] = ewalena::HermitianEigensolver<ValueType> (block, false).eigenvalues ();
+			});
+
+  std::vector<double> blocks;
+  for (unsigned int b=0; b<lambda.size (); ++b)
+    blocks.insert (blocks.end (), lambda[b].begin (), lambda[b].end ());
+  std::sort (blocks.begin (), blocks.end ());
+
+  for (unsigned int i=0; i<n; ++i)
+    error += (std::abs (blocks[i] - exact[i]) > 1e-10);
+
+  ewalena::Vector<ValueType> x (n), y (n), z (n);
+  for (unsigned int i=0; i<n; ++i)
+    x(i) = uniform<ValueType> ();
+
+  dense.vmult (y, x);
+  sparse.vmult (z, x);
+  for (unsigned int i=0; i<n; ++i)
+    error += (std::abs (y(i) - z(i)) > 1e-12);
+
+  if (!momentum)
+    {
+      ewalena::Vector<ValueType> x_full (n), y_full (n);
+      for (unsigned int b=0; b<sectors.size (); ++b)
+	for (unsigned int i=0; i<sectors[b].size (); ++i)
+	  x_full(sectors[b].state (i)) = x(dense.block_start (b)+i);
+
+      H.vmult (y_full, x_full);
+
+      for (unsigned int b=0; b<sectors.size (); ++b)
+	for (unsigned int i=0; i<sectors[b].size (); ++i)
+	  error += (std::abs (y_full(sectors[b].state (i)) - y(dense.block_start (b)+i)) > 1e-12);
+    }
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test_partition (8, 1, ewalena::FockBasis::fermions);
+  error += test_partition (7, 1, ewalena::FockBasis::hardcore_bosons);
+  error += test_partition (4, 2, ewalena::FockBasis::fermions);
+  error += test_partition (3, 3, ewalena::FockBasis::fermions);
+
+  // Spinful fermions (the Hubbard model), N and S_z.
+  error += test_spectrum<double>               (4, 2, false, ewalena::FockBasis::fermions);
+  error += test_spectrum<std::complex<double>> (4, 2, true,  ewalena::FockBasis::fermions);
+
+  // Spinless fermions with an even and an odd number of sites.
+  error += test_spectrum<std::complex<double>> (8, 1, true,  ewalena::FockBasis::fermions);
+  error += test_spectrum<std::complex<double>> (7, 1, true,  ewalena::FockBasis::fermions);
+
+  // Hard-core bosons, the XXZ ring.
+  error += test_spectrum<double>               (8, 1, false, ewalena::FockBasis::hardcore_bosons);
+  error += test_spectrum<std::complex<double>> (6, 1, true,  ewalena::FockBasis::hardcore_bosons);
+
+  assert (error == 0);
+}
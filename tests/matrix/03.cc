@@ -0,0 +1,112 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+
+#include <cstdlib>
+#include <ewalena/base/vector.h>
+#include <ewalena/base/matrix.h>
+
+// Blocked products against a textbook triple loop.
+
+template <typename ValueType>
+ValueType random_value ()
+{
+  return ValueType (std::rand ()/double (RAND_MAX) - 0.5);
+}
+
+template <>
+std::complex<double> random_value<std::complex<double> > ()
+{
+  return std::complex<double> (std::rand ()/double (RAND_MAX) - 0.5,
+			       std::rand ()/double (RAND_MAX) - 0.5);
+}
+
+template <typename ValueType>
+void fill (ewalena::Matrix<ValueType> &matrix)
+{
+  for (unsigned int i=0; i<matrix.n_rows (); ++i)
+    for (unsigned int j=0; j<matrix.n_cols (); ++j)
+      matrix(i, j) = random_value<ValueType> ();
+}
+
+template <typename ValueType>
+double difference (const ewalena::Matrix<ValueType> &left,
+		   const ewalena::Matrix<ValueType> &right)
+{
+  double max = 0.;
+  for (unsigned int i=0; i<left.n_rows (); ++i)
+    for (unsigned int j=0; j<left.n_cols (); ++j)
+      max = std::max (max, std::abs (left(i, j) - right(i, j)));
+  return max;
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int m,
+		   const unsigned int n,
+		   const unsigned int k)
+{
+  ewalena::Matrix<ValueType> A (m, k), B (k, n), At (k, m), Bt (n, k);
+  fill (A);
+  fill (B);
+
+  for (unsigned int i=0; i<m; ++i)
+    for (unsigned int p=0; p<k; ++p)
+      At(p, i) = A(i, p);
+
+  for (unsigned int p=0; p<k; ++p)
+    for (unsigned int j=0; j<n; ++j)
+      Bt(j, p) = B(p, j);
+
+  // The reference, starting from a non-zero matrix since all three
+  // products accumulate.
+  ewalena::Matrix<ValueType> C0 (m, n);
+  fill (C0);
+
+  ewalena::Matrix<ValueType> reference (C0);
+  for (unsigned int i=0; i<m; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      for (unsigned int p=0; p<k; ++p)
+	reference(i, j) += A(i, p)*B(p, j);
+
+  ewalena::Matrix<ValueType> C (C0);
+  C.mult (A, B);
+  std::cout << " mult  " << m << "x" << n << "x" << k 
+	    << ": " << difference (C, reference) << std::endl;
+  assert (difference (C, reference) < 1e-12*k);
+
+  C = C0;
+  C.Tmult (At, B);
+  std::cout << " Tmult " << m << "x" << n << "x" << k 
+	    << ": " << difference (C, reference) << std::endl;
+  assert (difference (C, reference) < 1e-12*k);
+
+  C = C0;
+  C.multT (A, Bt);
+  std::cout << " multT " << m << "x" << n << "x" << k 
+	    << ": " << difference (C, reference) << std::endl;
+  assert (difference (C, reference) < 1e-12*k);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  // Sizes both smaller and larger than the register tile and the
+  // cache blocks, and not multiples of either.
+  error += test<double> (1, 1, 1);
+  error += test<double> (7, 13, 5);
+  error += test<double> (150, 70, 300);
+  error += test<double> (33, 4111, 3);
+
+  error += test<std::complex<double> > (3, 5, 2);
+  error += test<std::complex<double> > (131, 67, 150);
+  
+  assert (error == 0);
+
+  return 0;
+}
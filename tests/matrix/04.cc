@@ -0,0 +1,99 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/base/matrix.h>
+
+// Parallel products: results must not depend on the number of
+// threads, and the time taken for 1..N threads is reported.
+
+template <typename ValueType>
+void fill (ewalena::Matrix<ValueType> &matrix)
+{
+  for (unsigned int i=0; i<matrix.n_rows (); ++i)
+    for (unsigned int j=0; j<matrix.n_cols (); ++j)
+      matrix(i, j) = ValueType (std::rand ()/double (RAND_MAX) - 0.5);
+}
+
+unsigned int test (const unsigned int m,
+		   const unsigned int n,
+		   const unsigned int k)
+{
+  ewalena::ThreadPool &pool = ewalena::ThreadPool::instance ();
+  const unsigned int n_threads_max = 
+    std::max (4u, std::thread::hardware_concurrency ());
+
+  ewalena::Matrix<double> A (m, k), B (k, n), Bt (n, k);
+  fill (A);
+  fill (B);
+  for (unsigned int p=0; p<k; ++p)
+    for (unsigned int j=0; j<n; ++j)
+      Bt(j, p) = B(p, j);
+
+  // Serial reference.
+  pool.set_n_threads (1);
+  ewalena::Matrix<double> reference (m, n);
+  reference.mult (A, B);
+
+  double serial_time = 0.;
+
+  std::cout << " " << m << "x" << n << "x" << k 
+	    << " threads  time [s]  GFLOP/s  speedup" << std::endl;
+
+  for (unsigned int n_threads=1; n_threads<=n_threads_max; ++n_threads)
+    {
+      pool.set_n_threads (n_threads);
+
+      ewalena::Matrix<double> C (m, n);
+
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      C.mult (A, B);
+      const double time = 
+	std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+      if (n_threads == 1)
+	serial_time = time;
+
+      std::cout << "   " << n_threads 
+		<< "  " << time 
+		<< "  " << 2.*m*n*k/time*1e-9 
+		<< "  " << serial_time/time << std::endl;
+
+      // Every tile is computed by the same serial engine, so the
+      // result is bit for bit that of the serial product.
+      assert (C == reference);
+
+      // Same for the transposed variant.
+      ewalena::Matrix<double> D (m, n);
+      D.multT (A, Bt);
+      assert (D == reference);
+    }
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  // Force the parallel path for small products too.
+  const std::size_t threshold = ewalena::blas::gemm_threshold ();
+  ewalena::blas::set_gemm_threshold (0);
+  error += test (5, 3, 7);
+  error += test (97, 211, 64);
+
+  ewalena::blas::set_gemm_threshold (threshold);
+  error += test (256, 256, 256);
+
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <utility>
+#include <ewalena/base/matrix.h>
+
+
+// Move semantics and reuse of memory.
+
+unsigned int test ()
+{
+  // An empty matrix owns nothing but is still symmetric.
+  ewalena::Matrix<double> empty;
+  assert (empty.n_elements () == 0);
+  assert (empty.is_symmetric ());
+
+  ewalena::Matrix<double> matrix (4, 6);
+  for (unsigned int i=0; i<4; ++i)
+    for (unsigned int j=0; j<6; ++j)
+      matrix(i,j) = double (i*j);
+  const double *address = &matrix(0,0);
+
+  // Moving hands the memory over and leaves the source empty.
+  ewalena::Matrix<double> moved (std::move (matrix));
+  assert (matrix.n_elements () == 0);
+  assert (&moved(0,0) == address);
+
+  matrix = std::move (moved);
+  assert (moved.n_elements () == 0);
+  assert (&matrix(0,0) == address);
+  assert (matrix(3,5) == 15.);
+
+  // Reshaping into no more elements does not reallocate.
+  matrix.reinit (6, 4);
+  assert (&matrix(0,0) == address);
+  matrix.reinit (2, 2);
+  assert (&matrix(0,0) == address);
+  assert (matrix(1,1) == 0.);
+
+  // Copies resize the target if needed, and chain.
+  ewalena::Matrix<double> identity (3, 3);
+  identity.identity ();
+
+  ewalena::Matrix<double> a, b;
+  a = b = identity;
+  assert (a == identity);
+  assert (b == identity);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test ();
+  assert (error == 0);
+
+  return 0;
+}
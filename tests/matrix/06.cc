@@ -0,0 +1,139 @@
+ 
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/lu_factorization.h>
+
+// LU factorization: solves with one and many right-hand sides,
+// determinants and inverses, on both sides of the panel width.
+
+template <typename ValueType>
+void fill (ewalena::Matrix<ValueType> &matrix)
+{
+  for (unsigned int i=0; i<matrix.n_rows (); ++i)
+    for (unsigned int j=0; j<matrix.n_cols (); ++j)
+      matrix(i, j) = ValueType (std::rand ()/double (RAND_MAX) - 0.5);
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int n)
+{
+  const double tolerance = 1e-10*n;
+
+  ewalena::Matrix<ValueType> A (n, n);
+  fill (A);
+
+  // Factorize once ...
+  const ewalena::LUFactorization<ValueType> lu (A);
+  assert (!lu.is_singular ());
+  assert (lu.size () == n);
+
+  // ... and solve many times.
+  for (unsigned int repeat=0; repeat<3; ++repeat)
+    {
+      ewalena::Vector<ValueType> b (n), x (n);
+      for (unsigned int i=0; i<n; ++i)
+	b(i) = ValueType (std::rand ()/double (RAND_MAX) - 0.5);
+
+      x = b;
+      lu.solve (x);
+
+      for (unsigned int i=0; i<n; ++i)
+	{
+	  ValueType sum = ValueType (0);
+	  for (unsigned int j=0; j<n; ++j)
+	    sum += A(i,j)*x(j);
+	  assert (std::abs (sum - b(i)) < tolerance);
+	}
+    }
+
+  // Many right-hand sides at once agree with one at a time.
+  {
+    ewalena::Matrix<ValueType> B (n, 5);
+    fill (B);
+
+    ewalena::Matrix<ValueType> X (B);
+    lu.solve (X);
+
+    for (unsigned int k=0; k<5; ++k)
+      {
+	ewalena::Vector<ValueType> x (n);
+	for (unsigned int i=0; i<n; ++i)
+	  x(i) = B(i,k);
+	lu.solve (x);
+
+	for (unsigned int i=0; i<n; ++i)
+	  assert (std::abs (X(i,k) - x(i)) < tolerance);
+      }
+  }
+
+  // The inverse, through the factorization and through Matrix.
+  {
+    ewalena::Matrix<ValueType> A_inverse, I (n, n);
+    A_inverse.invert (A);
+    I.mult (A, A_inverse);
+
+    for (unsigned int i=0; i<n; ++i)
+      for (unsigned int j=0; j<n; ++j)
+	assert (std::abs (I(i,j) - ValueType (i==j ? 1 : 0)) < tolerance);
+  }
+
+  return 0;
+}
+
+// The determinant of a permuted triangular matrix is known exactly.
+unsigned int test_determinant (const unsigned int n)
+{
+  ewalena::Matrix<double> A (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=i; j<n; ++j)
+      A(i,j) = (i==j) ? 1. + (i%3) : 0.25;
+
+  // Reverse the order of the rows: floor(n/2) exchanges.
+  ewalena::Matrix<double> P (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      P(n-1-i,j) = A(i,j);
+
+  double determinant = ((n/2)%2 == 0) ? 1. : -1.;
+  for (unsigned int i=0; i<n; ++i)
+    determinant *= 1. + (i%3);
+
+  const ewalena::LUFactorization<double> lu (P);
+  assert (std::fabs (lu.determinant () - determinant) < 1e-12*std::fabs (determinant));
+
+  // A singular matrix is flagged, and has a zero determinant.
+  for (unsigned int j=0; j<n; ++j)
+    P(n/2,j) = 0.;
+  const ewalena::LUFactorization<double> singular (P);
+  assert (singular.is_singular ());
+  assert (singular.determinant () == 0.);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  const unsigned int sizes[] = { 1, 2, 3, 4, 7, 64, 65, 150 };
+  for (unsigned int n : sizes)
+    {
+      error += test<double> (n);
+      error += test<std::complex<double> > (n);
+      error += test_determinant (n);
+    }
+
+  assert (error == 0);
+
+  return 0;
+}
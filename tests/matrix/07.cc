@@ -0,0 +1,203 @@
+ 
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/cholesky_factorization.h>
+#include <ewalena/lac/lu_factorization.h>
+#include <ewalena/lac/triangular.h>
+
+// Cholesky factorization of Hermitian positive definite matrices, and
+// triangular solves in every mode with one and many right-hand sides.
+
+double uniform ()
+{
+  return std::rand ()/double (RAND_MAX) - 0.5;
+}
+
+template <typename ValueType>
+ValueType conjugate (const ValueType &a)
+{
+  return a;
+}
+
+template <>
+std::complex<double> conjugate (const std::complex<double> &a)
+{
+  return std::conj (a);
+}
+
+// op(A)_{ij} for a row-major n x n array.
+template <typename ValueType>
+ValueType op (const ewalena::blas::Operation  operation,
+	      const ValueType                *A,
+	      const unsigned int              n,
+	      const unsigned int              i,
+	      const unsigned int              j)
+{
+  if (operation == ewalena::blas::no_transpose)
+    return A[i*n+j];
+  if (operation == ewalena::blas::transpose)
+    return A[j*n+i];
+  return conjugate (A[j*n+i]);
+}
+
+template <typename ValueType>
+unsigned int test_triangular (const unsigned int n)
+{
+  const ewalena::blas::Operation operations[] = 
+    { ewalena::blas::no_transpose, ewalena::blas::transpose, ewalena::blas::conjugate_transpose };
+  const unsigned int n_rhs = 3;
+
+  // A full array: the solves must only read the triangle asked for.
+  std::vector<ValueType> A (n*n), X (n*n_rhs), B (n*n_rhs);
+  for (unsigned int i=0; i<n*n; ++i)
+    A[i] = ValueType (uniform ());
+  for (unsigned int i=0; i<n; ++i)
+    A[i*n+i] += ValueType (4.);
+
+  for (unsigned int t=0; t<2; ++t)
+    for (unsigned int o=0; o<3; ++o)
+      for (unsigned int d=0; d<2; ++d)
+	{
+	  const ewalena::blas::Triangle  uplo = t ? ewalena::blas::upper : ewalena::blas::lower;
+	  const ewalena::blas::Diagonal  diag = d ? ewalena::blas::unit_diagonal : ewalena::blas::non_unit_diagonal;
+	  const ewalena::blas::Operation operation = operations[o];
+
+	  // B = op(T) X for the triangle T of A.
+	  for (unsigned int i=0; i<n*n_rhs; ++i)
+	    X[i] = ValueType (uniform ());
+
+	  for (unsigned int i=0; i<n; ++i)
+	    for (unsigned int k=0; k<n_rhs; ++k)
+	      {
+		ValueType sum = ValueType (0);
+		for (unsigned int j=0; j<n; ++j)
+		  {
+		    const unsigned int row = (operation == ewalena::blas::no_transpose) ? i : j;
+		    const unsigned int col = (operation == ewalena::blas::no_transpose) ? j : i;
+		    if ((uplo == ewalena::blas::lower) ? (col > row) : (col < row))
+		      continue;
+		    const ValueType a = ((i == j) && d) ? ValueType (1) : op (operation, &A[0], n, i, j);
+		    sum += a*X[j*n_rhs+k];
+		  }
+		B[i*n_rhs+k] = sum;
+	      }
+
+	  std::vector<ValueType> Y (B);
+	  ewalena::blas::trsm (uplo, operation, diag, n, n_rhs, ValueType (2.), &A[0], n, &Y[0], n_rhs);
+	  for (unsigned int i=0; i<n*n_rhs; ++i)
+	    assert (std::abs (Y[i] - ValueType (2.)*X[i]) < 1e-10);
+
+	  // The first column alone.
+	  std::vector<ValueType> y (n);
+	  for (unsigned int i=0; i<n; ++i)
+	    y[i] = B[i*n_rhs];
+	  ewalena::blas::trsv (uplo, operation, diag, n, &A[0], n, &y[0]);
+	  for (unsigned int i=0; i<n; ++i)
+	    assert (std::abs (y[i] - X[i*n_rhs]) < 1e-10);
+	}
+
+  return 0;
+}
+
+template <typename ValueType>
+unsigned int test_cholesky (const unsigned int n)
+{
+  const double tolerance = 1e-10*n;
+
+  // A = C^H C + I is Hermitian positive definite.
+  ewalena::Matrix<ValueType> C (n, n), A (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      C(i,j) = ValueType (uniform ());
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	ValueType sum = ValueType (i==j ? 1 : 0);
+	for (unsigned int k=0; k<n; ++k)
+	  sum += conjugate (C(k,i))*C(k,j);
+	A(i,j) = sum;
+      }
+
+  const ewalena::CholeskyFactorization<ValueType> cholesky (A);
+  assert (cholesky.is_positive_definite ());
+
+  // L L^H reproduces A.
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=i; j<n; ++j)
+      {
+	ValueType sum = ValueType (0);
+	for (unsigned int k=0; k<=i; ++k)
+	  sum += conjugate (cholesky.factors ()(k,i))*cholesky.factors ()(k,j);
+	assert (std::abs (sum - A(i,j)) < tolerance);
+      }
+
+  // Solves with one and many right-hand sides.
+  ewalena::Vector<ValueType> b (n), x (n);
+  for (unsigned int i=0; i<n; ++i)
+    b(i) = ValueType (uniform ());
+  x = b;
+  cholesky.solve (x);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      ValueType sum = ValueType (0);
+      for (unsigned int j=0; j<n; ++j)
+	sum += A(i,j)*x(j);
+      assert (std::abs (sum - b(i)) < tolerance);
+    }
+
+  ewalena::Matrix<ValueType> A_inverse, I (n, n);
+  cholesky.invert (A_inverse);
+  I.mult (A, A_inverse);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      assert (std::abs (I(i,j) - ValueType (i==j ? 1 : 0)) < tolerance);
+
+  // The two halves of the solve, one after the other.
+  x = b;
+  cholesky.forward_substitution (x);
+  cholesky.backward_substitution (x);
+  ewalena::Vector<ValueType> y (b);
+  cholesky.solve (y);
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (x(i) - y(i)) < tolerance);
+
+  // The determinant agrees with that of the LU factorization.
+  const ewalena::LUFactorization<ValueType> lu (A);
+  assert (std::abs (ValueType (cholesky.determinant ()) - lu.determinant ()) 
+	  < 1e-10*std::abs (lu.determinant ()));
+
+  // An indefinite matrix is rejected.
+  A(n-1,n-1) = ValueType (-1.);
+  const ewalena::CholeskyFactorization<ValueType> indefinite (A);
+  assert (!indefinite.is_positive_definite ());
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  const unsigned int sizes[] = { 1, 2, 5, 64, 65, 150 };
+  for (unsigned int n : sizes)
+    {
+      error += test_triangular<double> (n);
+      error += test_triangular<std::complex<double> > (n);
+      error += test_cholesky<double> (n);
+      error += test_cholesky<std::complex<double> > (n);
+    }
+
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+ 
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/base/matrix.h>
+#include "../tests.h"
+
+// Matrix-vector products in all three forms, compared against
+// explicit loops; results must not depend on the number of threads,
+// and the time taken for 1..N threads is reported.
+
+template <typename ValueType>
+ValueType conjugate (const ValueType &a)
+{
+  return a;
+}
+
+template <>
+std::complex<double> conjugate (const std::complex<double> &a)
+{
+  return std::conj (a);
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int m,
+		   const unsigned int n)
+{
+  ewalena::ThreadPool &pool = ewalena::ThreadPool::instance ();
+  const unsigned int n_threads_max = 
+    std::max (4u, std::thread::hardware_concurrency ());
+
+  ewalena::Matrix<ValueType> A (m, n);
+  for (unsigned int i=0; i<m; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      A(i,j) = uniform<ValueType> ();
+
+  ewalena::Vector<ValueType> x (n), xt (m), y0 (m), yt0 (n);
+  for (unsigned int j=0; j<n; ++j) x(j)  = uniform<ValueType> ();
+  for (unsigned int i=0; i<m; ++i) xt(i) = uniform<ValueType> ();
+  for (unsigned int i=0; i<m; ++i) y0(i) = uniform<ValueType> ();
+  for (unsigned int j=0; j<n; ++j) yt0(j) = uniform<ValueType> ();
+
+  const ValueType alpha = uniform<ValueType> (), beta = uniform<ValueType> ();
+  const double tolerance = 1e-12*(m+n);
+
+  // Serial reference results.
+  pool.set_n_threads (1);
+
+  ewalena::Vector<ValueType> y (y0), yt (yt0), yh (yt0);
+  A.vmult  (y,  x,  alpha, beta);
+  A.Tvmult (yt, xt, alpha, beta);
+  A.Hvmult (yh, xt, alpha, beta);
+
+  for (unsigned int i=0; i<m; ++i)
+    {
+      ValueType sum = ValueType (0);
+      for (unsigned int j=0; j<n; ++j)
+	sum += A(i,j)*x(j);
+      assert (std::abs (y(i) - (alpha*sum + beta*y0(i))) < tolerance);
+    }
+
+  for (unsigned int j=0; j<n; ++j)
+    {
+      ValueType sum = ValueType (0), sum_h = ValueType (0);
+      for (unsigned int i=0; i<m; ++i)
+	{
+	  sum   += A(i,j)*xt(i);
+	  sum_h += conjugate (A(i,j))*xt(i);
+	}
+      assert (std::abs (yt(j) - (alpha*sum   + beta*yt0(j))) < tolerance);
+      assert (std::abs (yh(j) - (alpha*sum_h + beta*yt0(j))) < tolerance);
+    }
+
+  // The default overwrites y.
+  ewalena::Vector<ValueType> z (m);
+  A.vmult (z, x);
+  for (unsigned int i=0; i<m; ++i)
+    {
+      ValueType sum = ValueType (0);
+      for (unsigned int j=0; j<n; ++j)
+	sum += A(i,j)*x(j);
+      assert (std::abs (z(i) - sum) < tolerance);
+    }
+
+  std::cout << " " << m << "x" << n 
+	    << " threads  time [s]  GB/s" << std::endl;
+
+  for (unsigned int n_threads=1; n_threads<=n_threads_max; ++n_threads)
+    {
+      pool.set_n_threads (n_threads);
+
+      ewalena::Vector<ValueType> w (y0), wt (yt0), wh (yt0);
+
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      A.vmult (w, x, alpha, beta);
+      const double time = 
+	std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+      std::cout << "   " << n_threads 
+		<< "  " << time 
+		<< "  " << sizeof (ValueType)*m*n/time*1e-9 << std::endl;
+
+      A.Tvmult (wt, xt, alpha, beta);
+      A.Hvmult (wh, xt, alpha, beta);
+
+      // Each element is computed by one thread, in the same order.
+      assert (w  == y);
+      assert (wt == yt);
+      assert (wh == yh);
+    }
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test<double> (1, 1);
+  error += test<double> (7, 3);
+  error += test<double> (1000, 1001);
+  error += test<std::complex<double> > (5, 9);
+  error += test<std::complex<double> > (701, 600);
+
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include "../tests.h"
+
+// All eigenpairs of dense Hermitian matrices: random ones of sizes
+// around the block and leaf sizes, and ones whose eigenvalues are
+// repeated or tightly clustered, which the divide and conquer method
+// deflates.
+
+// Check A Q = Q Lambda, Q^H Q = I and the order of the eigenvalues,
+// relative to the size and the norm of the matrix, and that the
+// eigenvalues alone are the same.
+template <typename ValueType>
+unsigned int check (const ewalena::Matrix<ValueType> &A)
+{
+  unsigned int error = 0;
+
+  const unsigned int n = A.n_rows ();
+
+  const ewalena::HermitianEigensolver<ValueType> eigensystem (A);
+  const std::vector<double>        &lambda = eigensystem.eigenvalues ();
+  const ewalena::Matrix<ValueType> &Q      = eigensystem.eigenvectors ();
+
+  error += (eigensystem.size () != n);
+  error += (Q.n_rows () != n || Q.n_cols () != n);
+
+  double norm = 0.;
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      norm = std::max (norm, std::abs (A(i, j)));
+
+  const double tolerance = 100.*(n+1)*std::numeric_limits<double>::epsilon ();
+
+  for (unsigned int j=1; j<n; ++j)
+    error += (lambda[j] < lambda[j-1]);
+
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	ValueType AQ = ValueType (0), QQ = ValueType (0);
+	for (unsigned int k=0; k<n; ++k)
+	  {
+	    AQ += A(i, k)*Q(k, j);
+	    QQ += ewalena::math::conjugate (Q(k, i))*Q(k, j);
+	  }
+	error += (std::abs (AQ - Q(i, j)*lambda[j]) > tolerance*std::max (norm, 1.));
+	error += (std::abs (QQ - ValueType (i == j)) > tolerance);
+      }
+
+  const ewalena::HermitianEigensolver<ValueType> values (A, false);
+  error += (values.eigenvectors ().n_rows () != 0);
+  for (unsigned int j=0; j<n; ++j)
+    error += (std::abs (values.eigenvalues ()[j] - lambda[j]) > tolerance*std::max (norm, 1.));
+
+  return error;
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int n)
+{
+  unsigned int error = 0;
+
+  // Random.
+  ewalena::Matrix<ValueType> A (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      A(i, i) = ValueType (std::real (uniform<ValueType> ()));
+      for (unsigned int j=i+1; j<n; ++j)
+	{
+	  A(i, j) = uniform<ValueType> ();
+	  A(j, i) = ewalena::math::conjugate (A(i, j));
+	}
+    }
+  error += check (A);
+
+  // Only the upper triangle is read.
+  const std::vector<double> lambda = ewalena::HermitianEigensolver<ValueType> (A).eigenvalues ();
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<i; ++j)
+      A(i, j) = ValueType (1e3);
+  error += (ewalena::HermitianEigensolver<ValueType> (A).eigenvalues () != lambda);
+
+  // The identity, and a diagonal matrix with repeated elements.
+  ewalena::Matrix<ValueType> D (n, n);
+  D.identity ();
+  error += check (D);
+
+  for (unsigned int i=0; i<n; ++i)
+    D(i, i) = ValueType (double (i%3));
+  error += check (D);
+
+  // A unitary transformation of eigenvalues in three tight
+  // clusters: U = I - 2 v v^H / v^H v.
+  ewalena::Vector<ValueType> v (n);
+  for (unsigned int i=0; i<n; ++i)
+    v(i) = uniform<ValueType> ();
+  const double vv = std::abs (v.dot (v));
+
+  ewalena::Matrix<ValueType> C (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	ValueType c = ValueType (0);
+	for (unsigned int k=0; k<n; ++k)
+	  {
+	    const ValueType u_ik = ValueType (i == k) - ValueType (2./vv)*v(i)*ewalena::math::conjugate (v(k));
+	    const ValueType u_jk = ValueType (j == k) - ValueType (2./vv)*v(j)*ewalena::math::conjugate (v(k));
+	    c += u_ik*ValueType (double (k%3) + 1e-12*k)*ewalena::math::conjugate (u_jk);
+	  }
+	C(i, j) = c;
+      }
+  error += check (C);
+
+  // The Wilkinson matrix, whose largest eigenvalues come in pairs
+  // that agree to many digits.
+  ewalena::Matrix<ValueType> W (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      W(i, i) = ValueType (std::abs (double (i) - 0.5*(n-1)));
+      if (i+1 < n)
+	{
+	  W(i, i+1) = ValueType (1);
+	  W(i+1, i) = ValueType (1);
+	}
+    }
+  error += check (W);
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  const unsigned int sizes[] = {0, 1, 2, 3, 25, 26, 33, 64, 101};
+
+  for (unsigned int s=0; s<9; ++s)
+    {
+      error += test<double>               (sizes[s]);
+      error += test<std::complex<double> > (sizes[s]);
+    }
+
+  assert (error == 0);
+}
@@ -0,0 +1,231 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <limits>
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/qr_factorization.h>
+#include <ewalena/lac/tsqr_factorization.h>
+#include "../tests.h"
+
+// Householder QR factorizations of tall, square and wide matrices
+// of sizes around the block size, and tall-skinny ones of several
+// blocks: A = QR, Q^H Q = I, Q and Q^H undo each other and
+// least-squares solutions satisfy the normal equations.
+
+template <typename ValueType>
+ewalena::Matrix<ValueType> random_matrix (const unsigned int m,
+					  const unsigned int n)
+{
+  ewalena::Matrix<ValueType> A (m, n);
+  for (unsigned int i=0; i<m; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      A(i, j) = uniform<ValueType> ();
+  return A;
+}
+
+// Check the factors and the application of Q of the factorization F
+// of A.
+template <typename ValueType, typename Factorization>
+unsigned int check_factors (const ewalena::Matrix<ValueType> &A,
+			    const Factorization              &F)
+{
+  unsigned int error = 0;
+
+  const unsigned int m = A.n_rows ();
+  const unsigned int n = A.n_cols ();
+  const unsigned int k = std::min (m, n);
+
+  const double tolerance = 100.*(m+n+1)*std::numeric_limits<double>::epsilon ();
+
+  ewalena::Matrix<ValueType> Q, R;
+  F.form_Q (Q);
+  F.form_R (R);
+
+  error += (Q.n_rows () != m || Q.n_cols () != k);
+  error += (R.n_rows () != k || R.n_cols () != n);
+
+  for (unsigned int i=0; i<k; ++i)
+    {
+      error += (std::abs (std::imag (R(i, i))) > tolerance);
+      for (unsigned int j=0; j<i; ++j)
+	error += (R(i, j) != ValueType (0));
+    }
+
+  for (unsigned int i=0; i<m; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	ValueType QR = ValueType (0);
+	for (unsigned int l=0; l<k; ++l)
+	  QR += Q(i, l)*R(l, j);
+	error += (std::abs (QR - A(i, j)) > tolerance);
+      }
+
+  for (unsigned int i=0; i<k; ++i)
+    for (unsigned int j=0; j<k; ++j)
+      {
+	ValueType QQ = ValueType (0);
+	for (unsigned int l=0; l<m; ++l)
+	  QQ += ewalena::math::conjugate (Q(l, i))*Q(l, j);
+	error += (std::abs (QQ - ValueType (i == j)) > tolerance);
+      }
+
+  // Q^H then Q is the identity, and a vector is treated as a matrix
+  // of one column.
+  const ewalena::Matrix<ValueType> B = random_matrix<ValueType> (m, 3);
+  ewalena::Matrix<ValueType> C (B);
+  F.apply_QH (C);
+
+  ewalena::Vector<ValueType> c (m);
+  for (unsigned int i=0; i<m; ++i)
+    c(i) = B(i, 1);
+  F.apply_QH (c);
+  for (unsigned int i=0; i<m; ++i)
+    error += (std::abs (c(i) - C(i, 1)) > tolerance);
+
+  F.apply_Q (C);
+  F.apply_Q (c);
+  for (unsigned int i=0; i<m; ++i)
+    {
+      error += (std::abs (c(i) - B(i, 1)) > tolerance);
+      for (unsigned int j=0; j<3; ++j)
+	error += (std::abs (C(i, j) - B(i, j)) > tolerance);
+    }
+
+  return error;
+}
+
+// Check that x and the columns of X solve the least-squares problem,
+// ie. that A^H (Ax - b) = 0.
+template <typename ValueType, typename Factorization>
+unsigned int check_solve (const ewalena::Matrix<ValueType> &A,
+			  const Factorization              &F)
+{
+  unsigned int error = 0;
+
+  const unsigned int m = A.n_rows ();
+  const unsigned int n = A.n_cols ();
+
+  const double tolerance = 1000.*(m+1)*std::numeric_limits<double>::epsilon ();
+
+  const ewalena::Matrix<ValueType> B = random_matrix<ValueType> (m, 2);
+  ewalena::Matrix<ValueType> X;
+  F.solve (X, B);
+  error += (X.n_rows () != n || X.n_cols () != 2);
+
+  ewalena::Vector<ValueType> b (m), x;
+  for (unsigned int i=0; i<m; ++i)
+    b(i) = B(i, 0);
+  F.solve (x, b);
+  error += (x.size () != n);
+
+  for (unsigned int j=0; j<n; ++j)
+    error += (std::abs (x(j) - X(j, 0)) > tolerance);
+
+  for (unsigned int p=0; p<2; ++p)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	ValueType normal = ValueType (0);
+	for (unsigned int i=0; i<m; ++i)
+	  {
+	    ValueType r = -B(i, p);
+	    for (unsigned int l=0; l<n; ++l)
+	      r += A(i, l)*X(l, p);
+	    normal += ewalena::math::conjugate (A(i, j))*r;
+	  }
+	error += (std::abs (normal) > tolerance);
+      }
+
+  return error;
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int m,
+		   const unsigned int n)
+{
+  unsigned int error = 0;
+
+  const ewalena::Matrix<ValueType> A = random_matrix<ValueType> (m, n);
+  const ewalena::QRFactorization<ValueType> F (A);
+
+  error += (F.n_rows () != m || F.n_cols () != n);
+  error += check_factors (A, F);
+
+  if (m >= n)
+    error += check_solve (A, F);
+
+  // A square system is solved exactly.
+  if (m == n && n != 0)
+    {
+      ewalena::Vector<ValueType> b (n), x;
+      for (unsigned int i=0; i<n; ++i)
+	b(i) = uniform<ValueType> ();
+      F.solve (x, b);
+
+      for (unsigned int i=0; i<n; ++i)
+	{
+	  ValueType Ax = ValueType (0);
+	  for (unsigned int j=0; j<n; ++j)
+	    Ax += A(i, j)*x(j);
+	  error += (std::abs (Ax - b(i)) > 1e-8);
+	}
+    }
+
+  return error;
+}
+
+// The tall-skinny factorization gives the same R as the plain one,
+// up to the sign of each row, and the same least-squares solutions.
+template <typename ValueType>
+unsigned int test_tsqr (const unsigned int m,
+			const unsigned int n)
+{
+  unsigned int error = 0;
+
+  const ewalena::Matrix<ValueType> A = random_matrix<ValueType> (m, n);
+  const ewalena::TSQRFactorization<ValueType> F (A);
+
+  error += (F.n_rows () != m || F.n_cols () != n);
+  error += (F.n_blocks () != std::max (1u, m/std::max (F.min_block_rows (), 2*n)));
+  error += check_factors (A, F);
+  error += check_solve (A, F);
+
+  ewalena::Matrix<ValueType> R, R_qr;
+  F.form_R (R);
+  ewalena::QRFactorization<ValueType> (A).form_R (R_qr);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      error += (std::abs (std::abs (R(i, j)) - std::abs (R_qr(i, j))) > 1e-10);
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  const unsigned int sizes[][2] = {{0, 0}, {1, 1}, {5, 3}, {3, 5}, {33, 33}, {70, 40}, {40, 70}, {100, 65}};
+
+  for (unsigned int s=0; s<8; ++s)
+    {
+      error += test<double>               (sizes[s][0], sizes[s][1]);
+      error += test<std::complex<double> > (sizes[s][0], sizes[s][1]);
+    }
+
+  const unsigned int tall_sizes[][2] = {{100, 4}, {600, 5}, {1100, 40}};
+
+  for (unsigned int s=0; s<3; ++s)
+    {
+      error += test_tsqr<double>               (tall_sizes[s][0], tall_sizes[s][1]);
+      error += test_tsqr<std::complex<double> > (tall_sizes[s][0], tall_sizes[s][1]);
+    }
+
+  assert (error == 0);
+}
@@ -0,0 +1,135 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/matrix.h>
+#include <ewalena/lac/fixed_size_inverse.h>
+#include "../tests.h"
+
+// Inverse of matrices of every size from the closed forms through
+// the unrolled elimination to the LU factorization, and the fixed
+// size solves, single and batched, of matrices that need their rows
+// exchanged.
+
+// Check M M^{-1} = I, and that inverting in place gives the same.
+template <typename ValueType>
+unsigned int test_invert (const unsigned int n)
+{
+  unsigned int error = 0;
+
+  ewalena::Matrix<ValueType> M (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      M(i, j) = uniform<ValueType> () + ValueType (i == j);
+
+  ewalena::Matrix<ValueType> M_inverse;
+  M_inverse.invert (M);
+  error += (M_inverse.n_rows () != n || M_inverse.n_cols () != n);
+
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	ValueType I = ValueType (0);
+	for (unsigned int k=0; k<n; ++k)
+	  I += M(i, k)*M_inverse(k, j);
+	error += (std::abs (I - ValueType (i == j)) > 1e-10);
+      }
+
+  if (n > 3)
+    {
+      ewalena::Matrix<ValueType> N (M);
+      N.invert (N);
+      for (unsigned int i=0; i<n; ++i)
+	for (unsigned int j=0; j<n; ++j)
+	  error += (std::abs (N(i, j) - M_inverse(i, j)) > 1e-12);
+    }
+
+  return error;
+}
+
+// Solve a batch of systems, stored as a structure of arrays, and
+// compare with the single solves and inverses. The matrices have a
+// zero on the diagonal, so that rows must be exchanged, at a
+// different row in each.
+template <unsigned int n, typename ValueType>
+unsigned int test_fixed_size ()
+{
+  unsigned int error = 0;
+
+  const unsigned int n_matrices = 37;
+
+  std::vector<ValueType> A (n*n*n_matrices), b (n*n_matrices);
+  for (unsigned int p=0; p<n_matrices; ++p)
+    {
+      for (unsigned int c=0; c<n*n; ++c)
+	A[c*n_matrices+p] = uniform<ValueType> ();
+      for (unsigned int i=0; i<n; ++i)
+	b[i*n_matrices+p] = uniform<ValueType> ();
+      A[(p%n)*(n+1)*n_matrices+p] = ValueType (0);
+    }
+
+  std::vector<ValueType> x (b), A_inverse (A.size ());
+  error += !ewalena::fixed_size::solve<n> (n_matrices, &A[0], n_matrices, &x[0], n_matrices);
+  error += !ewalena::fixed_size::invert<n> (n_matrices, &A[0], n_matrices, &A_inverse[0], n_matrices);
+
+  for (unsigned int p=0; p<n_matrices; ++p)
+    {
+      ValueType A_p[n*n], A_p_inverse[n*n], x_p[n];
+      for (unsigned int c=0; c<n*n; ++c)
+	A_p[c] = A[c*n_matrices+p];
+      for (unsigned int i=0; i<n; ++i)
+	x_p[i] = b[i*n_matrices+p];
+
+      error += !ewalena::fixed_size::solve<n> (A_p, x_p);
+      error += !ewalena::fixed_size::invert<n> (A_p, A_p_inverse);
+
+      for (unsigned int i=0; i<n; ++i)
+	{
+	  ValueType Ax = ValueType (0), A_inverse_b = ValueType (0);
+	  for (unsigned int j=0; j<n; ++j)
+	    {
+	      Ax          += A_p[i*n+j]*x_p[j];
+	      A_inverse_b += A_p_inverse[i*n+j]*b[j*n_matrices+p];
+	    }
+	  error += (std::abs (Ax - b[i*n_matrices+p]) > 1e-10);
+	  error += (std::abs (A_inverse_b - x_p[i]) > 1e-10);
+	  error += (std::abs (x[i*n_matrices+p] - x_p[i]) > 1e-12);
+
+	  for (unsigned int j=0; j<n; ++j)
+	    error += (std::abs (A_inverse[(i*n+j)*n_matrices+p] - A_p_inverse[i*n+j]) > 1e-12);
+	}
+    }
+
+  // A singular matrix is reported.
+  ValueType S[n*n];
+  for (unsigned int c=0; c<n*n; ++c)
+    S[c] = ValueType (c%n);
+  error += ewalena::fixed_size::invert<n> (S, S);
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  for (unsigned int n=1; n<12; ++n)
+    {
+      error += test_invert<double>               (n);
+      error += test_invert<std::complex<double> > (n);
+    }
+
+  error += test_fixed_size<4, double> () + test_fixed_size<5, double> ();
+  error += test_fixed_size<6, double> () + test_fixed_size<7, double> ();
+  error += test_fixed_size<8, double> ();
+  error += test_fixed_size<4, std::complex<double> > () + test_fixed_size<8, std::complex<double> > ();
+
+  assert (error == 0);
+}
@@ -0,0 +1,263 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/gemm.h>
+#include <ewalena/lac/kronecker_operator.h>
+#include <ewalena/many_body/fock_basis.h>
+#include <ewalena/many_body/fock_hamiltonian.h>
+#include "../tests.h"
+
+// Sums of Kronecker products applied mode by mode agree with the
+// product formed element by element, for terms on all modes and on
+// a few, and a spin chain built from local operators agrees with
+// the same chain of hard-core bosons.
+
+template <typename ValueType>
+ewalena::Matrix<ValueType> random_matrix (const unsigned int d)
+{
+  ewalena::Matrix<ValueType> A (d, d);
+  for (unsigned int i=0; i<d; ++i)
+    for (unsigned int j=0; j<d; ++j)
+      A(i, j) = uniform<ValueType> ();
+  return A;
+}
+
+template <typename ValueType>
+unsigned int test_terms (const std::vector<unsigned int> &dimensions)
+{
+  unsigned int error = 0;
+
+  const unsigned int K = dimensions.size ();
+
+  ewalena::KroneckerOperator<ValueType> H (dimensions);
+  const unsigned int n = H.size ();
+
+  // The terms as factors on every mode, identities included.
+  std::vector<std::vector<ewalena::Matrix<ValueType>>> factors;
+  std::vector<ValueType>                               coefficients;
+
+  for (unsigned int term=0; term<2*K+1; ++term)
+    {
+      std::vector<ewalena::Matrix<ValueType>> all;
+      for (unsigned int k=0; k<K; ++k)
+	{
+	  ewalena::Matrix<ValueType> I (dimensions[k], dimensions[k]);
+	  for (unsigned int i=0; i<dimensions[k]; ++i)
+	    I(i, i) = ValueType (1);
+	  all.push_back (I);
+	}
+
+      const ValueType c = uniform<ValueType> ();
+
+      if (term == 0)
+	{
+	  // A multiple of the identity.
+	  H.add_term (std::vector<unsigned int> (), std::vector<ewalena::Matrix<ValueType>> (), c);
+	}
+      else if (term % 2)
+	{
+	  for (unsigned int k=0; k<K; ++k)
+	    all[k] = random_matrix<ValueType> (dimensions[k]);
+	  H.add_term (all, c);
+	}
+      else
+	{
+	  // Two modes, given in decreasing order.
+	  const unsigned int a = std::rand () % K;
+	  const unsigned int b = (a + 1 + std::rand () % (K-1)) % K;
+	  all[a] = random_matrix<ValueType> (dimensions[a]);
+	  all[b] = random_matrix<ValueType> (dimensions[b]);
+
+	  std::vector<unsigned int>               modes (1, std::max (a, b));
+	  std::vector<ewalena::Matrix<ValueType>> local (1, all[std::max (a, b)]);
+	  modes.push_back (std::min (a, b));
+	  local.push_back (all[std::min (a, b)]);
+	  H.add_term (modes, local, c);
+	}
+
+      factors.push_back (all);
+      coefficients.push_back (c);
+    }
+
+  error += (H.n_terms () != factors.size ());
+
+  ewalena::Vector<ValueType> x (n), y (n);
+  for (unsigned int i=0; i<n; ++i)
+    x(i) = uniform<ValueType> ();
+
+  H.vmult (y, x);
+
+  // The element (i, j) of a Kronecker product is the product of the
+  // elements of the factors at the digits of i and j, mode 0 first.
+  for (unsigned int i=0; i<n; ++i)
+    {
+      ValueType Hx = ValueType (0);
+      for (unsigned int j=0; j<n; ++j)
+	{
+	  ValueType element = ValueType (0);
+	  for (unsigned int t=0; t<factors.size (); ++t)
+	    {
+	      ValueType    product = coefficients[t];
+	      unsigned int p = i, q = j;
+	      for (unsigned int k=K; k-->0; )
+		{
+		  product *= factors[t][k](p % dimensions[k], q % dimensions[k]);
+		  p /= dimensions[k];
+		  q /= dimensions[k];
+		}
+	      element += product;
+	    }
+	  Hx += element*x(j);
+	}
+      error += (std::abs (Hx - y(i)) > 1e-12);
+    }
+
+  return error;
+}
+
+// Modes with few slices before them but large ones after: the
+// product must not depend on whether the slices are split into
+// blocks of columns over the threads or left to gemm, nor on a
+// workspace kept by the caller from one product to the next.
+template <typename ValueType>
+unsigned int test_threads ()
+{
+  unsigned int error = 0;
+
+  std::vector<unsigned int> dimensions;
+  dimensions.push_back (2);
+  dimensions.push_back (64);
+  dimensions.push_back (64);
+
+  ewalena::KroneckerOperator<ValueType> H (dimensions);
+  std::vector<ewalena::Matrix<ValueType>> factors;
+  for (unsigned int k=0; k<dimensions.size (); ++k)
+    factors.push_back (random_matrix<ValueType> (dimensions[k]));
+  H.add_term (factors, uniform<ValueType> ());
+
+  std::vector<unsigned int> modes (1, 1);
+  H.add_term (modes, std::vector<ewalena::Matrix<ValueType>> (1, factors[1]), uniform<ValueType> ());
+
+  const unsigned int n = H.size ();
+  ewalena::Vector<ValueType> x (n), reference (n), y (n);
+  for (unsigned int i=0; i<n; ++i)
+    x(i) = uniform<ValueType> ();
+
+  ewalena::ThreadPool &pool      = ewalena::ThreadPool::instance ();
+  const unsigned int   n_threads = pool.n_threads ();
+  const std::size_t    threshold = ewalena::blas::gemm_threshold ();
+
+  pool.set_n_threads (1);
+  H.vmult (reference, x);
+
+  std::vector<ValueType> work;
+
+  pool.set_n_threads (4);
+  for (unsigned int gemm_threshold=0; gemm_threshold<2; ++gemm_threshold)
+    {
+      ewalena::blas::set_gemm_threshold (gemm_threshold ? threshold : 0);
+      H.vmult (y, x, work);
+      for (unsigned int i=0; i<n; ++i)
+	error += (std::abs (y(i) - reference(i)) > 1e-12*(1. + std::abs (reference(i))));
+    }
+
+  pool.set_n_threads (n_threads);
+  ewalena::blas::set_gemm_threshold (threshold);
+
+  return error;
+}
+
+// The XX chain with a field, sum_i t (s+_i s-_{i+1} + h.c.) + h n_i,
+// with spin up on mode i standing for a hard-core boson on mode
+// L-1-i, the bit that digit is.
+template <typename ValueType>
+unsigned int test_chain (const unsigned int L)
+{
+  unsigned int error = 0;
+
+  const ewalena::FockBasis              basis (L);
+  ewalena::FockHamiltonian<ValueType>   bosons (basis, ewalena::FockBasis::hardcore_bosons);
+  ewalena::KroneckerOperator<ValueType> spins (std::vector<unsigned int> (L, 2));
+
+  ewalena::Matrix<ValueType> raise (2, 2), lower (2, 2), number (2, 2);
+  raise(1, 0)  = ValueType (1);
+  lower(0, 1)  = ValueType (1);
+  number(1, 1) = ValueType (1);
+
+  for (unsigned int i=0; i+1<L; ++i)
+    {
+      const ValueType t = uniform<ValueType> ();
+      const double    h = uniform<double> ();
+
+      std::vector<unsigned int> modes;
+      modes.push_back (i);
+      modes.push_back (i+1);
+
+      std::vector<ewalena::Matrix<ValueType>> hop;
+      hop.push_back (raise);
+      hop.push_back (lower);
+      spins.add_term (modes, hop, t);
+
+      hop[0] = lower;
+      hop[1] = raise;
+      spins.add_term (modes, hop, ewalena::math::conjugate (t));
+
+      spins.add_term (std::vector<unsigned int> (1, i),
+		      std::vector<ewalena::Matrix<ValueType>> (1, number), ValueType (h));
+
+      bosons.add_hopping (L-1-i, L-2-i, t);
+      bosons.add_potential (L-1-i, h);
+    }
+
+  const unsigned int n = spins.size ();
+  error += (n != basis.size ());
+
+  ewalena::Vector<ValueType> x (n), y (n), z (n);
+  for (unsigned int i=0; i<n; ++i)
+    x(i) = uniform<ValueType> ();
+
+  spins.vmult (y, x);
+  bosons.vmult (z, x);
+
+  for (unsigned int i=0; i<n; ++i)
+    error += (std::abs (y(i) - z(i)) > 1e-12);
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  std::vector<unsigned int> dimensions;
+  dimensions.push_back (2);
+  dimensions.push_back (3);
+  dimensions.push_back (4);
+  dimensions.push_back (2);
+
+  error += test_terms<double>               (dimensions);
+  error += test_terms<std::complex<double>> (dimensions);
+
+  dimensions.assign (1, 7);
+  dimensions.push_back (5);
+  error += test_terms<double>               (dimensions);
+
+  error += test_threads<double>               ();
+  error += test_threads<std::complex<double>> ();
+
+  error += test_chain<double>               (12);
+  error += test_chain<std::complex<double>> (10);
+
+  assert (error == 0);
+}
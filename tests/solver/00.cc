@@ -0,0 +1,280 @@
+
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/linear_operator.h>
+#include <ewalena/lac/solver_bicgstab.h>
+#include <ewalena/lac/solver_cg.h>
+#include <ewalena/lac/solver_gmres.h>
+#include <ewalena/lac/solver_minres.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include "../tests.h"
+
+// Solve Hermitian positive definite, Hermitian indefinite and
+// non-Hermitian tridiagonal systems with the Krylov solvers, given as
+// a sparse matrix, a dense matrix and a linear operator, with and
+// without a preconditioner, and check the residual and the history.
+
+// The imaginary unit, or one for real value types.
+template <typename ValueType>
+ValueType unit ()
+{
+  return ValueType (1);
+}
+
+template <>
+std::complex<double> unit ()
+{
+  return std::complex<double> (0., 1.);
+}
+
+// Scale by the inverse of the diagonal of a matrix.
+template <typename ValueType>
+class PreconditionDiagonal
+{
+public:
+
+  PreconditionDiagonal (const ewalena::SparseMatrix<ValueType> &A)
+    :
+    diagonal (A.n_rows ())
+  {
+    for (unsigned int i=0; i<A.n_rows (); ++i)
+      diagonal(i) = ValueType (1)/A(i,i);
+  }
+
+  void vmult (ewalena::Vector<ValueType>       &dst,
+	      const ewalena::Vector<ValueType> &src) const
+  {
+    dst = src;
+    for (unsigned int i=0; i<dst.size (); ++i)
+      dst(i) *= diagonal(i);
+  }
+
+private:
+
+  ewalena::Vector<ValueType> diagonal;
+};
+
+// A tridiagonal matrix with diagonal d_i and off-diagonals lower and
+// upper.
+template <typename ValueType>
+ewalena::SparseMatrix<ValueType> 
+tridiagonal (const std::vector<ValueType> &d,
+	     const ValueType               lower,
+	     const ValueType               upper)
+{
+  typedef typename ewalena::SparseMatrix<ValueType>::Triplet Triplet;
+
+  const unsigned int n = d.size ();
+  std::vector<Triplet> triplets;
+  for (unsigned int i=0; i<n; ++i)
+    {
+      triplets.push_back (Triplet {i, i, d[i]});
+      if (i > 0)
+	triplets.push_back (Triplet {i, i-1, lower});
+      if (i+1 < n)
+	triplets.push_back (Triplet {i, i+1, upper});
+    }
+
+  return ewalena::SparseMatrix<ValueType> (n, n, triplets);
+}
+
+// Return the relative residual |b-Ax|/|b| and check that the history
+// is consistent with the solver state.
+template <typename ValueType, typename MatrixType>
+double residual (const MatrixType                 &A,
+		 const ewalena::Vector<ValueType> &x,
+		 const ewalena::Vector<ValueType> &b,
+		 const ewalena::SolverControl     &control)
+{
+  assert (control.last_state () == ewalena::SolverControl::success);
+  assert (control.history ().size () == control.last_step ()+1);
+  assert (control.last_value () <= control.target ());
+
+  ewalena::Vector<ValueType> r (b.size ());
+  A.vmult (r, x);
+  r.sadd (ValueType (1), b, ValueType (-1), r);
+
+  return std::abs (r.l2_norm ())/std::abs (b.l2_norm ());
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int n)
+{
+  unsigned int error = 0;
+
+  const double tolerance = 1e-8;
+
+  ewalena::Vector<ValueType> b (n, false);
+  for (unsigned int i=0; i<n; ++i)
+    b(i) = uniform<ValueType> ();
+
+  ewalena::Vector<ValueType> x (n);
+  ewalena::SolverControl control (10*n, 0., 1e-10);
+
+  // Hermitian positive definite: a shifted Laplacian with a varying
+  // diagonal, and a complex coupling for complex value types.
+  std::vector<ValueType> d (n);
+  for (unsigned int i=0; i<n; ++i)
+    d[i] = ValueType (2.01 + double (i%7));
+
+  const ValueType c = unit<ValueType> ();
+  const ewalena::SparseMatrix<ValueType> spd = tridiagonal (d, -ewalena::math::conjugate (c), -c);
+
+  {
+    ewalena::SolverCG<ValueType> solver (control);
+
+    x.reinit (n);
+    solver.solve (spd, x, b);
+    error += (residual (spd, x, b, control) > tolerance);
+    const unsigned int steps = control.last_step ();
+
+    // Solving again reuses the workspace; a preconditioner does not
+    // need more steps.
+    x.reinit (n);
+    solver.solve (spd, x, b, PreconditionDiagonal<ValueType> (spd));
+    error += (residual (spd, x, b, control) > tolerance);
+    error += (control.last_step () > steps);
+
+    // MINRES works on definite matrices too.
+    ewalena::SolverMINRES<ValueType> minres (control);
+    x.reinit (n);
+    minres.solve (spd, x, b, PreconditionDiagonal<ValueType> (spd));
+    error += (residual (spd, x, b, control) > tolerance);
+  }
+
+  // Hermitian indefinite: alternate the sign of the diagonal.
+  for (unsigned int i=0; i<n; ++i)
+    d[i] = ValueType ((i%2 == 0 ? 1. : -1.)*(1. + double (i%5)));
+
+  const ewalena::SparseMatrix<ValueType> indefinite 
+    = tridiagonal (d, ValueType (0.3)*ewalena::math::conjugate (c), ValueType (0.3)*c);
+
+  {
+    ewalena::SolverMINRES<ValueType> solver (control);
+
+    x.reinit (n);
+    solver.solve (indefinite, x, b);
+    error += (residual (indefinite, x, b, control) > tolerance);
+
+    // The residual MINRES minimises never grows.
+    for (unsigned int k=1; k<control.history ().size (); ++k)
+      error += (control.history ()[k] > control.history ()[k-1]*(1. + 1e-12));
+
+    // With a positive definite preconditioner: |d|.
+    std::vector<ValueType> abs_d (n);
+    for (unsigned int i=0; i<n; ++i)
+      abs_d[i] = std::abs (d[i]);
+    const ewalena::SparseMatrix<ValueType> modulus = tridiagonal (abs_d, ValueType (0), ValueType (0));
+
+    x.reinit (n);
+    solver.solve (indefinite, x, b, PreconditionDiagonal<ValueType> (modulus));
+    error += (residual (indefinite, x, b, control) > tolerance);
+  }
+
+  // Non-Hermitian: convection-diffusion.
+  for (unsigned int i=0; i<n; ++i)
+    d[i] = ValueType (4. + double (i%3));
+
+  const ewalena::SparseMatrix<ValueType> general 
+    = tridiagonal (d, ValueType (-1.5)*c, ValueType (-0.5));
+
+  {
+    // A short restart, so that GMRES restarts, and a long one.
+    ewalena::SolverGMRES<ValueType> gmres (control, 5);
+
+    x.reinit (n);
+    gmres.solve (general, x, b);
+    error += (residual (general, x, b, control) > tolerance);
+
+    x.reinit (n);
+    gmres.solve (general, x, b, PreconditionDiagonal<ValueType> (general));
+    error += (residual (general, x, b, control) > tolerance);
+
+    ewalena::SolverGMRES<ValueType> gmres_long (control, 50);
+    x.reinit (n);
+    gmres_long.solve (general, x, b);
+    error += (residual (general, x, b, control) > tolerance);
+
+    ewalena::SolverBiCGStab<ValueType> bicgstab (control);
+
+    x.reinit (n);
+    bicgstab.solve (general, x, b);
+    error += (residual (general, x, b, control) > tolerance);
+
+    x.reinit (n);
+    bicgstab.solve (general, x, b, PreconditionDiagonal<ValueType> (general));
+    error += (residual (general, x, b, control) > tolerance);
+
+    // The same matrix as a linear operator and as a dense matrix.
+    const ewalena::LinearOperator<ValueType> 
+      op ([&] (ewalena::Vector<ValueType> &y, const ewalena::Vector<ValueType> &v)
+	  {
+	    general.vmult (y, v);
+	  });
+
+    x.reinit (n);
+    gmres.solve (op, x, b);
+    error += (residual (general, x, b, control) > tolerance);
+
+    if (n <= 100)
+      {
+	ewalena::Matrix<ValueType> dense (n, n);
+	for (unsigned int i=0; i<n; ++i)
+	  for (unsigned int j=0; j<n; ++j)
+	    dense(i,j) = general(i,j);
+
+	x.reinit (n);
+	bicgstab.solve (dense, x, b);
+	error += (residual (general, x, b, control) > tolerance);
+      }
+  }
+
+  // A zero right hand side converges at step zero.
+  {
+    ewalena::Vector<ValueType> zero (n);
+    ewalena::SolverCG<ValueType> solver (control);
+
+    x.reinit (n);
+    solver.solve (spd, x, zero);
+    error += (control.last_step () != 0);
+    error += (x.l2_norm () != ValueType (0));
+  }
+
+  // Too few steps fail.
+  if (n > 10)
+    {
+      ewalena::SolverControl short_control (2, 0., 1e-10);
+      ewalena::SolverCG<ValueType> solver (short_control);
+
+      x.reinit (n);
+      error += (solver.solve (spd, x, b) != ewalena::SolverControl::failure);
+      error += (short_control.history ().size () != 3);
+    }
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  const unsigned int sizes[] = {1, 10, 100, 2000};
+
+  for (unsigned int s=0; s<4; ++s)
+    {
+      error += test<double>               (sizes[s]);
+      error += test<std::complex<double> > (sizes[s]);
+    }
+
+  assert (error == 0);
+}
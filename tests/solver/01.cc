@@ -0,0 +1,246 @@
+
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/eigensolver_davidson.h>
+#include <ewalena/lac/eigensolver_lanczos.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include <ewalena/lac/linear_operator.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include "../tests.h"
+
+// Find all eigenpairs of small dense Hermitian matrices, and the
+// lowest eigenpairs of a tight-binding Hamiltonian with a random
+// potential and of a diagonally dominant dense matrix with the
+// Lanczos and Davidson eigensolvers, and compare the two.
+
+// A random Hermitian matrix whose diagonal grows with the row, scaled
+// by d, so that it is diagonally dominant for large d.
+template <typename ValueType>
+ewalena::Matrix<ValueType> hermitian (const unsigned int n,
+				      const double       d)
+{
+  ewalena::Matrix<ValueType> A (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      A(i, i) = ValueType (d*i + std::real (uniform<ValueType> ()));
+      for (unsigned int j=i+1; j<n; ++j)
+	{
+	  A(i, j) = uniform<ValueType> ();
+	  A(j, i) = ewalena::math::conjugate (A(i, j));
+	}
+    }
+  return A;
+}
+
+// Return the largest residual |Ax-lambda x| and the largest
+// deviation from orthonormality of the eigenpairs.
+template <typename ValueType, typename MatrixType>
+double residual (const MatrixType                              &A,
+		 const std::vector<double>                     &lambda,
+		 const std::vector<ewalena::Vector<ValueType> > &x)
+{
+  double residual = 0.;
+
+  ewalena::Vector<ValueType> r (x[0].size ());
+  for (unsigned int i=0; i<x.size (); ++i)
+    {
+      A.vmult (r, x[i]);
+      r.add (ValueType (-lambda[i]), x[i]);
+      residual = std::max (residual, std::abs (r.l2_norm ()));
+
+      for (unsigned int j=0; j<x.size (); ++j)
+	residual = std::max (residual, std::abs (x[i].dot (x[j]) - ValueType (i == j)));
+    }
+
+  return residual;
+}
+
+template <typename ValueType>
+unsigned int test_dense (const unsigned int n)
+{
+  unsigned int error = 0;
+
+  const ewalena::Matrix<ValueType> A = hermitian<ValueType> (n, 0.);
+
+  const ewalena::HermitianEigensolver<ValueType> eigensystem (A);
+  const std::vector<double>        &lambda = eigensystem.eigenvalues ();
+  const ewalena::Matrix<ValueType> &Q      = eigensystem.eigenvectors ();
+
+  error += (eigensystem.size () != n);
+
+  for (unsigned int j=1; j<n; ++j)
+    error += (lambda[j] < lambda[j-1]);
+
+  // A Q = Q Lambda and Q^H Q = I.
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	ValueType AQ = ValueType (0), QQ = ValueType (0);
+	for (unsigned int k=0; k<n; ++k)
+	  {
+	    AQ += A(i, k)*Q(k, j);
+	    QQ += ewalena::math::conjugate (Q(k, i))*Q(k, j);
+	  }
+	error += (std::abs (AQ - Q(i, j)*lambda[j]) > 1e-12*n);
+	error += (std::abs (QQ - ValueType (i == j)) > 1e-12*n);
+      }
+
+  // The eigenvalues alone.
+  const ewalena::HermitianEigensolver<ValueType> values (A, false);
+  for (unsigned int j=0; j<n; ++j)
+    error += (std::abs (values.eigenvalues ()[j] - lambda[j]) > 1e-12*n);
+
+  return error;
+}
+
+template <typename ValueType>
+unsigned int test_iterative (const unsigned int n,
+			     const unsigned int k)
+{
+  unsigned int error = 0;
+
+  typedef typename ewalena::SparseMatrix<ValueType>::Triplet Triplet;
+  typedef ewalena::EigensolverLanczos<ValueType> Lanczos;
+
+  const double tolerance = 1e-8;
+
+  // A tight-binding Hamiltonian on a ring with a random potential,
+  // and a phase on the hopping for complex value types.
+  std::vector<Triplet> triplets;
+  for (unsigned int i=0; i<n; ++i)
+    {
+      const ValueType hopping = (n == 1) ? ValueType (0) : ValueType (-1) + uniform<ValueType> ()*ValueType (0.2);
+      triplets.push_back (Triplet {i, i, ValueType (4.*std::real (uniform<ValueType> ()))});
+      triplets.push_back (Triplet {i, (i+1)%n, hopping});
+      triplets.push_back (Triplet {(i+1)%n, i, ewalena::math::conjugate (hopping)});
+    }
+  const ewalena::SparseMatrix<ValueType> H (n, n, triplets);
+
+  ewalena::Matrix<ValueType> dense (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      dense(i, j) = H(i, j);
+  const std::vector<double> exact = ewalena::HermitianEigensolver<ValueType> (dense, false).eigenvalues ();
+
+  std::vector<double> lambda;
+  std::vector<ewalena::Vector<ValueType> > x (k, ewalena::Vector<ValueType> (n));
+
+  // Lanczos with full and local reorthogonalisation, with a small
+  // basis so that it restarts.
+  {
+    ewalena::SolverControl control (1000, tolerance);
+
+    Lanczos full (control, k, k+10, Lanczos::full);
+    error += (full.solve (H, lambda, x) != ewalena::SolverControl::success);
+    error += (residual (H, lambda, x) > 10.*tolerance);
+    for (unsigned int i=0; i<k; ++i)
+      error += (std::abs (lambda[i] - exact[i]) > 1e-10);
+    error += (control.history ().size () != control.last_step ()+1);
+    const unsigned int n_steps = control.last_step ();
+
+    // Starting from the solution takes no more steps.
+    error += (full.solve (H, lambda, x) != ewalena::SolverControl::success);
+    error += (control.last_step () > n_steps);
+
+    for (unsigned int i=0; i<k; ++i)
+      x[i].reinit (n);
+
+    Lanczos local (control, k, 0, Lanczos::local);
+    error += (local.solve (H, lambda, x) != ewalena::SolverControl::success);
+    for (unsigned int i=0; i<k; ++i)
+      error += (std::abs (lambda[i] - exact[i]) > 1e-8);
+  }
+
+  // Davidson with the diagonal of the matrix, as a linear operator.
+  {
+    ewalena::SolverControl control (1000, tolerance);
+
+    ewalena::Vector<ValueType> diagonal (n);
+    diagonal.diag (dense);
+
+    const ewalena::LinearOperator<ValueType> 
+      op ([&] (ewalena::Vector<ValueType> &y, const ewalena::Vector<ValueType> &v)
+	  {
+	    H.vmult (y, v);
+	  });
+
+    // The lowest eigenvectors are localised anywhere on the ring, so
+    // start from random vectors rather than the lowest diagonal
+    // elements.
+    for (unsigned int i=0; i<k; ++i)
+      for (unsigned int j=0; j<n; ++j)
+	x[i](j) = uniform<ValueType> ();
+
+    ewalena::EigensolverDavidson<ValueType> davidson (control, k);
+    error += (davidson.solve (op, diagonal, lambda, x) != ewalena::SolverControl::success);
+    error += (residual (H, lambda, x) > 10.*tolerance);
+    for (unsigned int i=0; i<k; ++i)
+      error += (std::abs (lambda[i] - exact[i]) > 1e-10);
+  }
+
+  // A diagonally dominant dense matrix, for which Davidson needs far
+  // fewer steps than Lanczos.
+  {
+    const ewalena::Matrix<ValueType> A = hermitian<ValueType> (n, 10.);
+    const std::vector<double> exact = ewalena::HermitianEigensolver<ValueType> (A, false).eigenvalues ();
+
+    ewalena::Vector<ValueType> diagonal (n);
+    diagonal.diag (A);
+
+    ewalena::SolverControl control (1000, tolerance);
+
+    for (unsigned int i=0; i<k; ++i)
+      x[i].reinit (n);
+
+    ewalena::EigensolverDavidson<ValueType> davidson (control, k);
+    error += (davidson.solve (A, diagonal, lambda, x) != ewalena::SolverControl::success);
+    error += (residual (A, lambda, x) > 10.*tolerance);
+    for (unsigned int i=0; i<k; ++i)
+      error += (std::abs (lambda[i] - exact[i]) > 1e-10);
+    const unsigned int n_davidson = control.last_step ();
+
+    for (unsigned int i=0; i<k; ++i)
+      x[i].reinit (n);
+
+    Lanczos lanczos (control, k);
+    error += (lanczos.solve (A, lambda, x) != ewalena::SolverControl::success);
+    for (unsigned int i=0; i<k; ++i)
+      error += (std::abs (lambda[i] - exact[i]) > 1e-10);
+
+    error += (n > 100 && n_davidson > 20);
+  }
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  const unsigned int sizes[] = {1, 2, 5, 40};
+  for (unsigned int s=0; s<4; ++s)
+    {
+      error += test_dense<double>               (sizes[s]);
+      error += test_dense<std::complex<double> > (sizes[s]);
+    }
+
+  error += test_iterative<double>               (1,   1);
+  error += test_iterative<std::complex<double> > (1,   1);
+  error += test_iterative<double>               (4,   4);
+  error += test_iterative<std::complex<double> > (4,   4);
+  error += test_iterative<double>               (150, 4);
+  error += test_iterative<std::complex<double> > (150, 4);
+
+  assert (error == 0);
+}
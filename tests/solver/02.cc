@@ -0,0 +1,174 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/math.h>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/hermitian_eigensolver.h>
+#include <ewalena/lac/propagator_krylov.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include "../tests.h"
+
+// Propagation of a state by exp(-iHt) with the Krylov method and the
+// Chebyshev expansion, against the exponential from the eigensystem
+// of small dense matrices, in one call and in many short ones,
+// forwards and back, and on a large sparse tight-binding ring where
+// the two methods are compared with each other.
+
+typedef std::complex<double> Complex;
+
+double distance (const ewalena::Vector<Complex> &x,
+		 const ewalena::Vector<Complex> &y)
+{
+  double d = 0.;
+  for (unsigned int i=0; i<x.size (); ++i)
+    d += std::norm (x(i) - y(i));
+  return std::sqrt (d);
+}
+
+// exp(-iHt) v = Y exp(-i Lambda t) Y^H v.
+ewalena::Vector<Complex> exact (const ewalena::HermitianEigensolver<Complex> &eigensystem,
+				const double                                 t,
+				const ewalena::Vector<Complex>              &v)
+{
+  const std::vector<double>      &lambda = eigensystem.eigenvalues ();
+  const ewalena::Matrix<Complex> &Y      = eigensystem.eigenvectors ();
+  const unsigned int              n      = v.size ();
+
+  ewalena::Vector<Complex> y (n);
+  for (unsigned int l=0; l<n; ++l)
+    {
+      Complex c = 0.;
+      for (unsigned int i=0; i<n; ++i)
+	c += ewalena::math::conjugate (Y(i, l))*v(i);
+      c *= std::polar (1., -lambda[l]*t);
+      for (unsigned int i=0; i<n; ++i)
+	y(i) += Y(i, l)*c;
+    }
+  return y;
+}
+
+unsigned int test_dense (const unsigned int n,
+			 const double       t)
+{
+  unsigned int error = 0;
+
+  // A random Hermitian matrix with a spread-out diagonal.
+  ewalena::Matrix<Complex> H (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      H(i, i) = Complex (10.*uniform<double> ());
+      for (unsigned int j=0; j<i; ++j)
+	{
+	  H(i, j) = Complex (uniform<double> (), uniform<double> ());
+	  H(j, i) = ewalena::math::conjugate (H(i, j));
+	}
+    }
+
+  const ewalena::HermitianEigensolver<Complex> eigensystem (H);
+  const std::vector<double> &lambda = eigensystem.eigenvalues ();
+
+  ewalena::Vector<Complex> v (n);
+  for (unsigned int i=0; i<n; ++i)
+    v(i) = Complex (uniform<double> (), uniform<double> ());
+  const double norm = std::abs (v.l2_norm ());
+
+  const ewalena::Vector<Complex> reference = exact (eigensystem, t, v);
+
+  // In one call, which takes several steps, and back.
+  ewalena::PropagatorKrylov krylov (1e-10, 20);
+  ewalena::Vector<Complex>  x (v);
+  krylov.propagate (H, t, x);
+  error += (distance (x, reference) > 1e-8*norm);
+  error += (std::abs (std::abs (x.l2_norm ()) - norm) > 1e-8*norm);
+  error += (n > 20 && krylov.n_steps () < 2);
+
+  krylov.propagate (H, -t, x);
+  error += (distance (x, v) > 1e-8*norm);
+
+  // In many short calls, with the step size and workspace carried
+  // over.
+  ewalena::PropagatorKrylov steps (1e-10, 20);
+  x = v;
+  for (unsigned int k=0; k<25; ++k)
+    steps.propagate (H, t/25, x);
+  error += (distance (x, reference) > 1e-8*norm);
+  error += (steps.step_size () <= 0.);
+
+  // The Chebyshev expansion on slightly loose bounds.
+  ewalena::PropagatorKrylov chebyshev (1e-10);
+  chebyshev.set_spectral_bounds (lambda[0] - 0.1, lambda[n-1] + 0.1);
+  x = v;
+  chebyshev.propagate (H, t, x);
+  error += (distance (x, reference) > 1e-8*norm);
+  error += (chebyshev.n_steps () != 1);
+
+  chebyshev.propagate (H, -t, x);
+  error += (distance (x, v) > 1e-8*norm);
+
+  return error;
+}
+
+// A ring with hopping and a random potential, long enough that the
+// state spreads over many sites.
+unsigned int test_ring (const unsigned int n,
+			const double       t)
+{
+  unsigned int error = 0;
+
+  typedef ewalena::SparseMatrix<Complex>::Triplet Triplet;
+  std::vector<Triplet> triplets;
+  for (unsigned int i=0; i<n; ++i)
+    {
+      const Triplet diagonal = {i, i, Complex (uniform<double> ())};
+      const Triplet right    = {i, (i+1) % n, Complex (-1.)};
+      const Triplet left     = {(i+1) % n, i, Complex (-1.)};
+      triplets.push_back (diagonal);
+      triplets.push_back (right);
+      triplets.push_back (left);
+    }
+  const ewalena::SparseMatrix<Complex> H (n, n, triplets);
+
+  // A wave packet.
+  ewalena::Vector<Complex> v (n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      const double s = (double (i) - n/2.)/10.;
+      v(i) = std::polar (std::exp (-s*s), 0.5*i);
+    }
+  const double norm = std::abs (v.l2_norm ());
+
+  ewalena::PropagatorKrylov krylov (1e-10), chebyshev (1e-10);
+  chebyshev.set_spectral_bounds (-2.5, 2.5);
+
+  ewalena::Vector<Complex> x (v), y (v);
+  krylov.propagate (H, t, x);
+  chebyshev.propagate (H, t, y);
+
+  error += (distance (x, y) > 1e-8*norm);
+  error += (std::abs (std::abs (x.l2_norm ()) - norm) > 1e-8*norm);
+
+  // About r t products for the expansion.
+  error += (chebyshev.n_products () > 2.5*t + 60);
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test_dense (1,  2.);
+  error += test_dense (3,  2.);
+  error += test_dense (80, 3.);
+  error += test_ring  (2000, 20.);
+
+  assert (error == 0);
+}
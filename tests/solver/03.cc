@@ -0,0 +1,381 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/precondition.h>
+#include <ewalena/lac/solver_cg.h>
+#include <ewalena/lac/solver_control.h>
+#include <ewalena/lac/solver_gmres.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include "../tests.h"
+
+// Jacobi, block-Jacobi, SSOR and incomplete LU preconditioners: the
+// cases in which they are exact, SSOR against its definition, the
+// same result on one thread as on all, refactorization against a new
+// factorization, and the number of iterations they save on a
+// diffusion problem with strongly varying coefficients.
+
+template <typename ValueType>
+double distance (const ewalena::Vector<ValueType> &x,
+		 const ewalena::Vector<ValueType> &y)
+{
+  double d = 0.;
+  for (unsigned int i=0; i<x.size (); ++i)
+    d = std::max (d, std::abs (x(i) - y(i)));
+  return d;
+}
+
+// A random sparse matrix with a dominant diagonal and elements
+// within bandwidth of it, sparse otherwise.
+template <typename ValueType>
+ewalena::SparseMatrix<ValueType> random_matrix (const unsigned int n,
+						const unsigned int bandwidth)
+{
+  typedef typename ewalena::SparseMatrix<ValueType>::Triplet Triplet;
+
+  std::vector<Triplet> triplets;
+  for (unsigned int i=0; i<n; ++i)
+    {
+      const Triplet diagonal = {i, i, ValueType (4. + std::rand () % 4)};
+      triplets.push_back (diagonal);
+
+      for (unsigned int k=0; k<3; ++k)
+	{
+	  const unsigned int j = std::min (n-1, i + std::rand () % (bandwidth+1));
+	  const Triplet upper = {i, j, uniform<ValueType> ()};
+	  const Triplet lower = {j, i, uniform<ValueType> ()};
+	  triplets.push_back (upper);
+	  triplets.push_back (lower);
+	}
+    }
+
+  return ewalena::SparseMatrix<ValueType> (n, n, triplets);
+}
+
+template <typename ValueType>
+ewalena::Matrix<ValueType> dense (const ewalena::SparseMatrix<ValueType> &A)
+{
+  ewalena::Matrix<ValueType> M (A.n_rows (), A.n_cols ());
+  for (unsigned int i=0; i<A.n_rows (); ++i)
+    for (unsigned int k=0; k<A.row_length (i); ++k)
+      M(i, A.columns (i)[k]) = A.values (i)[k];
+  return M;
+}
+
+// P^{-1} A x = x where the preconditioner is exact.
+template <typename ValueType, typename PreconditionerType>
+double exactness (const ewalena::SparseMatrix<ValueType> &A,
+		  const PreconditionerType               &P)
+{
+  const unsigned int n = A.n_rows ();
+
+  ewalena::Vector<ValueType> x (n), Ax (n), y (n);
+  for (unsigned int i=0; i<n; ++i)
+    x(i) = uniform<ValueType> ();
+
+  A.vmult (Ax, x);
+  P.vmult (y, Ax);
+
+  return distance (x, y);
+}
+
+template <typename ValueType>
+unsigned int test_exact ()
+{
+  unsigned int error = 0;
+
+  // ILU(0) of a tridiagonal matrix is its LU factorization.
+  const ewalena::SparseMatrix<ValueType> tridiagonal = random_matrix<ValueType> (500, 1);
+  ewalena::PreconditionILU<ValueType> ilu;
+  ilu.initialize (tridiagonal);
+  error += (exactness (tridiagonal, ilu) > 1e-12);
+  error += (ilu.n_nonzero_elements () != tridiagonal.n_nonzero_elements ());
+
+  // So is ILUT of any matrix that keeps everything.
+  const ewalena::SparseMatrix<ValueType> banded = random_matrix<ValueType> (300, 6);
+  ewalena::PreconditionILU<ValueType> ilut;
+  ilut.initialize (banded, 0., 300);
+  error += (exactness (banded, ilut) > 1e-10);
+
+  // Block-Jacobi of a block-diagonal matrix, with blocks inverted in
+  // closed form, unrolled and by LU.
+  const unsigned int block_sizes[] = {3, 5, 12};
+  for (unsigned int s=0; s<3; ++s)
+    {
+      const unsigned int b = block_sizes[s];
+
+      typedef typename ewalena::SparseMatrix<ValueType>::Triplet Triplet;
+      std::vector<Triplet> triplets;
+      for (unsigned int i=0; i<100; ++i)
+	for (unsigned int j=(i/b)*b; j<std::min (100u, (i/b+1)*b); ++j)
+	  {
+	    const Triplet element = {i, j, (i == j) ? ValueType (3.) : uniform<ValueType> ()};
+	    triplets.push_back (element);
+	  }
+      const ewalena::SparseMatrix<ValueType> A (100, 100, triplets);
+
+      ewalena::PreconditionBlockJacobi<ValueType> sparse, full;
+      sparse.initialize (A, b);
+      full.initialize (dense (A), b);
+      error += (exactness (A, sparse) > 1e-12);
+      error += (exactness (A, full) > 1e-12);
+    }
+
+  // Jacobi of a diagonal matrix.
+  typedef typename ewalena::SparseMatrix<ValueType>::Triplet Triplet;
+  std::vector<Triplet> triplets;
+  for (unsigned int i=0; i<50; ++i)
+    {
+      const Triplet element = {i, i, ValueType (1. + i)};
+      triplets.push_back (element);
+    }
+  const ewalena::SparseMatrix<ValueType> diagonal (50, 50, triplets);
+  ewalena::PreconditionJacobi<ValueType> jacobi, full_jacobi;
+  jacobi.initialize (diagonal);
+  full_jacobi.initialize (dense (diagonal));
+  error += (exactness (diagonal, jacobi) > 1e-14);
+  error += (exactness (diagonal, full_jacobi) > 1e-14);
+
+  return error;
+}
+
+// P y = r for the SSOR matrix P formed from its definition.
+template <typename ValueType>
+unsigned int test_ssor (const double omega)
+{
+  unsigned int error = 0;
+
+  const ewalena::SparseMatrix<ValueType> A = random_matrix<ValueType> (60, 8);
+  const ewalena::Matrix<ValueType>       M = dense (A);
+  const unsigned int                     n = A.n_rows ();
+
+  ewalena::PreconditionSSOR<ValueType> ssor;
+  ssor.initialize (A, omega);
+
+  ewalena::Vector<ValueType> r (n), y (n);
+  for (unsigned int i=0; i<n; ++i)
+    r(i) = uniform<ValueType> ();
+  ssor.vmult (y, r);
+
+  // P = omega/(2-omega) (D/omega + L) D^{-1} (D/omega + U).
+  ewalena::Vector<ValueType> Uy (n), Py (n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      Uy(i) = M(i, i)/ValueType (omega)*y(i);
+      for (unsigned int j=i+1; j<n; ++j)
+	Uy(i) += M(i, j)*y(j);
+      Uy(i) /= M(i, i);
+    }
+  for (unsigned int i=0; i<n; ++i)
+    {
+      Py(i) = M(i, i)/ValueType (omega)*Uy(i);
+      for (unsigned int j=0; j<i; ++j)
+	Py(i) += M(i, j)*Uy(j);
+      Py(i) *= ValueType (omega/(2.-omega));
+    }
+  error += (distance (Py, r) > 1e-12);
+
+  return error;
+}
+
+// The level-scheduled sweeps and factorization give the same result
+// on one thread and on all, and refactorization after the values
+// change gives the factors of a new initialization.
+template <typename ValueType>
+unsigned int test_refactorize ()
+{
+  unsigned int error = 0;
+
+  ewalena::SparseMatrix<ValueType> A = random_matrix<ValueType> (20000, 40);
+  const unsigned int               n = A.n_rows ();
+
+  ewalena::Vector<ValueType> r (n), x (n), y (n);
+  for (unsigned int i=0; i<n; ++i)
+    r(i) = uniform<ValueType> ();
+
+  ewalena::PreconditionILU<ValueType>  ilu, ilut;
+  ewalena::PreconditionSSOR<ValueType> ssor;
+  ilu.initialize (A);
+  ilut.initialize (A, 1e-3, 5);
+  ssor.initialize (A, 1.3);
+
+  ewalena::ThreadPool &pool      = ewalena::ThreadPool::instance ();
+  const unsigned int   n_threads = pool.n_threads ();
+
+  ewalena::Vector<ValueType> serial[3], parallel[3];
+  for (unsigned int pass=0; pass<2; ++pass)
+    {
+      pool.set_n_threads (pass ? n_threads : 1);
+
+      ewalena::Vector<ValueType> *z = pass ? parallel : serial;
+      for (unsigned int p=0; p<3; ++p)
+	z[p].reinit (n);
+
+      ewalena::PreconditionILU<ValueType> factorized;
+      factorized.initialize (A);
+      factorized.vmult (z[0], r);
+      ilut.vmult (z[1], r);
+      ssor.vmult (z[2], r);
+    }
+
+  for (unsigned int p=0; p<3; ++p)
+    error += (distance (serial[p], parallel[p]) != 0.);
+
+  // New values on the same pattern.
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int k=0; k<A.row_length (i); ++k)
+      A.values (i)[k] *= (A.columns (i)[k] == i) ? ValueType (2.) : uniform<ValueType> ();
+
+  ewalena::PreconditionILU<ValueType>  fresh_ilu;
+  ewalena::PreconditionSSOR<ValueType> fresh_ssor;
+  fresh_ilu.initialize (A);
+  fresh_ssor.initialize (A, 1.3);
+  ilu.refactorize (A);
+  ssor.refactorize ();
+
+  ilu.vmult (x, r);
+  fresh_ilu.vmult (y, r);
+  error += (distance (x, y) > 1e-14);
+
+  ssor.vmult (x, r);
+  fresh_ssor.vmult (y, r);
+  error += (distance (x, y) > 1e-14);
+
+  // The pattern of ILUT is kept.
+  const std::size_t n_elements = ilut.n_nonzero_elements ();
+  ilut.refactorize (A);
+  error += (ilut.n_nonzero_elements () != n_elements);
+
+  return error;
+}
+
+// A diffusion problem -div (k grad u) = f on an m x m grid with
+// coefficients over four orders of magnitude: every preconditioner
+// saves iterations of CG, and ILU more than Jacobi.
+unsigned int test_diffusion (const unsigned int m)
+{
+  unsigned int error = 0;
+
+  typedef ewalena::SparseMatrix<double>::Triplet Triplet;
+
+  const unsigned int n = m*m;
+  std::vector<double> k (n);
+  for (unsigned int i=0; i<n; ++i)
+    k[i] = std::pow (10., 4.*(std::rand ()/double (RAND_MAX)) - 2.);
+
+  std::vector<Triplet> triplets;
+  for (unsigned int x=0; x<m; ++x)
+    for (unsigned int y=0; y<m; ++y)
+      {
+	const unsigned int i = x*m + y;
+	double diagonal = 0.;
+
+	const int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+	for (unsigned int d=0; d<4; ++d)
+	  {
+	    const int nx = int (x) + neighbours[d][0];
+	    const int ny = int (y) + neighbours[d][1];
+
+	    if (nx < 0 || ny < 0 || nx >= int (m) || ny >= int (m))
+	      {
+		diagonal += k[i];
+		continue;
+	      }
+
+	    const unsigned int j = nx*m + ny;
+	    const double       c = 2.*k[i]*k[j]/(k[i] + k[j]);
+	    const Triplet element = {i, j, -c};
+	    triplets.push_back (element);
+	    diagonal += c;
+	  }
+
+	const Triplet element = {i, i, diagonal};
+	triplets.push_back (element);
+      }
+
+  const ewalena::SparseMatrix<double> A (n, n, triplets);
+
+  ewalena::Vector<double> b (n);
+  for (unsigned int i=0; i<n; ++i)
+    b(i) = 1.;
+
+  ewalena::PreconditionJacobi<double>      jacobi;
+  ewalena::PreconditionBlockJacobi<double> block_jacobi;
+  ewalena::PreconditionSSOR<double>        ssor;
+  ewalena::PreconditionILU<double>         ilu, ilut;
+  jacobi.initialize (A);
+  block_jacobi.initialize (A, m);
+  ssor.initialize (A, 1.5);
+  ilu.initialize (A);
+  ilut.initialize (A, 1e-4, 10);
+
+  unsigned int steps[6];
+
+  ewalena::SolverControl  control (10000, 1e-8);
+  ewalena::SolverCG<>     cg (control);
+  ewalena::Vector<double> x (n);
+
+  cg.solve (A, x, b);
+  steps[0] = control.last_step ();
+
+  x.reinit (n);
+  cg.solve (A, x, b, jacobi);
+  steps[1] = control.last_step ();
+  error += (control.last_state () != ewalena::SolverControl::success);
+
+  x.reinit (n);
+  cg.solve (A, x, b, block_jacobi);
+  steps[2] = control.last_step ();
+  error += (control.last_state () != ewalena::SolverControl::success);
+
+  x.reinit (n);
+  cg.solve (A, x, b, ssor);
+  steps[3] = control.last_step ();
+  error += (control.last_state () != ewalena::SolverControl::success);
+
+  x.reinit (n);
+  cg.solve (A, x, b, ilu);
+  steps[4] = control.last_step ();
+  error += (control.last_state () != ewalena::SolverControl::success);
+
+  // ILUT is not symmetric.
+  ewalena::SolverGMRES<> gmres (control, 50);
+  x.reinit (n);
+  gmres.solve (A, x, b, ilut);
+  steps[5] = control.last_step ();
+  error += (control.last_state () != ewalena::SolverControl::success);
+
+  for (unsigned int p=1; p<6; ++p)
+    error += (steps[p] >= steps[0]);
+  error += (steps[4] >= steps[1]);
+  error += (steps[5] >= steps[4]);
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test_exact<double> ();
+  error += test_exact<std::complex<double>> ();
+
+  error += test_ssor<double>               (1.);
+  error += test_ssor<std::complex<double>> (1.4);
+
+  error += test_refactorize<double> ();
+  error += test_refactorize<std::complex<double>> ();
+
+  error += test_diffusion (60);
+
+  assert (error == 0);
+}
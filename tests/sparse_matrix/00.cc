@@ -0,0 +1,123 @@
+ 
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <ewalena/base/matrix.h>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include "../tests.h"
+
+// Build a sparse matrix from triplets, with duplicates, and compare
+// the matrix and its product with a vector against the triplets, for
+// any number of threads.
+
+template <typename ValueType>
+unsigned int test (const unsigned int n)
+{
+  typedef typename ewalena::SparseMatrix<ValueType>::Triplet Triplet;
+
+  // A one-dimensional Laplacian assembled element by element, so that
+  // every diagonal element but the ends is given twice, plus a dense
+  // first row and some random elements in no particular order.
+  std::vector<Triplet> triplets;
+
+  const auto add = [&] (const unsigned int i, const unsigned int j, const ValueType value)
+    {
+      triplets.push_back (Triplet {i, j, value});
+    };
+
+  for (unsigned int e=0; e+1<n; ++e)
+    {
+      add (e,   e,    ValueType ( 1.));
+      add (e,   e+1,  ValueType (-1.));
+      add (e+1, e,    ValueType (-1.));
+      add (e+1, e+1,  ValueType ( 1.));
+    }
+
+  for (unsigned int j=0; j<n; j+=2)
+    add (0, j, uniform<ValueType> ());
+
+  for (unsigned int k=0; k<n; ++k)
+    add (std::rand ()%n, std::rand ()%n, uniform<ValueType> ());
+
+  const ewalena::SparseMatrix<ValueType> sparse (n, n, triplets);
+  assert (sparse.n_rows () == n);
+  assert (sparse.n_nonzero_elements () < triplets.size () || n == 1);
+
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int k=1; k<sparse.row_length (i); ++k)
+      assert (sparse.columns (i)[k-1] < sparse.columns (i)[k]);
+
+  // Elements, where a dense copy fits.
+  if (n <= 100)
+    {
+      ewalena::Matrix<ValueType> dense (n, n);
+      for (unsigned int k=0; k<triplets.size (); ++k)
+	dense(triplets[k].row, triplets[k].column) += triplets[k].value;
+
+      for (unsigned int i=0; i<n; ++i)
+	for (unsigned int j=0; j<n; ++j)
+	  assert (std::abs (sparse(i,j) - dense(i,j)) < 1e-14);
+    }
+
+  // Products.
+  ewalena::Vector<ValueType> x (n), y0 (n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      x(i)  = uniform<ValueType> ();
+      y0(i) = uniform<ValueType> ();
+    }
+  const ValueType alpha = uniform<ValueType> (), beta = uniform<ValueType> ();
+
+  ewalena::Vector<ValueType> reference (y0);
+  reference *= beta;
+  for (unsigned int k=0; k<triplets.size (); ++k)
+    reference(triplets[k].row) += alpha*triplets[k].value*x(triplets[k].column);
+
+  ewalena::ThreadPool &pool = ewalena::ThreadPool::instance ();
+  const unsigned int n_threads_max = 
+    std::max (4u, std::thread::hardware_concurrency ());
+
+  pool.set_n_threads (1);
+  ewalena::Vector<ValueType> serial (y0);
+  sparse.vmult (serial, x, alpha, beta);
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (serial(i) - reference(i)) < 1e-12*n);
+
+  for (unsigned int n_threads=2; n_threads<=n_threads_max; ++n_threads)
+    {
+      pool.set_n_threads (n_threads);
+
+      ewalena::Vector<ValueType> y (y0);
+      sparse.vmult (y, x, alpha, beta);
+
+      // Every row is summed by one thread, in the same order.
+      assert (y == serial);
+    }
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test<double> (1);
+  error += test<double> (10);
+  error += test<double> (20000);
+  error += test<std::complex<double> > (10);
+  error += test<std::complex<double> > (20000);
+
+  assert (error == 0);
+
+  return 0;
+}
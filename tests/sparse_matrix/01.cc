@@ -0,0 +1,147 @@
+ 
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <ewalena/base/thread_pool.h>
+#include <ewalena/base/vector.h>
+#include <ewalena/lac/sell_matrix.h>
+#include <ewalena/lac/sparse_matrix.h>
+#include "../tests.h"
+
+// SELL-C-sigma products agree with those of the CSR matrix they were
+// converted from, for every instruction set, window and number of
+// threads; the time taken by both formats is reported.
+
+template <typename ValueType>
+double time_vmult (const ValueType               &M,
+		   ewalena::Vector<typename ValueType::value_type> &y,
+		   const ewalena::Vector<typename ValueType::value_type> &x)
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  M.vmult (y, x);
+  return std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int n)
+{
+  typedef typename ewalena::SparseMatrix<ValueType>::Triplet Triplet;
+
+  // Irregular rows: most are short, some long, some empty.
+  std::vector<Triplet> triplets;
+  for (unsigned int i=0; i<n; ++i)
+    {
+      const unsigned int length = (i%7 == 0) ? 0 : (i%13 == 0) ? 60 : 1 + std::rand ()%9;
+      for (unsigned int k=0; k<length; ++k)
+	triplets.push_back (Triplet {i, unsigned (std::rand ())%n, uniform<ValueType> ()});
+    }
+
+  const ewalena::SparseMatrix<ValueType> csr (n, n, triplets);
+
+  ewalena::Vector<ValueType> x (n), y0 (n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      x(i)  = uniform<ValueType> ();
+      y0(i) = uniform<ValueType> ();
+    }
+  const ValueType alpha = uniform<ValueType> (), beta = uniform<ValueType> ();
+
+  ewalena::ThreadPool &pool = ewalena::ThreadPool::instance ();
+  pool.set_n_threads (1);
+
+  ewalena::Vector<ValueType> reference (y0);
+  csr.vmult (reference, x, alpha, beta);
+
+  const unsigned int sigmas[] = { 1, 8, 100, ewalena::SellMatrix<ValueType>::default_sigma, n };
+  for (unsigned int sigma : sigmas)
+    {
+      const ewalena::SellMatrix<ValueType> sell (csr, sigma);
+      assert (sell.n_nonzero_elements () == csr.n_nonzero_elements ());
+      assert (sell.n_stored_elements () >= sell.n_nonzero_elements ());
+
+      for (unsigned int isa=ewalena::blas::generic; isa<=ewalena::blas::avx512; ++isa)
+	{
+	  if (!ewalena::blas::is_available (ewalena::blas::InstructionSet (isa)))
+	    continue;
+	  ewalena::blas::set_instruction_set (ewalena::blas::InstructionSet (isa));
+
+	  for (unsigned int n_threads=1; n_threads<=4; ++n_threads)
+	    {
+	      pool.set_n_threads (n_threads);
+
+	      ewalena::Vector<ValueType> y (y0);
+	      sell.vmult (y, x, alpha, beta);
+	      for (unsigned int i=0; i<n; ++i)
+		assert (std::abs (y(i) - reference(i)) < 1e-12);
+	    }
+	}
+    }
+
+  // Straight from the triplets, and reinitialised in place.
+  {
+    ewalena::SellMatrix<ValueType> sell (n, n, triplets);
+    assert (sell.n_nonzero_elements () == csr.n_nonzero_elements ());
+
+    ewalena::Vector<ValueType> y (y0);
+    sell.vmult (y, x, alpha, beta);
+    for (unsigned int i=0; i<n; ++i)
+      assert (std::abs (y(i) - reference(i)) < 1e-12);
+
+    const std::vector<Triplet> half (triplets.begin (), triplets.begin () + triplets.size ()/2);
+    sell.reinit (n, n, half, 1);
+    sell.vmult (y, x);
+
+    ewalena::Vector<ValueType> z (n);
+    ewalena::SparseMatrix<ValueType> (n, n, half).vmult (z, x);
+    for (unsigned int i=0; i<n; ++i)
+      assert (std::abs (y(i) - z(i)) < 1e-12);
+  }
+
+  // Timing with the widest instruction set and all threads.
+  for (unsigned int isa=ewalena::blas::avx512; isa>ewalena::blas::generic; --isa)
+    if (ewalena::blas::is_available (ewalena::blas::InstructionSet (isa)))
+      {
+	ewalena::blas::set_instruction_set (ewalena::blas::InstructionSet (isa));
+	break;
+      }
+  pool.set_n_threads (std::max (1u, std::thread::hardware_concurrency ()));
+
+  const ewalena::SellMatrix<ValueType> sell (csr);
+  ewalena::Vector<ValueType> y (n);
+
+  double csr_time = 1e10, sell_time = 1e10;
+  for (unsigned int repeat=0; repeat<5; ++repeat)
+    {
+      csr_time  = std::min (csr_time,  time_vmult (csr,  y, x));
+      sell_time = std::min (sell_time, time_vmult (sell, y, x));
+    }
+
+  std::cout << " n=" << n 
+	    << "  padding " << double (sell.n_stored_elements ())/sell.n_nonzero_elements ()
+	    << "  CSR " << csr_time << " s  SELL " << sell_time << " s" << std::endl;
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test<double> (13);
+  error += test<double> (100000);
+  error += test<std::complex<double> > (13);
+  error += test<std::complex<double> > (20000);
+
+  assert (error == 0);
+
+  return 0;
+}
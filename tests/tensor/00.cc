@@ -0,0 +1,55 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <utility>
+#include <ewalena/base/tensor.h>
+
+
+// Copies, moves and the arithmetic operators.
+
+unsigned int test ()
+{
+  ewalena::Tensor<3, 2, double> a, b, c;
+  for (unsigned int i=0; i<3; ++i)
+    for (unsigned int j=0; j<3; ++j)
+      {
+	a(i,j) = double (i+j);
+	b(i,j) = double (i*j);
+	c(i,j) = 1.;
+      }
+
+  // Chained sums build the result in the first temporary.
+  ewalena::Tensor<3, 2, double> d = a + b - c;
+  for (unsigned int i=0; i<3; ++i)
+    for (unsigned int j=0; j<3; ++j)
+      assert (d(i,j) == double (i+j) + double (i*j) - 1.);
+
+  // Copy and move assignment.
+  ewalena::Tensor<3, 2, double> e;
+  e = d;
+  assert (e == d);
+
+  ewalena::Tensor<3, 2, double> f (std::move (d));
+  assert (f == e);
+
+  // A moved-from tensor can be assigned to again.
+  d = a;
+  assert (d == a);
+
+  e = std::move (f);
+  assert (e == d + b - c);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test ();
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <complex>
+#include <type_traits>
+#include <ewalena/base/tensor.h>
+
+
+// Tensors hold their components inline: their size is known at
+// compile time and they are copied with a plain memory copy.
+
+static_assert (sizeof (ewalena::Tensor<3, 2, double>) == 72, 
+	       "A rank 2 tensor in three dimensions should hold nine doubles and nothing else.");
+static_assert (sizeof (ewalena::Tensor<2, 4, double>) == 16*sizeof (double), 
+	       "A rank 4 tensor in two dimensions should hold sixteen doubles and nothing else.");
+static_assert (sizeof (ewalena::Tensor<3, 6, std::complex<double> >) == 729*sizeof (std::complex<double>), 
+	       "Tensors should not be padded.");
+static_assert (alignof (ewalena::Tensor<2, 2, double>) == 32, 
+	       "Tensors should be aligned as widely as their size allows.");
+static_assert (std::is_trivially_copyable<ewalena::Tensor<3, 4, double> >::value,
+	       "Tensors should be trivially copyable.");
+
+unsigned int test ()
+{
+  // A tensor is zero by default.
+  ewalena::Tensor<3, 4, double> tensor;
+  for (unsigned int i=0; i<tensor.n_components (); ++i)
+    assert ((*tensor)[i] == 0.);
+
+  // An array of tensors is one contiguous block.
+  ewalena::Tensor<2, 2, double> tensors[8];
+  assert (reinterpret_cast<const char*> (*tensors[1]) - reinterpret_cast<const char*> (*tensors[0]) 
+	  == 4*sizeof (double));
+  
+  tensors[3](1,0) = 2.;
+  tensors[4] = tensors[3];
+  assert (tensors[4](1,0) == 2.);
+  assert (tensors[4] == tensors[3]);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test ();
+  assert (error == 0);
+
+  return 0;
+}
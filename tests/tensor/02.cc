@@ -0,0 +1,69 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <array>
+#include <ewalena/base/tensor.h>
+
+
+// Element access: the layout of components, access through a list
+// of indices and through an array of indices.
+
+template <int dim>
+unsigned int test_layout ()
+{
+  ewalena::Tensor<dim, 3, double> tensor;
+
+  for (unsigned int i=0; i<dim; ++i)
+    for (unsigned int j=0; j<dim; ++j)
+      for (unsigned int k=0; k<dim; ++k)
+	{
+	  const unsigned int position = i + dim*j + dim*dim*k;
+	  assert ((ewalena::Tensor<dim, 3, double>::component_index ({{i, j, k}}) == position));
+
+	  tensor(i,j,k) = double (position);
+	  assert ((*tensor)[position] == double (position));
+
+	  const std::array<unsigned int, 3> index = {{i, j, k}};
+	  assert (tensor(index) == double (position));
+	}
+
+  const ewalena::Tensor<dim, 3, double> &constant = tensor;
+  assert (constant(dim-1, 0, dim-1) == tensor(dim-1, 0, dim-1));
+
+  return 0;
+}
+
+unsigned int test ()
+{
+  test_layout<1> ();
+  test_layout<2> ();
+  test_layout<3> ();
+
+  // Inverse of a rank two tensor.
+  ewalena::Tensor<3, 2, double> A, A_inverse, identity;
+  A(0,0) = 2.; A(0,1) = 1.; A(1,1) = 3.; A(2,1) = 1.; A(2,2) = 4.;
+  A_inverse.invert (A);
+
+  for (unsigned int i=0; i<3; ++i)
+    for (unsigned int k=0; k<3; ++k)
+      for (unsigned int j=0; j<3; ++j)
+	identity(i,k) += A(i,j)*A_inverse(j,k);
+
+  for (unsigned int i=0; i<3; ++i)
+    for (unsigned int j=0; j<3; ++j)
+      assert (std::fabs (identity(i,j) - (i==j ? 1. : 0.)) < 1e-14);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test ();
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <cmath>
+#include <ewalena/base/tensor.h>
+
+
+// Contraction of arbitrary index pairs, compared against explicit
+// loops.
+
+using ewalena::IndexPair;
+
+template <int dim, int rank>
+void fill (ewalena::Tensor<dim, rank, double> &tensor,
+	   const double                        seed)
+{
+  for (unsigned int i=0; i<tensor.n_components (); ++i)
+    (*tensor)[i] = std::sin (seed + 0.37*i);
+}
+
+template <int dim>
+unsigned int test ()
+{
+  ewalena::Tensor<dim, 2, double> A;
+  ewalena::Tensor<dim, 3, double> B;
+  ewalena::Tensor<dim, 4, double> C;
+  ewalena::Tensor<dim, 6, double> D;
+  fill (A, 0.1); fill (B, 0.2); fill (C, 0.3); fill (D, 0.4);
+
+  const double tolerance = 1e-12;
+
+  // The existing overloads.
+  {
+    const ewalena::Tensor<dim, 2, double> T = contract (A, C);
+    for (unsigned int k=0; k<dim; ++k)
+      for (unsigned int l=0; l<dim; ++l)
+	{
+	  double sum = 0.;
+	  for (unsigned int i=0; i<dim; ++i)
+	    for (unsigned int j=0; j<dim; ++j)
+	      sum += A(i,j)*C(i,j,k,l);
+	  assert (std::fabs (T(k,l) - sum) < tolerance);
+	}
+
+    const ewalena::Tensor<dim, 1, double> t = contract (B, A);
+    for (unsigned int i=0; i<dim; ++i)
+      {
+	double sum = 0.;
+	for (unsigned int j=0; j<dim; ++j)
+	  for (unsigned int k=0; k<dim; ++k)
+	    sum += B(i,j,k)*A(j,k);
+	assert (std::fabs (t(i) - sum) < tolerance);
+      }
+  }
+
+  // Pairs out of order: T_{jlm} = B_{ijk} C_{kilm}.
+  {
+    const ewalena::Tensor<dim, 3, double> T 
+      = ewalena::contract<IndexPair<0, 1>, IndexPair<2, 0> > (B, C);
+    for (unsigned int j=0; j<dim; ++j)
+      for (unsigned int l=0; l<dim; ++l)
+	for (unsigned int m=0; m<dim; ++m)
+	  {
+	    double sum = 0.;
+	    for (unsigned int i=0; i<dim; ++i)
+	      for (unsigned int k=0; k<dim; ++k)
+		sum += B(i,j,k)*C(k,i,l,m);
+	    assert (std::fabs (T(j,l,m) - sum) < tolerance);
+	  }
+  }
+
+  // Rank six: T_{ijkl} = D_{ijmkln} A_{mn}.
+  {
+    const ewalena::Tensor<dim, 4, double> T 
+      = ewalena::contract<IndexPair<2, 0>, IndexPair<5, 1> > (D, A);
+    for (unsigned int i=0; i<dim; ++i)
+      for (unsigned int j=0; j<dim; ++j)
+	for (unsigned int k=0; k<dim; ++k)
+	  for (unsigned int l=0; l<dim; ++l)
+	    {
+	      double sum = 0.;
+	      for (unsigned int m=0; m<dim; ++m)
+		for (unsigned int n=0; n<dim; ++n)
+		  sum += D(i,j,m,k,l,n)*A(m,n);
+	      assert (std::fabs (T(i,j,k,l) - sum) < tolerance);
+	    }
+  }
+
+  // No pairs is the outer product, all pairs a scalar.
+  {
+    const ewalena::Tensor<dim, 5, double> T = ewalena::contract<> (A, B);
+    for (unsigned int i=0; i<dim; ++i)
+      for (unsigned int j=0; j<dim; ++j)
+	for (unsigned int k=0; k<dim; ++k)
+	  for (unsigned int l=0; l<dim; ++l)
+	    for (unsigned int m=0; m<dim; ++m)
+	      assert (T(i,j,k,l,m) == A(i,j)*B(k,l,m));
+
+    const ewalena::Tensor<dim, 0, double> s 
+      = ewalena::contract<IndexPair<0, 1>, IndexPair<1, 0> > (A, A);
+    double sum = 0.;
+    for (unsigned int i=0; i<dim; ++i)
+      for (unsigned int j=0; j<dim; ++j)
+	sum += A(i,j)*A(j,i);
+    assert (std::fabs (s () - sum) < tolerance);
+  }
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test<1> () + test<2> () + test<3> ();
+  assert (error == 0);
+
+  return 0;
+}
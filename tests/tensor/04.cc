@@ -0,0 +1,92 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <cmath>
+#include <ewalena/base/symmetric_tensor.h>
+
+
+// Symmetric tensors: storage, conversion to and from full tensors,
+// and contractions compared with those of full tensors.
+
+using ewalena::IndexPair;
+
+static_assert (sizeof (ewalena::SymmetricTensor<3, 4, double>) == 21*sizeof (double),
+	       "A symmetric rank four tensor in three dimensions should store 21 components.");
+static_assert (sizeof (ewalena::SymmetricTensor<3, 2, double>) == 6*sizeof (double),
+	       "A symmetric rank two tensor in three dimensions should store 6 components.");
+
+template <int dim>
+unsigned int test ()
+{
+  const double tolerance = 1e-12;
+
+  // Fill the unique components, which makes symmetric tensors.
+  ewalena::SymmetricTensor<dim, 4, double> C;
+  for (unsigned int i=0; i<C.n_components (); ++i)
+    (*C)[i] = std::cos (1. + 0.7*i);
+
+  ewalena::SymmetricTensor<dim, 2, double> epsilon;
+  for (unsigned int i=0; i<epsilon.n_components (); ++i)
+    (*epsilon)[i] = std::sin (2. + 0.3*i);
+
+  // Symmetric partners share a component.
+  if (dim > 1)
+    {
+      assert (&C(0,1,1,1) == &C(1,1,1,0));
+      assert (&epsilon(0,1) == &epsilon(1,0));
+    }
+
+  // Conversion to a full tensor and back is lossless.
+  const ewalena::Tensor<dim, 4, double> C_full       = C;
+  const ewalena::Tensor<dim, 2, double> epsilon_full = epsilon;
+  assert ((ewalena::SymmetricTensor<dim, 4, double> (C_full) == C));
+  assert ((ewalena::SymmetricTensor<dim, 2, double> (epsilon_full) == epsilon));
+
+  for (unsigned int i=0; i<dim; ++i)
+    for (unsigned int j=0; j<dim; ++j)
+      for (unsigned int k=0; k<dim; ++k)
+	for (unsigned int l=0; l<dim; ++l)
+	  {
+	    assert (C_full(i,j,k,l) == C_full(j,i,k,l));
+	    assert (C_full(i,j,k,l) == C_full(k,l,i,j));
+	  }
+
+  // sigma = C:epsilon in Voigt form and in full.
+  const ewalena::SymmetricTensor<dim, 2, double> sigma = contract (C, epsilon);
+  const ewalena::Tensor<dim, 2, double> sigma_full 
+    = ewalena::contract<IndexPair<2, 0>, IndexPair<3, 1> > (C_full, epsilon_full);
+
+  for (unsigned int i=0; i<dim; ++i)
+    for (unsigned int j=0; j<dim; ++j)
+      assert (std::fabs (sigma(i,j) - sigma_full(i,j)) < tolerance);
+
+  assert (contract (epsilon, C) == sigma);
+
+  // The energy epsilon:C:epsilon.
+  const ewalena::Tensor<dim, 0, double> energy 
+    = ewalena::contract<IndexPair<0, 0>, IndexPair<1, 1> > (epsilon_full, sigma_full);
+  assert (std::fabs (contract (epsilon, sigma) - energy ()) < tolerance);
+
+  // Symmetric part of a tensor that is not symmetric.
+  ewalena::Tensor<dim, 2, double> A;
+  for (unsigned int i=0; i<A.n_components (); ++i)
+    (*A)[i] = double (i);
+  const ewalena::SymmetricTensor<dim, 2, double> A_symmetric (A);
+  for (unsigned int i=0; i<dim; ++i)
+    for (unsigned int j=0; j<dim; ++j)
+      assert (A_symmetric(i,j) == (A(i,j) + A(j,i))/2.);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test<1> () + test<2> () + test<3> ();
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+ 
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <cmath>
+#include <ewalena/base/tensor_field.h>
+
+
+// TensorField: storage layout, batched arithmetic, pointwise inverse
+// and contraction, compared against the same operations on single
+// tensors.
+
+using ewalena::IndexPair;
+
+template <int dim, int rank>
+void fill (ewalena::TensorField<dim, rank, double> &field,
+	   const double                             seed)
+{
+  for (unsigned int p=0; p<field.n_points (); ++p)
+    {
+      ewalena::Tensor<dim, rank, double> T (false);
+      for (unsigned int i=0; i<T.n_components (); ++i)
+	(*T)[i] = std::sin (seed + 0.37*i + 0.011*p);
+      field.set (p, T);
+    }
+}
+
+template <int dim>
+unsigned int test ()
+{
+  // Not a multiple of the block size nor of the alignment.
+  const unsigned int n_points = 2500;
+  const double tolerance      = 1e-12;
+
+  ewalena::TensorField<dim, 2, double> A (n_points), B (n_points);
+  ewalena::TensorField<dim, 3, double> C (n_points);
+  fill (A, 0.1); fill (B, 0.2); fill (C, 0.3);
+
+  // Every component array starts aligned.
+  assert (A.stride () >= n_points);
+  for (unsigned int c=0; c<A.n_tensor_components; ++c)
+    assert (reinterpret_cast<std::size_t> (A.component (c)) % ewalena::memory::alignment == 0);
+
+  // Element access agrees with the gathered tensor.
+  for (unsigned int p=0; p<n_points; p+=97)
+    for (unsigned int i=0; i<dim; ++i)
+      for (unsigned int j=0; j<dim; ++j)
+	assert (A(p,i,j) == A[p](i,j));
+
+  // Arithmetic.
+  {
+    ewalena::TensorField<dim, 2, double> F (A);
+    F.sadd (2., A, -3., B);
+    F -= B;
+    F *= 0.5;
+    for (unsigned int p=0; p<n_points; ++p)
+      {
+	ewalena::Tensor<dim, 2, double> T = A[p];
+	T.sadd (2., A[p], -3., B[p]);
+	T -= B[p];
+	T *= 0.5;
+	for (unsigned int c=0; c<T.n_components (); ++c)
+	  assert (std::fabs ((*F[p])[c] - (*T)[c]) < tolerance);
+      }
+
+    // Moving leaves the source empty, copying and reinit reuse memory.
+    ewalena::TensorField<dim, 2, double> G (std::move (F));
+    assert (F.n_points () == 0);
+    assert (G.n_points () == n_points);
+    G.reinit (10);
+    assert (G(9,0,0) == 0.);
+  }
+
+  // Pointwise inverse.
+  {
+    ewalena::TensorField<dim, 2, double> F (A);
+    for (unsigned int p=0; p<n_points; ++p)
+      for (unsigned int i=0; i<dim; ++i)
+	F(p,i,i) += 4.;
+
+    ewalena::TensorField<dim, 2, double> F_inverse;
+    F_inverse.invert (F);
+    for (unsigned int p=0; p<n_points; p+=13)
+      {
+	ewalena::Tensor<dim, 2, double> T = F[p], T_inverse (false);
+	T_inverse.invert (T);
+	for (unsigned int i=0; i<dim; ++i)
+	  for (unsigned int j=0; j<dim; ++j)
+	    assert (std::fabs (F_inverse(p,i,j) - T_inverse(i,j)) < tolerance);
+      }
+  }
+
+  // Contraction of two fields, and of a tensor with a field.
+  {
+    const ewalena::TensorField<dim, 1, double> F 
+      = ewalena::contract<IndexPair<1, 0>, IndexPair<2, 1> > (C, A);
+    const ewalena::TensorField<dim, 3, double> G 
+      = ewalena::contract<IndexPair<0, 1> > (A, C);
+    const ewalena::TensorField<dim, 2, double> H 
+      = ewalena::contract<IndexPair<1, 0> > (A[7], B);
+
+    for (unsigned int p=0; p<n_points; ++p)
+      {
+	const ewalena::Tensor<dim, 1, double> f 
+	  = ewalena::contract<IndexPair<1, 0>, IndexPair<2, 1> > (C[p], A[p]);
+	const ewalena::Tensor<dim, 3, double> g 
+	  = ewalena::contract<IndexPair<0, 1> > (A[p], C[p]);
+	const ewalena::Tensor<dim, 2, double> h 
+	  = ewalena::contract<IndexPair<1, 0> > (A[7], B[p]);
+
+	for (unsigned int c=0; c<f.n_components (); ++c)
+	  assert (std::fabs ((*F[p])[c] - (*f)[c]) < tolerance);
+	for (unsigned int c=0; c<g.n_components (); ++c)
+	  assert (std::fabs ((*G[p])[c] - (*g)[c]) < tolerance);
+	for (unsigned int c=0; c<h.n_components (); ++c)
+	  assert (std::fabs ((*H[p])[c] - (*h)[c]) < tolerance);
+      }
+  }
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test<1> () + test<2> () + test<3> ();
+  assert (error == 0);
+
+  return 0;
+}
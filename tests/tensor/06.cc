@@ -0,0 +1,97 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <cmath>
+#include <complex>
+#include <ewalena/base/tensor.h>
+#include <ewalena/base/tensor_field.h>
+
+// Inverse of rank two tensors and tensor fields of dimension four to
+// eight, beyond the closed forms: T T^{-1} = I, and the batched
+// inverse of a field agrees with that of its single tensors.
+
+template <typename ValueType>
+ValueType value (const double real,
+		 const double)
+{
+  return ValueType (real);
+}
+
+template <>
+std::complex<double> value (const double real,
+			    const double imaginary)
+{
+  return std::complex<double> (real, imaginary);
+}
+
+template <int dim, typename ValueType>
+ewalena::Tensor<dim, 2, ValueType> tensor (const double seed)
+{
+  // Diagonally dominant enough to be well conditioned, but with
+  // large off-diagonal elements so that rows are exchanged.
+  ewalena::Tensor<dim, 2, ValueType> T (false);
+  for (unsigned int i=0; i<dim; ++i)
+    for (unsigned int j=0; j<dim; ++j)
+      T(i,j) = value<ValueType> (std::sin (seed + 0.37*i*j + 1.3*j), 0.2*std::cos (seed*j));
+  for (unsigned int i=0; i<dim; ++i)
+    T(i,(i+1)%dim) += ValueType (3.);
+  return T;
+}
+
+template <int dim, typename ValueType>
+unsigned int test ()
+{
+  unsigned int error = 0;
+
+  const double tolerance = 1e-12;
+
+  const ewalena::Tensor<dim, 2, ValueType> T = tensor<dim, ValueType> (0.1);
+  ewalena::Tensor<dim, 2, ValueType> T_inverse (false);
+  T_inverse.invert (T);
+
+  for (unsigned int i=0; i<dim; ++i)
+    for (unsigned int j=0; j<dim; ++j)
+      {
+	ValueType I = ValueType (0);
+	for (unsigned int k=0; k<dim; ++k)
+	  I += T(i,k)*T_inverse(k,j);
+	error += (std::abs (I - ValueType (i == j)) > tolerance);
+      }
+
+  // Not a multiple of the vector width, and inverted in place.
+  const unsigned int n_points = 1001;
+
+  ewalena::TensorField<dim, 2, ValueType> F (n_points);
+  for (unsigned int p=0; p<n_points; ++p)
+    F.set (p, tensor<dim, ValueType> (0.01*p));
+
+  ewalena::TensorField<dim, 2, ValueType> F_inverse (F);
+  F_inverse.invert (F_inverse);
+
+  for (unsigned int p=0; p<n_points; p+=7)
+    {
+      ewalena::Tensor<dim, 2, ValueType> S_inverse (false);
+      S_inverse.invert (F[p]);
+      for (unsigned int i=0; i<dim; ++i)
+	for (unsigned int j=0; j<dim; ++j)
+	  error += (std::abs (F_inverse(p,i,j) - S_inverse(i,j)) > tolerance*std::abs (S_inverse(i,j)) + tolerance);
+    }
+
+  return error;
+}
+
+int main ()
+{
+  unsigned int error = 0;
+
+  error += test<4, double> () + test<5, double> () + test<6, double> ();
+  error += test<7, double> () + test<8, double> ();
+  error += test<4, std::complex<double> > () + test<8, std::complex<double> > ();
+
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,32 @@
+ 
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <complex>
+#include <cstdlib>
+
+#ifndef __ewalena_tests_h
+#define __ewalena_tests_h
+
+// Helpers shared by the tests.
+
+// A random number uniformly distributed in [-0.5, 0.5], in both real
+// and imaginary part if it is complex.
+template <typename ValueType>
+inline
+ValueType uniform ()
+{
+  return ValueType (std::rand ()/double (RAND_MAX) - 0.5);
+}
+
+template <>
+inline
+std::complex<double> uniform ()
+{
+  return std::complex<double> (uniform<double> (), uniform<double> ());
+}
+
+#endif /* __ewalena_tests_h */
@@ -0,0 +1,212 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <ewalena/base/vector.h>
+
+// Vectorised kernels against plain loops, for every instruction set
+// this processor supports.
+
+template <typename ValueType>
+ValueType random_value ()
+{
+  return ValueType (std::rand ()/double (RAND_MAX) - 0.5);
+}
+
+template <>
+std::complex<double> random_value<std::complex<double> > ()
+{
+  return std::complex<double> (std::rand ()/double (RAND_MAX) - 0.5,
+			       std::rand ()/double (RAND_MAX) - 0.5);
+}
+
+double conjugate (const double a)
+{
+  return a;
+}
+
+std::complex<double> conjugate (const std::complex<double> a)
+{
+  return std::conj (a);
+}
+
+template <typename ValueType>
+double difference (const ewalena::Vector<ValueType> &v,
+		   const ewalena::Vector<ValueType> &w)
+{
+  double max = 0.;
+  for (unsigned int i=0; i<v.size (); ++i)
+    max = std::max (max, std::abs (v(i) - w(i)));
+  return max;
+}
+
+template <typename ValueType>
+unsigned int test (const unsigned int n)
+{
+  const double tolerance = 1e-13*(n+1);
+
+  ewalena::Vector<ValueType> u (n), v (n), w (n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      u(i) = random_value<ValueType> ();
+      v(i) = random_value<ValueType> ();
+    }
+
+  const ValueType a = random_value<ValueType> ();
+  const ValueType b = random_value<ValueType> ();
+
+  // += and -=
+  w = u;
+  w += v;
+  for (unsigned int i=0; i<n; ++i)
+    assert (w(i) == u(i) + v(i));
+
+  w -= v;
+  w -= u;
+  assert (difference (w, ewalena::Vector<ValueType> (n)) <= tolerance);
+
+  // *= and /=
+  w = u;
+  w *= a;
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (w(i) - a*u(i)) <= tolerance);
+
+  w /= a;
+  assert (difference (w, u) <= tolerance*std::abs (ValueType (1)/a));
+
+  // Norms.
+  double l1 = 0., l2 = 0.;
+  for (unsigned int i=0; i<n; ++i)
+    {
+      l1 += std::abs (u(i));
+      l2 += std::norm (u(i));
+    }
+  assert (std::abs (u.l1_norm () - l1) <= tolerance);
+  assert (std::abs (u.l2_norm () - std::sqrt (l2)) <= tolerance);
+
+  // Scale-and-add.
+  if (n != 0)
+    {
+      for (unsigned int i=0; i<n; ++i)
+	w(i) = std::nan ("");
+
+      w.sadd (a, u);
+      for (unsigned int i=0; i<n; ++i)
+	assert (std::abs (w(i) - a*u(i)) <= tolerance);
+
+      w.sadd (a, u, b, v);
+      for (unsigned int i=0; i<n; ++i)
+	assert (std::abs (w(i) - (a*u(i) + b*v(i))) <= tolerance);
+
+      // Infinities stay infinite, in every lane and in the tail.
+      ewalena::Vector<ValueType> z (u);
+      for (unsigned int i=0; i<n; i+=3)
+	z(i) = ValueType (std::numeric_limits<double>::infinity ());
+
+      w.sadd (a, z);
+      for (unsigned int i=0; i<n; ++i)
+	if (i%3 == 0)
+	  assert (std::isinf (std::abs (w(i))) && !std::isnan (std::real (w(i))));
+	else
+	  assert (std::abs (w(i) - a*u(i)) <= tolerance);
+    }
+
+  // Kernels not (yet) behind a Vector operation.
+  ValueType dot = ValueType (0), dotu = ValueType (0);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      dot  += conjugate (u(i))*v(i);
+      dotu += u(i)*v(i);
+    }
+
+  std::vector<ValueType> x (n), y (n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      x[i] = u(i);
+      y[i] = v(i);
+    }
+  assert (std::abs (ewalena::blas::dot (n, x.data (), y.data ()) - dot) <= tolerance);
+  assert (std::abs (ewalena::blas::dotu (n, x.data (), y.data ()) - dotu) <= tolerance);
+
+  ewalena::blas::axpy (n, a, x.data (), y.data ());
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (y[i] - (v(i) + a*u(i))) <= tolerance);
+
+  ewalena::blas::axpy_conj (n, b, x.data (), y.data ());
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (y[i] - (v(i) + a*u(i) + b*conjugate (u(i)))) <= tolerance);
+
+  for (unsigned int i=0; i<n; ++i)
+    y[i] = v(i) + a*u(i);
+  ewalena::blas::axpby (n, a, x.data (), b, y.data ());
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (y[i] - (a*u(i) + b*(v(i) + a*u(i)))) <= tolerance);
+
+  std::vector<ValueType> z (y);
+  ewalena::blas::multiply_add (n, x.data (), y.data (), z.data ());
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (z[i] - (y[i] + x[i]*y[i])) <= tolerance);
+
+  return 0;
+}
+
+// Report the bandwidth reached by y+=x on a vector well beyond the
+// caches.
+void bandwidth ()
+{
+  const unsigned int n = 1 << 22;
+  ewalena::Vector<double> x (n), y (n);
+
+  y += x;
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  for (unsigned int r=0; r<10; ++r)
+    y += x;
+  const double time = 
+    std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+  std::cout << "   y+=x: " << 10*3.*sizeof (double)*n/time*1e-9 << " GB/s" << std::endl;
+}
+
+int main ()
+{
+  const char *names[] = { "generic", "sse2", "avx2", "avx512" };
+  const ewalena::blas::InstructionSet selected = ewalena::blas::instruction_set ();
+
+  std::cout << " Selected: " << names[selected] << std::endl;
+
+  unsigned int error = 0;
+
+  for (int isa=ewalena::blas::generic; isa<=ewalena::blas::avx512; ++isa)
+    {
+      if (!ewalena::blas::is_available (ewalena::blas::InstructionSet (isa)))
+	continue;
+
+      ewalena::blas::set_instruction_set (ewalena::blas::InstructionSet (isa));
+      std::cout << " Testing: " << names[isa] << std::endl;
+
+      // All tails of the widest register with four-fold unrolling.
+      for (unsigned int n=0; n<70; ++n)
+	{
+	  error += test<double> (n);
+	  error += test<std::complex<double> > (n);
+	}
+      error += test<double> (1001);
+      error += test<std::complex<double> > (1001);
+
+      bandwidth ();
+    }
+
+  ewalena::blas::set_instruction_set (selected);
+
+  assert (error == 0);
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <complex>
+#include <cmath>
+#include <ewalena/base/vector.h>
+
+
+// Expressions of vectors and matrices, evaluated in one pass and
+// compared against element-by-element loops.
+
+template <typename ValueType>
+unsigned int test_vector (const unsigned int n)
+{
+  ewalena::Vector<ValueType> u (n), v (n), w (n), z (n);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      u(i) = ValueType (1.+i);
+      v(i) = ValueType (2.-0.5*i);
+      w(i) = ValueType (0.25*i*i);
+      z(i) = ValueType (3.);
+    }
+
+  const ValueType a = ValueType (2.), b = ValueType (-0.5), 
+    c = ValueType (0.125), d = ValueType (4.);
+
+  // A linear combination, assigned to a new vector.
+  ewalena::Vector<ValueType> x = a*u + b*v + c*w - d*z;
+  assert (x.size () == n);
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (x(i) - (a*u(i) + b*v(i) + c*w(i) - d*z(i))) < 1e-12);
+
+  // Elementwise products and quotients, assigned to an existing
+  // vector of a different size.
+  ewalena::Vector<ValueType> y (1);
+  y = ewalena::elementwise_product (u, v) - ewalena::elementwise_quotient (w, z)/a;
+  assert (y.size () == n);
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (y(i) - (u(i)*v(i) - w(i)/z(i)/a)) < 1e-12);
+
+  // The left hand side may appear on the right hand side.
+  ewalena::Vector<ValueType> x_copy (x);
+  x = -x + a*(u - v);
+  x += u*b;
+  x -= w;
+  for (unsigned int i=0; i<n; ++i)
+    assert (std::abs (x(i) - (-x_copy(i) + a*(u(i) - v(i)) + u(i)*b - w(i))) < 1e-12);
+
+  return 0;
+}
+
+template <typename ValueType>
+unsigned int test_matrix (const unsigned int m, 
+			  const unsigned int n)
+{
+  ewalena::Matrix<ValueType> A (m, n), B (m, n);
+  for (unsigned int i=0; i<m; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+	A(i,j) = ValueType (i+0.5*j);
+	B(i,j) = ValueType (1.+j);
+      }
+
+  ewalena::Matrix<ValueType> C = ValueType (3.)*A - B/ValueType (2.);
+  C += ewalena::elementwise_product (A, B);
+  for (unsigned int i=0; i<m; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      assert (std::abs (C(i,j) - (ValueType (3.)*A(i,j) - B(i,j)/ValueType (2.) + A(i,j)*B(i,j))) < 1e-12);
+
+  C = A + B;
+  C -= A;
+  assert (C == B);
+
+  // Assignment resizes an empty (or differently shaped) matrix.
+  ewalena::Matrix<ValueType> D;
+  D = A + B;
+  assert (D.n_rows () == m && D.n_cols () == n);
+  D -= A;
+  assert (D == B);
+
+  return 0;
+}
+
+unsigned int test ()
+{
+  for (unsigned int n=0; n<20; ++n)
+    {
+      test_vector<double> (n);
+      test_vector<std::complex<double> > (n);
+    }
+
+  test_matrix<double> (7, 5);
+  test_matrix<std::complex<double> > (3, 9);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test ();
+  assert (error == 0);
+
+  return 0;
+}
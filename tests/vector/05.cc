@@ -0,0 +1,82 @@
+// -------------------------------------------------------------------
+// Copyright 2012 namespace ewalena authors. All rights reserved.
+//
+// Author: Toby D. Young
+// -------------------------------------------------------------------
+
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <ewalena/base/vector.h>
+
+
+// Move semantics and reuse of memory.
+
+ewalena::Vector<double> make_vector (const unsigned int n)
+{
+  ewalena::Vector<double> vector (n, false);
+  for (unsigned int i=0; i<n; ++i)
+    vector(i) = double (i);
+  return vector;
+}
+
+unsigned int test ()
+{
+  // An empty vector owns nothing.
+  ewalena::Vector<double> empty;
+  assert (empty.size () == 0);
+
+  // Moving hands the memory over and leaves the source empty.
+  ewalena::Vector<double> vector = make_vector (10);
+  const double *address = &vector(0);
+
+  ewalena::Vector<double> moved (std::move (vector));
+  assert (vector.size () == 0);
+  assert (moved.size () == 10);
+  assert (&moved(0) == address);
+
+  vector = std::move (moved);
+  assert (moved.size () == 0);
+  assert (&vector(0) == address);
+  for (unsigned int i=0; i<10; ++i)
+    assert (vector(i) == double (i));
+
+  // Shrinking or keeping the size does not reallocate, and neither
+  // does copying into a vector that is large enough.
+  vector.reinit (4);
+  assert (vector.size () == 4);
+  assert (&vector(0) == address);
+  assert (vector(3) == 0.);
+
+  vector.reinit (10, false);
+  assert (&vector(0) == address);
+
+  vector = make_vector (7);
+  address = &vector(0);
+  ewalena::Vector<double> copy = make_vector (3);
+  vector = copy;
+  assert (&vector(0) == address);
+  assert (vector == copy);
+
+  // Assignment returns a reference, so it can be chained.
+  ewalena::Vector<double> a, b;
+  a = b = copy;
+  assert (a == copy);
+
+  // Vectors of vectors move their elements when they grow.
+  std::vector<ewalena::Vector<double> > vectors;
+  for (unsigned int i=0; i<16; ++i)
+    vectors.push_back (make_vector (i+1));
+  for (unsigned int i=0; i<16; ++i)
+    assert (vectors[i].size () == i+1);
+
+  return 0;
+}
+
+int main ()
+{
+  unsigned int error = test ();
+  assert (error == 0);
+
+  return 0;
+}